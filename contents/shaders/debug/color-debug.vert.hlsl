@@ -1,24 +1,10 @@
-struct PER_CAMERA
-{
-    float4x4 view;
-    float4x4 projection;
-
-    float4x4 projectionView;
-
-    float4x4 invertedView;
-    float4x4 invertedProjection;
-};
+#include "common.hlsl"
 
 layout (set = 0, binding = 0) ConstantBuffer<PER_CAMERA> camera : register(b0, space0);
-
-struct PER_OBJECT
-{
-    float4x4 world;
-    float4x4 normal;
-};
-
 layout (set = 1, binding = 0) StructuredBuffer<PER_OBJECT> object : register(t0, space0);
 
+[[vk::push_constant]] ConstantBuffer<PER_DRAW> draw;
+
 struct VS_OUTPUT
 {
 	float4 position : SV_POSITION;
@@ -31,7 +17,7 @@ VS_OUTPUT main(VS_INPUT input)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
 
-    output.position = mul(object[0].world, float4(input.POSITION, 1.));
+    output.position = mul(object[draw.objectIndex].world, float4(input.POSITION, 1.));
     output.position = mul(camera.projectionView, output.position);
 
     output.color = unpackAttribute(input.COLOR_0);
@@ -44,7 +30,7 @@ VS_OUTPUT main(VS_INPUT input)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
 
-    output.position = mul(object[0].world, float4(input.POSITION, 1.));
+    output.position = mul(object[draw.objectIndex].world, float4(input.POSITION, 1.));
     output.position = mul(camera.projectionView, output.position);
 
     output.color = unpackAttribute(input.COLOR_0);
@@ -1,24 +1,10 @@
-struct PER_CAMERA
-{
-    float4x4 view;
-    float4x4 projection;
-
-    float4x4 projectionView;
-
-    float4x4 invertedView;
-    float4x4 invertedProjection;
-};
+#include "common.hlsl"
 
 layout (set = 0, binding = 0) ConstantBuffer<PER_CAMERA> camera : register(b0, space0);
-
-struct PER_OBJECT
-{
-    float4x4 world;
-    float4x4 normal;
-};
-
 layout (set = 1, binding = 0) StructuredBuffer<PER_OBJECT> object : register(t0, space0);
 
+[[vk::push_constant]] ConstantBuffer<PER_DRAW> draw;
+
 struct VS_OUTPUT
 {
 	float4 sv_position : SV_POSITION;
@@ -30,10 +16,10 @@ VS_OUTPUT process(in float3 position, in float3 normal)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
 
-    output.sv_position = mul(object[0].world, float4(position, 1.));
+    output.sv_position = mul(object[draw.objectIndex].world, float4(position, 1.));
     output.sv_position = mul(camera.view, output.sv_position);
 
-    float4 viewSpaceNormal = mul(object[0].normal, float4(normal, 0.0));
+    float4 viewSpaceNormal = mul(object[draw.objectIndex].normal, float4(normal, 0.0));
     output.normal = normalize(float3(viewSpaceNormal));
 
     return output;
@@ -1,24 +1,10 @@
-struct PER_CAMERA
-{
-    float4x4 view;
-    float4x4 projection;
-
-    float4x4 projectionView;
-
-    float4x4 invertedView;
-    float4x4 invertedProjection;
-};
+#include "common.hlsl"
 
 layout (set = 0, binding = 0) ConstantBuffer<PER_CAMERA> camera : register(b0, space0);
-
-struct PER_OBJECT
-{
-    float4x4 world;
-    float4x4 normal;
-};
-
 layout (set = 1, binding = 0) StructuredBuffer<PER_OBJECT> object : register(t0, space0);
 
+[[vk::push_constant]] ConstantBuffer<PER_DRAW> draw;
+
 struct VS_OUTPUT
 {
 	float4 position : SV_POSITION;
@@ -30,7 +16,7 @@ VS_OUTPUT process(in float3 position, in float2 texcoord_0)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
 
-    output.position = mul(object[0].world, float4(position, 1.));
+    output.position = mul(object[draw.objectIndex].world, float4(position, 1.));
     output.position = mul(camera.view, output.position);
     output.position = mul(camera.projection, output.position);
 
@@ -0,0 +1,18 @@
+struct PS_INPUT
+{
+	float4 sv_position : SV_POSITION;
+    [[vk::location(0)]] float2 texcoord : TEXCOORD0;
+    [[vk::location(1)]] nointerpolation uint textureIndex : TEXCOORD1;
+};
+
+// Global partially bound texture array; the index is uniform across a draw.
+layout (set = 2, binding = 0) Texture2D textures[] : register(t1);
+layout (set = 2, binding = 0) SamplerState samplers[] : register(s1);
+
+
+#pragma technique(0)
+[earlydepthstencil]
+float4 main(PS_INPUT ps_input) : SV_TARGET
+{
+    return textures[ps_input.textureIndex].Sample(samplers[ps_input.textureIndex], ps_input.texcoord);
+}
@@ -13,6 +13,14 @@ struct PER_OBJECT
 {
     float4x4 world;
     float4x4 normal;
+
+    uint textureIndex;
+};
+
+// Pushed for every draw to select its object data.
+struct PER_DRAW
+{
+    uint objectIndex;
 };
 
 float2 normalizedToViewport(in int4 screenRect, in float2 position)
@@ -3,6 +3,8 @@
 layout (set = 0, binding = 0) ConstantBuffer<PER_CAMERA> camera : register(b0, space0);
 layout (set = 1, binding = 0) StructuredBuffer<PER_OBJECT> object : register(t0, space0);
 
+[[vk::push_constant]] ConstantBuffer<PER_DRAW> draw;
+
 struct VS_OUTPUT
 {
 	float4 sv_position : SV_POSITION;
@@ -22,14 +24,14 @@ VS_OUTPUT main(VS_INPUT input)
 
     VS_OUTPUT output = (VS_OUTPUT)0;
 
-    float4 position = mul(object[0].world, float4(in_position, 1.));
+    float4 position = mul(object[draw.objectIndex].world, float4(in_position, 1.));
     position = mul(camera.view, position);
 
     output.position = position.xyz;
 
     output.sv_position = mul(camera.projection, position);
 
-    output.normal = normalize(mul(float3x3(object[0].normal), in_normal));
+    output.normal = normalize(mul(float3x3(object[draw.objectIndex].normal), in_normal));
 
     float4 vs_light_pos = mul(camera.view, light_position);
     output.light_vector = normalize((vs_light_pos - position).xyz);
@@ -3,3 +3,5 @@
 #define PROJECT_VERSION_MAJOR 1
 #define PROJECT_VERSION_MINOR 0
 #define PROJECT_VERSION_PATCH 0
+
+#define USE_TRACING 0
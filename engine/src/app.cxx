@@ -11,6 +11,9 @@ using namespace std::string_view_literals;
 #include <ranges>
 #include <cmath>
 #include <chrono>
+#include <optional>
+#include <iterator>
+#include <algorithm>
 
 #include <boost/align/align.hpp>
 #include <boost/align.hpp>
@@ -37,6 +40,7 @@ using namespace std::string_view_literals;
 #include "loaders/scene_loader.hxx"
 #include "loaders/image_loader.hxx"
 #include "loaders/TARGA_loader.hxx"
+#include "loaders/SPIRV_loader.hxx"
 
 #include "descriptor.hxx"
 
@@ -49,6 +53,7 @@ using namespace std::string_view_literals;
 
 #include "renderer/command_buffer.hxx"
 #include "renderer/swapchain.hxx"
+#include "renderer/gpu_profiler.hxx"
 #include "renderer/renderer.hxx"
 #include "renderer/config.hxx"
 
@@ -68,11 +73,24 @@ using namespace std::string_view_literals;
 
 namespace temp
 {
-    static glm::vec4 generate_color()
+    static std::mt19937 &color_generator()
     {
         static std::random_device random_device;
         static std::mt19937 generator{random_device()};
 
+        return generator;
+    }
+
+    // Textured material sampling either the image resources descriptor set or the bindless texture table.
+    static std::string texture_material_name(app_t const &app)
+    {
+        return app.bindless_textures ? "debug/texture-debug-bindless"s : "debug/texture-debug"s;
+    }
+
+    static glm::vec4 generate_color()
+    {
+        auto &&generator = color_generator();
+
         std::uniform_real_distribution<float> uniform_real_distribution{0.f, 1.f};
 
         return glm::vec4{
@@ -452,7 +470,7 @@ namespace temp
         model_.materials.push_back(xformat::material{0, "debug/texture-coordinate-debug"});
         model_.materials.push_back(xformat::material{0, "debug/solid-wireframe"});
         model_.materials.push_back(xformat::material{0, "debug/normal-vectors-debug-material"});
-        model_.materials.push_back(xformat::material{0, "debug/texture-debug"});
+        model_.materials.push_back(xformat::material{0, texture_material_name(app)});
         model_.materials.push_back(xformat::material{0, "lighting/blinn-phong-material"});
 
         model_.transforms.push_back(glm::translate(glm::mat4{1.f}, glm::vec3{0, -1, 0}));
@@ -621,14 +639,120 @@ namespace temp
 
         return model_;
     }
+
+    static xformat generate_synthetic_scene(app_t &app, synthetic_scene_info const &info)
+    {
+        xformat model_;
+
+        // Colors are the only randomized data, so the same seed gives the same vertex buffers.
+        color_generator().seed(info.seed);
+
+        auto const materials = std::array{
+            xformat::material{0, "debug/color-debug-material"},
+            xformat::material{0, "debug/normals-debug"},
+            xformat::material{0, "debug/texture-coordinate-debug"},
+            xformat::material{0, texture_material_name(app)},
+            xformat::material{0, "lighting/blinn-phong-material"},
+            xformat::material{0, "debug/solid-wireframe"},
+            xformat::material{0, "debug/normal-vectors-debug-material"}
+        };
+
+        auto const materials_count = std::clamp(info.materials_count, std::size_t{1}, std::size(materials));
+
+        std::copy_n(std::begin(materials), materials_count, std::back_inserter(model_.materials));
+
+        // Every layout has all the semantics the materials above consume and differs only in attribute formats.
+        for (auto normal_format : {graphics::FORMAT::RGB32_SFLOAT, graphics::FORMAT::RG16_SNORM}) {
+            for (auto tex_coord_format : {graphics::FORMAT::RG16_UNORM, graphics::FORMAT::RG32_SFLOAT}) {
+                for (auto color_format : {graphics::FORMAT::RGBA8_UNORM, graphics::FORMAT::RGBA32_SFLOAT}) {
+                    model_.vertex_layouts.push_back(vertex::create_vertex_layout(
+                            vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT,
+                            vertex::SEMANTIC::NORMAL, normal_format,
+                            vertex::SEMANTIC::TEXCOORD_0, tex_coord_format,
+                            vertex::SEMANTIC::COLOR_0, color_format
+                    ));
+                }
+            }
+        }
+
+        auto const vertex_layouts_count = std::clamp(info.vertex_layouts_count, std::size_t{1}, std::size(model_.vertex_layouts));
+
+        model_.vertex_layouts.resize(vertex_layouts_count);
+
+        // Objects are laid out on a square grid around the origin.
+        auto const grid_size = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(info.objects_count))));
+        auto const grid_offset = static_cast<float>(grid_size) * .5f;
+
+        for (std::size_t object_index = 0; object_index < info.objects_count; ++object_index) {
+            auto const x = static_cast<float>(object_index % grid_size) - grid_offset;
+            auto const z = static_cast<float>(object_index / grid_size) - grid_offset;
+
+            model_.transforms.push_back(glm::translate(glm::mat4{1.f}, glm::vec3{x * 2.f, 0, z * 2.f}));
+
+            model_.scene_nodes.push_back(xformat::scene_node{object_index, std::size(model_.meshes)});
+
+            auto const vertex_layout_index = object_index % vertex_layouts_count;
+            auto const material_index = (object_index / vertex_layouts_count) % materials_count;
+
+            switch (object_index % 3) {
+                case 0:
+                    add_plane(app, model_, vertex_layout_index, graphics::INDEX_TYPE::UINT_16, material_index);
+                    break;
+
+                case 1:
+                    add_box(app, model_, vertex_layout_index, graphics::INDEX_TYPE::UINT_16, material_index);
+                    break;
+
+                default:
+                    add_sphere(app, model_, vertex_layout_index, graphics::INDEX_TYPE::UINT_16, material_index);
+                    break;
+            }
+        }
+
+        return model_;
+    }
 }
 
-app_t::app_t(platform::window &window)
+app_t::app_t(platform::window &window, render::presentation_config presentation_config, render::features_config features_config,
+             std::uint32_t workers_number)
+    : presentation_config{presentation_config}, features_config{features_config}
 {
+    job_system = std::make_unique<jobs::job_system>(workers_number);
+
     instance = std::make_unique<vulkan::instance>();
 
     platform_surface = instance->get_platform_surface(window);
 
+    create_resources();
+}
+
+app_t::app_t(render::extent extent, std::optional<synthetic_scene_info> synthetic_scene, render::presentation_config presentation_config,
+             render::features_config features_config, std::uint32_t workers_number)
+    : width{static_cast<std::int32_t>(extent.width)}, height{static_cast<std::int32_t>(extent.height)},
+      presentation_config{presentation_config}, features_config{features_config}, synthetic_scene{std::move(synthetic_scene)}
+{
+    job_system = std::make_unique<jobs::job_system>(workers_number);
+
+    instance = std::make_unique<vulkan::instance>(true);
+
+    create_resources();
+}
+
+render::extent app_t::render_target_extent() const
+{
+    return headless() ? offscreen_target->extent() : swapchain->extent();
+}
+
+std::vector<std::shared_ptr<resource::image_view>> const &app_t::render_target_views() const
+{
+    return headless() ? offscreen_target->image_views() : swapchain->image_views();
+}
+
+void app_t::create_resources()
+{
+    if (presentation_config.frames_in_flight < 1)
+        throw graphics::exception("at least one frame has to be in flight"s);
+
     device = std::make_unique<vulkan::device>(*instance, platform_surface);
 
     renderer_config = render::adjust_renderer_config(device->device_limits());
@@ -637,11 +761,13 @@ app_t::app_t(platform::window &window)
     resource_manager = std::make_unique<resource::resource_manager>(*device, renderer_config, *memory_manager);
 
     shader_manager = std::make_unique<graphics::shader_manager>(*device);
+    shader_manager->prefetch(loader::enumerate_SPIRV(), *job_system);
     material_factory = std::make_unique<graphics::material_factory>();
     vertex_input_state_manager = std::make_unique<graphics::vertex_input_state_manager>();
     pipeline_factory = std::make_unique<graphics::pipeline_factory>(*device, renderer_config, *shader_manager);
 
     render_pass_manager = std::make_unique<graphics::render_pass_manager>(*device);
+    render_graph_manager = std::make_unique<graphics::render_graph_manager>(*resource_manager, *memory_manager);
 
     descriptor_registry = std::make_unique<graphics::descriptor_registry>(*device);
 
@@ -650,39 +776,41 @@ app_t::app_t(platform::window &window)
 
     else throw graphics::exception("failed to transfer command pool"s);
 
-    if (auto command_pool = create_command_pool(*device, device->graphics_queue, 0); command_pool)
+    // Command buffers are rerecorded individually, e.g. by the benchmark.
+    if (auto command_pool = create_command_pool(*device, device->graphics_queue, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT); command_pool)
         graphics_command_pool = *command_pool;
 
     else throw graphics::exception("failed to graphics command pool"s);
 
     create_frame_data(*this);
 
-    if (auto descriptor_set_layout = create_view_resources_descriptor_set_layout(*device); !descriptor_set_layout)
+    if (view_resources_descriptor_set_layout = create_view_resources_descriptor_set_layout(*descriptor_registry); !view_resources_descriptor_set_layout)
         throw graphics::exception("failed to create the view resources descriptor set layout"s);
 
-    else view_resources_descriptor_set_layout = descriptor_set_layout.value();
-
-    if (auto descriptor_set_layout = create_object_resources_descriptor_set_layout(*device); !descriptor_set_layout)
+    if (object_resources_descriptor_set_layout = create_object_resources_descriptor_set_layout(*descriptor_registry); !object_resources_descriptor_set_layout)
         throw graphics::exception("failed to create the object resources descriptor set layout"s);
 
-    else object_resources_descriptor_set_layout = descriptor_set_layout.value();
-
-    if (auto descriptor_set_layout = create_image_resources_descriptor_set_layout(*device); !descriptor_set_layout)
+    if (image_resources_descriptor_set_layout = create_image_resources_descriptor_set_layout(*descriptor_registry); !image_resources_descriptor_set_layout)
         throw graphics::exception("failed to create the image resources descriptor set layout"s);
 
-    else image_resources_descriptor_set_layout = descriptor_set_layout.value();
+    view_resources_descriptor_update_template = descriptor_registry->create_descriptor_update_template(view_resources_descriptor_set_layout);
+    object_resources_descriptor_update_template = descriptor_registry->create_descriptor_update_template(object_resources_descriptor_set_layout);
+    image_resources_descriptor_update_template = descriptor_registry->create_descriptor_update_template(image_resources_descriptor_set_layout);
 
 #ifdef TEMPORARILY_DISABLED
     if (auto result = glTF::load(sceneName, scene, nodeSystem); !result)
         throw resource::exception("failed to load a mesh"s);
 #endif
 
-    auto descriptor_sets_layouts = std::array{view_resources_descriptor_set_layout, object_resources_descriptor_set_layout, image_resources_descriptor_set_layout};
+    if (features_config.bindless_textures && graphics::bindless_texture_table::is_supported(*device))
+        bindless_textures = std::make_unique<graphics::bindless_texture_table>(*device, *descriptor_registry, device->graphics_queue.timeline());
 
-    if (auto result = create_pipeline_layout(*device, descriptor_sets_layouts); !result)
-        throw graphics::exception("failed to create the pipeline layout"s);
+    else features_config.bindless_textures = false;
 
-    else pipeline_layout = result.value();
+    pipeline_layout = descriptor_registry->create_pipeline_layout({
+        view_resources_descriptor_set_layout, object_resources_descriptor_set_layout,
+        bindless_textures ? bindless_textures->descriptor_set_layout() : image_resources_descriptor_set_layout
+    });
 
     // "chalet/textures/chalet.tga"sv
     // "Hebe/textures/HebehebemissinSG1_metallicRoughness.tga"sv
@@ -701,51 +829,23 @@ app_t::app_t(platform::window &window)
 
     else texture->sampler = result;
 
-    xmodel = temp::populate(*this);
-
-    auto const min_offset_alignment = static_cast<std::size_t>(device->device_limits().min_storage_buffer_offset_alignment);
-    auto const aligned_offset = boost::alignment::align_up(sizeof(per_object_t), min_offset_alignment);
-
-    objects.resize(std::size(xmodel.scene_nodes));
-
-    aligned_buffer_size = aligned_offset * std::size(objects);
-
-    if (per_object_buffer = create_storage_buffer(*resource_manager, aligned_buffer_size); per_object_buffer) {
-        auto &&buffer = *per_object_buffer;
+    if (bindless_textures)
+        texture_index = bindless_textures->add(texture->view, texture->sampler);
 
-        auto const offset = buffer.memory()->offset();
-        auto const size = buffer.memory()->size();
+    xmodel = synthetic_scene ? temp::generate_synthetic_scene(*this, *synthetic_scene) : temp::populate(*this);
 
-        if (auto result = vkMapMemory(device->handle(), buffer.memory()->handle(), offset, size, 0, &ssbo_mapped_ptr); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to map per object uniform buffer memory: {0:#x}", result));
-    }
-
-    else throw graphics::exception("failed to init per object uniform buffer"s);
-
-    if (per_camera_buffer = create_uniform_buffer(*resource_manager, sizeof(camera::data_t)); !per_camera_buffer)
-        throw graphics::exception("failed to init per camera uniform buffer"s);
-
-    if (per_viewport_buffer = create_uniform_buffer(*resource_manager, sizeof(per_viewport_t)); !per_viewport_buffer)
-        throw graphics::exception("failed to init per viewport uniform buffer"s);
-
-    if (auto result = create_descriptor_pool(*device); !result)
-        throw graphics::exception("failed to create the descriptor pool"s);
+    for (auto &&state : frame_states)
+        state.objects.resize(std::size(xmodel.scene_nodes));
 
-    else descriptor_pool = result.value();
+    create_per_frame_buffers(*this);
 
-    if (auto descriptor_sets = create_descriptor_sets(*device, descriptor_pool, descriptor_sets_layouts); descriptor_sets.empty())
-        throw graphics::exception("failed to create the descriptor pool"s);
-
-    else {
-        view_resources_descriptor_set = descriptor_sets.at(0);
-        object_resources_descriptor_set = descriptor_sets.at(1);
-        image_resources_descriptor_set = descriptor_sets.at(2);
-    }
+    view_resources_descriptor_set = descriptor_registry->allocate_descriptor_set(*view_resources_descriptor_set_layout);
+    object_resources_descriptor_set = descriptor_registry->allocate_descriptor_set(*object_resources_descriptor_set_layout);
+    image_resources_descriptor_set = descriptor_registry->allocate_descriptor_set(*image_resources_descriptor_set_layout);
 
     per_viewport_data.rect = glm::ivec4{0, 0, width, height};
-    update_viewport_descriptor_buffer(*this);
 
-    update_descriptor_set(*this, *device);
+    update_descriptor_set(*this);
 
     build_render_pipelines(*this, xmodel);
 
@@ -754,6 +854,19 @@ app_t::app_t(platform::window &window)
     create_sync_objects(*this);
 }
 
+void app_t::enable_gpu_profiler(bool pipeline_statistics)
+{
+    auto &&timeline = device->graphics_queue.timeline();
+
+    timeline.wait(timeline.last_value());
+
+    gpu_profiler = std::make_unique<render::gpu_profiler>(*device, 256u, pipeline_statistics);
+
+    // Command buffers are recorded once, so they have to be rerecorded to contain the queries.
+    for (std::size_t image_index = 0; image_index < std::size(command_buffers); ++image_index)
+        record_graphics_command_buffer(*this, image_index);
+}
+
 void app_t::clean_up()
 {
     if (device == nullptr)
@@ -761,6 +874,8 @@ void app_t::clean_up()
 
     vkDeviceWaitIdle(device->handle());
 
+    gpu_profiler.reset();
+
     draw_commands_holder.clear();
 
     cleanup_frame_data(*this);
@@ -773,14 +888,6 @@ void app_t::clean_up()
         if (semaphore)
             semaphore.reset();
 
-    for (auto &&fence : concurrent_frames_fences)
-        if (fence)
-            fence.reset();
-
-    for (auto &&fence : busy_frames_fences)
-        if (fence)
-            fence.reset();
-
     pipeline_factory.reset();
 
     vertex_input_state_manager.reset();
@@ -789,33 +896,29 @@ void app_t::clean_up()
 
     shader_manager.reset();
 
-    if (pipeline_layout != VK_NULL_HANDLE)
-        vkDestroyPipelineLayout(device->handle(), pipeline_layout, nullptr);
-
-    if (view_resources_descriptor_set_layout != VK_NULL_HANDLE)
-        vkDestroyDescriptorSetLayout(device->handle(), view_resources_descriptor_set_layout, nullptr);
+    material_pipeline_layouts.clear();
+    pipeline_layout.reset();
 
-    if (object_resources_descriptor_set_layout != VK_NULL_HANDLE)
-        vkDestroyDescriptorSetLayout(device->handle(), object_resources_descriptor_set_layout, nullptr);
+    view_resources_descriptor_update_template.reset();
+    object_resources_descriptor_update_template.reset();
+    image_resources_descriptor_update_template.reset();
 
-    if (image_resources_descriptor_set_layout != VK_NULL_HANDLE)
-        vkDestroyDescriptorSetLayout(device->handle(), image_resources_descriptor_set_layout, nullptr);
+    view_resources_descriptor_set_layout.reset();
+    object_resources_descriptor_set_layout.reset();
+    image_resources_descriptor_set_layout.reset();
 
-    vkDestroyDescriptorPool(device->handle(), descriptor_pool, nullptr);
+    bindless_textures.reset();
 
     descriptor_registry.reset();
 
     render_pass.reset();
     render_pass_manager.reset();
+    render_graph_manager.reset();
 
     texture.reset();
 
-    if (ssbo_mapped_ptr)
-        vkUnmapMemory(device->handle(), per_object_buffer->memory()->handle());
-
-    per_camera_buffer.reset();
-    per_object_buffer.reset();
-    per_viewport_buffer.reset();
+    view_uniforms.reset();
+    object_buffer.reset();
 
     if (transfer_command_pool != VK_NULL_HANDLE)
         vkDestroyCommandPool(device->handle(), transfer_command_pool, nullptr);
@@ -849,8 +952,6 @@ void app_t::on_resize(std::int32_t w, std::int32_t h)
     {
         recreate_swap_chain(*this);
 
-        update_viewport_descriptor_buffer(*this);
-
         camera_->aspect = static_cast<float>(width) / static_cast<float>(height);
     };
 }
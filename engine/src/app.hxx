@@ -10,9 +10,11 @@
 #include <execution>
 #include <unordered_map>
 #include <span>
+#include <array>
 #include <ranges>
 #include <cmath>
 #include <chrono>
+#include <optional>
 #include "primitives/primitives.hxx"
 #include "camera/camera_controller.hxx"
 #include "camera/camera.hxx"
@@ -24,6 +26,7 @@
 #include "renderer/material.hxx"
 #include "graphics/pipeline_states.hxx"
 #include "graphics/graphics_pipeline.hxx"
+#include "graphics/bindless.hxx"
 #include "graphics/graphics.hxx"
 #include "loaders/scene_loader.hxx"
 #include "loaders/image_loader.hxx"
@@ -37,6 +40,10 @@
 #include "resources/buffer.hxx"
 #include "renderer/command_buffer.hxx"
 #include "renderer/swapchain.hxx"
+#include "renderer/offscreen_target.hxx"
+#include "renderer/gpu_profiler.hxx"
+#include "renderer/uniform_ring_buffer.hxx"
+#include "renderer/frame_pacer.hxx"
 #include "renderer/renderer.hxx"
 #include "renderer/config.hxx"
 #include "vulkan/device.hxx"
@@ -44,14 +51,23 @@
 #include "math/pack-unpack.hxx"
 #include "math/math.hxx"
 #include "utility/exceptions.hxx"
+#include "utility/job_system.hxx"
 #include "utility/helpers.hxx"
 #include "utility/mpl.hxx"
 #include "main.hxx"
 
 
-struct per_object_t final {
+// Objects are indexed in a tightly packed array, so the alignment matches the shaders' structured buffer stride.
+struct alignas(16) per_object_t final {
     glm::mat4 world{1};
     glm::mat4 normal{1};  // Transposed and inversed upper left 3x3 sub-matrix of the xmodel(world)-view matrix.
+
+    std::uint32_t texture_index{0};  // Index into the bindless texture table.
+};
+
+// Pushed for every draw; the materials declare the ranges of it their shaders read.
+struct per_draw_t final {
+    std::uint32_t object_index{0};
 };
 
 struct per_viewport_t final {
@@ -59,6 +75,56 @@ struct per_viewport_t final {
     //glm::vec2 depth{0, 1};
 };
 
+// Ranges of the view uniforms' slots, in the order of the view resources set bindings.
+inline std::size_t constexpr kCAMERA_UNIFORMS_RANGE{0};
+inline std::size_t constexpr kVIEWPORT_UNIFORMS_RANGE{1};
+
+inline std::size_t constexpr kOBJECTS_RANGE{0};
+
+// Frame data produced by the simulation stage and consumed by the submission one.
+struct frame_state final {
+    camera::data_t camera;
+    per_viewport_t viewport;
+
+    // The simulation stage writes one of the states while the submission stage reads the other one; the pipelined frames
+    // simulate the next state on the job system while the current one is submitted.
+    std::array<frame_state, 2> frame_states;
+    std::size_t simulated_frame_state_index{0};
+
+    jobs::counter simulation_counter;
+
+    // When the input the state has been simulated from was sampled and how long its sampling was delayed for.
+    render::frame_pacer::time_point input_time;
+    render::frame_pacer::duration input_delay{0};
+};
+
+// Parameterized scene that replaces the hardcoded one to measure the frame loop on a known workload.
+struct synthetic_scene_info final {
+    std::size_t objects_count{1};
+
+    // Clamped to the number of available materials and vertex layouts.
+    std::size_t materials_count{1};
+    std::size_t vertex_layouts_count{1};
+
+    std::uint32_t seed{0};
+};
+
+// Frame data replaced by a resize; it's kept until all the frames submitted before the replacement complete.
+struct retired_frame_data final {
+    // Graphics queue timeline value of the last submission that might use the data.
+    std::uint64_t timeline_value;
+
+    std::unique_ptr<render::swapchain> swapchain;
+    std::unique_ptr<render::offscreen_target> offscreen_target;
+
+    std::unique_ptr<graphics::render_flow> render_flow;
+
+    std::vector<graphics::attachment> attachments;
+    std::vector<std::shared_ptr<resource::framebuffer>> framebuffers;
+
+    std::vector<VkCommandBuffer> command_buffers;
+};
+
 struct app_t final : public platform::window::event_handler_interface  {
     std::int32_t width{1920};
     std::int32_t height{1080};
@@ -66,6 +132,11 @@ struct app_t final : public platform::window::event_handler_interface  {
     std::size_t current_frame_index = 0;
 
     render::config renderer_config;
+    render::presentation_config presentation_config;
+    render::features_config features_config;
+
+    // Shared by the per-frame updates and the asset loading; the frame loop runs on its main thread.
+    std::unique_ptr<jobs::job_system> job_system;
 
     std::unique_ptr<vulkan::instance> instance;
     std::unique_ptr<vulkan::device> device;
@@ -73,6 +144,12 @@ struct app_t final : public platform::window::event_handler_interface  {
     render::platform_surface platform_surface;
     std::unique_ptr<render::swapchain> swapchain;
 
+    // Replaces the swapchain in the headless mode.
+    std::unique_ptr<render::offscreen_target> offscreen_target;
+
+    // Opt-in, as queries are recorded into every command buffer.
+    std::unique_ptr<render::gpu_profiler> gpu_profiler;
+
     std::unique_ptr<resource::resource_manager> resource_manager;
     std::unique_ptr<resource::memory_manager> memory_manager;
 
@@ -83,17 +160,31 @@ struct app_t final : public platform::window::event_handler_interface  {
 
     std::unique_ptr<graphics::descriptor_registry> descriptor_registry;
 
+    // Created only if requested and supported by the device; replaces the image resources descriptor set then.
+    std::unique_ptr<graphics::bindless_texture_table> bindless_textures;
+
     std::shared_ptr<graphics::render_pass> render_pass;
     std::unique_ptr<graphics::render_pass_manager> render_pass_manager;
 
+    std::unique_ptr<graphics::render_graph_manager> render_graph_manager;
+    std::unique_ptr<graphics::render_flow> render_flow;
+
     std::vector<graphics::attachment> attachments;
     std::vector<std::shared_ptr<resource::framebuffer>> framebuffers;
 
-    std::array<std::shared_ptr<resource::semaphore>, render::kCONCURRENTLY_PROCESSED_FRAMES> image_available_semaphores;
-    std::array<std::shared_ptr<resource::semaphore>, render::kCONCURRENTLY_PROCESSED_FRAMES> render_finished_semaphores;
+    // Indexed by the concurrently processed frame; there are 'presentation_config.frames_in_flight' of them.
+    std::vector<std::shared_ptr<resource::semaphore>> image_available_semaphores;
+    std::vector<std::shared_ptr<resource::semaphore>> render_finished_semaphores;
+
+    // Graphics queue timeline values the concurrently processed frames have been last submitted with.
+    std::vector<std::uint64_t> frame_timeline_values;
+
+    // Indexed by the render target image; values of the frames that have last rendered into the images.
+    std::vector<std::uint64_t> busy_images_timeline_values;
 
-    std::array<std::shared_ptr<resource::fence>, render::kCONCURRENTLY_PROCESSED_FRAMES> concurrent_frames_fences;
-    std::vector<std::shared_ptr<resource::fence>> busy_frames_fences;
+    render::frame_pacer frame_pacer;
+
+    std::vector<retired_frame_data> retired_frames_data;
 
     camera_system cameraSystem;
     std::shared_ptr<camera> camera_;
@@ -104,37 +195,65 @@ struct app_t final : public platform::window::event_handler_interface  {
 
     per_viewport_t per_viewport_data;
 
-    VkPipelineLayout pipeline_layout{VK_NULL_HANDLE};
+    std::shared_ptr<graphics::pipeline_layout> pipeline_layout;
+
+    // The descriptor set layouts of the above extended by the materials' push constant ranges; the draw commands refer to them.
+    std::vector<std::shared_ptr<graphics::pipeline_layout>> material_pipeline_layouts;
 
     VkCommandPool graphics_command_pool{VK_NULL_HANDLE}, transfer_command_pool{VK_NULL_HANDLE};
 
-    VkDescriptorPool descriptor_pool{VK_NULL_HANDLE};
+    std::shared_ptr<graphics::descriptor_set_layout> view_resources_descriptor_set_layout;
+    std::shared_ptr<graphics::descriptor_set_layout> object_resources_descriptor_set_layout;
+    std::shared_ptr<graphics::descriptor_set_layout> image_resources_descriptor_set_layout;
 
-    VkDescriptorSetLayout view_resources_descriptor_set_layout{VK_NULL_HANDLE};
-    VkDescriptorSetLayout object_resources_descriptor_set_layout{VK_NULL_HANDLE};
-    VkDescriptorSetLayout image_resources_descriptor_set_layout{VK_NULL_HANDLE};
+    std::shared_ptr<graphics::descriptor_update_template> view_resources_descriptor_update_template;
+    std::shared_ptr<graphics::descriptor_update_template> object_resources_descriptor_update_template;
+    std::shared_ptr<graphics::descriptor_update_template> image_resources_descriptor_update_template;
     VkDescriptorSet view_resources_descriptor_set{VK_NULL_HANDLE};
     VkDescriptorSet object_resources_descriptor_set{VK_NULL_HANDLE};
     VkDescriptorSet image_resources_descriptor_set{VK_NULL_HANDLE};
 
     std::vector<VkCommandBuffer> command_buffers;
 
-    std::shared_ptr<resource::buffer> per_object_buffer, per_camera_buffer, per_viewport_buffer;
-    void *ssbo_mapped_ptr{nullptr};
+    // The view uniforms, a slot per render target image; the ranges are the camera and the viewport data.
+    std::unique_ptr<render::uniform_ring_buffer> view_uniforms;
 
-    size_t aligned_buffer_size{0u};
+    // The objects' storage buffer, a slot per render target image as well; the only range is the tightly packed objects' data.
+    std::unique_ptr<render::uniform_ring_buffer> object_buffer;
 
     std::shared_ptr<resource::texture> texture;
 
+    // Index of the texture in the bindless texture table if there is one.
+    std::uint32_t texture_index{0};
+
     render::draw_commands_holder draw_commands_holder;
 
     std::function<void()> resize_callback{nullptr};
 
     xformat xmodel;
 
-    app_t(platform::window &window);
+    std::optional<synthetic_scene_info> synthetic_scene;
+
+    app_t(platform::window &window, render::presentation_config presentation_config = { }, render::features_config features_config = { },
+          std::uint32_t workers_number = jobs::job_system::default_workers_number());
+
+    // Headless application renders into offscreen images without a window and a swapchain.
+    explicit app_t(render::extent extent, std::optional<synthetic_scene_info> synthetic_scene = std::nullopt,
+                   render::presentation_config presentation_config = { }, render::features_config features_config = { },
+                   std::uint32_t workers_number = jobs::job_system::default_workers_number());
+
+    [[nodiscard]] bool headless() const noexcept { return instance && instance->headless(); }
+
+    [[nodiscard]] render::extent render_target_extent() const;
+    [[nodiscard]] std::vector<std::shared_ptr<resource::image_view>> const &render_target_views() const;
+
+    void enable_gpu_profiler(bool pipeline_statistics);
 
     void clean_up();
 
     void on_resize(std::int32_t w, std::int32_t h) override;
+
+private:
+
+    void create_resources();
 };
@@ -0,0 +1,766 @@
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <span>
+#include <array>
+#include <numeric>
+#include <fstream>
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include <nlohmann/json.hpp>
+
+#include "utility/helpers.hxx"
+#include "utility/exceptions.hxx"
+#include "utility/trace.hxx"
+#include "platform/input/input_manager.hxx"
+#include "primitives/primitives.hxx"
+#include "vulkan/device.hxx"
+#include "graphics/graphics_api.hxx"
+#include "main.hxx"
+#include "app.hxx"
+#include "benchmark.hxx"
+
+
+namespace
+{
+    using duration_t = std::chrono::nanoseconds;
+
+    struct frame_timings final {
+        duration_t::rep update;
+
+        // Time spent waiting for the frame state simulation to complete.
+        duration_t::rep simulation;
+
+        // Time spent waiting for the GPU to release the frame's resources.
+        duration_t::rep wait;
+
+        duration_t::rep record;
+        duration_t::rep submit;
+
+        duration_t::rep total;
+    };
+
+    nlohmann::json statistics(std::vector<duration_t::rep> samples)
+    {
+        if (samples.empty())
+            return nlohmann::json::object();
+
+        std::ranges::sort(samples);
+
+        // Nearest-rank percentile.
+        auto const percentile = [&samples] (double rank)
+        {
+            auto const index = static_cast<std::size_t>(std::ceil(rank * static_cast<double>(std::size(samples))));
+
+            return samples.at(std::clamp(index, std::size_t{1}, std::size(samples)) - 1);
+        };
+
+        auto const sum = std::accumulate(std::cbegin(samples), std::cend(samples), duration_t::rep{0});
+
+        return nlohmann::json{
+            {"mean", static_cast<double>(sum) / static_cast<double>(std::size(samples))},
+            {"min", samples.front()},
+            {"median", percentile(.5)},
+            {"p95", percentile(.95)},
+            {"p99", percentile(.99)},
+            {"max", samples.back()}
+        };
+    }
+
+    // FNV-1a.
+    std::uint64_t checksum(std::span<std::byte const> data, std::uint64_t hash = 0xcbf29ce484222325)
+    {
+        for (auto byte : data) {
+            hash ^= static_cast<std::uint64_t>(byte);
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    void churn_resources(resource::resource_manager &resource_manager, std::size_t resources_number)
+    {
+        for (std::size_t i = 0; i < resources_number; ++i) {
+            auto const buffer = create_uniform_buffer(resource_manager, 0x1000);
+
+            if (buffer == nullptr)
+                throw resource::exception("failed to create a churned buffer"s);
+
+            auto const image = resource_manager.create_image(
+                graphics::IMAGE_TYPE::TYPE_2D, graphics::FORMAT::RGBA8_UNORM, render::extent{64, 64}, 1, 1, graphics::IMAGE_TILING::OPTIMAL,
+                graphics::IMAGE_USAGE::SAMPLED | graphics::IMAGE_USAGE::TRANSFER_DESTINATION, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL
+            );
+
+            if (image == nullptr)
+                throw resource::exception("failed to create a churned image"s);
+
+            auto const image_view = resource_manager.create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+
+            if (image_view == nullptr)
+                throw resource::exception("failed to create a churned image view"s);
+        }
+    }
+
+    void churn_descriptor_sets(graphics::descriptor_allocator &descriptor_allocator, std::span<graphics::descriptor_set_layout const *const> layouts,
+                               std::size_t descriptor_sets_number)
+    {
+        descriptor_allocator.reset();
+
+        for (std::size_t i = 0; i < descriptor_sets_number; ++i) {
+            if (descriptor_allocator.allocate(*layouts[i % std::size(layouts)]) == VK_NULL_HANDLE)
+                throw graphics::exception("failed to allocate a churned descriptor set"s);
+        }
+    }
+
+    // The write descriptor set array path the update templates have replaced.
+    void write_descriptor_sets(vulkan::device const &device, std::array<VkDescriptorSet, 3> const &descriptor_sets, descriptor_sets_data const &data)
+    {
+        std::array<VkWriteDescriptorSet, 4> const write_descriptor_sets{{
+            {
+                VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                nullptr,
+                descriptor_sets[0],
+                0,
+                0, 1,
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                nullptr,
+                &data.view_resources.per_camera,
+                nullptr
+            },
+            {
+                VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                nullptr,
+                descriptor_sets[0],
+                1,
+                0, 1,
+                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                nullptr,
+                &data.view_resources.per_viewport,
+                nullptr
+            },
+            {
+                VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                nullptr,
+                descriptor_sets[1],
+                0,
+                0, 1,
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+                nullptr,
+                &data.object_resources.per_object,
+                nullptr
+            },
+            {
+                VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                nullptr,
+                descriptor_sets[2],
+                0,
+                0, 1,
+                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                &data.image_resources.per_image,
+                nullptr,
+                nullptr
+            }
+        }};
+
+        vkUpdateDescriptorSets(device.handle(), static_cast<std::uint32_t>(std::size(write_descriptor_sets)),
+                               std::data(write_descriptor_sets), 0, nullptr);
+    }
+
+    void update_descriptor_sets(app_t const &app, std::array<VkDescriptorSet, 3> const &descriptor_sets, descriptor_sets_data const &data)
+    {
+        app.view_resources_descriptor_update_template->update(descriptor_sets[0], data.view_resources);
+        app.object_resources_descriptor_update_template->update(descriptor_sets[1], data.object_resources);
+        app.image_resources_descriptor_update_template->update(descriptor_sets[2], data.image_resources);
+    }
+
+    void begin_selection_recording(VkCommandBuffer command_buffer)
+    {
+        VkCommandBufferBeginInfo const begin_info{
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            nullptr,
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            nullptr
+        };
+
+        if (auto result = vkBeginCommandBuffer(command_buffer, &begin_info); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to record command buffer: {0:#x}", result));
+    }
+
+    void end_selection_recording(VkCommandBuffer command_buffer)
+    {
+        if (auto result = vkEndCommandBuffer(command_buffer); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to end command buffer: {0:#x}", result));
+    }
+
+    // Selects every draw's object by the pushed index, as the forward pass does.
+    void record_pushed_draw_selections(VkCommandBuffer command_buffer, graphics::pipeline_layout const &pipeline_layout, std::size_t draws_number)
+    {
+        begin_selection_recording(command_buffer);
+
+        for (std::size_t draw_index = 0; draw_index < draws_number; ++draw_index) {
+            per_draw_t const per_draw{static_cast<std::uint32_t>(draw_index)};
+
+            for (auto &&range : pipeline_layout.push_constant_ranges()) {
+                vkCmdPushConstants(command_buffer, pipeline_layout.handle(), static_cast<VkShaderStageFlags>(convert_to::vulkan(range.shader_stages)),
+                                   range.offset, range.size, reinterpret_cast<std::byte const *>(&per_draw) + range.offset);
+            }
+        }
+
+        end_selection_recording(command_buffer);
+    }
+
+    // The per-draw dynamic offset rebinds the push constants have replaced: the object set is rebound at the offsets
+    // of the objects' buffer slots in turn.
+    void record_rebound_draw_selections(VkCommandBuffer command_buffer, app_t const &app, graphics::pipeline_layout const &pipeline_layout,
+                                        std::size_t draws_number)
+    {
+        begin_selection_recording(command_buffer);
+
+        auto const slots_number = app.object_buffer->slots_number();
+
+        for (std::size_t draw_index = 0; draw_index < draws_number; ++draw_index) {
+            auto const offset = app.object_buffer->dynamic_offset(static_cast<std::uint32_t>(draw_index % slots_number));
+
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(),
+                                    1,
+                                    1, &app.object_resources_descriptor_set,
+                                    1, &offset);
+        }
+
+        end_selection_recording(command_buffer);
+    }
+
+    nlohmann::json phase_statistics(std::vector<frame_timings> const &timings, duration_t::rep frame_timings::*phase)
+    {
+        std::vector<duration_t::rep> samples(std::size(timings));
+
+        std::ranges::transform(timings, std::begin(samples), [phase] (auto &&frame) { return frame.*phase; });
+
+        return statistics(std::move(samples));
+    }
+}
+
+void run_benchmark(benchmark_info const &info, std::string const &report_path)
+{
+    std::ofstream file{report_path, std::ios::out | std::ios::trunc};
+
+    if (!file.is_open())
+        throw resource::exception(fmt::format("failed to open benchmark report file: {}", report_path));
+
+    // Isn't connected to any window; the camera stays where it has been put.
+    auto const input_manager = std::make_shared<platform::input_manager>();
+
+    std::unique_ptr<app_t> app_ptr;
+
+    auto const setup_time = measure<duration_t>::execution([&app_ptr, &info]
+    {
+        render::presentation_config presentation_config;
+        presentation_config.frames_in_flight = info.frames_in_flight;
+
+        render::features_config features_config;
+        features_config.bindless_textures = info.bindless_textures;
+        features_config.pipelined_frames = info.pipelined_frames;
+
+        app_ptr = std::make_unique<app_t>(info.extent, info.scene, presentation_config, features_config, info.workers_number);
+    });
+
+    auto &&app = *app_ptr;
+
+    create_camera(app, *input_manager);
+
+    std::vector<frame_timings> timings;
+    timings.reserve(info.frames_number);
+
+    std::vector<duration_t::rep> resize_timings;
+
+    std::vector<duration_t::rep> churn_timings;
+    std::size_t max_pending_deletions = 0;
+
+    // Sets of all the application's layouts, so the pools are proportioned for a mix of the descriptor types.
+    auto const descriptor_set_layouts = std::array<graphics::descriptor_set_layout const *, 3>{
+        app.view_resources_descriptor_set_layout.get(), app.object_resources_descriptor_set_layout.get(), app.image_resources_descriptor_set_layout.get()
+    };
+
+    for (std::size_t i = 0; i < info.churned_descriptor_sets_number; ++i) {
+        if (app.descriptor_registry->allocate_descriptor_set(*descriptor_set_layouts[i % std::size(descriptor_set_layouts)]) == VK_NULL_HANDLE)
+            throw graphics::exception("failed to allocate a persistent descriptor set"s);
+    }
+
+    // The churned sets aren't used by any submission, so the pools can be reset right away.
+    auto descriptor_allocator = std::make_unique<graphics::descriptor_allocator>(*app.device);
+
+    std::vector<duration_t::rep> descriptor_churn_timings;
+
+    std::array<VkDescriptorSet, 3> updated_descriptor_sets{ };
+
+    if (info.descriptor_updates_number != 0) {
+        std::ranges::transform(descriptor_set_layouts, std::begin(updated_descriptor_sets), [&app] (auto layout)
+        {
+            return app.descriptor_registry->allocate_descriptor_set(*layout);
+        });
+    }
+
+    std::vector<duration_t::rep> update_template_timings, write_timings;
+
+    // The draw selections are recorded into a command buffer of their own, which is never submitted.
+    VkCommandBuffer selection_command_buffer{VK_NULL_HANDLE};
+    std::shared_ptr<graphics::pipeline_layout> selection_pipeline_layout;
+
+    if (info.draw_selections_number != 0) {
+        VkCommandBufferAllocateInfo const allocate_info{
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            nullptr,
+            app.graphics_command_pool,
+            VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            1
+        };
+
+        if (auto result = vkAllocateCommandBuffers(app.device->handle(), &allocate_info, &selection_command_buffer); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to allocate draw selection command buffer: {0:#x}", result));
+
+        // The shared set layouts extended by the per-draw index range, as the materials' layouts are.
+        selection_pipeline_layout = app.descriptor_registry->create_pipeline_layout(
+            app.pipeline_layout->descriptor_set_layouts(),
+            {graphics::push_constant_range{graphics::SHADER_STAGE::VERTEX, 0, static_cast<std::uint32_t>(sizeof(per_draw_t))}}
+        );
+    }
+
+    std::vector<duration_t::rep> pushed_selection_timings, rebound_selection_timings;
+
+    prepare_frame_pipeline(app);
+
+    for (std::size_t frame_index = 0; frame_index < info.warmup_frames_number + info.frames_number; ++frame_index) {
+        if (info.resize_interval != 0 && frame_index != 0 && frame_index % info.resize_interval == 0) {
+            auto const halved = (frame_index / info.resize_interval) % 2 != 0;
+
+            auto const width = halved ? std::max(info.extent.width / 2, 1u) : info.extent.width;
+            auto const height = halved ? std::max(info.extent.height / 2, 1u) : info.extent.height;
+
+            app.on_resize(static_cast<std::int32_t>(width), static_cast<std::int32_t>(height));
+
+            // Applied by the next update otherwise; it's done here to be measured apart from the frame.
+            auto const resize_time = measure<duration_t>::execution([&app] { app.resize_callback(); });
+
+            app.resize_callback = nullptr;
+
+            if (frame_index >= info.warmup_frames_number)
+                resize_timings.push_back(resize_time);
+        }
+
+        frame_timings frame{};
+
+        frame.total = measure<duration_t>::execution([&app, &frame, &info]
+        {
+            frame.update = measure<duration_t>::execution([&app] { update(app); });
+
+            if (!info.pipelined_frames)
+                frame.simulation = measure<duration_t>::execution([&app] { complete_frame_simulation(app); });
+
+            std::size_t image_index = 0;
+
+            frame.wait = measure<duration_t>::execution([&app, &image_index] { image_index = wait_offscreen_frame(app); });
+
+            // Command buffers are static otherwise; they are rerecorded each frame to make recording cost visible.
+            frame.record = measure<duration_t>::execution([&app, &image_index] { record_graphics_command_buffer(app, image_index); });
+
+            frame.submit = measure<duration_t>::execution([&app, &image_index] { submit_offscreen_frame(app, image_index); });
+
+            if (info.pipelined_frames)
+                frame.simulation = measure<duration_t>::execution([&app] { complete_frame_simulation(app); });
+        });
+
+        if (frame_index >= info.warmup_frames_number)
+            timings.push_back(frame);
+
+        if (info.churned_resources_number != 0) {
+            auto const churn_time = measure<duration_t>::execution([&app, &info]
+            {
+                churn_resources(*app.resource_manager, info.churned_resources_number);
+            });
+
+            if (frame_index >= info.warmup_frames_number) {
+                churn_timings.push_back(churn_time);
+
+                max_pending_deletions = std::max(max_pending_deletions, app.resource_manager->deletion_queue().size());
+            }
+        }
+
+        if (info.churned_descriptor_sets_number != 0) {
+            auto const churn_time = measure<duration_t>::execution([&descriptor_allocator, &descriptor_set_layouts, &info]
+            {
+                churn_descriptor_sets(*descriptor_allocator, descriptor_set_layouts, info.churned_descriptor_sets_number);
+            });
+
+            if (frame_index >= info.warmup_frames_number)
+                descriptor_churn_timings.push_back(churn_time);
+        }
+
+        if (info.descriptor_updates_number != 0) {
+            auto const data = get_descriptor_sets_data(app);
+
+            auto const update_template_time = measure<duration_t>::execution([&app, &info, &updated_descriptor_sets, &data]
+            {
+                for (std::size_t i = 0; i < info.descriptor_updates_number; ++i)
+                    update_descriptor_sets(app, updated_descriptor_sets, data);
+            });
+
+            auto const write_time = measure<duration_t>::execution([&app, &info, &updated_descriptor_sets, &data]
+            {
+                for (std::size_t i = 0; i < info.descriptor_updates_number; ++i)
+                    write_descriptor_sets(*app.device, updated_descriptor_sets, data);
+            });
+
+            if (frame_index >= info.warmup_frames_number) {
+                update_template_timings.push_back(update_template_time);
+                write_timings.push_back(write_time);
+            }
+        }
+
+        if (info.draw_selections_number != 0) {
+            auto const pushed_time = measure<duration_t>::execution([&info, selection_command_buffer, &selection_pipeline_layout]
+            {
+                record_pushed_draw_selections(selection_command_buffer, *selection_pipeline_layout, info.draw_selections_number);
+            });
+
+            auto const rebound_time = measure<duration_t>::execution([&app, &info, selection_command_buffer, &selection_pipeline_layout]
+            {
+                record_rebound_draw_selections(selection_command_buffer, app, *selection_pipeline_layout, info.draw_selections_number);
+            });
+
+            if (frame_index >= info.warmup_frames_number) {
+                pushed_selection_timings.push_back(pushed_time);
+                rebound_selection_timings.push_back(rebound_time);
+            }
+        }
+    }
+
+    auto &&timeline = app.device->graphics_queue.timeline();
+
+    timeline.wait(timeline.last_value());
+
+    // Cost of an empty trace zone, so the instrumentation overhead can be subtracted from the phases.
+    auto constexpr zones_number = std::size_t{1} << 16;
+
+    auto const zones_time = measure<duration_t>::execution([]
+    {
+        for (std::size_t i = 0; i < zones_number; ++i) {
+            TRACE_ZONE("benchmark: empty zone");
+        }
+    });
+
+    auto const memory_statistics = app.memory_manager->statistics();
+
+    nlohmann::json report{
+        {"unit", "ns"s},
+        {"extent", {{"width", info.extent.width}, {"height", info.extent.height}}},
+        {"scene", {
+            {"objects", std::size(app.xmodel.scene_nodes)},
+            {"materials", std::size(app.xmodel.materials)},
+            {"vertex_layouts", std::size(app.xmodel.vertex_layouts)},
+            {"seed", info.scene.seed},
+            {"draws", app.draw_commands_holder.size()},
+            {"pipeline_layouts", std::size(app.material_pipeline_layouts)}
+        }},
+        {"warmup_frames", info.warmup_frames_number},
+        {"frames_in_flight", info.frames_in_flight},
+        {"bindless_textures", app.features_config.bindless_textures},
+        {"pipelined_frames", app.features_config.pipelined_frames},
+        {"workers", app.job_system->workers_number()},
+        {"frames", std::size(timings)},
+        {"setup", setup_time},
+        {"memory", {
+            {"allocated", memory_statistics.allocated_size},
+            {"sub_allocated", memory_statistics.sub_allocated_size},
+            {"lazily_sub_allocated", memory_statistics.lazily_sub_allocated_size},
+            {"lazily_committed", memory_statistics.lazily_committed_size}
+        }},
+        {"tracing", USE_TRACING != 0},
+        {"trace_zone_overhead", static_cast<double>(zones_time) / static_cast<double>(zones_number)},
+        {"phases", {
+            {"update", phase_statistics(timings, &frame_timings::update)},
+            {"simulation", phase_statistics(timings, &frame_timings::simulation)},
+            {"wait", phase_statistics(timings, &frame_timings::wait)},
+            {"record", phase_statistics(timings, &frame_timings::record)},
+            {"submit", phase_statistics(timings, &frame_timings::submit)},
+            {"total", phase_statistics(timings, &frame_timings::total)}
+        }},
+        {"resize_interval", info.resize_interval},
+        {"resizes", std::size(resize_timings)},
+        {"resize", statistics(std::move(resize_timings))},
+        {"churned_resources", info.churned_resources_number},
+        {"churn", statistics(std::move(churn_timings))},
+        {"max_pending_deletions", max_pending_deletions},
+        {"churned_descriptor_sets", info.churned_descriptor_sets_number},
+        {"descriptor_churn", statistics(std::move(descriptor_churn_timings))},
+        {"descriptor_pools", descriptor_allocator->pools_number()},
+        {"descriptor_updates", info.descriptor_updates_number},
+        {"descriptor_update_templates", statistics(std::move(update_template_timings))},
+        {"descriptor_writes", statistics(std::move(write_timings))},
+        {"draw_selections", info.draw_selections_number},
+        {"pushed_draw_selections", statistics(std::move(pushed_selection_timings))},
+        {"rebound_draw_selections", statistics(std::move(rebound_selection_timings))}
+    };
+
+    if (selection_command_buffer != VK_NULL_HANDLE)
+        vkFreeCommandBuffers(app.device->handle(), app.graphics_command_pool, 1, &selection_command_buffer);
+
+    selection_pipeline_layout.reset();
+    descriptor_allocator.reset();
+
+    app.clean_up();
+
+    file << report.dump(4) << std::endl;
+}
+
+void run_jobs_benchmark(jobs_benchmark_info const &info, std::string const &report_path)
+{
+    std::ofstream file{report_path, std::ios::out | std::ios::trunc};
+
+    if (!file.is_open())
+        throw resource::exception(fmt::format("failed to open benchmark report file: {}", report_path));
+
+    std::mt19937 generator{info.seed};
+    std::uniform_real_distribution<float> distribution{-1.f, 1.f};
+
+    std::vector<glm::mat4> transforms(info.objects_number);
+
+    std::ranges::generate(transforms, [&generator, &distribution]
+    {
+        auto const translation = glm::vec3{distribution(generator), distribution(generator), distribution(generator)} * 64.f;
+        auto const axis = glm::vec3{distribution(generator), distribution(generator), 1.f};
+
+        return glm::rotate(glm::translate(glm::mat4{1}, translation), distribution(generator) * glm::pi<float>(), glm::normalize(axis));
+    });
+
+    auto const view = glm::lookAt(glm::vec3{0, 0, 128}, glm::vec3{0}, glm::vec3{0, 1, 0});
+
+    std::vector<per_object_t> objects(info.objects_number);
+
+    std::vector<std::uint32_t> workers_numbers{0};
+
+    for (auto workers_number = 1u; workers_number < info.max_workers_number; workers_number *= 2)
+        workers_numbers.push_back(workers_number);
+
+    if (info.max_workers_number != 0)
+        workers_numbers.push_back(info.max_workers_number);
+
+    nlohmann::json runs = nlohmann::json::array();
+
+    duration_t::rep serial_median = 0;
+
+    // As many empty jobs as the update submits, so the scheduling overhead is measured apart from the work.
+    auto const jobs_number = (info.objects_number + std::max(info.grain_size, std::size_t{1}) - 1) / std::max(info.grain_size, std::size_t{1});
+
+    for (auto workers_number : workers_numbers) {
+        jobs::job_system job_system{workers_number};
+
+        std::vector<duration_t::rep> timings, scheduling_timings;
+        timings.reserve(info.iterations_number);
+        scheduling_timings.reserve(info.iterations_number);
+
+        for (std::size_t iteration = 0; iteration < info.warmup_iterations_number + info.iterations_number; ++iteration) {
+            auto const update_time = measure<duration_t>::execution([&job_system, &info, &transforms, &objects, &view]
+            {
+                job_system.parallel_for(0, std::size(objects), info.grain_size, [&transforms, &objects, &view] (std::size_t begin, std::size_t end)
+                {
+                    for (auto index = begin; index < end; ++index)
+                        objects[index] = per_object_t{transforms[index], glm::inverseTranspose(view * transforms[index]), 0};
+                });
+            });
+
+            auto const scheduling_time = measure<duration_t>::execution([&job_system, jobs_number]
+            {
+                jobs::counter counter;
+
+                for (std::size_t i = 0; i < jobs_number; ++i)
+                    job_system.submit([] { }, &counter);
+
+                job_system.wait(counter);
+            });
+
+            if (iteration >= info.warmup_iterations_number) {
+                timings.push_back(update_time);
+                scheduling_timings.push_back(scheduling_time);
+            }
+        }
+
+        auto update_statistics = statistics(std::move(timings));
+
+        auto const median = update_statistics.value("median", duration_t::rep{0});
+
+        if (workers_number == 0)
+            serial_median = median;
+
+        runs.push_back(nlohmann::json{
+            {"workers", workers_number},
+            {"update", std::move(update_statistics)},
+            {"scheduling", statistics(std::move(scheduling_timings))},
+            {"speedup", median != 0 ? static_cast<double>(serial_median) / static_cast<double>(median) : 0.}
+        });
+    }
+
+    nlohmann::json const report{
+        {"unit", "ns"s},
+        {"objects", info.objects_number},
+        {"grain_size", info.grain_size},
+        {"jobs", jobs_number},
+        {"seed", info.seed},
+        {"warmup_iterations", info.warmup_iterations_number},
+        {"iterations", info.iterations_number},
+        {"hardware_threads", std::thread::hardware_concurrency()},
+        {"runs", std::move(runs)}
+    };
+
+    file << report.dump(4) << std::endl;
+}
+
+void run_primitives_benchmark(primitives_benchmark_info const &info, std::string const &report_path)
+{
+    std::ofstream file{report_path, std::ios::out | std::ios::trunc};
+
+    if (!file.is_open())
+        throw resource::exception(fmt::format("failed to open benchmark report file: {}", report_path));
+
+    std::vector<graphics::vertex_layout> vertex_layouts;
+
+    // The synthetic scene's ones.
+    for (auto normal_format : {graphics::FORMAT::RGB32_SFLOAT, graphics::FORMAT::RG16_SNORM}) {
+        for (auto tex_coord_format : {graphics::FORMAT::RG16_UNORM, graphics::FORMAT::RG32_SFLOAT}) {
+            for (auto color_format : {graphics::FORMAT::RGBA8_UNORM, graphics::FORMAT::RGBA32_SFLOAT}) {
+                vertex_layouts.push_back(vertex::create_vertex_layout(
+                        vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT,
+                        vertex::SEMANTIC::NORMAL, normal_format,
+                        vertex::SEMANTIC::TEXCOORD_0, tex_coord_format,
+                        vertex::SEMANTIC::COLOR_0, color_format
+                ));
+            }
+        }
+    }
+
+    auto constexpr topology = graphics::PRIMITIVE_TOPOLOGY::TRIANGLES;
+    auto constexpr index_type = graphics::INDEX_TYPE::UINT_32;
+
+    auto const segments = std::max(info.segments_number, 2u);
+    auto const color = glm::vec4{.25f, .5f, .75f, 1.f};
+
+    nlohmann::json runs = nlohmann::json::array();
+
+    auto const measure_primitive = [&info, &runs] (std::string const &name, graphics::vertex_layout const &vertex_layout,
+                                                   std::uint32_t vertices_number, std::uint32_t indices_number, auto &&generate)
+    {
+        std::vector<std::byte> vertex_buffer(vertices_number * vertex_layout.size_bytes);
+        std::vector<std::byte> index_buffer(indices_number * graphics::size_bytes(index_type));
+
+        std::vector<duration_t::rep> timings;
+        timings.reserve(info.iterations_number);
+
+        for (std::size_t iteration = 0; iteration < info.warmup_iterations_number + info.iterations_number; ++iteration) {
+            auto const generation_time = measure<duration_t>::execution([&generate, &vertex_buffer, &index_buffer]
+            {
+                generate(std::span{vertex_buffer}, std::span{index_buffer});
+            });
+
+            if (iteration >= info.warmup_iterations_number)
+                timings.push_back(generation_time);
+        }
+
+        auto const hash = checksum(index_buffer, checksum(vertex_buffer));
+
+        runs.push_back(nlohmann::json{
+            {"primitive", name},
+            {"vertex_layout", graphics::to_string(vertex_layout)},
+            {"vertices", vertices_number},
+            {"indices", indices_number},
+            {"generation", statistics(std::move(timings))},
+            {"checksum", fmt::format("{:016x}", hash)}
+        });
+    };
+
+    for (auto &&vertex_layout : vertex_layouts) {
+        primitives::plane_create_info const plane_info{
+            vertex_layout, topology, index_type,
+            1.f, 1.f, segments, segments
+        };
+
+        measure_primitive("plane"s, vertex_layout,
+                          primitives::calculate_plane_vertices_count(plane_info), primitives::calculate_plane_indices_count(plane_info),
+                          [&plane_info, &color] (std::span<std::byte> vertex_buffer, std::span<std::byte> index_buffer)
+        {
+            primitives::generate_plane_indexed(plane_info, vertex_buffer, index_buffer, color);
+        });
+
+        primitives::box_create_info const box_info{
+            vertex_layout, topology, index_type,
+            1.f, 1.f, 1.f, segments, segments, segments,
+            {color, color, color, color, color, color}
+        };
+
+        measure_primitive("box"s, vertex_layout,
+                          primitives::calculate_box_vertices_count(box_info), primitives::calculate_box_indices_number(box_info),
+                          [&box_info] (std::span<std::byte> vertex_buffer, std::span<std::byte> index_buffer)
+        {
+            primitives::generate_box_indexed(box_info, vertex_buffer, index_buffer);
+        });
+
+        primitives::sphere_create_info const sphere_info{
+            vertex_layout, topology, index_type,
+            1.f, segments, segments,
+            color
+        };
+
+        measure_primitive("sphere"s, vertex_layout,
+                          primitives::calculate_sphere_vertices_count(sphere_info), primitives::calculate_sphere_indices_count(sphere_info),
+                          [&sphere_info] (std::span<std::byte> vertex_buffer, std::span<std::byte> index_buffer)
+        {
+            primitives::generate_sphere_indexed(sphere_info, vertex_buffer, index_buffer);
+        });
+
+        // The icosahedron isn't indexed; its detail gives about as many vertices as the sphere's segments.
+        primitives::icosahedron_create_info const icosahedron_info{
+            vertex_layout, topology,
+            color,
+            1.f, segments / 8
+        };
+
+        measure_primitive("icosahedron"s, vertex_layout,
+                          primitives::calculate_icosahedron_vertices_count(icosahedron_info), 0,
+                          [&icosahedron_info] (std::span<std::byte> vertex_buffer, std::span<std::byte>)
+        {
+            primitives::generate_icosahedron(icosahedron_info, vertex_buffer);
+        });
+
+        for (auto subdivisions = 0u; subdivisions <= info.subdivisions_number; ++subdivisions) {
+            primitives::icosphere_create_info const icosphere_info{
+                vertex_layout, topology, index_type,
+                1.f, subdivisions,
+                color
+            };
+
+            measure_primitive(fmt::format("icosphere {}", subdivisions), vertex_layout,
+                              primitives::calculate_icosphere_vertices_count(icosphere_info), primitives::calculate_icosphere_indices_count(icosphere_info),
+                              [&icosphere_info] (std::span<std::byte> vertex_buffer, std::span<std::byte> index_buffer)
+            {
+                primitives::generate_icosphere_indexed(icosphere_info, vertex_buffer, index_buffer);
+            });
+        }
+    }
+
+    nlohmann::json const report{
+        {"unit", "ns"s},
+        {"segments", segments},
+        {"subdivisions", info.subdivisions_number},
+        {"warmup_iterations", info.warmup_iterations_number},
+        {"iterations", info.iterations_number},
+        {"runs", std::move(runs)}
+    };
+
+    file << report.dump(4) << std::endl;
+}
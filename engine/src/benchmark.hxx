@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+#include "utility/job_system.hxx"
+#include "graphics/graphics.hxx"
+#include "app.hxx"
+
+
+struct benchmark_info final {
+    render::extent extent;
+
+    synthetic_scene_info scene;
+
+    // Frames rendered before the measurements to settle pipeline and memory caches.
+    std::size_t warmup_frames_number{0};
+    std::size_t frames_number{1};
+
+    // Every that many frames the extent is switched between the given one and its half to measure the frame data
+    // recreation; zero disables the resizes.
+    std::size_t resize_interval{0};
+
+    // Number of the buffers and images created and released every frame while the previous frames are in flight;
+    // their destruction is deferred to the deletion queue, so the releases shouldn't stall.
+    std::size_t churned_resources_number{0};
+
+    // Number of the descriptor sets allocated every frame and freed at once by resetting the pools; as many sets as that
+    // are allocated from the application's descriptor registry at the start, as the persistent per-material sets would be.
+    std::size_t churned_descriptor_sets_number{0};
+
+    // Number of times the application's descriptor sets are written every frame through the update templates and,
+    // to compare with, through the write descriptor set arrays; the copies of the sets that no frame uses are written.
+    std::size_t descriptor_updates_number{0};
+
+    // Number of the draws whose objects are selected every frame, once by the pushed indices and once by rebinding a set
+    // with dynamic offsets, each recorded into a command buffer of its own to compare the CPU recording costs.
+    std::size_t draw_selections_number{0};
+
+    std::uint32_t frames_in_flight{render::kCONCURRENTLY_PROCESSED_FRAMES};
+
+    // The textured objects sample the bindless texture table if the device supports it.
+    bool bindless_textures{false};
+
+    // The next frame is simulated on the job system while the current one is waited for, recorded and submitted.
+    bool pipelined_frames{false};
+
+    std::uint32_t workers_number{jobs::job_system::default_workers_number()};
+};
+
+// Measures the job system scaling on the objects' transforms update without any device; the workload is run with
+// no workers, then with the powers of two of them up to the given number and with that number.
+// Submitting and waiting for as many empty jobs is measured too, which is the scheduling overhead of the update.
+struct jobs_benchmark_info final {
+    std::size_t objects_number{1};
+    std::size_t grain_size{256};
+
+    std::size_t warmup_iterations_number{0};
+    std::size_t iterations_number{1};
+
+    std::uint32_t max_workers_number{jobs::job_system::default_workers_number()};
+
+    std::uint32_t seed{0};
+};
+
+// Measures the primitives' generation into the host memory for the synthetic scene vertex layouts without any device.
+// The checksums of the generated vertex and index data are reported to compare the output across the generators' changes.
+struct primitives_benchmark_info final {
+    std::uint32_t segments_number{64};
+
+    // The icospheres are generated for every level up to this one.
+    std::uint32_t subdivisions_number{8};
+
+    std::size_t warmup_iterations_number{0};
+    std::size_t iterations_number{1};
+};
+
+// Renders a synthetic scene headlessly and saves CPU per-phase and total frame times as JSON.
+void run_benchmark(benchmark_info const &info, std::string const &report_path);
+
+// Saves the update times per the workers number and their speedups over no workers as JSON.
+void run_jobs_benchmark(jobs_benchmark_info const &info, std::string const &report_path);
+
+// Saves the generation times and the output checksums per primitive and vertex layout as JSON.
+void run_primitives_benchmark(primitives_benchmark_info const &info, std::string const &report_path);
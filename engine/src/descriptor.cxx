@@ -34,31 +34,6 @@ std::optional<VulkanDescriptorPool> DescriptorsManager::create_descriptor_pool()
 #endif
 
 
-std::optional<VkDescriptorPool> create_descriptor_pool(vulkan::device const &device)
-{
-    std::array<VkDescriptorPoolSize, 3> constexpr pool_sizes{{
-		{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
-		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1 },
-//#ifdef TEMPORARILY_DISABLED
-		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 }
-//#endif
-    }};
-
-    VkDescriptorPoolCreateInfo const create_info{
-        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        nullptr, 0,
-        3,
-        static_cast<std::uint32_t>(std::size(pool_sizes)), std::data(pool_sizes)
-    };
-
-    VkDescriptorPool handle;
-
-    if (auto result = vkCreateDescriptorPool(device.handle(), &create_info, nullptr, &handle); result == VK_SUCCESS)
-        return handle;
-
-    else throw vulkan::exception(fmt::format("failed to create descriptor pool: {0:#x}", result));
-}
-
 #ifdef OBSOLETE
 std::optional<VkDescriptorSetLayout> create_descriptor_set_layout(vulkan::device const &device)
 {
@@ -97,90 +72,43 @@ std::optional<VkDescriptorSetLayout> create_descriptor_set_layout(vulkan::device
 }
 #endif
 
-std::vector<VkDescriptorSet>
-create_descriptor_sets(vulkan::device const &device, VkDescriptorPool descriptor_pool, std::span<VkDescriptorSetLayout const> const descriptor_set_layouts)
+std::vector<graphics::descriptor_set_binding> view_resources_descriptor_set_bindings()
 {
-    VkDescriptorSetAllocateInfo const allocate_info{
-        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-        nullptr,
-        descriptor_pool,
-        static_cast<std::uint32_t>(std::size(descriptor_set_layouts)), std::data(descriptor_set_layouts)
-    };
-
-    std::vector<VkDescriptorSet> handles(std::size(descriptor_set_layouts));
+    auto constexpr shader_stages = graphics::SHADER_STAGE::VERTEX | graphics::SHADER_STAGE::GEOMETRY | graphics::SHADER_STAGE::FRAGMENT;
 
-    if (auto result = vkAllocateDescriptorSets(device.handle(), &allocate_info, std::data(handles)); result == VK_SUCCESS)
-        return handles;
-
-    else throw vulkan::exception(fmt::format("failed to allocate descriptor set(s): {0:#x}", result));
+    return {
+        { 0, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER_DYNAMIC, shader_stages },
+        { 1, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER_DYNAMIC, shader_stages }
+    };
 }
 
-std::optional<VkDescriptorSetLayout> create_descriptor_set_layout2(vulkan::device const &device, std::span<const VkDescriptorSetLayoutBinding> const layout_bindings)
+std::vector<graphics::descriptor_set_binding> object_resources_descriptor_set_bindings()
 {
-    VkDescriptorSetLayoutCreateInfo const create_info{
-        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-        nullptr, 0,
-        static_cast<std::uint32_t>(std::size(layout_bindings)), std::data(layout_bindings)
+    return {
+        { 0, 1, graphics::DESCRIPTOR_TYPE::STORAGE_BUFFER_DYNAMIC, graphics::SHADER_STAGE::VERTEX | graphics::SHADER_STAGE::FRAGMENT }
     };
-
-    VkDescriptorSetLayout handle;
-
-    if (auto result = vkCreateDescriptorSetLayout(device.handle(), &create_info, nullptr, &handle); result == VK_SUCCESS)
-        return handle;
-
-    else throw vulkan::exception(fmt::format("failed to create descriptor set layout: {0:#x}", result));
 }
 
-std::optional<VkDescriptorSetLayout> create_view_resources_descriptor_set_layout(vulkan::device const &device)
+std::vector<graphics::descriptor_set_binding> image_resources_descriptor_set_bindings()
 {
-    std::array<VkDescriptorSetLayoutBinding, 2> constexpr layout_bindings{{
-        {
-            0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            nullptr
-        },
-        {
-            1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            nullptr
-        }
-    }};
-
-    return create_descriptor_set_layout2(device, layout_bindings);
+    return {
+        { 0, 1, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT }
+        /*{ 0, 1, graphics::DESCRIPTOR_TYPE::SAMPLED_IMAGE, graphics::SHADER_STAGE::FRAGMENT },
+        { 1, 1, graphics::DESCRIPTOR_TYPE::SAMPLER, graphics::SHADER_STAGE::FRAGMENT }*/
+    };
 }
 
-std::optional<VkDescriptorSetLayout> create_object_resources_descriptor_set_layout(vulkan::device const &device)
+std::shared_ptr<graphics::descriptor_set_layout> create_view_resources_descriptor_set_layout(graphics::descriptor_registry &descriptor_registry)
 {
-    std::array<VkDescriptorSetLayoutBinding, 1> constexpr layout_bindings{{
-        {
-            0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
-            1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            nullptr
-        }
-    }};
-
-    return create_descriptor_set_layout2(device, layout_bindings);
+    return descriptor_registry.create_descriptor_set_layout(view_resources_descriptor_set_bindings());
 }
 
-std::optional<VkDescriptorSetLayout> create_image_resources_descriptor_set_layout(vulkan::device const &device)
+std::shared_ptr<graphics::descriptor_set_layout> create_object_resources_descriptor_set_layout(graphics::descriptor_registry &descriptor_registry)
 {
-    std::array<VkDescriptorSetLayoutBinding, 1> constexpr layout_bindings{{
-        {
-            0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            1, VK_SHADER_STAGE_FRAGMENT_BIT,
-            nullptr
-        }
-        /*{
-            0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-            1, VK_SHADER_STAGE_FRAGMENT_BIT,
-            nullptr
-        },
-        {
-            1, VK_DESCRIPTOR_TYPE_SAMPLER,
-            1, VK_SHADER_STAGE_FRAGMENT_BIT,
-            nullptr
-        }*/
-    }};
+    return descriptor_registry.create_descriptor_set_layout(object_resources_descriptor_set_bindings());
+}
 
-    return create_descriptor_set_layout2(device, layout_bindings);
+std::shared_ptr<graphics::descriptor_set_layout> create_image_resources_descriptor_set_layout(graphics::descriptor_registry &descriptor_registry)
+{
+    return descriptor_registry.create_descriptor_set_layout(image_resources_descriptor_set_bindings());
 }
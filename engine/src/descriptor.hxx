@@ -4,22 +4,41 @@
 #include <iostream>
 #include <memory>
 #include <span>
+#include <vector>
 
 #include <fmt/format.h>
 
 #include "main.hxx"
 #include "utility/exceptions.hxx"
 #include "vulkan/device.hxx"
+#include "graphics/descriptors.hxx"
 
 
-std::optional<VkDescriptorPool> create_descriptor_pool(vulkan::device const &device);
+// Bindings of the engine's descriptor sets, the pipeline layouts are made of.
+std::vector<graphics::descriptor_set_binding> view_resources_descriptor_set_bindings();
+std::vector<graphics::descriptor_set_binding> object_resources_descriptor_set_bindings();
+std::vector<graphics::descriptor_set_binding> image_resources_descriptor_set_bindings();
 
-std::vector<VkDescriptorSet>
-create_descriptor_sets(vulkan::device const &device, VkDescriptorPool descriptorPool, std::span<VkDescriptorSetLayout const> const descriptorSetLayouts);
+std::shared_ptr<graphics::descriptor_set_layout> create_view_resources_descriptor_set_layout(graphics::descriptor_registry &descriptor_registry);
+std::shared_ptr<graphics::descriptor_set_layout> create_object_resources_descriptor_set_layout(graphics::descriptor_registry &descriptor_registry);
+std::shared_ptr<graphics::descriptor_set_layout> create_image_resources_descriptor_set_layout(graphics::descriptor_registry &descriptor_registry);
 
-std::optional<VkDescriptorSetLayout>
-create_descriptor_set_layout2(vulkan::device const &device, std::span<const VkDescriptorSetLayoutBinding> const layout_bindings);
+// Raw descriptors data of the sets above, written through the update templates generated from the layouts.
+struct view_resources_descriptors final {
+    VkDescriptorBufferInfo per_camera;
+    VkDescriptorBufferInfo per_viewport;
+};
 
-std::optional<VkDescriptorSetLayout> create_view_resources_descriptor_set_layout(vulkan::device const &device);
-std::optional<VkDescriptorSetLayout> create_object_resources_descriptor_set_layout(vulkan::device const &device);
-std::optional<VkDescriptorSetLayout> create_image_resources_descriptor_set_layout(vulkan::device const &device);
+struct object_resources_descriptors final {
+    VkDescriptorBufferInfo per_object;
+};
+
+struct image_resources_descriptors final {
+    VkDescriptorImageInfo per_image;
+};
+
+struct descriptor_sets_data final {
+    view_resources_descriptors view_resources;
+    object_resources_descriptors object_resources;
+    image_resources_descriptors image_resources;
+};
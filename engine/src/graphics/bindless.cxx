@@ -0,0 +1,162 @@
+#include <algorithm>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include "utility/exceptions.hxx"
+#include "utility/trace.hxx"
+#include "bindless.hxx"
+
+
+namespace graphics
+{
+    bool bindless_texture_table::is_supported(vulkan::device const &device) noexcept
+    {
+        auto &&features = device.descriptor_indexing_features();
+
+        return features.runtimeDescriptorArray == VK_TRUE &&
+               features.descriptorBindingPartiallyBound == VK_TRUE &&
+               features.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+               features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE;
+    }
+
+    std::vector<graphics::descriptor_set_binding> bindless_texture_table::descriptor_set_bindings(std::uint32_t capacity)
+    {
+        return {
+            {
+                0, capacity, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT,
+                graphics::DESCRIPTOR_BINDING_FLAGS::UPDATE_AFTER_BIND | graphics::DESCRIPTOR_BINDING_FLAGS::UPDATE_UNUSED_WHILE_PENDING |
+                graphics::DESCRIPTOR_BINDING_FLAGS::PARTIALLY_BOUND
+            }
+        };
+    }
+
+    bindless_texture_table::bindless_texture_table(vulkan::device const &device, graphics::descriptor_registry &descriptor_registry,
+                                                   render::timeline const &timeline, std::uint32_t capacity)
+        : device_{device}, timeline_{timeline}
+    {
+        if (!is_supported(device))
+            throw graphics::exception("bindless textures aren't supported by the device"s);
+
+        auto &&limits = device.device_limits();
+
+        // Combined image samplers count against both the sampler and the sampled image limits.
+        capacity_ = std::min({
+            capacity, limits.max_per_stage_descriptor_update_after_bind_samplers, limits.max_per_stage_descriptor_update_after_bind_sampled_images
+        });
+
+        if (capacity_ == 0)
+            throw graphics::exception("bindless texture table capacity has to be positive"s);
+
+        descriptor_set_layout_ = descriptor_registry.create_descriptor_set_layout(descriptor_set_bindings(capacity_));
+
+        VkDescriptorPoolSize const pool_size{
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, capacity_
+        };
+
+        VkDescriptorPoolCreateInfo const create_info{
+            VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            nullptr,
+            VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+            1,
+            1, &pool_size
+        };
+
+        if (auto result = vkCreateDescriptorPool(device_.handle(), &create_info, nullptr, &descriptor_pool_); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to create the bindless descriptor pool: {0:#x}", result));
+
+        auto const layout_handle = descriptor_set_layout_->handle();
+
+        VkDescriptorSetAllocateInfo const allocate_info{
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            nullptr,
+            descriptor_pool_,
+            1, &layout_handle
+        };
+
+        if (auto result = vkAllocateDescriptorSets(device_.handle(), &allocate_info, &descriptor_set_); result != VK_SUCCESS) {
+            vkDestroyDescriptorPool(device_.handle(), descriptor_pool_, nullptr);
+
+            throw vulkan::exception(fmt::format("failed to allocate the bindless descriptor set: {0:#x}", result));
+        }
+    }
+
+    bindless_texture_table::~bindless_texture_table()
+    {
+        vkDestroyDescriptorPool(device_.handle(), descriptor_pool_, nullptr);
+    }
+
+    std::uint32_t bindless_texture_table::add(std::shared_ptr<resource::image_view> image_view, std::shared_ptr<resource::sampler> sampler)
+    {
+        reclaim_released_indices();
+
+        std::uint32_t index = 0;
+
+        if (!free_indices_.empty()) {
+            index = free_indices_.back();
+            free_indices_.pop_back();
+        }
+
+        else if (std::size(textures_) < capacity_) {
+            index = static_cast<std::uint32_t>(std::size(textures_));
+            textures_.emplace_back();
+        }
+
+        else throw graphics::exception("bindless texture table is full"s);
+
+        VkDescriptorImageInfo const image_info{
+            sampler->handle(), image_view->handle(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+
+        VkWriteDescriptorSet const write_descriptor_set{
+            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            nullptr,
+            descriptor_set_,
+            0,
+            index, 1,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            &image_info,
+            nullptr,
+            nullptr
+        };
+
+        // The descriptor isn't used by any pending submission, so it's written while the set is bound.
+        vkUpdateDescriptorSets(device_.handle(), 1, &write_descriptor_set, 0, nullptr);
+
+        textures_.at(index) = texture{std::move(image_view), std::move(sampler)};
+
+        TRACE_COUNTER("bindless textures", size());
+
+        return index;
+    }
+
+    void bindless_texture_table::remove(std::uint32_t index)
+    {
+        auto &&entry = textures_.at(index);
+
+        if (entry.image_view == nullptr)
+            throw graphics::exception("bindless texture has been already removed"s);
+
+        // The resources' destruction is deferred by the resource manager itself.
+        entry = texture{ };
+
+        released_indices_.emplace_back(timeline_.last_value(), index);
+
+        TRACE_COUNTER("bindless textures", size());
+    }
+
+    void bindless_texture_table::reclaim_released_indices()
+    {
+        if (released_indices_.empty())
+            return;
+
+        auto const completed_value = timeline_.completed_value();
+
+        while (!released_indices_.empty() && released_indices_.front().first <= completed_value) {
+            free_indices_.push_back(released_indices_.front().second);
+            released_indices_.pop_front();
+        }
+    }
+}
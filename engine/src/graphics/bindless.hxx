@@ -0,0 +1,79 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "vulkan/device.hxx"
+#include "resources/image.hxx"
+#include "renderer/timeline.hxx"
+#include "descriptors.hxx"
+
+
+namespace graphics
+{
+    // Global array of combined image samplers the shaders index by the texture index from the per-object data, so the draws
+    // of different textured materials don't need any descriptor set binds in between. The array is partially bound and updated
+    // after bind, so the textures are added while the set is still in use by the previous frames.
+    class bindless_texture_table final {
+    public:
+
+        static std::uint32_t constexpr kMAX_TEXTURES_NUMBER{4096u};
+
+        [[nodiscard]] static bool is_supported(vulkan::device const &device) noexcept;
+
+        [[nodiscard]] static std::vector<graphics::descriptor_set_binding> descriptor_set_bindings(std::uint32_t capacity);
+
+        // The capacity is clamped to the device limits.
+        bindless_texture_table(vulkan::device const &device, graphics::descriptor_registry &descriptor_registry, render::timeline const &timeline,
+                               std::uint32_t capacity = kMAX_TEXTURES_NUMBER);
+        ~bindless_texture_table();
+
+        // Returns the index the shaders sample the texture at.
+        [[nodiscard]] std::uint32_t add(std::shared_ptr<resource::image_view> image_view, std::shared_ptr<resource::sampler> sampler);
+
+        // The index is reused only after the submissions made so far, which may sample the texture, have completed.
+        void remove(std::uint32_t index);
+
+        [[nodiscard]] std::shared_ptr<graphics::descriptor_set_layout> const &descriptor_set_layout() const noexcept { return descriptor_set_layout_; }
+
+        [[nodiscard]] VkDescriptorSet descriptor_set() const noexcept { return descriptor_set_; }
+
+        [[nodiscard]] std::uint32_t capacity() const noexcept { return capacity_; }
+
+        [[nodiscard]] std::size_t size() const noexcept { return std::size(textures_) - std::size(free_indices_) - std::size(released_indices_); }
+
+    private:
+
+        struct texture final {
+            std::shared_ptr<resource::image_view> image_view;
+            std::shared_ptr<resource::sampler> sampler;
+        };
+
+        vulkan::device const &device_;
+        render::timeline const &timeline_;
+
+        std::uint32_t capacity_;
+
+        std::shared_ptr<graphics::descriptor_set_layout> descriptor_set_layout_;
+
+        VkDescriptorPool descriptor_pool_{VK_NULL_HANDLE};
+        VkDescriptorSet descriptor_set_{VK_NULL_HANDLE};
+
+        // Indexed by the texture index; the removed ones are empty.
+        std::vector<texture> textures_;
+
+        std::vector<std::uint32_t> free_indices_;
+
+        // The indices removed while they might be in use, paired with the timeline value to complete before reusing them.
+        std::deque<std::pair<std::uint64_t, std::uint32_t>> released_indices_;
+
+        void reclaim_released_indices();
+
+        bindless_texture_table() = delete;
+        bindless_texture_table(bindless_texture_table const &) = delete;
+        bindless_texture_table(bindless_texture_table &&) = delete;
+    };
+}
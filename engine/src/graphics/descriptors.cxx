@@ -1,10 +1,15 @@
+#include <cassert>
+#include <algorithm>
+
 #include <string>
 using namespace std::string_literals;
 
 #include <fmt/format.h>
 #include <boost/functional/hash.hpp>
+#include <boost/align/align_up.hpp>
 
 #include "utility/exceptions.hxx"
+#include "utility/trace.hxx"
 #include "descriptors.hxx"
 #include "graphics_api.hxx"
 
@@ -19,55 +24,236 @@ namespace graphics
         boost::hash_combine(seed, binding.descriptor_count);
         boost::hash_combine(seed, binding.descriptor_type);
         boost::hash_combine(seed, binding.shader_stages);
+        boost::hash_combine(seed, binding.binding_flags);
 
         return seed;
     }
 
-    std::size_t hash<graphics::descriptor_set_layout>::operator() (graphics::descriptor_set_layout const &layout) const
+    std::size_t hash<std::vector<graphics::descriptor_set_binding>>::operator() (std::vector<graphics::descriptor_set_binding> const &bindings) const
     {
         std::size_t seed = 0;
 
         hash<graphics::descriptor_set_binding> constexpr hasher;
 
-        for (auto &&binding : layout.descriptor_set_bindings())
+        for (auto &&binding : bindings)
             boost::hash_combine(seed, hasher(binding));
 
         return seed;
     }
+
+    std::size_t hash<graphics::descriptor_set_layout>::operator() (graphics::descriptor_set_layout const &layout) const
+    {
+        hash<std::vector<graphics::descriptor_set_binding>> constexpr hasher;
+
+        return hasher(layout.descriptor_set_bindings());
+    }
+
+    std::size_t hash<graphics::push_constant_range>::operator() (graphics::push_constant_range const &range) const
+    {
+        std::size_t seed = 0;
+
+        boost::hash_combine(seed, range.shader_stages);
+        boost::hash_combine(seed, range.offset);
+        boost::hash_combine(seed, range.size);
+
+        return seed;
+    }
+
+    std::size_t hash<graphics::pipeline_layout_invariant>::operator() (graphics::pipeline_layout_invariant const &invariant) const
+    {
+        std::size_t seed = 0;
+
+        for (auto descriptor_set_layout : invariant.descriptor_set_layouts)
+            boost::hash_combine(seed, descriptor_set_layout);
+
+        hash<graphics::push_constant_range> constexpr hasher;
+
+        for (auto &&range : invariant.push_constant_ranges)
+            boost::hash_combine(seed, hasher(range));
+
+        return seed;
+    }
 }
 
 namespace graphics
 {
-    descriptor_registry::descriptor_registry(vulkan::device &device) : device_{device}
+    descriptor_allocator::descriptor_allocator(vulkan::device const &device, std::uint32_t sets_per_pool)
+        : device_{device}, sets_per_pool_{std::clamp(sets_per_pool, 1u, kMAX_SETS_PER_POOL)}
+    {
+    }
+
+    descriptor_allocator::~descriptor_allocator()
+    {
+        for (auto pool : used_pools_)
+            vkDestroyDescriptorPool(device_.handle(), pool, nullptr);
+
+        for (auto pool : free_pools_)
+            vkDestroyDescriptorPool(device_.handle(), pool, nullptr);
+    }
+
+    VkDescriptorSet descriptor_allocator::allocate(graphics::descriptor_set_layout const &layout)
+    {
+        // Accounted before the allocation, so a pool created for it is sized for the layout as well.
+        ++allocated_sets_number_;
+
+        std::array<std::uint64_t, kDESCRIPTOR_TYPES_NUMBER> descriptors_numbers{};
+
+        for (auto &&binding : layout.descriptor_set_bindings())
+            descriptors_numbers.at(static_cast<std::size_t>(binding.descriptor_type)) += binding.descriptor_count;
+
+        for (std::size_t type_index = 0; type_index < kDESCRIPTOR_TYPES_NUMBER; ++type_index) {
+            allocated_descriptors_numbers_[type_index] += descriptors_numbers[type_index];
+            max_descriptors_numbers_[type_index] = std::max(max_descriptors_numbers_[type_index], descriptors_numbers[type_index]);
+        }
+
+        if (used_pools_.empty())
+            used_pools_.push_back(next_pool());
+
+        auto const layout_handle = layout.handle();
+
+        VkDescriptorSetAllocateInfo allocate_info{
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            nullptr,
+            used_pools_.back(),
+            1, &layout_handle
+        };
+
+        VkDescriptorSet handle;
+
+        switch (auto result = vkAllocateDescriptorSets(device_.handle(), &allocate_info, &handle); result) {
+            case VK_SUCCESS:
+                return handle;
+
+            case VK_ERROR_OUT_OF_POOL_MEMORY:
+            case VK_ERROR_FRAGMENTED_POOL:
+                break;
+
+            default:
+                throw vulkan::exception(fmt::format("failed to allocate descriptor set: {0:#x}", result));
+        }
+
+        // Recycled pools may have been sized before the layout had been seen, so they are skipped until a fitting one is found.
+        while (!free_pools_.empty()) {
+            used_pools_.push_back(next_pool());
+
+            allocate_info.descriptorPool = used_pools_.back();
+
+            if (vkAllocateDescriptorSets(device_.handle(), &allocate_info, &handle) == VK_SUCCESS)
+                return handle;
+        }
+
+        used_pools_.push_back(create_pool());
+
+        allocate_info.descriptorPool = used_pools_.back();
+
+        if (auto result = vkAllocateDescriptorSets(device_.handle(), &allocate_info, &handle); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to allocate descriptor set from a new pool: {0:#x}", result));
+
+        return handle;
+    }
+
+    void descriptor_allocator::reset()
     {
-        std::array<VkDescriptorPoolSize, 3> constexpr descriptor_pool{{
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
-            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1 },
-            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 }
-        }};
+        for (auto pool : used_pools_) {
+            if (auto result = vkResetDescriptorPool(device_.handle(), pool, 0); result != VK_SUCCESS)
+                throw vulkan::exception(fmt::format("failed to reset descriptor pool: {0:#x}", result));
+
+            free_pools_.push_back(pool);
+        }
+
+        used_pools_.clear();
+
+        // Halving keeps the proportions; a descriptor type no longer allocated drops out of the new pools after a few resets.
+        allocated_sets_number_ /= 2;
+
+        for (auto &&descriptors_number : allocated_descriptors_numbers_)
+            descriptors_number /= 2;
+
+        max_descriptors_numbers_.fill(0);
+    }
+
+    VkDescriptorPool descriptor_allocator::next_pool()
+    {
+        if (free_pools_.empty())
+            return create_pool();
+
+        auto pool = free_pools_.back();
+        free_pools_.pop_back();
+
+        return pool;
+    }
+
+    VkDescriptorPool descriptor_allocator::create_pool()
+    {
+        auto const sets_number = sets_per_pool_;
+
+        std::vector<VkDescriptorPoolSize> pool_sizes;
+
+        for (std::size_t type_index = 0; type_index < kDESCRIPTOR_TYPES_NUMBER; ++type_index) {
+            auto const descriptors_number = allocated_descriptors_numbers_.at(type_index);
+
+            if (descriptors_number == 0)
+                continue;
+
+            // Rounded up, so the pool holds at least as many sets of the average composition, and at least one of the largest set.
+            auto const descriptors_per_pool = std::max((descriptors_number * sets_number + allocated_sets_number_ - 1) / allocated_sets_number_,
+                                                       max_descriptors_numbers_[type_index]);
+
+            pool_sizes.push_back(VkDescriptorPoolSize{
+                convert_to::vulkan(static_cast<graphics::DESCRIPTOR_TYPE>(type_index)),
+                static_cast<std::uint32_t>(descriptors_per_pool)
+            });
+        }
 
         VkDescriptorPoolCreateInfo const create_info{
             VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
             nullptr, 0,
-            kDESCRIPTOR_SET_MAXIMUM_NUMBER,
-            static_cast<std::uint32_t>(std::size(descriptor_pool)), std::data(descriptor_pool)
+            sets_number,
+            static_cast<std::uint32_t>(std::size(pool_sizes)), std::data(pool_sizes)
         };
 
-        if (auto result = vkCreateDescriptorPool(device_.handle(), &create_info, nullptr, &descriptor_pool_); result != VK_SUCCESS)
+        VkDescriptorPool handle;
+
+        if (auto result = vkCreateDescriptorPool(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
             throw vulkan::exception(fmt::format("failed to create the descriptor pool: {0:#x}", result));
+
+        sets_per_pool_ = std::min(sets_per_pool_ * 2, kMAX_SETS_PER_POOL);
+
+        TRACE_COUNTER("descriptors: pools", pools_number() + 1);
+
+        return handle;
+    }
+}
+
+namespace graphics
+{
+    descriptor_registry::descriptor_registry(vulkan::device &device) : device_{device}, descriptor_allocator_{device}
+    {
     }
 
     descriptor_registry::~descriptor_registry()
     {
-        vkDestroyDescriptorPool(device_.handle(), descriptor_pool_, nullptr);
+        // The deleters of the live objects refer to the registry.
+        assert(is_expired(descriptor_update_templates_) && "descriptor update templates outlive the registry");
+        assert(is_expired(pipeline_layouts_) && "pipeline layouts outlive the registry");
+        assert(is_expired(descriptor_set_layouts_) && "descriptor set layouts outlive the registry");
     }
 
     std::shared_ptr<graphics::descriptor_set_layout>
     descriptor_registry::create_descriptor_set_layout(std::vector<graphics::descriptor_set_binding> const &descriptor_set_bindings)
     {
+        auto sorted_bindings = descriptor_set_bindings;
+
+        std::ranges::sort(sorted_bindings, {}, &graphics::descriptor_set_binding::binding_index);
+
+        if (auto it = descriptor_set_layouts_.find(sorted_bindings); it != std::end(descriptor_set_layouts_))
+            if (auto descriptor_set_layout = it->second.lock(); descriptor_set_layout)
+                return descriptor_set_layout;
+
         std::vector<VkDescriptorSetLayoutBinding> layout_bindigns;
+        std::vector<VkDescriptorBindingFlags> binding_flags;
 
-        for (auto &&binding : descriptor_set_bindings) {
+        for (auto &&binding : sorted_bindings) {
             layout_bindigns.push_back(VkDescriptorSetLayoutBinding{
                 binding.binding_index,
                 convert_to::vulkan(binding.descriptor_type),
@@ -75,11 +261,27 @@ namespace graphics
                 static_cast<VkShaderStageFlags>(convert_to::vulkan(binding.shader_stages)),
                 nullptr
              });
+
+            binding_flags.push_back(convert_to::vulkan(binding.binding_flags));
         }
 
+        auto const use_binding_flags = std::ranges::any_of(binding_flags, [] (auto flags) { return flags != 0; });
+
+        auto const update_after_bind = std::ranges::any_of(binding_flags, [] (auto flags)
+        {
+            return (flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT) != 0;
+        });
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo const binding_flags_create_info{
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            nullptr,
+            static_cast<std::uint32_t>(std::size(binding_flags)), std::data(binding_flags)
+        };
+
         VkDescriptorSetLayoutCreateInfo const create_info{
             VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-            nullptr, 0,
+            use_binding_flags ? &binding_flags_create_info : nullptr,
+            update_after_bind ? VkDescriptorSetLayoutCreateFlags{VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT} : 0,
             static_cast<std::uint32_t>(std::size(layout_bindigns)), std::data(layout_bindigns)
         };
 
@@ -90,14 +292,176 @@ namespace graphics
 
         std::shared_ptr<graphics::descriptor_set_layout> descriptor_set_layout;
 
-        descriptor_set_layout.reset(new graphics::descriptor_set_layout{handle}, [this] (graphics::descriptor_set_layout *ptr_descriptor_set_layout)
+        descriptor_set_layout.reset(new graphics::descriptor_set_layout{handle, sorted_bindings}, [this, sorted_bindings] (graphics::descriptor_set_layout *ptr_descriptor_set_layout)
         {
             vkDestroyDescriptorSetLayout(device_.handle(), ptr_descriptor_set_layout->handle(), nullptr);
 
             delete ptr_descriptor_set_layout;
+
+            evict_expired(descriptor_set_layouts_, sorted_bindings);
         });
 
+        descriptor_set_layouts_.insert_or_assign(sorted_bindings, descriptor_set_layout);
+
+        TRACE_COUNTER("descriptors: cached set layouts", std::size(descriptor_set_layouts_));
+
         return descriptor_set_layout;
     }
+
+    std::shared_ptr<graphics::pipeline_layout>
+    descriptor_registry::create_pipeline_layout(std::vector<std::shared_ptr<graphics::descriptor_set_layout>> const &descriptor_set_layouts,
+                                                std::vector<graphics::push_constant_range> const &push_constant_ranges)
+    {
+        graphics::pipeline_layout_invariant invariant{{ }, push_constant_ranges};
+
+        for (auto &&descriptor_set_layout : descriptor_set_layouts)
+            invariant.descriptor_set_layouts.push_back(descriptor_set_layout->handle());
+
+        if (auto it = pipeline_layouts_.find(invariant); it != std::end(pipeline_layouts_))
+            if (auto pipeline_layout = it->second.lock(); pipeline_layout)
+                return pipeline_layout;
+
+        std::vector<VkPushConstantRange> ranges;
+
+        for (auto &&range : push_constant_ranges) {
+            ranges.push_back(VkPushConstantRange{
+                static_cast<VkShaderStageFlags>(convert_to::vulkan(range.shader_stages)),
+                range.offset, range.size
+            });
+        }
+
+        VkPipelineLayoutCreateInfo const create_info{
+            VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            nullptr, 0,
+            static_cast<std::uint32_t>(std::size(invariant.descriptor_set_layouts)), std::data(invariant.descriptor_set_layouts),
+            static_cast<std::uint32_t>(std::size(ranges)), std::data(ranges)
+        };
+
+        VkPipelineLayout handle;
+
+        if (auto result = vkCreatePipelineLayout(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to create pipeline layout: {0:#x}", result));
+
+        auto pipeline_layout = std::shared_ptr<graphics::pipeline_layout>(
+            new graphics::pipeline_layout{handle, descriptor_set_layouts, push_constant_ranges}, [this, invariant] (graphics::pipeline_layout *const ptr_pipeline_layout)
+            {
+                vkDestroyPipelineLayout(device_.handle(), ptr_pipeline_layout->handle(), nullptr);
+
+                // Releases the set layouts, which may be evicted in turn.
+                delete ptr_pipeline_layout;
+
+                evict_expired(pipeline_layouts_, invariant);
+            }
+        );
+
+        pipeline_layouts_.insert_or_assign(invariant, pipeline_layout);
+
+        TRACE_COUNTER("descriptors: cached pipeline layouts", std::size(pipeline_layouts_));
+
+        return pipeline_layout;
+    }
+
+    std::shared_ptr<graphics::descriptor_update_template>
+    descriptor_registry::create_descriptor_update_template(std::shared_ptr<graphics::descriptor_set_layout> descriptor_set_layout)
+    {
+        auto const layout_handle = descriptor_set_layout->handle();
+
+        if (auto it = descriptor_update_templates_.find(layout_handle); it != std::end(descriptor_update_templates_))
+            if (auto descriptor_update_template = it->second.lock(); descriptor_update_template)
+                return descriptor_update_template;
+
+        std::vector<VkDescriptorUpdateTemplateEntry> entries;
+
+        std::size_t data_size = 0, data_alignment = 1;
+
+        // The bindings are sorted by their indices, as the struct members are.
+        for (auto &&binding : descriptor_set_layout->descriptor_set_bindings()) {
+            std::size_t size = sizeof(VkDescriptorBufferInfo), alignment = alignof(VkDescriptorBufferInfo);
+
+            switch (binding.descriptor_type) {
+                case graphics::DESCRIPTOR_TYPE::SAMPLER:
+                case graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER:
+                case graphics::DESCRIPTOR_TYPE::SAMPLED_IMAGE:
+                case graphics::DESCRIPTOR_TYPE::STORAGE_IMAGE:
+                case graphics::DESCRIPTOR_TYPE::INPUT_ATTACHMENT:
+                    size = sizeof(VkDescriptorImageInfo);
+                    alignment = alignof(VkDescriptorImageInfo);
+                    break;
+
+                case graphics::DESCRIPTOR_TYPE::UNIFORM_TEXEL_BUFFER:
+                case graphics::DESCRIPTOR_TYPE::STORAGE_TEXEL_BUFFER:
+                    size = sizeof(VkBufferView);
+                    alignment = alignof(VkBufferView);
+                    break;
+
+                default:
+                    break;
+            }
+
+            data_size = boost::alignment::align_up(data_size, alignment);
+            data_alignment = std::max(data_alignment, alignment);
+
+            entries.push_back(VkDescriptorUpdateTemplateEntry{
+                binding.binding_index, 0, binding.descriptor_count,
+                convert_to::vulkan(binding.descriptor_type),
+                data_size, size
+            });
+
+            data_size += size * binding.descriptor_count;
+        }
+
+        data_size = boost::alignment::align_up(data_size, data_alignment);
+
+        VkDescriptorUpdateTemplateCreateInfo const create_info{
+            VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+            nullptr, 0,
+            static_cast<std::uint32_t>(std::size(entries)), std::data(entries),
+            VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+            layout_handle,
+            VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0
+        };
+
+        VkDescriptorUpdateTemplate handle;
+
+        if (auto result = vkCreateDescriptorUpdateTemplate(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to create descriptor update template: {0:#x}", result));
+
+        auto descriptor_update_template = std::shared_ptr<graphics::descriptor_update_template>(
+            new graphics::descriptor_update_template{device_, handle, std::move(descriptor_set_layout), data_size},
+            [this, layout_handle] (graphics::descriptor_update_template *const ptr_descriptor_update_template)
+            {
+                vkDestroyDescriptorUpdateTemplate(device_.handle(), ptr_descriptor_update_template->handle(), nullptr);
+
+                delete ptr_descriptor_update_template;
+
+                evict_expired(descriptor_update_templates_, layout_handle);
+            }
+        );
+
+        descriptor_update_templates_.insert_or_assign(layout_handle, descriptor_update_template);
+
+        return descriptor_update_template;
+    }
+
+    VkDescriptorSet descriptor_registry::allocate_descriptor_set(graphics::descriptor_set_layout const &layout)
+    {
+        return descriptor_allocator_.allocate(layout);
+    }
 }
 
+namespace graphics
+{
+    template<class K, class V, class H>
+    void descriptor_registry::evict_expired(std::unordered_map<K, std::weak_ptr<V>, H> &cache, K const &key)
+    {
+        // The entry could have been already replaced by a live object created after the last owner had gone.
+        if (auto it = cache.find(key); it != std::end(cache) && it->second.expired())
+            cache.erase(it);
+    }
+
+    template<class K, class V, class H>
+    bool descriptor_registry::is_expired(std::unordered_map<K, std::weak_ptr<V>, H> const &cache) noexcept
+    {
+        return std::ranges::all_of(cache, [] (auto &&entry) { return entry.second.expired(); });
+    }
+}
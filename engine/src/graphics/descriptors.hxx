@@ -1,10 +1,15 @@
 #pragma once
 
+#include <unordered_map>
+#include <array>
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <type_traits>
 
 #include "graphics.hxx"
 #include "utility/mpl.hxx"
+#include "utility/exceptions.hxx"
 #include "vulkan/device.hxx"
 
 
@@ -19,20 +24,37 @@ namespace graphics
         graphics::DESCRIPTOR_TYPE descriptor_type;
         graphics::SHADER_STAGE shader_stages;
 
+        // Any binding updated after bind makes the whole layout require the sets to be allocated from update-after-bind pools.
+        graphics::DESCRIPTOR_BINDING_FLAGS binding_flags{graphics::DESCRIPTOR_BINDING_FLAGS::NONE};
+
         template<class T> requires std::same_as<std::remove_cvref_t<T>, descriptor_set_binding>
         auto constexpr operator== (T &&rhs) const
         {
             return binding_index == rhs.binding_index &&
                 descriptor_count == rhs.descriptor_count &&
                 descriptor_type == rhs.descriptor_type &&
-                shader_stages == rhs.shader_stages;
+                shader_stages == rhs.shader_stages &&
+                binding_flags == rhs.binding_flags;
+        }
+    };
+
+    struct push_constant_range final {
+        graphics::SHADER_STAGE shader_stages;
+
+        std::uint32_t offset, size;
+
+        template<class T> requires std::same_as<std::remove_cvref_t<T>, push_constant_range>
+        auto constexpr operator== (T &&rhs) const
+        {
+            return shader_stages == rhs.shader_stages && offset == rhs.offset && size == rhs.size;
         }
     };
 
     class descriptor_set_layout final {
     public:
 
-        descriptor_set_layout(VkDescriptorSetLayout handle) noexcept : handle_{handle} { }
+        descriptor_set_layout(VkDescriptorSetLayout handle, std::vector<graphics::descriptor_set_binding> descriptor_set_bindings) noexcept
+            : handle_{handle}, descriptor_set_bindings_{std::move(descriptor_set_bindings)} { }
 
         VkDescriptorSetLayout handle() const noexcept { return handle_; }
 
@@ -51,26 +73,41 @@ namespace graphics
             return descriptor_set_bindings_ == rhs.descriptor_set_bindings_;
         }
     };
-}
 
-namespace graphics
-{
-    class descriptor_registry final {
+    class pipeline_layout final {
     public:
 
-        static auto constexpr kDESCRIPTOR_SET_MAXIMUM_NUMBER{128u};
+        pipeline_layout(VkPipelineLayout handle, std::vector<std::shared_ptr<graphics::descriptor_set_layout>> descriptor_set_layouts,
+                        std::vector<graphics::push_constant_range> push_constant_ranges) noexcept
+            : handle_{handle}, descriptor_set_layouts_{std::move(descriptor_set_layouts)}, push_constant_ranges_{std::move(push_constant_ranges)} { }
 
-        descriptor_registry(vulkan::device &device);
-        ~descriptor_registry();
+        VkPipelineLayout handle() const noexcept { return handle_; }
 
-        [[nodiscard]] std::shared_ptr<descriptor_set_layout>
-        create_descriptor_set_layout(std::vector<graphics::descriptor_set_binding> const &descriptor_set_bindings);
+        std::vector<std::shared_ptr<graphics::descriptor_set_layout>> const &descriptor_set_layouts() const noexcept { return descriptor_set_layouts_; }
+
+        std::vector<graphics::push_constant_range> const &push_constant_ranges() const noexcept { return push_constant_ranges_; }
 
     private:
 
-        vulkan::device &device_;
+        VkPipelineLayout handle_;
 
-        VkDescriptorPool descriptor_pool_;
+        // Kept alive as long as the pipeline layout, so their handles can't be reused while the layout is cached.
+        std::vector<std::shared_ptr<graphics::descriptor_set_layout>> descriptor_set_layouts_;
+
+        std::vector<graphics::push_constant_range> push_constant_ranges_;
+    };
+
+    struct pipeline_layout_invariant final {
+        // The set layouts are unique per bindings, so the handles identify the bindings.
+        std::vector<VkDescriptorSetLayout> descriptor_set_layouts;
+
+        std::vector<graphics::push_constant_range> push_constant_ranges;
+
+        template<class T> requires std::same_as<std::remove_cvref_t<T>, pipeline_layout_invariant>
+        auto constexpr operator== (T &&rhs) const
+        {
+            return descriptor_set_layouts == rhs.descriptor_set_layouts && push_constant_ranges == rhs.push_constant_ranges;
+        }
     };
 }
 
@@ -81,8 +118,156 @@ namespace graphics
         std::size_t operator() (graphics::descriptor_set_binding const &binding) const;
     };
 
+    template<>
+    struct hash<std::vector<graphics::descriptor_set_binding>> {
+        std::size_t operator() (std::vector<graphics::descriptor_set_binding> const &bindings) const;
+    };
+
     template<>
     struct hash<graphics::descriptor_set_layout> {
         std::size_t operator() (graphics::descriptor_set_layout const &binding) const;
     };
+
+    template<>
+    struct hash<graphics::push_constant_range> {
+        std::size_t operator() (graphics::push_constant_range const &range) const;
+    };
+
+    template<>
+    struct hash<graphics::pipeline_layout_invariant> {
+        std::size_t operator() (graphics::pipeline_layout_invariant const &invariant) const;
+    };
+}
+
+namespace graphics
+{
+    // Allocates descriptor sets from a chain of pools, creating a new pool whenever the current one is exhausted.
+    // New pools hold twice as many sets as the previous one and their descriptors are proportioned as in the recently allocated sets.
+    class descriptor_allocator final {
+    public:
+
+        static std::uint32_t constexpr kINITIAL_SETS_PER_POOL{64u};
+        static std::uint32_t constexpr kMAX_SETS_PER_POOL{4096u};
+
+        explicit descriptor_allocator(vulkan::device const &device, std::uint32_t sets_per_pool = kINITIAL_SETS_PER_POOL);
+        ~descriptor_allocator();
+
+        [[nodiscard]] VkDescriptorSet allocate(graphics::descriptor_set_layout const &layout);
+
+        // Frees all the sets allocated so far at once, e.g. per-frame sets after the frame has completed.
+        // The pools are kept to be reused by the following allocations, and the usage observed so far weighs half as much.
+        void reset();
+
+        [[nodiscard]] std::size_t pools_number() const noexcept { return std::size(used_pools_) + std::size(free_pools_); }
+
+    private:
+
+        static auto constexpr kDESCRIPTOR_TYPES_NUMBER = static_cast<std::size_t>(graphics::DESCRIPTOR_TYPE::INPUT_ATTACHMENT) + 1;
+
+        vulkan::device const &device_;
+
+        std::uint32_t sets_per_pool_;
+
+        // The last used pool is the current one.
+        std::vector<VkDescriptorPool> used_pools_, free_pools_;
+
+        // Decayed by each reset, so the pools follow the recent allocations rather than the ones at the start.
+        std::uint64_t allocated_sets_number_{0};
+        std::array<std::uint64_t, kDESCRIPTOR_TYPES_NUMBER> allocated_descriptors_numbers_{};
+
+        // The most descriptors of each type a single set has had since the last reset.
+        std::array<std::uint64_t, kDESCRIPTOR_TYPES_NUMBER> max_descriptors_numbers_{};
+
+        [[nodiscard]] VkDescriptorPool create_pool();
+        [[nodiscard]] VkDescriptorPool next_pool();
+
+        descriptor_allocator() = delete;
+        descriptor_allocator(descriptor_allocator const &) = delete;
+        descriptor_allocator(descriptor_allocator &&) = delete;
+    };
+
+    // The descriptor set and pipeline layouts are hash-consed: equal descriptions give the same object as long as it's alive,
+    // so the pipelines created with equal layouts are compatible and the bound descriptor sets survive switching between them.
+    // Writes all the descriptors of a set at once from a raw struct, which mirrors the layout's bindings in the binding index order:
+    // 'descriptor_count' of VkDescriptorImageInfo, VkDescriptorBufferInfo or VkBufferView per binding, depending on its type.
+    class descriptor_update_template final {
+    public:
+
+        descriptor_update_template(vulkan::device const &device, VkDescriptorUpdateTemplate handle,
+                                   std::shared_ptr<graphics::descriptor_set_layout> descriptor_set_layout, std::size_t data_size) noexcept
+            : device_{device}, handle_{handle}, descriptor_set_layout_{std::move(descriptor_set_layout)}, data_size_{data_size} { }
+
+        VkDescriptorUpdateTemplate handle() const noexcept { return handle_; }
+
+        std::shared_ptr<graphics::descriptor_set_layout> const &descriptor_set_layout() const noexcept { return descriptor_set_layout_; }
+
+        // Size of the struct the descriptors are read from.
+        std::size_t data_size() const noexcept { return data_size_; }
+
+        template<class T> requires std::is_trivially_copyable_v<T>
+        void update(VkDescriptorSet descriptor_set, T const &data) const
+        {
+            if (sizeof(T) != data_size_)
+                throw graphics::exception("descriptor data doesn't match the update template");
+
+            vkUpdateDescriptorSetWithTemplate(device_.handle(), descriptor_set, handle_, &data);
+        }
+
+    private:
+
+        vulkan::device const &device_;
+
+        VkDescriptorUpdateTemplate handle_;
+
+        // Kept alive as long as the template, so its handle can't be reused while the template is cached.
+        std::shared_ptr<graphics::descriptor_set_layout> descriptor_set_layout_;
+
+        std::size_t data_size_;
+    };
+
+    // The layouts and templates evict themselves from the registry's caches when released, so the registry has to outlive them:
+    // destroying it while any of them is still alive is an error.
+    class descriptor_registry final {
+    public:
+
+        descriptor_registry(vulkan::device &device);
+        ~descriptor_registry();
+
+        // The bindings order doesn't matter.
+        [[nodiscard]] std::shared_ptr<descriptor_set_layout>
+        create_descriptor_set_layout(std::vector<graphics::descriptor_set_binding> const &descriptor_set_bindings);
+
+        [[nodiscard]] std::shared_ptr<graphics::pipeline_layout>
+        create_pipeline_layout(std::vector<std::shared_ptr<graphics::descriptor_set_layout>> const &descriptor_set_layouts,
+                               std::vector<graphics::push_constant_range> const &push_constant_ranges = { });
+
+        [[nodiscard]] std::shared_ptr<graphics::descriptor_update_template>
+        create_descriptor_update_template(std::shared_ptr<graphics::descriptor_set_layout> descriptor_set_layout);
+
+        // The sets live as long as the registry.
+        [[nodiscard]] VkDescriptorSet allocate_descriptor_set(graphics::descriptor_set_layout const &layout);
+
+    private:
+
+        vulkan::device &device_;
+
+        graphics::descriptor_allocator descriptor_allocator_;
+
+        std::unordered_map<
+            std::vector<graphics::descriptor_set_binding>, std::weak_ptr<graphics::descriptor_set_layout>,
+            graphics::hash<std::vector<graphics::descriptor_set_binding>>
+        > descriptor_set_layouts_;
+
+        std::unordered_map<
+            graphics::pipeline_layout_invariant, std::weak_ptr<graphics::pipeline_layout>, graphics::hash<graphics::pipeline_layout_invariant>
+        > pipeline_layouts_;
+
+        std::unordered_map<VkDescriptorSetLayout, std::weak_ptr<graphics::descriptor_update_template>> descriptor_update_templates_;
+
+        template<class K, class V, class H>
+        static void evict_expired(std::unordered_map<K, std::weak_ptr<V>, H> &cache, K const &key);
+
+        template<class K, class V, class H>
+        [[nodiscard]] static bool is_expired(std::unordered_map<K, std::weak_ptr<V>, H> const &cache) noexcept;
+    };
 }
@@ -67,6 +67,13 @@ namespace graphics
         ALL_COMMANDS = 0x1'0000
     };
 
+    enum struct DESCRIPTOR_BINDING_FLAGS {
+        NONE = 0,
+        UPDATE_AFTER_BIND = 0x01,
+        UPDATE_UNUSED_WHILE_PENDING = 0x02,
+        PARTIALLY_BOUND = 0x04
+    };
+
     enum struct DESCRIPTOR_TYPE {
         SAMPLER = 0,
         COMBINED_IMAGE_SAMPLER,
@@ -147,6 +147,24 @@ namespace convert_to
         return result;
     }
 
+    VkDescriptorBindingFlags vulkan(graphics::DESCRIPTOR_BINDING_FLAGS binding_flags) noexcept
+    {
+        VkDescriptorBindingFlags result = 0;
+
+        using E = std::underlying_type_t<graphics::DESCRIPTOR_BINDING_FLAGS>;
+
+        if (static_cast<E>(binding_flags & graphics::DESCRIPTOR_BINDING_FLAGS::UPDATE_AFTER_BIND))
+            result |= VkDescriptorBindingFlagBits::VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+
+        if (static_cast<E>(binding_flags & graphics::DESCRIPTOR_BINDING_FLAGS::UPDATE_UNUSED_WHILE_PENDING))
+            result |= VkDescriptorBindingFlagBits::VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+        if (static_cast<E>(binding_flags & graphics::DESCRIPTOR_BINDING_FLAGS::PARTIALLY_BOUND))
+            result |= VkDescriptorBindingFlagBits::VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+        return result;
+    }
+
     VkDescriptorType vulkan(graphics::DESCRIPTOR_TYPE descriptor_type) noexcept
     {
         switch (descriptor_type) {
@@ -20,6 +20,8 @@ namespace convert_to
 
     VkDescriptorType vulkan(graphics::DESCRIPTOR_TYPE descriptor_type) noexcept;
 
+    VkDescriptorBindingFlags vulkan(graphics::DESCRIPTOR_BINDING_FLAGS binding_flags) noexcept;
+
     VkCullModeFlags vulkan(graphics::CULL_MODE cull_mode) noexcept;
 
     VkPolygonMode vulkan(graphics::POLYGON_MODE polygon_mode) noexcept;
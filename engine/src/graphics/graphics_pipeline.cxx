@@ -151,9 +151,11 @@ namespace graphics
 {
     std::shared_ptr<graphics::pipeline> pipeline_factory::create_pipeline(
         std::shared_ptr<graphics::material> material, graphics::pipeline_states const &pipeline_states,
-        VkPipelineLayout layout, std::shared_ptr<graphics::render_pass> render_pass, std::uint32_t subpass_index
+        graphics::pipeline_layout const &pipeline_layout, std::shared_ptr<graphics::render_pass> render_pass, std::uint32_t subpass_index
     )
     {
+        auto const layout = pipeline_layout.handle();
+
         graphics::pipeline_invariant invariant{material, pipeline_states, layout, render_pass, subpass_index};
 
         if (pipelines_.contains(invariant))
@@ -178,6 +180,8 @@ namespace graphics
         std::size_t shader_stage_index = 0;
 
         for (auto &&shader_stage : shader_stages) {
+            shader_manager_.validate(shader_stage, kENTRY_POINTS.at(shader_stage.technique_index), pipeline_layout);
+
             auto shader_module = shader_manager_.shader_module(shader_stage.module_name);
 
             VkPipelineShaderStageCreateInfo create_info{
@@ -432,41 +436,6 @@ namespace graphics
     }
 }
 
-namespace graphics
-{
-    std::shared_ptr<graphics::pipeline_layout>
-    pipeline_factory::create_pipeline_layout(std::span<const graphics::descriptor_set_layout> const descriptor_set_layouts)
-    {
-        std::vector<VkDescriptorSetLayout> layouts_handles;
-
-        for (auto &&descriptor_set_layout : descriptor_set_layouts)
-            layouts_handles.push_back(descriptor_set_layout.handle());
-
-        VkPipelineLayoutCreateInfo const create_info{
-            VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-            nullptr, 0,
-            static_cast<std::uint32_t>(std::size(layouts_handles)), std::data(layouts_handles),
-            0, nullptr
-        };
-
-        VkPipelineLayout handle;
-
-        if (auto result = vkCreatePipelineLayout(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to create pipeline layout: {0:#x}", result));
-
-        auto pipeline_layout = std::shared_ptr<graphics::pipeline_layout>(
-            new graphics::pipeline_layout{handle}, [this] (graphics::pipeline_layout *const ptr_pipeline_layout)
-            {
-                vkDestroyPipelineLayout(device_.handle(), ptr_pipeline_layout->handle(), nullptr);
-
-                delete ptr_pipeline_layout;
-            }
-        );
-
-        return pipeline_layout;
-    }
-}
-
 namespace graphics
 {
     std::size_t graphics::hash<pipeline_invariant>::operator() (pipeline_invariant const &pipeline_invariant) const
@@ -486,21 +455,3 @@ namespace graphics
         return seed;
     }
 }
-
-std::optional<VkPipelineLayout>
-create_pipeline_layout(vulkan::device const &device, std::span<VkDescriptorSetLayout const> const descriptor_set_layouts)
-{
-    VkPipelineLayoutCreateInfo const create_info{
-        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        nullptr, 0,
-        static_cast<std::uint32_t>(std::size(descriptor_set_layouts)), std::data(descriptor_set_layouts),
-        0, nullptr
-    };
-
-    VkPipelineLayout handle;
-
-    if (auto result = vkCreatePipelineLayout(device.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to create pipeline layout: {0:#x}", result));
-
-    return handle;
-}
@@ -46,18 +46,6 @@ namespace graphics
 
 namespace graphics
 {
-    class pipeline_layout final {
-    public:
-
-        explicit pipeline_layout(VkPipelineLayout handle) noexcept : handle_{handle} { }
-
-        VkPipelineLayout handle() const noexcept { return handle_; }
-
-    private:
-
-        VkPipelineLayout handle_;
-    };
-
     class pipeline final {
     public:
 
@@ -112,10 +100,7 @@ namespace graphics
 
         [[nodiscard]] std::shared_ptr<graphics::pipeline>
         create_pipeline(std::shared_ptr<graphics::material> material, graphics::pipeline_states const &pipeline_states,
-                        VkPipelineLayout layout, std::shared_ptr<graphics::render_pass> render_pass, std::uint32_t subpass_index);
-
-        [[nodiscard]] std::shared_ptr<graphics::pipeline_layout>
-        create_pipeline_layout(std::span<const graphics::descriptor_set_layout> const descriptor_set_layouts);
+                        graphics::pipeline_layout const &pipeline_layout, std::shared_ptr<graphics::render_pass> render_pass, std::uint32_t subpass_index);
 
     private:
 
@@ -126,6 +111,3 @@ namespace graphics
         std::unordered_map<graphics::pipeline_invariant, std::shared_ptr<graphics::pipeline>, graphics::hash<pipeline_invariant>> pipelines_;
     };
 }
-
-/* [[nodiscard]] */ std::optional<VkPipelineLayout>
-create_pipeline_layout(vulkan::device const &device, std::span<VkDescriptorSetLayout const> const descriptorSetLayouts);
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <algorithm>
+#include <optional>
 
 #include <string>
 using namespace std::string_literals;
@@ -14,6 +16,19 @@ using namespace std::string_literals;
 #include "shader_program.hxx"
 
 
+namespace
+{
+    [[nodiscard]] std::vector<std::uint32_t> load_byte_code(std::string_view name)
+    {
+        auto byte_code = loader::map_SPIRV(name);
+
+        if (byte_code.empty())
+            throw resource::exception(fmt::format("failed to open shader file: {}", name));
+
+        return byte_code;
+    }
+}
+
 namespace graphics
 {
     std::shared_ptr<graphics::shader_module> shader_manager::shader_module(std::string_view name)
@@ -24,43 +39,135 @@ namespace graphics
         else return create_shader_module(name);
     }
 
-    std::shared_ptr<graphics::shader_module> shader_manager::create_shader_module(std::string_view name)
+    graphics::shader_reflection const &shader_manager::reflection(std::string_view name)
     {
-        // TODO:: move to loader class.
-        auto const shader_byte_code = loader::load_SPIRV(name);
+        return binary(name).reflection;
+    }
 
-        if (shader_byte_code.empty())
-            throw resource::exception(fmt::format("failed to open shader file: {}", name));
+    void shader_manager::prefetch(std::span<std::string const> names, jobs::job_system &job_system)
+    {
+        std::vector<std::string> pending;
 
-        std::shared_ptr<graphics::shader_module> shader_module;
+        std::ranges::copy_if(names, std::back_inserter(pending), [this] (auto &&name)
+        {
+            return !shader_binaries_.contains(name);
+        });
 
-        if (std::size(shader_byte_code) % sizeof(std::uint32_t) != 0)
-            throw resource::exception(fmt::format("invalid byte code buffer size: {}", name));
+        std::ranges::sort(pending);
+        auto [first, last] = std::ranges::unique(pending);
+        pending.erase(first, last);
 
-        else {
-            VkShaderModuleCreateInfo const create_info{
-                VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-                nullptr, 0,
-                std::size(shader_byte_code),
-                reinterpret_cast<std::uint32_t const *>(std::data(shader_byte_code))
-            };
+        if (pending.empty())
+            return;
 
-            VkShaderModule handle;
+        std::vector<std::optional<shader_binary>> binaries(std::size(pending));
+        std::vector<std::string> errors(std::size(pending));
 
-            if (auto result = vkCreateShaderModule(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
-                throw vulkan::exception(fmt::format("failed to create shader module: {0:#x}", result));
+        job_system.parallel_for(0, std::size(pending), 1, [&pending, &binaries, &errors] (std::size_t begin, std::size_t end)
+        {
+            for (auto index = begin; index < end; ++index) {
+                try {
+                    auto byte_code = load_byte_code(pending[index]);
+                    auto reflection = graphics::reflect_SPIRV(byte_code);
 
-            else {
-                shader_module.reset(new graphics::shader_module{handle}, [this] (graphics::shader_module *ptr_module)
-                    {
-                        vkDestroyShaderModule(device_.handle(), ptr_module->handle(), nullptr);
+                    binaries[index].emplace(std::move(byte_code), std::move(reflection));
+                }
 
-                        delete ptr_module;
-                    }
-                );
+                // A stale or foreign module in the folder shouldn't stop the startup when no material uses it.
+                catch (graphics::exception const &ex) {
+                    errors[index] = ex.what();
+                }
 
-                shader_modules_.emplace(name, shader_module);
+                catch (resource::exception const &ex) {
+                    errors[index] = ex.what();
+                }
             }
+        });
+
+        for (std::size_t index = 0; index < std::size(pending); ++index) {
+            if (binaries[index])
+                shader_binaries_.emplace(std::move(pending[index]), std::move(*binaries[index]));
+
+            else fmt::print(stderr, "skipped shader module '{}': {}\n", pending[index], errors[index]);
+        }
+    }
+
+    void shader_manager::validate(graphics::shader_stage const &shader_stage, std::string_view entry_point, graphics::pipeline_layout const &pipeline_layout)
+    {
+        auto &&module_reflection = reflection(shader_stage.module_name);
+
+        if (module_reflection.entry_point_stage(entry_point) != shader_stage.semantic)
+            throw graphics::exception(fmt::format("shader module '{}' has no '{}' entry point for the stage", shader_stage.module_name, entry_point));
+
+        using CONSTANT_TYPE = graphics::shader_reflection::CONSTANT_TYPE;
+
+        for (auto &&[id, value] : shader_stage.constants) {
+            // Vulkan ignores the constants that aren't present in a module, e.g. eliminated as unused ones.
+            auto it = module_reflection.specialization_constants.find(id);
+
+            if (it == std::end(module_reflection.specialization_constants))
+                continue;
+
+            auto const constant_type = it->second;
+
+            // The materials give the boolean constants as integers, as VkBool32 they are specialized with is.
+            auto const is_integral = constant_type == CONSTANT_TYPE::INTEGER || constant_type == CONSTANT_TYPE::BOOLEAN;
+            auto const type_matches = std::holds_alternative<float32>(value) ? constant_type == CONSTANT_TYPE::FLOATING_POINT : is_integral;
+
+            if (!type_matches)
+                throw graphics::exception(fmt::format("shader module '{}' specialization constant {} type mismatch", shader_stage.module_name, id));
+        }
+
+        try {
+            graphics::validate_pipeline_layout(module_reflection, shader_stage.semantic, pipeline_layout);
+        }
+
+        catch (graphics::exception const &ex) {
+            throw graphics::exception(fmt::format("shader module '{}' doesn't match the pipeline layout: {}", shader_stage.module_name, ex.what()));
+        }
+    }
+
+    shader_manager::shader_binary const &shader_manager::binary(std::string_view name)
+    {
+        if (auto it = shader_binaries_.find(name); it != std::end(shader_binaries_))
+            return it->second;
+
+        auto byte_code = load_byte_code(name);
+        auto reflection = graphics::reflect_SPIRV(byte_code);
+
+        auto [it, _] = shader_binaries_.emplace(std::string{name}, shader_binary{std::move(byte_code), std::move(reflection)});
+
+        return it->second;
+    }
+
+    std::shared_ptr<graphics::shader_module> shader_manager::create_shader_module(std::string_view name)
+    {
+        auto &&shader_byte_code = binary(name).byte_code;
+
+        std::shared_ptr<graphics::shader_module> shader_module;
+
+        VkShaderModuleCreateInfo const create_info{
+            VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            nullptr, 0,
+            std::size(shader_byte_code) * sizeof(std::uint32_t),
+            std::data(shader_byte_code)
+        };
+
+        VkShaderModule handle;
+
+        if (auto result = vkCreateShaderModule(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to create shader module: {0:#x}", result));
+
+        else {
+            shader_module.reset(new graphics::shader_module{handle}, [this] (graphics::shader_module *ptr_module)
+                {
+                    vkDestroyShaderModule(device_.handle(), ptr_module->handle(), nullptr);
+
+                    delete ptr_module;
+                }
+            );
+
+            shader_modules_.emplace(name, shader_module);
         }
 
         return shader_module;
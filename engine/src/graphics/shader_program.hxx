@@ -1,15 +1,21 @@
 #pragma once
 
 #include <unordered_map>
+#include <string_view>
 #include <variant>
 #include <memory>
 #include <vector>
+#include <string>
+#include <span>
 #include <map>
 #include <set>
 
 #include "utility/mpl.hxx"
+#include "utility/job_system.hxx"
 #include "vulkan/device.hxx"
 #include "graphics.hxx"
+#include "descriptors.hxx"
+#include "shader_reflection.hxx"
 
 import engine_types;
 
@@ -111,12 +117,30 @@ namespace graphics
 
         [[nodiscard]] std::shared_ptr<graphics::shader_module> shader_module(std::string_view name);
 
+        [[nodiscard]] graphics::shader_reflection const &reflection(std::string_view name);
+
+        // Loads and reflects the modules in parallel, so the pipeline creation path doesn't touch the file system.
+        // The modules that fail to load or reflect are reported and skipped; they throw again if a pipeline requests them.
+        void prefetch(std::span<std::string const> names, jobs::job_system &job_system);
+
+        // Checks the shader stage against the module's interface and the pipeline layout; throws 'graphics::exception' on a mismatch.
+        void validate(graphics::shader_stage const &shader_stage, std::string_view entry_point, graphics::pipeline_layout const &pipeline_layout);
+
     private:
 
         vulkan::device &device_;
 
+        struct shader_binary final {
+            std::vector<std::uint32_t> byte_code;
+            graphics::shader_reflection reflection;
+        };
+
+        std::map<std::string, shader_binary, std::less<>> shader_binaries_;
+
         std::map<std::string, std::shared_ptr<graphics::shader_module>> shader_modules_;
 
+        [[nodiscard]] shader_binary const &binary(std::string_view name);
+
         [[nodiscard]] std::shared_ptr<graphics::shader_module> create_shader_module(std::string_view name);
     };
 }
@@ -0,0 +1,612 @@
+#include <tuple>
+#include <ranges>
+#include <algorithm>
+#include <unordered_map>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include "utility/exceptions.hxx"
+#include "descriptors.hxx"
+#include "shader_reflection.hxx"
+
+
+namespace
+{
+    namespace spirv
+    {
+        std::uint32_t constexpr kMAGIC_NUMBER{0x0723'0203};
+        std::size_t constexpr kHEADER_WORDS_NUMBER{5};
+
+        // Way beyond what the shaders nest; a deeper type is taken for a malformed module's cycle.
+        std::uint32_t constexpr kMAX_TYPE_NESTING_DEPTH{64};
+
+        enum struct OP : std::uint32_t {
+            ENTRY_POINT = 15,
+            TYPE_BOOL = 20,
+            TYPE_INT = 21,
+            TYPE_FLOAT = 22,
+            TYPE_VECTOR = 23,
+            TYPE_MATRIX = 24,
+            TYPE_IMAGE = 25,
+            TYPE_SAMPLER = 26,
+            TYPE_SAMPLED_IMAGE = 27,
+            TYPE_ARRAY = 28,
+            TYPE_RUNTIME_ARRAY = 29,
+            TYPE_STRUCT = 30,
+            TYPE_POINTER = 32,
+            CONSTANT = 43,
+            SPEC_CONSTANT_TRUE = 48,
+            SPEC_CONSTANT_FALSE = 49,
+            SPEC_CONSTANT = 50,
+            SPEC_CONSTANT_COMPOSITE = 51,
+            VARIABLE = 59,
+            DECORATE = 71,
+            MEMBER_DECORATE = 72
+        };
+
+        enum struct DECORATION : std::uint32_t {
+            SPEC_ID = 1,
+            BLOCK = 2,
+            BUFFER_BLOCK = 3,
+            ARRAY_STRIDE = 6,
+            MATRIX_STRIDE = 7,
+            BINDING = 33,
+            DESCRIPTOR_SET = 34,
+            OFFSET = 35
+        };
+
+        enum struct STORAGE_CLASS : std::uint32_t {
+            UNIFORM_CONSTANT = 0,
+            UNIFORM = 2,
+            PUSH_CONSTANT = 9,
+            STORAGE_BUFFER = 12
+        };
+
+        enum struct DIM : std::uint32_t {
+            BUFFER = 5,
+            SUBPASS_DATA = 6
+        };
+    }
+
+    struct type_info final {
+        spirv::OP op;
+        std::vector<std::uint32_t> operands;
+    };
+
+    struct decorations final {
+        std::optional<std::uint32_t> set, binding, spec_id, array_stride;
+
+        bool block{false}, buffer_block{false};
+
+        std::unordered_map<std::uint32_t, std::uint32_t> member_offsets;
+    };
+
+    std::optional<graphics::SHADER_STAGE> execution_model_stage(std::uint32_t execution_model) noexcept
+    {
+        switch (execution_model) {
+            case 0: return graphics::SHADER_STAGE::VERTEX;
+            case 1: return graphics::SHADER_STAGE::TESS_CONTROL;
+            case 2: return graphics::SHADER_STAGE::TESS_EVAL;
+            case 3: return graphics::SHADER_STAGE::GEOMETRY;
+            case 4: return graphics::SHADER_STAGE::FRAGMENT;
+            case 5: return graphics::SHADER_STAGE::COMPUTE;
+            default: return { };
+        }
+    }
+
+    [[nodiscard]] bool is_visible(graphics::SHADER_STAGE stages, graphics::SHADER_STAGE stage) noexcept
+    {
+        using E = std::underlying_type_t<graphics::SHADER_STAGE>;
+
+        return static_cast<E>(stages & stage) != 0;
+    }
+
+    // SPIR-V doesn't tell the dynamic buffers apart, the offsets are only supplied at the binding. A combined image sampler
+    // is also accessible through separate image and sampler variables, e.g. the HLSL's ones sharing the binding.
+    [[nodiscard]] bool is_compatible_descriptor_type(graphics::DESCRIPTOR_TYPE shader_type, graphics::DESCRIPTOR_TYPE layout_type) noexcept
+    {
+        switch (layout_type) {
+            case graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER:
+                return shader_type == graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER ||
+                       shader_type == graphics::DESCRIPTOR_TYPE::SAMPLED_IMAGE || shader_type == graphics::DESCRIPTOR_TYPE::SAMPLER;
+
+            case graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER_DYNAMIC:
+                return shader_type == graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER;
+
+            case graphics::DESCRIPTOR_TYPE::STORAGE_BUFFER_DYNAMIC:
+                return shader_type == graphics::DESCRIPTOR_TYPE::STORAGE_BUFFER;
+
+            default:
+                return shader_type == layout_type;
+        }
+    }
+
+    std::string literal_string(std::span<std::uint32_t const> words)
+    {
+        std::string string;
+
+        for (auto word : words) {
+            for (auto i = 0u; i < 4; ++i) {
+                auto const character = static_cast<char>((word >> (i * 8)) & 0xFF);
+
+                if (character == '\0')
+                    return string;
+
+                string.push_back(character);
+            }
+        }
+
+        throw graphics::exception("unterminated SPIR-V literal string"s);
+    }
+
+    class module_parser final {
+    public:
+
+        explicit module_parser(std::span<std::uint32_t const> byte_code)
+        {
+            if (std::size(byte_code) < spirv::kHEADER_WORDS_NUMBER || byte_code[0] != spirv::kMAGIC_NUMBER)
+                throw graphics::exception("invalid SPIR-V module header"s);
+
+            for (auto words = byte_code.subspan(spirv::kHEADER_WORDS_NUMBER); !words.empty(); ) {
+                auto const words_count = words[0] >> 16;
+                auto const op = static_cast<spirv::OP>(words[0] & 0xFFFF);
+
+                if (words_count == 0 || words_count > std::size(words))
+                    throw graphics::exception("malformed SPIR-V instruction"s);
+
+                parse_instruction(op, words.subspan(1, words_count - 1));
+
+                words = words.subspan(words_count);
+            }
+        }
+
+        [[nodiscard]] graphics::shader_reflection reflect() const
+        {
+            graphics::shader_reflection reflection;
+
+            reflection.entry_points = entry_points_;
+
+            for (auto &&[id, value] : decorations_) {
+                if (!value.spec_id)
+                    continue;
+
+                if (auto it = spec_constants_.find(id); it != std::end(spec_constants_))
+                    reflection.specialization_constants.insert_or_assign(*value.spec_id, constant_type(it->second));
+            }
+
+            for (auto [id, type_id, storage_class] : variables_) {
+                auto const pointee_id = pointee_type(type_id);
+
+                if (storage_class == spirv::STORAGE_CLASS::PUSH_CONSTANT) {
+                    auto const offset = offset_bytes(pointee_id);
+
+                    if (reflection.push_constants_size_bytes != 0)
+                        reflection.push_constants_offset_bytes = std::min(reflection.push_constants_offset_bytes, offset);
+
+                    else reflection.push_constants_offset_bytes = offset;
+
+                    reflection.push_constants_size_bytes = std::max(reflection.push_constants_size_bytes, size_bytes(pointee_id));
+                    continue;
+                }
+
+                auto const it_decorations = decorations_.find(id);
+
+                if (it_decorations == std::end(decorations_))
+                    continue;
+
+                auto &&[set, binding, spec_id, array_stride, block, buffer_block, member_offsets] = it_decorations->second;
+
+                if (!set || !binding)
+                    continue;
+
+                auto [element_type_id, count] = unwrap_array(pointee_id);
+
+                if (auto type = descriptor_type(element_type_id, storage_class); type)
+                    reflection.descriptor_bindings.push_back({*set, *binding, *type, count});
+
+                else throw graphics::exception(fmt::format("unsupported SPIR-V resource type at set {} binding {}", *set, *binding));
+            }
+
+            std::ranges::sort(reflection.descriptor_bindings, [] (auto &&lhs, auto &&rhs)
+            {
+                return std::tie(lhs.set, lhs.binding) < std::tie(rhs.set, rhs.binding);
+            });
+
+            return reflection;
+        }
+
+    private:
+
+        struct variable final {
+            std::uint32_t id;
+            std::uint32_t type_id;
+
+            spirv::STORAGE_CLASS storage_class;
+        };
+
+        std::vector<graphics::shader_reflection::entry_point> entry_points_;
+
+        std::unordered_map<std::uint32_t, type_info> types_;
+        std::unordered_map<std::uint32_t, std::uint32_t> constants_;
+        std::unordered_map<std::uint32_t, decorations> decorations_;
+
+        // Result type ids of specialization constants keyed by result ids.
+        std::unordered_map<std::uint32_t, std::pair<spirv::OP, std::uint32_t>> spec_constants_;
+
+        std::vector<variable> variables_;
+
+        void parse_instruction(spirv::OP op, std::span<std::uint32_t const> operands)
+        {
+            auto require = [&operands] (std::size_t count)
+            {
+                if (std::size(operands) < count)
+                    throw graphics::exception("malformed SPIR-V instruction operands"s);
+            };
+
+            switch (op) {
+                case spirv::OP::ENTRY_POINT:
+                    require(3);
+
+                    if (auto stage = execution_model_stage(operands[0]); stage)
+                        entry_points_.push_back({*stage, literal_string(operands.subspan(2))});
+
+                    break;
+
+                case spirv::OP::TYPE_BOOL:
+                case spirv::OP::TYPE_INT:
+                case spirv::OP::TYPE_FLOAT:
+                case spirv::OP::TYPE_VECTOR:
+                case spirv::OP::TYPE_MATRIX:
+                case spirv::OP::TYPE_IMAGE:
+                case spirv::OP::TYPE_SAMPLER:
+                case spirv::OP::TYPE_SAMPLED_IMAGE:
+                case spirv::OP::TYPE_ARRAY:
+                case spirv::OP::TYPE_RUNTIME_ARRAY:
+                case spirv::OP::TYPE_STRUCT:
+                case spirv::OP::TYPE_POINTER:
+                    require(1);
+                    types_.insert_or_assign(operands[0], type_info{op, {std::next(std::begin(operands)), std::end(operands)}});
+                    break;
+
+                case spirv::OP::CONSTANT:
+                    require(3);
+                    constants_.insert_or_assign(operands[1], operands[2]);
+                    break;
+
+                case spirv::OP::SPEC_CONSTANT_TRUE:
+                case spirv::OP::SPEC_CONSTANT_FALSE:
+                case spirv::OP::SPEC_CONSTANT:
+                case spirv::OP::SPEC_CONSTANT_COMPOSITE:
+                    require(2);
+                    spec_constants_.insert_or_assign(operands[1], std::pair{op, operands[0]});
+                    break;
+
+                case spirv::OP::VARIABLE:
+                    require(3);
+                    variables_.push_back({operands[1], operands[0], static_cast<spirv::STORAGE_CLASS>(operands[2])});
+                    break;
+
+                case spirv::OP::DECORATE:
+                    require(2);
+                    decorate(decorations_[operands[0]], static_cast<spirv::DECORATION>(operands[1]), operands.subspan(2));
+                    break;
+
+                case spirv::OP::MEMBER_DECORATE:
+                    require(3);
+
+                    if (static_cast<spirv::DECORATION>(operands[2]) == spirv::DECORATION::OFFSET) {
+                        require(4);
+                        decorations_[operands[0]].member_offsets.insert_or_assign(operands[1], operands[3]);
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        static void decorate(decorations &decorations, spirv::DECORATION decoration, std::span<std::uint32_t const> literals)
+        {
+            auto literal = [literals]
+            {
+                if (literals.empty())
+                    throw graphics::exception("malformed SPIR-V decoration"s);
+
+                return literals[0];
+            };
+
+            switch (decoration) {
+                case spirv::DECORATION::SPEC_ID:
+                    decorations.spec_id = literal();
+                    break;
+
+                case spirv::DECORATION::BLOCK:
+                    decorations.block = true;
+                    break;
+
+                case spirv::DECORATION::BUFFER_BLOCK:
+                    decorations.buffer_block = true;
+                    break;
+
+                case spirv::DECORATION::ARRAY_STRIDE:
+                    decorations.array_stride = literal();
+                    break;
+
+                case spirv::DECORATION::BINDING:
+                    decorations.binding = literal();
+                    break;
+
+                case spirv::DECORATION::DESCRIPTOR_SET:
+                    decorations.set = literal();
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        [[nodiscard]] graphics::shader_reflection::CONSTANT_TYPE constant_type(std::pair<spirv::OP, std::uint32_t> spec_constant) const
+        {
+            using CONSTANT_TYPE = graphics::shader_reflection::CONSTANT_TYPE;
+
+            auto [op, type_id] = spec_constant;
+
+            switch (op) {
+                case spirv::OP::SPEC_CONSTANT_TRUE:
+                case spirv::OP::SPEC_CONSTANT_FALSE:
+                    return CONSTANT_TYPE::BOOLEAN;
+
+                case spirv::OP::SPEC_CONSTANT:
+                    return type(type_id).op == spirv::OP::TYPE_FLOAT ? CONSTANT_TYPE::FLOATING_POINT : CONSTANT_TYPE::INTEGER;
+
+                default:
+                    return CONSTANT_TYPE::COMPOSITE;
+            }
+        }
+
+        [[nodiscard]] type_info const &type(std::uint32_t id) const
+        {
+            if (auto it = types_.find(id); it != std::end(types_))
+                return it->second;
+
+            throw graphics::exception(fmt::format("unknown SPIR-V type id: {}", id));
+        }
+
+        [[nodiscard]] std::uint32_t pointee_type(std::uint32_t pointer_type_id) const
+        {
+            auto &&[op, operands] = type(pointer_type_id);
+
+            if (op != spirv::OP::TYPE_POINTER || std::size(operands) < 2)
+                throw graphics::exception("SPIR-V variable type isn't a pointer"s);
+
+            return operands[1];
+        }
+
+        [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> unwrap_array(std::uint32_t type_id) const
+        {
+            std::uint32_t count = 1;
+
+            for (std::uint32_t depth = 0; ; ++depth) {
+                if (depth > spirv::kMAX_TYPE_NESTING_DEPTH)
+                    throw graphics::exception(fmt::format("SPIR-V array type is nested too deep: {}", type_id));
+
+                auto &&info = type(type_id);
+
+                if (info.op == spirv::OP::TYPE_ARRAY && std::size(info.operands) >= 2) {
+                    count *= constant(info.operands[1]);
+                    type_id = info.operands[0];
+                }
+
+                else if (info.op == spirv::OP::TYPE_RUNTIME_ARRAY && !info.operands.empty()) {
+                    count = 0;
+                    type_id = info.operands[0];
+                }
+
+                else return {type_id, count};
+            }
+        }
+
+        [[nodiscard]] std::uint32_t constant(std::uint32_t id) const
+        {
+            if (auto it = constants_.find(id); it != std::end(constants_))
+                return it->second;
+
+            throw graphics::exception(fmt::format("unknown SPIR-V constant id: {}", id));
+        }
+
+        [[nodiscard]] std::optional<graphics::DESCRIPTOR_TYPE> descriptor_type(std::uint32_t type_id, spirv::STORAGE_CLASS storage_class) const
+        {
+            auto &&[op, operands] = type(type_id);
+
+            auto is_decorated = [this, type_id] (auto member)
+            {
+                auto it = decorations_.find(type_id);
+                return it != std::end(decorations_) && it->second.*member;
+            };
+
+            switch (op) {
+                case spirv::OP::TYPE_STRUCT:
+                    if (storage_class == spirv::STORAGE_CLASS::STORAGE_BUFFER || is_decorated(&decorations::buffer_block))
+                        return graphics::DESCRIPTOR_TYPE::STORAGE_BUFFER;
+
+                    if (storage_class == spirv::STORAGE_CLASS::UNIFORM && is_decorated(&decorations::block))
+                        return graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER;
+
+                    return { };
+
+                case spirv::OP::TYPE_SAMPLER:
+                    return graphics::DESCRIPTOR_TYPE::SAMPLER;
+
+                case spirv::OP::TYPE_SAMPLED_IMAGE:
+                    return graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER;
+
+                case spirv::OP::TYPE_IMAGE:
+                {
+                    if (std::size(operands) < 6)
+                        return { };
+
+                    auto const dim = static_cast<spirv::DIM>(operands[1]);
+                    auto const is_storage = operands[5] == 2;
+
+                    if (dim == spirv::DIM::SUBPASS_DATA)
+                        return graphics::DESCRIPTOR_TYPE::INPUT_ATTACHMENT;
+
+                    if (dim == spirv::DIM::BUFFER)
+                        return is_storage ? graphics::DESCRIPTOR_TYPE::STORAGE_TEXEL_BUFFER : graphics::DESCRIPTOR_TYPE::UNIFORM_TEXEL_BUFFER;
+
+                    return is_storage ? graphics::DESCRIPTOR_TYPE::STORAGE_IMAGE : graphics::DESCRIPTOR_TYPE::SAMPLED_IMAGE;
+                }
+
+                default:
+                    return { };
+            }
+        }
+
+        // Offset of the struct's first member; zero for the undecorated ones.
+        [[nodiscard]] std::uint32_t offset_bytes(std::uint32_t type_id) const
+        {
+            auto const it = decorations_.find(type_id);
+
+            if (it == std::end(decorations_) || it->second.member_offsets.empty())
+                return 0;
+
+            return std::ranges::min(it->second.member_offsets | std::views::values);
+        }
+
+        [[nodiscard]] std::uint32_t size_bytes(std::uint32_t type_id, std::uint32_t depth = 0) const
+        {
+            if (depth > spirv::kMAX_TYPE_NESTING_DEPTH)
+                throw graphics::exception(fmt::format("SPIR-V type is nested too deep: {}", type_id));
+
+            auto &&[op, operands] = type(type_id);
+
+            auto operand = [&operands] (std::size_t index)
+            {
+                if (index >= std::size(operands))
+                    throw graphics::exception("malformed SPIR-V type"s);
+
+                return operands[index];
+            };
+
+            switch (op) {
+                case spirv::OP::TYPE_BOOL:
+                    return 4;
+
+                case spirv::OP::TYPE_INT:
+                case spirv::OP::TYPE_FLOAT:
+                    return operand(0) / 8;
+
+                case spirv::OP::TYPE_VECTOR:
+                case spirv::OP::TYPE_MATRIX:
+                    return size_bytes(operand(0), depth + 1) * operand(1);
+
+                case spirv::OP::TYPE_ARRAY:
+                {
+                    auto const it = decorations_.find(type_id);
+
+                    auto const stride = it != std::end(decorations_) && it->second.array_stride ? *it->second.array_stride : size_bytes(operand(0), depth + 1);
+
+                    return stride * constant(operand(1));
+                }
+
+                case spirv::OP::TYPE_STRUCT:
+                {
+                    auto const it = decorations_.find(type_id);
+
+                    std::uint32_t size = 0;
+
+                    for (std::uint32_t member = 0; member < std::size(operands); ++member) {
+                        std::uint32_t offset = 0;
+
+                        if (it != std::end(decorations_))
+                            if (auto it_offset = it->second.member_offsets.find(member); it_offset != std::end(it->second.member_offsets))
+                                offset = it_offset->second;
+
+                        size = std::max(size, offset + size_bytes(operands[member], depth + 1));
+                    }
+
+                    return size;
+                }
+
+                default:
+                    return 0;
+            }
+        }
+    };
+}
+
+namespace graphics
+{
+    std::optional<graphics::SHADER_STAGE> shader_reflection::entry_point_stage(std::string_view name) const noexcept
+    {
+        auto it = std::ranges::find(entry_points, name, &entry_point::name);
+
+        if (it != std::end(entry_points))
+            return it->stage;
+
+        return { };
+    }
+
+    graphics::shader_reflection reflect_SPIRV(std::span<std::uint32_t const> byte_code)
+    {
+        return module_parser{byte_code}.reflect();
+    }
+
+    void validate_pipeline_layout(graphics::shader_reflection const &reflection, graphics::SHADER_STAGE stage,
+                                  graphics::pipeline_layout const &pipeline_layout)
+    {
+        auto &&descriptor_set_layouts = pipeline_layout.descriptor_set_layouts();
+
+        for (auto [set, binding, type, count] : reflection.descriptor_bindings) {
+            if (set >= std::size(descriptor_set_layouts) || descriptor_set_layouts[set] == nullptr)
+                throw graphics::exception(fmt::format("pipeline layout has no descriptor set {} (binding {})", set, binding));
+
+            auto &&bindings = descriptor_set_layouts[set]->descriptor_set_bindings();
+
+            auto it = std::ranges::find(bindings, binding, &graphics::descriptor_set_binding::binding_index);
+
+            if (it == std::end(bindings))
+                throw graphics::exception(fmt::format("pipeline layout has no binding {} in descriptor set {}", binding, set));
+
+            if (!is_compatible_descriptor_type(type, it->descriptor_type))
+                throw graphics::exception(fmt::format("set {} binding {} descriptor type mismatch: shader {}, layout {}", set, binding,
+                                                      static_cast<std::uint32_t>(type), static_cast<std::uint32_t>(it->descriptor_type)));
+
+            // Runtime sized arrays are reflected with zero count and fit any binding.
+            if (count > it->descriptor_count)
+                throw graphics::exception(fmt::format("set {} binding {} has {} descriptors, the layout declares {}", set, binding,
+                                                      count, it->descriptor_count));
+
+            if (!is_visible(it->shader_stages, stage))
+                throw graphics::exception(fmt::format("set {} binding {} isn't visible to the shader stage", set, binding));
+        }
+
+        if (reflection.push_constants_size_bytes == 0)
+            return;
+
+        // The ranges visible to the stage have to cover the block, which may be split between several of them.
+        auto covered = reflection.push_constants_offset_bytes;
+
+        for (auto extended = true; covered < reflection.push_constants_size_bytes && extended; ) {
+            extended = false;
+
+            for (auto &&range : pipeline_layout.push_constant_ranges()) {
+                if (!is_visible(range.shader_stages, stage))
+                    continue;
+
+                if (range.offset <= covered && covered < range.offset + range.size) {
+                    covered = range.offset + range.size;
+                    extended = true;
+                }
+            }
+        }
+
+        if (covered < reflection.push_constants_size_bytes)
+            throw graphics::exception(fmt::format("push constants [{}, {}) aren't covered by the pipeline layout's ranges for the stage",
+                                                  covered, reflection.push_constants_size_bytes));
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "graphics.hxx"
+
+
+namespace graphics
+{
+    class pipeline_layout;
+
+    // Interface of a SPIR-V module that's required to validate it against materials and pipeline layouts.
+    struct shader_reflection final {
+        struct entry_point final {
+            graphics::SHADER_STAGE stage;
+            std::string name;
+        };
+
+        struct descriptor_binding final {
+            std::uint32_t set;
+            std::uint32_t binding;
+
+            graphics::DESCRIPTOR_TYPE type;
+
+            // Zero for runtime sized arrays.
+            std::uint32_t count;
+        };
+
+        std::vector<entry_point> entry_points;
+        std::vector<descriptor_binding> descriptor_bindings;
+
+        // The push constant block's members span [offset, size); a stage's block may start past the other stages' ones.
+        std::uint32_t push_constants_offset_bytes{0};
+        std::uint32_t push_constants_size_bytes{0};
+
+        enum struct CONSTANT_TYPE {
+            BOOLEAN, INTEGER, FLOATING_POINT, COMPOSITE
+        };
+
+        // Specialization constant types keyed by constant IDs.
+        std::map<std::uint32_t, CONSTANT_TYPE> specialization_constants;
+
+        [[nodiscard]] std::optional<graphics::SHADER_STAGE> entry_point_stage(std::string_view name) const noexcept;
+    };
+
+    // CPU-only SPIR-V parser; doesn't depend on a Vulkan device.
+    [[nodiscard]] graphics::shader_reflection reflect_SPIRV(std::span<std::uint32_t const> byte_code);
+
+    // Checks the resources the module's stage accesses against the pipeline layout's set layouts and push constant ranges;
+    // throws 'graphics::exception' describing the first mismatch.
+    void validate_pipeline_layout(graphics::shader_reflection const &reflection, graphics::SHADER_STAGE stage,
+                                  graphics::pipeline_layout const &pipeline_layout);
+}
@@ -1,4 +1,4 @@
-#include <fstream>
+#include <cstring>
 #include <filesystem>
 namespace fs = std::filesystem;
 
@@ -6,35 +6,63 @@ namespace fs = std::filesystem;
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
+#include <fmt/format.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "utility/exceptions.hxx"
 #include "SPIRV_loader.hxx"
 
 
-namespace loader
+namespace
 {
-    std::vector<std::byte> load_SPIRV(std::string_view name)
+    fs::path shaders_contents_path()
     {
         fs::path contents{"contents/shaders/bin"sv};
 
         if (!fs::exists(fs::current_path() / contents))
             contents = fs::current_path() / "../"sv / contents;
 
-        auto path = contents / (std::string{name} +".spv"s);
+        return contents;
+    }
+}
 
-        std::ifstream file{path.native().c_str(), std::ios::in | std::ios::binary};
+namespace loader
+{
+    std::vector<std::uint32_t> map_SPIRV(std::string_view name)
+    {
+        auto const path = shaders_contents_path() / (std::string{name} + ".spv"s);
 
-        if (file.bad() || file.fail())
+        if (!fs::exists(path) || fs::file_size(path) == 0)
             return { };
 
-        auto const start_pos = file.tellg();
-        file.ignore(std::numeric_limits<std::streamsize>::max());
+        boost::interprocess::file_mapping const mapping{path.string().c_str(), boost::interprocess::read_only};
+        boost::interprocess::mapped_region const region{mapping, boost::interprocess::read_only};
 
-        std::vector<std::byte> byte_code(static_cast<std::size_t>(file.gcount()));
+        if (region.get_size() % sizeof(std::uint32_t) != 0)
+            throw resource::exception(fmt::format("invalid byte code buffer size: {}", name));
 
-        file.seekg(start_pos);
+        std::vector<std::uint32_t> byte_code(region.get_size() / sizeof(std::uint32_t));
 
-        if (!byte_code.empty())
-            file.read(reinterpret_cast<char *>(std::data(byte_code)), static_cast<std::streamsize>(std::size(byte_code)));
+        std::memcpy(std::data(byte_code), region.get_address(), region.get_size());
 
         return byte_code;
     }
+
+    std::vector<std::string> enumerate_SPIRV()
+    {
+        auto const contents = shaders_contents_path();
+
+        if (!fs::exists(contents))
+            return { };
+
+        std::vector<std::string> names;
+
+        for (auto &&entry : fs::directory_iterator{contents})
+            if (entry.is_regular_file() && entry.path().extension() == ".spv"sv)
+                names.push_back(entry.path().stem().string());
+
+        return names;
+    }
 }
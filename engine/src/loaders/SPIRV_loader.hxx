@@ -5,10 +5,16 @@
 #endif
 
 #include <vector>
+#include <cstdint>
+#include <string>
 #include <string_view>
 
 
 namespace loader
 {
-    std::vector<std::byte> load_SPIRV(std::string_view name);
+    // Memory maps the module and returns its words; an empty vector if the file doesn't exist.
+    std::vector<std::uint32_t> map_SPIRV(std::string_view name);
+
+    // Names of all compiled modules produced by the content pipeline.
+    std::vector<std::string> enumerate_SPIRV();
 }
@@ -0,0 +1,417 @@
+#include <bit>
+#include <span>
+#include <limits>
+#include <vector>
+#include <cstring>
+#include <variant>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "utility/helpers.hxx"
+#include "utility/exceptions.hxx"
+#include "cooked_material.hxx"
+
+
+namespace
+{
+    using namespace loader::cooked_material;
+
+    [[nodiscard]] std::uint32_t checksum(std::span<std::byte const> bytes) noexcept
+    {
+        // 32-bit FNV-1a.
+        std::uint32_t hash = 0x811C'9DC5;
+
+        for (auto byte : bytes) {
+            hash ^= std::to_integer<std::uint32_t>(byte);
+            hash *= 0x0100'0193;
+        }
+
+        return hash;
+    }
+
+    [[nodiscard]] bool is_valid_shader_stage(std::uint32_t stage) noexcept
+    {
+        switch (static_cast<graphics::SHADER_STAGE>(stage)) {
+            case graphics::SHADER_STAGE::VERTEX:
+            case graphics::SHADER_STAGE::TESS_CONTROL:
+            case graphics::SHADER_STAGE::TESS_EVAL:
+            case graphics::SHADER_STAGE::GEOMETRY:
+            case graphics::SHADER_STAGE::FRAGMENT:
+            case graphics::SHADER_STAGE::COMPUTE:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] bool is_valid_shader_stages(std::uint32_t stages) noexcept
+    {
+        auto constexpr all_stages = static_cast<std::uint32_t>(graphics::SHADER_STAGE::ALL_SHADER_STAGES);
+
+        return stages != 0 && (stages & ~all_stages) == 0;
+    }
+
+    // The semantics and the formats are contiguous enumerations, so a decoded value is valid within their bounds.
+    [[nodiscard]] bool is_valid_semantic(std::uint32_t semantic) noexcept
+    {
+        return semantic <= static_cast<std::uint32_t>(vertex::SEMANTIC::WEIGHTS_0);
+    }
+
+    [[nodiscard]] bool is_valid_format(std::uint32_t format) noexcept
+    {
+        return format > static_cast<std::uint32_t>(graphics::FORMAT::UNDEFINED) &&
+               format <= static_cast<std::uint32_t>(graphics::FORMAT::RGBA12X4_UNORM_4PACK16);
+    }
+
+    template<class T>
+    [[nodiscard]] std::uint32_t to_uint32(T value)
+    {
+        if constexpr (std::is_enum_v<T>)
+            return static_cast<std::uint32_t>(value);
+
+        else {
+            if (value > std::numeric_limits<std::uint32_t>::max())
+                throw resource::exception("cooked material value is out of range"s);
+
+            return static_cast<std::uint32_t>(value);
+        }
+    }
+
+    class section_writer final {
+    public:
+
+        template<class T>
+        void append(SECTION section, std::vector<T> const &records)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+
+            auto &&[offset, count] = sections_.at(static_cast<std::size_t>(section));
+
+            offset = to_uint32(sizeof(header) + std::size(payload_));
+            count = to_uint32(std::size(records));
+
+            auto const bytes = std::as_bytes(std::span{records});
+            payload_.insert(std::end(payload_), std::begin(bytes), std::end(bytes));
+
+            // Keep every following section 4-byte aligned.
+            payload_.resize(aligned_size(std::size(payload_)), std::byte{0});
+        }
+
+        [[nodiscard]] std::vector<std::byte> finish(std::uint32_t name_offset, std::uint32_t name_length) const
+        {
+            header const file_header{
+                kMAGIC,
+                kVERSION,
+                to_uint32(sizeof(header) + std::size(payload_)),
+                checksum(payload_),
+                name_offset, name_length,
+                sections_
+            };
+
+            std::vector<std::byte> bytes(sizeof(file_header));
+            std::memcpy(std::data(bytes), &file_header, sizeof(file_header));
+
+            bytes.insert(std::end(bytes), std::begin(payload_), std::end(payload_));
+
+            return bytes;
+        }
+
+    private:
+
+        std::array<section, static_cast<std::size_t>(SECTION::COUNT)> sections_{};
+        std::vector<std::byte> payload_;
+
+        [[nodiscard]] static std::size_t aligned_size(std::size_t size) noexcept
+        {
+            return (size + 3) & ~std::size_t{3};
+        }
+    };
+
+    class cooked_file_view final {
+    public:
+
+        explicit cooked_file_view(std::span<std::byte const> bytes) : bytes_{bytes}
+        {
+            if (std::size(bytes_) < sizeof(header_))
+                throw resource::exception("cooked material is truncated"s);
+
+            std::memcpy(&header_, std::data(bytes_), sizeof(header_));
+
+            if (header_.magic != kMAGIC)
+                throw resource::exception("cooked material has invalid signature"s);
+
+            if (header_.version != kVERSION)
+                throw resource::exception(fmt::format("unsupported cooked material version: {}", header_.version));
+
+            if (header_.size_bytes != std::size(bytes_))
+                throw resource::exception("cooked material size mismatch"s);
+
+            if (header_.checksum != checksum(bytes_.subspan(sizeof(header_))))
+                throw resource::exception("cooked material checksum mismatch"s);
+
+            for (auto section : {SECTION::STRINGS, SECTION::SHADER_MODULES, SECTION::VERTEX_ATTRIBUTES, SECTION::TECHNIQUES,
+                                 SECTION::SHADER_BUNDLES, SECTION::SPECIALIZATION_CONSTANTS, SECTION::VERTEX_LAYOUTS, SECTION::VERTEX_LAYOUT_INDICES,
+                                 SECTION::PUSH_CONSTANT_RANGES}) {
+                auto [offset, count] = header_.sections.at(static_cast<std::size_t>(section));
+
+                if (offset < sizeof(header_) || offset % alignof(std::uint32_t) != 0 || offset > std::size(bytes_))
+                    throw resource::exception("cooked material has invalid section offset"s);
+            }
+
+            auto [strings_offset, strings_size] = header_.sections.at(static_cast<std::size_t>(SECTION::STRINGS));
+
+            if (strings_size > std::size(bytes_) - strings_offset)
+                throw resource::exception("cooked material section is out of bounds"s);
+
+            strings_ = bytes_.subspan(strings_offset, strings_size);
+        }
+
+        [[nodiscard]] header const &file_header() const noexcept { return header_; }
+
+        template<class T>
+        [[nodiscard]] std::span<T const> records(SECTION section) const
+        {
+            auto [offset, count] = header_.sections.at(static_cast<std::size_t>(section));
+
+            if (count > (std::size(bytes_) - offset) / sizeof(T))
+                throw resource::exception("cooked material section is out of bounds"s);
+
+            return {reinterpret_cast<T const *>(std::data(bytes_) + offset), count};
+        }
+
+        [[nodiscard]] std::string string(std::uint32_t offset, std::uint32_t length) const
+        {
+            if (offset > std::size(strings_) || length > std::size(strings_) - offset)
+                throw resource::exception("cooked material string is out of bounds"s);
+
+            return {reinterpret_cast<char const *>(std::data(strings_) + offset), length};
+        }
+
+    private:
+
+        std::span<std::byte const> bytes_;
+        std::span<std::byte const> strings_;
+
+        header header_{};
+    };
+
+    template<class T>
+    [[nodiscard]] std::span<T const> subrange(std::span<T const> records, std::uint32_t first, std::uint32_t count)
+    {
+        if (first > std::size(records) || count > std::size(records) - first)
+            throw resource::exception("cooked material record range is out of bounds"s);
+
+        return records.subspan(first, count);
+    }
+}
+
+namespace loader
+{
+    void cook_material_description(loader::material_description const &description, std::filesystem::path const &path)
+    {
+        std::string strings;
+
+        auto append_string = [&strings] (std::string const &string)
+        {
+            auto offset = to_uint32(std::size(strings));
+            strings += string;
+
+            return std::pair{offset, to_uint32(std::size(string))};
+        };
+
+        auto const [name_offset, name_length] = append_string(description.name);
+
+        std::vector<cooked_material::shader_module> shader_modules;
+
+        for (auto &&shader_module : description.shader_modules) {
+            auto const [offset, length] = append_string(shader_module.name);
+            shader_modules.push_back({to_uint32(shader_module.stage), offset, length});
+        }
+
+        std::vector<cooked_material::vertex_attribute> vertex_attributes;
+
+        for (auto &&vertex_attribute : description.vertex_attributes)
+            vertex_attributes.push_back({to_uint32(vertex_attribute.semantic), to_uint32(vertex_attribute.format)});
+
+        std::vector<cooked_material::technique> techniques;
+        std::vector<cooked_material::shader_bundle> shader_bundles;
+        std::vector<cooked_material::specialization_constant> specialization_constants;
+        std::vector<cooked_material::vertex_layout> vertex_layouts;
+        std::vector<std::uint32_t> vertex_layout_indices;
+
+        for (auto &&technique : description.techniques) {
+            techniques.push_back({
+                to_uint32(std::size(shader_bundles)), to_uint32(std::size(technique.shaders_bundle)),
+                to_uint32(std::size(vertex_layouts)), to_uint32(std::size(technique.vertex_layouts))
+            });
+
+            for (auto &&shader_bundle : technique.shaders_bundle) {
+                shader_bundles.push_back({
+                    to_uint32(shader_bundle.module_index), to_uint32(shader_bundle.technique_index),
+                    to_uint32(std::size(specialization_constants)), to_uint32(std::size(shader_bundle.specialization_constants))
+                });
+
+                for (auto &&constant : shader_bundle.specialization_constants) {
+                    specialization_constants.push_back(std::visit(overloaded{
+                        [] (std::int32_t value)
+                        {
+                            return cooked_material::specialization_constant{
+                                cooked_material::SPECIALIZATION_CONSTANT_TYPE::INT32, std::bit_cast<std::uint32_t>(value)
+                            };
+                        },
+                        [] (boost::float32_t value)
+                        {
+                            return cooked_material::specialization_constant{
+                                cooked_material::SPECIALIZATION_CONSTANT_TYPE::FLOAT32, std::bit_cast<std::uint32_t>(value)
+                            };
+                        }
+                    }, constant));
+                }
+            }
+
+            for (auto &&vertex_layout : technique.vertex_layouts) {
+                vertex_layouts.push_back({to_uint32(std::size(vertex_layout_indices)), to_uint32(std::size(vertex_layout))});
+
+                for (auto index : vertex_layout)
+                    vertex_layout_indices.push_back(to_uint32(index));
+            }
+        }
+
+        std::vector<cooked_material::push_constant_range> push_constant_ranges;
+
+        for (auto &&range : description.push_constant_ranges)
+            push_constant_ranges.push_back({to_uint32(range.shader_stages), range.offset, range.size});
+
+        section_writer writer;
+
+        writer.append(SECTION::STRINGS, std::vector<char>(std::begin(strings), std::end(strings)));
+        writer.append(SECTION::SHADER_MODULES, shader_modules);
+        writer.append(SECTION::VERTEX_ATTRIBUTES, vertex_attributes);
+        writer.append(SECTION::TECHNIQUES, techniques);
+        writer.append(SECTION::SHADER_BUNDLES, shader_bundles);
+        writer.append(SECTION::SPECIALIZATION_CONSTANTS, specialization_constants);
+        writer.append(SECTION::VERTEX_LAYOUTS, vertex_layouts);
+        writer.append(SECTION::VERTEX_LAYOUT_INDICES, vertex_layout_indices);
+        writer.append(SECTION::PUSH_CONSTANT_RANGES, push_constant_ranges);
+
+        auto const bytes = writer.finish(name_offset, name_length);
+
+        std::filesystem::create_directories(path.parent_path());
+
+        std::ofstream file{path.native().c_str(), std::ios::out | std::ios::binary | std::ios::trunc};
+
+        if (file.bad() || file.fail())
+            throw resource::exception(fmt::format("failed to open file: {}", path.string()));
+
+        file.write(reinterpret_cast<char const *>(std::data(bytes)), static_cast<std::streamsize>(std::size(bytes)));
+    }
+
+    std::optional<loader::material_description> load_cooked_material_description(std::filesystem::path const &path)
+    {
+        if (!std::filesystem::exists(path) || std::filesystem::file_size(path) == 0)
+            return { };
+
+        boost::interprocess::file_mapping const mapping{path.string().c_str(), boost::interprocess::read_only};
+        boost::interprocess::mapped_region const region{mapping, boost::interprocess::read_only};
+
+        cooked_file_view const view{std::span{static_cast<std::byte const *>(region.get_address()), region.get_size()}};
+
+        auto const &header = view.file_header();
+
+        loader::material_description description;
+
+        description.name = view.string(header.name_offset, header.name_length);
+
+        for (auto &&shader_module : view.records<cooked_material::shader_module>(SECTION::SHADER_MODULES)) {
+            if (!is_valid_shader_stage(shader_module.stage))
+                throw resource::exception("unsupported shader stage"s);
+
+            description.shader_modules.push_back({
+                static_cast<graphics::SHADER_STAGE>(shader_module.stage),
+                view.string(shader_module.name_offset, shader_module.name_length)
+            });
+        }
+
+        for (auto &&vertex_attribute : view.records<cooked_material::vertex_attribute>(SECTION::VERTEX_ATTRIBUTES)) {
+            if (!is_valid_semantic(vertex_attribute.semantic))
+                throw resource::exception("unsupported vertex attribute semantic"s);
+
+            if (!is_valid_format(vertex_attribute.format))
+                throw resource::exception("unsupported vertex attribute format"s);
+
+            description.vertex_attributes.push_back({
+                static_cast<vertex::SEMANTIC>(vertex_attribute.semantic),
+                static_cast<graphics::FORMAT>(vertex_attribute.format)
+            });
+        }
+
+        auto const shader_bundles = view.records<cooked_material::shader_bundle>(SECTION::SHADER_BUNDLES);
+        auto const specialization_constants = view.records<cooked_material::specialization_constant>(SECTION::SPECIALIZATION_CONSTANTS);
+        auto const vertex_layouts = view.records<cooked_material::vertex_layout>(SECTION::VERTEX_LAYOUTS);
+        auto const vertex_layout_indices = view.records<std::uint32_t>(SECTION::VERTEX_LAYOUT_INDICES);
+
+        for (auto &&cooked_technique : view.records<cooked_material::technique>(SECTION::TECHNIQUES)) {
+            auto &&technique = description.techniques.emplace_back();
+
+            for (auto &&shader_bundle : subrange(shader_bundles, cooked_technique.first_shader_bundle, cooked_technique.shader_bundles_count)) {
+                if (shader_bundle.module_index >= std::size(description.shader_modules))
+                    throw resource::exception("shader bundle refers to unknown shader module"s);
+
+                auto &&bundle = technique.shaders_bundle.emplace_back();
+
+                bundle.module_index = shader_bundle.module_index;
+                bundle.technique_index = shader_bundle.technique_index;
+
+                for (auto [type, bits] : subrange(specialization_constants, shader_bundle.first_specialization_constant, shader_bundle.specialization_constants_count)) {
+                    switch (type) {
+                        case cooked_material::SPECIALIZATION_CONSTANT_TYPE::INT32:
+                            bundle.specialization_constants.emplace_back(std::bit_cast<std::int32_t>(bits));
+                            break;
+
+                        case cooked_material::SPECIALIZATION_CONSTANT_TYPE::FLOAT32:
+                            bundle.specialization_constants.emplace_back(std::bit_cast<boost::float32_t>(bits));
+                            break;
+
+                        default:
+                            throw resource::exception("unsupported specialization constant value"s);
+                    }
+                }
+            }
+
+            for (auto &&vertex_layout : subrange(vertex_layouts, cooked_technique.first_vertex_layout, cooked_technique.vertex_layouts_count)) {
+                auto &&layout = technique.vertex_layouts.emplace_back();
+
+                for (auto index : subrange(vertex_layout_indices, vertex_layout.first_index, vertex_layout.indices_count)) {
+                    if (index >= std::size(description.vertex_attributes))
+                        throw resource::exception("vertex layout refers to unknown vertex attribute"s);
+
+                    layout.push_back(index);
+                }
+            }
+        }
+
+        for (auto &&range : view.records<cooked_material::push_constant_range>(SECTION::PUSH_CONSTANT_RANGES)) {
+            if (!is_valid_shader_stages(range.shader_stages))
+                throw resource::exception("unsupported push constant range shader stages"s);
+
+            if (range.size == 0 || range.offset % 4 != 0 || range.size % 4 != 0)
+                throw resource::exception("invalid push constant range"s);
+
+            description.push_constant_ranges.push_back({
+                static_cast<graphics::SHADER_STAGE>(range.shader_stages), range.offset, range.size
+            });
+        }
+
+        return description;
+    }
+}
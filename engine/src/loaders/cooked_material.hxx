@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <filesystem>
+
+#include "material_loader.hxx"
+
+
+namespace loader
+{
+    // Compact binary representation of 'loader::material_description' with all enumerations already resolved.
+    // The file is a header followed by the tightly packed sections; every record is a sequence of 32-bit words.
+    namespace cooked_material
+    {
+        std::uint32_t constexpr kMAGIC{0x444D'4956}; // "VIMD"
+        std::uint32_t constexpr kVERSION{2};
+
+        enum struct SECTION : std::uint32_t {
+            STRINGS = 0,
+            SHADER_MODULES,
+            VERTEX_ATTRIBUTES,
+            TECHNIQUES,
+            SHADER_BUNDLES,
+            SPECIALIZATION_CONSTANTS,
+            VERTEX_LAYOUTS,
+            VERTEX_LAYOUT_INDICES,
+            PUSH_CONSTANT_RANGES,
+
+            COUNT
+        };
+
+        struct section final {
+            std::uint32_t offset;
+            std::uint32_t count;
+        };
+
+        struct header final {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t size_bytes;
+            std::uint32_t checksum;
+
+            std::uint32_t name_offset;
+            std::uint32_t name_length;
+
+            std::array<cooked_material::section, static_cast<std::size_t>(SECTION::COUNT)> sections;
+        };
+
+        struct shader_module final {
+            std::uint32_t stage;
+            std::uint32_t name_offset;
+            std::uint32_t name_length;
+        };
+
+        struct vertex_attribute final {
+            std::uint32_t semantic;
+            std::uint32_t format;
+        };
+
+        struct technique final {
+            std::uint32_t first_shader_bundle;
+            std::uint32_t shader_bundles_count;
+            std::uint32_t first_vertex_layout;
+            std::uint32_t vertex_layouts_count;
+        };
+
+        struct shader_bundle final {
+            std::uint32_t module_index;
+            std::uint32_t technique_index;
+            std::uint32_t first_specialization_constant;
+            std::uint32_t specialization_constants_count;
+        };
+
+        enum struct SPECIALIZATION_CONSTANT_TYPE : std::uint32_t {
+            INT32 = 0, FLOAT32
+        };
+
+        struct specialization_constant final {
+            SPECIALIZATION_CONSTANT_TYPE type;
+            std::uint32_t bits;
+        };
+
+        struct vertex_layout final {
+            std::uint32_t first_index;
+            std::uint32_t indices_count;
+        };
+
+        struct push_constant_range final {
+            std::uint32_t shader_stages;
+            std::uint32_t offset;
+            std::uint32_t size;
+        };
+    }
+
+    // Serializes the description into the cooked format.
+    void cook_material_description(loader::material_description const &description, std::filesystem::path const &path);
+
+    // Maps the cooked file into memory and validates it before building the description.
+    // Returns an empty value when the file doesn't exist; throws when it is malformed.
+    [[nodiscard]] std::optional<loader::material_description> load_cooked_material_description(std::filesystem::path const &path);
+}
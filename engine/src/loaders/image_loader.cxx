@@ -101,7 +101,7 @@ namespace
 
     template<class T>
     [[nodiscard]] std::shared_ptr<resource::buffer>
-    stage_data(vulkan::device &device, resource::resource_manager &resource_manager, std::span<T> texels_data)
+    stage_data(resource::resource_manager &resource_manager, std::span<T> texels_data)
     {
         auto constexpr usage_flags = graphics::BUFFER_USAGE::TRANSFER_SOURCE;
         auto constexpr property_flags = graphics::MEMORY_PROPERTY_TYPE::HOST_VISIBLE | graphics::MEMORY_PROPERTY_TYPE::HOST_COHERENT;
@@ -111,18 +111,12 @@ namespace
         auto buffer = resource_manager.create_buffer(texels_data.size_bytes(), usage_flags, property_flags, graphics::RESOURCE_SHARING_MODE::EXCLUSIVE);
 
         if (buffer) {
-            void *data = nullptr;
+            auto const mapped_range = buffer->memory()->mapped_range();
 
-            auto &&memory = buffer->memory();
+            if (std::size(mapped_range) < texels_data.size_bytes())
+                throw vulkan::exception("staging buffer memory isn't mapped"s);
 
-            if (auto result = vkMapMemory(device.handle(), memory->handle(), memory->offset(), memory->size(), 0, &data); result != VK_SUCCESS)
-                throw vulkan::exception(fmt::format("failed to map staging buffer memory: {0:#x}", result));
-
-            else {
-                std::ranges::copy(texels_data, static_cast<T *>(data));
-
-                vkUnmapMemory(device.handle(), buffer->memory()->handle());
-            }
+            std::ranges::copy(std::as_bytes(texels_data), std::data(mapped_range));
         }
 
         return buffer;
@@ -143,7 +137,7 @@ load_texture(vulkan::device &device, render::config const &config, resource::res
 {
     auto const info = load_texture_data(name);
 
-    auto staging_buffer = stage_data(device, resource_manager, std::span{std::to_address(info.pixels_ptr), info.size_bytes});
+    auto staging_buffer = stage_data(resource_manager, std::span{std::to_address(info.pixels_ptr), info.size_bytes});
     if (staging_buffer == nullptr)
         return { };
 
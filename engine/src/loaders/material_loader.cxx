@@ -2,7 +2,6 @@
 #include <optional>
 #include <unordered_map>
 
-#include <iostream>
 #include <fstream>
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -13,6 +12,7 @@ namespace fs = std::filesystem;
 
 #include "utility/exceptions.hxx"
 #include "material_loader.hxx"
+#include "cooked_material.hxx"
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -403,6 +403,28 @@ namespace loader
         shader_module.name = j.at("name"s).get<std::string>();
     }
 
+    static void from_json(nlohmann::json const &j, loader::material_description::push_constant_range &push_constant_range)
+    {
+        push_constant_range.shader_stages = graphics::SHADER_STAGE{0};
+
+        for (auto &&name : j.at("stages"s).get<std::vector<std::string>>()) {
+            if (auto stage = loader::shader_stage_semantic(name); stage)
+                push_constant_range.shader_stages = push_constant_range.shader_stages | *stage;
+
+            else throw resource::exception("unsupported push constant range shader stage"s);
+        }
+
+        if (push_constant_range.shader_stages == graphics::SHADER_STAGE{0})
+            throw resource::exception("push constant range has no shader stages"s);
+
+        push_constant_range.offset = j.at("offset"s).get<std::uint32_t>();
+        push_constant_range.size = j.at("size"s).get<std::uint32_t>();
+
+        // Vulkan requires both to be multiples of four.
+        if (push_constant_range.size == 0 || push_constant_range.offset % 4 != 0 || push_constant_range.size % 4 != 0)
+            throw resource::exception("invalid push constant range"s);
+    }
+
     static void from_json(nlohmann::json const &j, loader::material_description::vertex_attribute &vertex_attribute)
     {
         if (auto semantic = loader::attribute_semantic(j.at("semantic"s).get<std::string>()); semantic)
@@ -447,17 +469,58 @@ namespace loader
 
 namespace loader
 {
+    fs::path materials_contents_path()
+    {
+        fs::path contents{"contents/materials"s};
+
+        if (!fs::exists(fs::current_path() / contents))
+            contents = fs::current_path() / "../"s / contents;
+
+        return contents;
+    }
+
+    fs::path material_source_path(std::string_view name)
+    {
+        return (materials_contents_path() / name).replace_extension(".json"sv);
+    }
+
+    fs::path cooked_material_path(std::string_view name)
+    {
+        return (materials_contents_path() / "bin"sv / name).replace_extension(".bin"sv);
+    }
+
     loader::material_description load_material_description(std::string_view name)
     {
-        nlohmann::json json;
+        auto const source_path = material_source_path(name);
+        auto const cooked_path = cooked_material_path(name);
 
-        {
-            fs::path contents{"contents/materials"s};
+        auto const is_up_to_date = fs::exists(cooked_path) &&
+                                   (!fs::exists(source_path) || fs::last_write_time(source_path) <= fs::last_write_time(cooked_path));
 
-            if (!fs::exists(fs::current_path() / contents))
-                contents = fs::current_path() / "../"s / contents;
+        if (is_up_to_date) {
+            try {
+                if (auto description = load_cooked_material_description(cooked_path); description)
+                    return *description;
+            }
 
-            auto path = (contents / name).replace_extension(".json"sv);
+            catch (resource::exception const &ex) {
+                if (!fs::exists(source_path))
+                    throw resource::exception(fmt::format("failed to load cooked material '{}': {}", name, ex.what()));
+
+                // The cooked file is a cache of the source, so a damaged one is reported and the source is loaded instead.
+                fmt::print(stderr, "failed to load cooked material '{}', loading its source: {}\n", name, ex.what());
+            }
+        }
+
+        return load_material_description_json(name);
+    }
+
+    loader::material_description load_material_description_json(std::string_view name)
+    {
+        nlohmann::json json;
+
+        {
+            auto const path = material_source_path(name);
 
             std::ifstream file{path.native().c_str(), std::ios::in};
 
@@ -473,11 +536,17 @@ namespace loader
 
         auto techniques = json.at("techniques"s).get<std::vector<material_description::technique>>();
 
+        std::vector<material_description::push_constant_range> push_constant_ranges;
+
+        if (json.count("pushConstants"s))
+            push_constant_ranges = json.at("pushConstants"s).get<std::vector<material_description::push_constant_range>>();
+
         return loader::material_description{
             std::string{name},
             shader_modules,
             vertex_attributes,
-            techniques
+            techniques,
+            push_constant_ranges
         };
     }
 }
@@ -5,6 +5,7 @@
 #include <variant>
 #include <string>
 #include <string_view>
+#include <filesystem>
 
 #include <boost/cstdfloat.hpp>
 
@@ -49,7 +50,24 @@ namespace loader
         };
 
         std::vector<technique> techniques;
+
+        // Ranges of the per-draw data pushed to the shaders; they extend the material's pipeline layout.
+        struct push_constant_range final {
+            graphics::SHADER_STAGE shader_stages;
+
+            std::uint32_t offset;
+            std::uint32_t size;
+        };
+
+        std::vector<push_constant_range> push_constant_ranges;
     };
 
+    // Loads the cooked material if it is up to date, otherwise falls back to the JSON source.
     [[nodiscard]] loader::material_description load_material_description(std::string_view name);
+
+    [[nodiscard]] loader::material_description load_material_description_json(std::string_view name);
+
+    [[nodiscard]] std::filesystem::path materials_contents_path();
+    [[nodiscard]] std::filesystem::path material_source_path(std::string_view name);
+    [[nodiscard]] std::filesystem::path cooked_material_path(std::string_view name);
 }
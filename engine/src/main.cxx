@@ -51,16 +51,18 @@
 #endif
 
 #include <chrono>
+#include <thread>
 #include <cmath>
 #include <ranges>
 #include <span>
+#include <algorithm>
 #include <unordered_map>
 
-#ifdef _MSC_VER
-    #include <execution>
-#endif
 #include <random>
 #include <ranges>
+#include <fstream>
+#include <optional>
+#include <iostream>
 #include <functional>
 
 #include <string>
@@ -73,10 +75,12 @@ using namespace std::string_view_literals;
 
 #include <boost/align.hpp>
 #include <boost/align/align.hpp>
+#include <boost/program_options.hpp>
 
 #include "utility/mpl.hxx"
 #include "utility/helpers.hxx"
 #include "utility/exceptions.hxx"
+#include "utility/trace.hxx"
 
 #include "math/math.hxx"
 #include "math/pack-unpack.hxx"
@@ -87,6 +91,7 @@ using namespace std::string_view_literals;
 #include "renderer/config.hxx"
 #include "renderer/renderer.hxx"
 #include "renderer/swapchain.hxx"
+#include "renderer/offscreen_target.hxx"
 #include "renderer/command_buffer.hxx"
 
 #include "resources/buffer.hxx"
@@ -122,89 +127,38 @@ using namespace std::string_view_literals;
 
 #include "main.hxx"
 #include "app.hxx"
+#include "benchmark.hxx"
 
 
-void update_descriptor_set(app_t &app, vulkan::device const &device)
+descriptor_sets_data get_descriptor_sets_data(app_t const &app)
 {
-    // TODO: descriptor info typed by VkDescriptorType.
-    auto const per_camera = std::array{
-        VkDescriptorBufferInfo{app.per_camera_buffer->handle(), 0, sizeof(camera::data_t)}
-    };
-
-    // TODO: descriptor info typed by VkDescriptorType.
-    auto const per_object = std::array{
-        VkDescriptorBufferInfo{app.per_object_buffer->handle(), 0, sizeof(per_object_t)}
-    };
-
-    // TODO: descriptor info typed by VkDescriptorType.
-    auto const per_viewport = std::array{
-        VkDescriptorBufferInfo{app.per_viewport_buffer->handle(), 0, sizeof(per_viewport_t)}
-    };
-
-//#ifdef TEMPORARILY_DISABLED
-    // TODO: descriptor info typed by VkDescriptorType.
-    auto const per_image = std::array{
-        VkDescriptorImageInfo{app.texture->sampler->handle(), app.texture->view->handle(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}
-    };
-//#endif
-
-    std::array<VkWriteDescriptorSet, 4> const write_descriptor_sets{{
-        {
-            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            nullptr,
-            app.view_resources_descriptor_set,
-            0,
-            0, static_cast<std::uint32_t>(std::size(per_camera)),
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            nullptr,
-            std::data(per_camera),
-            nullptr
+    return descriptor_sets_data{
+        view_resources_descriptors{
+            app.view_uniforms->descriptor_buffer_info(kCAMERA_UNIFORMS_RANGE),
+            app.view_uniforms->descriptor_buffer_info(kVIEWPORT_UNIFORMS_RANGE)
         },
-        {
-            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            nullptr,
-            app.object_resources_descriptor_set,
-            0, // it is 1 when there was only one descriptor set
-            0, static_cast<std::uint32_t>(std::size(per_object)),
-            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
-            nullptr,
-            std::data(per_object),
-            nullptr
+        object_resources_descriptors{
+            app.object_buffer->descriptor_buffer_info(kOBJECTS_RANGE)
         },
-        {
-            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            nullptr,
-            app.view_resources_descriptor_set,
-            1,
-            0, static_cast<std::uint32_t>(std::size(per_viewport)),
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            nullptr,
-            std::data(per_viewport),
-            nullptr
-        },
-//#ifdef TEMPORARILY_DISABLED
-        {
-            VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            nullptr,
-            app.image_resources_descriptor_set,
-            0,
-            0, static_cast<std::uint32_t>(std::size(per_image)),
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            std::data(per_image),
-            nullptr,
-            nullptr
+        image_resources_descriptors{
+            VkDescriptorImageInfo{app.texture->sampler->handle(), app.texture->view->handle(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}
         }
-//#endif
-    }};
+    };
+}
+
+void update_descriptor_set(app_t &app)
+{
+    auto const data = get_descriptor_sets_data(app);
 
     // :WARN: remember about potential race condition with the related executing command buffer.
-    vkUpdateDescriptorSets(device.handle(), static_cast<std::uint32_t>(std::size(write_descriptor_sets)),
-                           std::data(write_descriptor_sets), 0, nullptr);
+    app.view_resources_descriptor_update_template->update(app.view_resources_descriptor_set, data.view_resources);
+    app.object_resources_descriptor_update_template->update(app.object_resources_descriptor_set, data.object_resources);
+    app.image_resources_descriptor_update_template->update(app.image_resources_descriptor_set, data.image_resources);
 }
 
 void create_graphics_command_buffers(app_t &app)
 {
-    app.command_buffers.resize(std::size(app.swapchain->image_views()));
+    app.command_buffers.resize(std::size(app.render_target_views()));
 
     VkCommandBufferAllocateInfo const allocate_info{
         VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
@@ -217,6 +171,12 @@ void create_graphics_command_buffers(app_t &app)
     if (auto result = vkAllocateCommandBuffers(app.device->handle(), &allocate_info, std::data(app.command_buffers)); result != VkResult::VK_SUCCESS)
         throw vulkan::exception{fmt::format("failed to create allocate command buffers: {0:#x}", result)};
 
+    for (std::size_t image_index = 0; image_index < std::size(app.command_buffers); ++image_index)
+        record_graphics_command_buffer(app, image_index);
+}
+
+static void record_forward_pass(app_t &app, VkCommandBuffer command_buffer, std::size_t image_index)
+{
 #if defined(__clang__)/* || defined(_MSC_VER)*/
     auto const clear_colors = std::array{
         VkClearValue{{{ .64f, .64f, .64f, 1.f }}},
@@ -232,113 +192,174 @@ void create_graphics_command_buffers(app_t &app)
     auto non_indexed = app.draw_commands_holder.get_primitives_buffers_bind_ranges();
     auto indexed = app.draw_commands_holder.get_indexed_primitives_buffers_bind_range();
 
-    for (std::size_t i = 0; auto &command_buffer : app.command_buffers) {
-        VkCommandBufferBeginInfo const begin_info{
-            VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-            nullptr,
-            0,
-            nullptr
-        };
+    auto &&gpu_profiler = app.gpu_profiler;
 
-        if (auto result = vkBeginCommandBuffer(command_buffer, &begin_info); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to record command buffer: {0:#x}", result));
+    auto [width, height] = app.render_target_extent();
 
-        auto [width, height] = app.swapchain->extent();
+    VkRenderPassBeginInfo const render_pass_info{
+        VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+        nullptr,
+        app.render_pass->handle(),
+        app.framebuffers.at(image_index)->handle(),
+        {{0, 0}, VkExtent2D{width, height}},
+        static_cast<std::uint32_t>(std::size(clear_colors)), std::data(clear_colors)
+    };
 
-        VkRenderPassBeginInfo const render_pass_info{
-            VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            nullptr,
-            app.render_pass->handle(),
-            app.framebuffers.at(i++)->handle(),
-            {{0, 0}, VkExtent2D{width, height}},
-            static_cast<std::uint32_t>(std::size(clear_colors)), std::data(clear_colors)
-        };
+    vkCmdBeginRenderPass(command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
 
-        vkCmdBeginRenderPass(command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+#if USE_DYNAMIC_PIPELINE_STATE
+    VkViewport const viewport{
+        0, static_cast<float>(height),
+        static_cast<float>(width), -static_cast<float>(height),
+        0, 1
+    };
 
-    #if USE_DYNAMIC_PIPELINE_STATE
-        VkViewport const viewport{
-            0, static_cast<float>(height),
-            static_cast<float>(width), -static_cast<float>(height),
-            0, 1
-        };
+    VkRect2D const scissor{
+        {0, 0}, VkExtent2D{width, height}
+    };
 
-        VkRect2D const scissor{
-            {0, 0}, VkExtent2D{width, height}
-        };
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+#endif
 
-        vkCmdSetViewport(command_buffer, 0, 1, &viewport);
-        vkCmdSetScissor(command_buffer, 0, 1, &scissor);
-    #endif
+    VkPipeline bound_pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout bound_pipeline_layout = VK_NULL_HANDLE;
+    VkDescriptorSet bound_object_descriptor_set = VK_NULL_HANDLE;
+
+    // Equal pipeline layouts are the same object, so switching between the pipelines sharing a layout keeps the descriptor sets
+    // bound; the layouts differ only in the materials' push constant ranges. A draw selects its object by the pushed index.
+    // The bindless texture table replaces the image resources set, so the textured materials don't differ in the bound sets.
+    auto const image_resources_descriptor_set = app.bindless_textures ? app.bindless_textures->descriptor_set() : app.image_resources_descriptor_set;
 
-        const auto min_offset_alignment = static_cast<std::size_t>(app.device->device_limits().min_storage_buffer_offset_alignment);
-        auto aligned_offset = boost::alignment::align_up(sizeof(per_object_t), min_offset_alignment);
+    // The image's slots of the view uniforms, the same for both the camera and the viewport ranges, and of the objects' buffer.
+    auto const view_uniforms_offset = app.view_uniforms->dynamic_offset(static_cast<std::uint32_t>(image_index));
+    auto const object_buffer_offset = app.object_buffer->dynamic_offset(static_cast<std::uint32_t>(image_index));
 
-        for (auto &&range : indexed) {
-            vkCmdBindIndexBuffer(command_buffer, range.index_buffer_handle, range.index_buffer_offset, convert_to::vulkan(range.index_type));
+    std::array<std::uint32_t, 3> const dynamic_offsets{view_uniforms_offset, view_uniforms_offset, object_buffer_offset};
+
+    auto const bind_draw_resources = [&] (auto &&dc)
+    {
+        if (auto const pipeline = dc.pipeline->handle(); pipeline != bound_pipeline) {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
-            for (auto &&subrange : range.vertex_buffers_bind_ranges) {
-                vkCmdBindVertexBuffers(command_buffer, subrange.first_binding, static_cast<std::uint32_t>(std::size(subrange.buffer_handles)),
-                                       std::data(subrange.buffer_handles), std::data(subrange.buffer_offsets));
+            bound_pipeline = pipeline;
+        }
 
-                std::visit([&] (auto span)
-                {
-                    if constexpr (std::is_same_v<typename decltype(span)::value_type, render::indexed_draw_command>) {
-                        for (auto &&dc : span) {
-                            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline->handle());
+        if (dc.pipeline_layout != bound_pipeline_layout) {
+            std::array<VkDescriptorSet, 3> descriptor_sets{
+                app.view_resources_descriptor_set, dc.descriptor_set, image_resources_descriptor_set
+            };
 
-                            std::array<VkDescriptorSet, 3> descriptor_sets{
-                                app.view_resources_descriptor_set, dc.descriptor_set, app.image_resources_descriptor_set
-                            };
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline_layout,
+                                    0,
+                                    static_cast<std::uint32_t>(std::size(descriptor_sets)), std::data(descriptor_sets),
+                                    static_cast<std::uint32_t>(std::size(dynamic_offsets)), std::data(dynamic_offsets));
 
-                            std::array<std::uint32_t, 1> dynamic_offsets{
-                                dc.transform_index * static_cast<std::uint32_t>(aligned_offset)
-                            };
+            bound_pipeline_layout = dc.pipeline_layout;
+            bound_object_descriptor_set = dc.descriptor_set;
+        }
 
-                            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline_layout,
-                                                    0,
-                                                    static_cast<std::uint32_t>(std::size(descriptor_sets)), std::data(descriptor_sets),
-                                                    static_cast<std::uint32_t>(std::size(dynamic_offsets)), std::data(dynamic_offsets));
+        else if (dc.descriptor_set != bound_object_descriptor_set) {
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline_layout,
+                                    1,
+                                    1, &dc.descriptor_set,
+                                    1, &object_buffer_offset);
 
-                            vkCmdDrawIndexed(command_buffer, dc.index_count, 1, dc.first_index, static_cast<std::int32_t>(dc.first_vertex), 0);
-                        }
-                    }
-                }, subrange.draw_commands);
-            }
+            bound_object_descriptor_set = dc.descriptor_set;
         }
 
-        for (auto &&range : non_indexed) {
-            vkCmdBindVertexBuffers(command_buffer, range.first_binding, static_cast<std::uint32_t>(std::size(range.buffer_handles)),
-                                   std::data(range.buffer_handles), std::data(range.buffer_offsets));
+        per_draw_t const per_draw{dc.transform_index};
 
-            std::visit([&] (auto span)
-            {
-                for (auto &&dc : span) {
-                    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline->handle());
+        for (auto &&range : dc.material->push_constant_ranges) {
+            vkCmdPushConstants(command_buffer, dc.pipeline_layout, static_cast<VkShaderStageFlags>(convert_to::vulkan(range.shader_stages)),
+                               range.offset, range.size, reinterpret_cast<std::byte const *>(&per_draw) + range.offset);
+        }
+    };
 
-                    std::array<VkDescriptorSet, 3> descriptor_sets{
-                        app.view_resources_descriptor_set, dc.descriptor_set, app.image_resources_descriptor_set
-                    };
+    for (auto &&range : indexed) {
+        if (gpu_profiler)
+            gpu_profiler->begin_scope(command_buffer, image_index, "indexed draws"sv);
 
-                    std::array<std::uint32_t, 1> dynamic_offsets{
-                        dc.transform_index *static_cast<std::uint32_t>(aligned_offset)
-                    };
+        vkCmdBindIndexBuffer(command_buffer, range.index_buffer_handle, range.index_buffer_offset, convert_to::vulkan(range.index_type));
 
-                    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline_layout,
-                                            0,
-                                            static_cast<std::uint32_t>(std::size(descriptor_sets)), std::data(descriptor_sets),
-                                            static_cast<std::uint32_t>(std::size(dynamic_offsets)), std::data(dynamic_offsets));
+        for (auto &&subrange : range.vertex_buffers_bind_ranges) {
+            vkCmdBindVertexBuffers(command_buffer, subrange.first_binding, static_cast<std::uint32_t>(std::size(subrange.buffer_handles)),
+                                   std::data(subrange.buffer_handles), std::data(subrange.buffer_offsets));
+
+            std::visit([&] (auto span)
+            {
+                if constexpr (std::is_same_v<typename decltype(span)::value_type, render::indexed_draw_command>) {
+                    for (auto &&dc : span) {
+                        bind_draw_resources(dc);
 
-                    vkCmdDraw(command_buffer, dc.vertex_count, 1, dc.first_vertex, 0);
+                        vkCmdDrawIndexed(command_buffer, dc.index_count, 1, dc.first_index, static_cast<std::int32_t>(dc.first_vertex), 0);
+                    }
                 }
-            }, range.draw_commands);
+            }, subrange.draw_commands);
         }
 
-        vkCmdEndRenderPass(command_buffer);
+        if (gpu_profiler)
+            gpu_profiler->end_scope(command_buffer, image_index);
+    }
+
+    for (auto &&range : non_indexed) {
+        if (gpu_profiler)
+            gpu_profiler->begin_scope(command_buffer, image_index, "non-indexed draws"sv);
+
+        vkCmdBindVertexBuffers(command_buffer, range.first_binding, static_cast<std::uint32_t>(std::size(range.buffer_handles)),
+                               std::data(range.buffer_handles), std::data(range.buffer_offsets));
+
+        std::visit([&] (auto span)
+        {
+            for (auto &&dc : span) {
+                bind_draw_resources(dc);
+
+                vkCmdDraw(command_buffer, dc.vertex_count, 1, dc.first_vertex, 0);
+            }
+        }, range.draw_commands);
 
-        if (auto result = vkEndCommandBuffer(command_buffer); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to end command buffer: {0:#x}", result));
+        if (gpu_profiler)
+            gpu_profiler->end_scope(command_buffer, image_index);
     }
+
+    vkCmdEndRenderPass(command_buffer);
+}
+
+void record_graphics_command_buffer(app_t &app, std::size_t image_index)
+{
+    TRACE_FUNCTION();
+
+    auto command_buffer = app.command_buffers.at(image_index);
+
+    VkCommandBufferBeginInfo const begin_info{
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        nullptr,
+        0,
+        nullptr
+    };
+
+    if (auto result = vkBeginCommandBuffer(command_buffer, &begin_info); result != VK_SUCCESS)
+        throw vulkan::exception(fmt::format("failed to record command buffer: {0:#x}", result));
+
+    auto &&gpu_profiler = app.gpu_profiler;
+
+    if (gpu_profiler)
+        gpu_profiler->begin_recording(command_buffer, image_index);
+
+    app.render_flow->record(command_buffer, image_index, [&app, command_buffer, image_index, &gpu_profiler] (graphics::graph_pass const &pass)
+    {
+        if (gpu_profiler)
+            gpu_profiler->begin_scope(command_buffer, image_index, pass.name);
+
+        if (pass.name == "forward"sv)
+            record_forward_pass(app, command_buffer, image_index);
+
+        if (gpu_profiler)
+            gpu_profiler->end_scope(command_buffer, image_index);
+    });
+
+    if (auto result = vkEndCommandBuffer(command_buffer); result != VK_SUCCESS)
+        throw vulkan::exception(fmt::format("failed to end command buffer: {0:#x}", result));
 }
 
 void create_frame_data(app_t &app)
@@ -346,66 +367,197 @@ void create_frame_data(app_t &app)
     auto &&device = *app.device;
     auto &&platform_surface = app.platform_surface;
     auto &&resource_manager = *app.resource_manager;
-    
-    auto swapchain = create_swapchain(device, platform_surface, render::extent{ static_cast<std::uint32_t>(app.width), static_cast<std::uint32_t>(app.height)});
 
-    if (swapchain == nullptr)
-        throw graphics::exception("failed to create the swapchain"s);
+    render::extent const extent{static_cast<std::uint32_t>(app.width), static_cast<std::uint32_t>(app.height)};
+
+    std::optional<render::surface_format> previous_surface_format;
+
+    if (app.swapchain || app.offscreen_target)
+        previous_surface_format = app.swapchain ? app.swapchain->surface_format() : app.offscreen_target->surface_format();
+
+    std::unique_ptr<render::swapchain> swapchain;
+    std::unique_ptr<render::offscreen_target> offscreen_target;
+
+    if (app.headless()) {
+        offscreen_target = create_offscreen_target(device, resource_manager, extent, app.presentation_config.frames_in_flight);
+
+        if (offscreen_target == nullptr)
+            throw graphics::exception("failed to create the offscreen target"s);
+    }
+
+    else {
+        swapchain = create_swapchain(device, platform_surface, extent, app.presentation_config, app.swapchain.get());
+
+        if (swapchain == nullptr)
+            throw graphics::exception("failed to create the swapchain"s);
+    }
+
+    auto const surface_format = swapchain ? swapchain->surface_format() : offscreen_target->surface_format();
+    auto const target_extent = swapchain ? swapchain->extent() : offscreen_target->extent();
+    auto &&target_images = swapchain ? swapchain->images() : offscreen_target->images();
+    auto &&target_views = swapchain ? swapchain->image_views() : offscreen_target->image_views();
 
-    const auto attachment_descriptions = create_attachment_descriptions(device, app.renderer_config, *swapchain);
+    const auto attachment_descriptions = create_attachment_descriptions(device, app.renderer_config, surface_format);
 
     if (attachment_descriptions.empty())
         throw graphics::exception("failed to create the attachment descriptions"s);
 
-    auto attachments = create_attachments(resource_manager, attachment_descriptions, swapchain->extent());
+    graphics::render_graph render_graph;
+
+    auto &&color_description = attachment_descriptions.at(0);
+    auto &&depth_description = attachment_descriptions.at(1);
+
+    auto const color = render_graph.create_image("color"s, {color_description.format, target_extent, color_description.samples_count});
+    auto const depth = render_graph.create_image("depth"s, {depth_description.format, target_extent, depth_description.samples_count});
+
+    // Swapchain images become available in the color attachment output stage; offscreen images are left ready to be copied from.
+    auto const target = render_graph.import_image(
+        "render target"s, {surface_format.format, target_extent, 1},
+        graphics::resource_state{graphics::IMAGE_LAYOUT::UNDEFINED, graphics::PIPELINE_STAGE::COLOR_ATTACHMENT_OUTPUT, graphics::MEMORY_ACCESS_TYPE{}},
+        swapchain ? graphics::RESOURCE_USAGE::PRESENT : graphics::RESOURCE_USAGE::TRANSFER_SOURCE
+    );
+
+    // The attachments are cleared and the render target is entirely resolved into.
+    render_graph.add_pass("forward"s, {
+        {color, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true},
+        {depth, graphics::RESOURCE_USAGE::DEPTH_STENCIL_ATTACHMENT, true},
+        {target, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}
+    });
+
+    auto render_flow = app.render_graph_manager->create_render_flow(std::move(render_graph), {{target, target_images}});
+
+    if (render_flow == nullptr)
+        throw graphics::exception("failed to create the render flow"s);
+
+    auto attachments = create_attachments(resource_manager, *render_flow, {color, depth});
 
     if (attachments.empty())
         throw graphics::exception("failed to create the attachments"s);
 
-    auto render_pass = create_render_pass(*app.render_pass_manager, swapchain->surface_format(), attachment_descriptions);
+    // Nothing of the render pass depends on the extent, so it's kept, and so are the pipelines created with it,
+    // unless the surface format has changed.
+    auto render_pass = app.render_pass;
+
+    if (render_pass == nullptr || previous_surface_format != surface_format)
+        render_pass = create_render_pass(*app.render_pass_manager, surface_format, attachment_descriptions);
 
     if (render_pass == nullptr)
         throw graphics::exception("failed to create the render pass"s);
 
-    auto framebuffers = create_framebuffers(resource_manager, *swapchain, render_pass, attachments);
+    auto framebuffers = create_framebuffers(resource_manager, target_extent, target_views, render_pass, attachments);
 
     if (framebuffers.empty())
         throw graphics::exception("failed to create the framebuffers"s);
 
+    // The frames in flight keep using the current frame data, so it's retired instead of waiting for the device to get idle.
+    if (app.swapchain || app.offscreen_target) {
+        app.retired_frames_data.push_back(retired_frame_data{
+            app.device->graphics_queue.timeline().last_value(),
+            std::move(app.swapchain), std::move(app.offscreen_target),
+            std::move(app.render_flow),
+            std::move(app.attachments), std::move(app.framebuffers),
+            std::move(app.command_buffers)
+        });
+
+        app.command_buffers.clear();
+    }
+
     app.swapchain = std::move(swapchain);
+    app.offscreen_target = std::move(offscreen_target);
+    app.render_flow = std::move(render_flow);
     app.attachments = std::move(attachments);
     app.render_pass = std::move(render_pass);
     app.framebuffers = std::move(framebuffers);
 }
 
+static void free_command_buffers(app_t &app, std::vector<VkCommandBuffer> &command_buffers)
+{
+    if (app.graphics_command_pool && !command_buffers.empty())
+        vkFreeCommandBuffers(app.device->handle(), app.graphics_command_pool, static_cast<std::uint32_t>(std::size(command_buffers)), std::data(command_buffers));
+
+    command_buffers.clear();
+}
+
+// Timeline values complete in order, so the submissions up to the completed one don't use the retired data anymore.
+static void release_retired_frame_data(app_t &app)
+{
+    if (app.retired_frames_data.empty())
+        return;
+
+    auto const completed_value = app.device->graphics_queue.timeline().completed_value();
+
+    std::erase_if(app.retired_frames_data, [&app, completed_value] (auto &&retired_data)
+    {
+        if (retired_data.timeline_value > completed_value)
+            return false;
+
+        free_command_buffers(app, retired_data.command_buffers);
+
+        return true;
+    });
+}
+
 void cleanup_frame_data(app_t &app)
 {
-    auto &&device = *app.device;
+    auto &&timeline = app.device->graphics_queue.timeline();
+
+    timeline.wait(timeline.last_value());
 
-    if (app.graphics_command_pool)
-        vkFreeCommandBuffers(device.handle(), app.graphics_command_pool, static_cast<std::uint32_t>(std::size(app.command_buffers)), std::data(app.command_buffers));
+    release_retired_frame_data(app);
 
-    app.command_buffers.clear();
+    free_command_buffers(app, app.command_buffers);
 
     app.framebuffers.clear();
     app.attachments.clear();
+    app.render_flow.reset();
 
     app.swapchain.reset();
+    app.offscreen_target.reset();
+}
+
+// Creates the view uniforms and the objects' buffer with a slot per render target image, if the current ones have fewer slots.
+void create_per_frame_buffers(app_t &app)
+{
+    auto const slots_number = static_cast<std::uint32_t>(std::size(app.render_target_views()));
+
+    if (app.view_uniforms && app.view_uniforms->slots_number() >= slots_number)
+        return;
+
+    auto const had_buffers = app.view_uniforms != nullptr;
+
+    if (had_buffers) {
+        auto &&timeline = app.device->graphics_queue.timeline();
+
+        // The descriptor sets are rewritten while the previous frames might still read the old buffers through them.
+        timeline.wait(timeline.last_value());
+    }
+
+    auto const view_ranges_sizes = std::array<std::size_t, 2>{sizeof(camera::data_t), sizeof(per_viewport_t)};
+
+    app.view_uniforms = std::make_unique<render::uniform_ring_buffer>(*app.device, *app.resource_manager, view_ranges_sizes, slots_number);
+
+    auto const objects_ranges_sizes = std::array<std::size_t, 1>{sizeof(per_object_t) * std::max(std::size(app.xmodel.scene_nodes), std::size_t{1})};
+
+    app.object_buffer = std::make_unique<render::uniform_ring_buffer>(*app.device, *app.resource_manager, objects_ranges_sizes, slots_number,
+                                                                      graphics::BUFFER_USAGE::STORAGE_BUFFER);
+
+    if (had_buffers)
+        update_descriptor_set(app);
 }
 
 void recreate_swap_chain(app_t &app)
 {
+    TRACE_FUNCTION();
+
     if (app.width < 1 || app.height < 1)
         return;
 
-    vkDeviceWaitIdle(app.device->handle());
-
-    cleanup_frame_data(app);
     create_frame_data(app);
 
-#if !USE_DYNAMIC_PIPELINE_STATE
-    CreateGraphicsPipelines(app);
-#endif
+    // The new images haven't been rendered into yet; the previous ones are waited for through the concurrently processed frames.
+    app.busy_images_timeline_values.assign(std::size(app.render_target_views()), 0);
+
+    create_per_frame_buffers(app);
 
     create_graphics_command_buffers(app);
 }
@@ -461,7 +613,8 @@ void build_render_pipelines(app_t &app, xformat const &model_)
 
             fmt::print("{}.{}.{}\n", name, technique_index, vertex_layout_name);
 
-            auto material = material_factory.material(name, technique_index, vertex_layout, primitive_topology);
+            auto material = material_factory.material(material_factory.material_id(name), technique_index, vertex_layout,
+                                                      vertex_buffer->vertex_layout_hash(), primitive_topology);
 
             if (material == nullptr)
                 throw graphics::exception("failed to create material"s);
@@ -478,14 +631,24 @@ void build_render_pipelines(app_t &app, xformat const &model_)
                 color_blend_state
             };
 
-            auto pipeline = pipeline_factory.create_pipeline(material, pipeline_states, app.pipeline_layout, app.render_pass, 0u);
+            for (auto &&range : material->push_constant_ranges)
+                if (range.offset + range.size > sizeof(per_draw_t))
+                    throw graphics::exception("material push constant range is out of the per-draw data"s);
+
+            auto pipeline_layout = app.descriptor_registry->create_pipeline_layout(app.pipeline_layout->descriptor_set_layouts(),
+                                                                                   material->push_constant_ranges);
+
+            if (std::ranges::find(app.material_pipeline_layouts, pipeline_layout) == std::end(app.material_pipeline_layouts))
+                app.material_pipeline_layouts.push_back(pipeline_layout);
+
+            auto pipeline = pipeline_factory.create_pipeline(material, pipeline_states, *pipeline_layout, app.render_pass, 0u);
 
             auto vertex_input_binding_index = app.vertex_input_state_manager->binding_index(vertex_buffer->vertex_layout());
 
             if (index_buffer) {
                 app.draw_commands_holder.add_draw_command(
                            render::indexed_draw_command{
-                        pipeline, material, app.pipeline_layout, app.object_resources_descriptor_set, app.render_pass,
+                        pipeline, material, pipeline_layout->handle(), app.object_resources_descriptor_set, app.render_pass,
                         vertex_buffer, index_buffer, vertex_input_binding_index,
                         meshlet.first_vertex, meshlet.vertex_count, meshlet.first_index, meshlet.index_count,
                         static_cast<std::uint32_t>(transform_index)
@@ -496,7 +659,7 @@ void build_render_pipelines(app_t &app, xformat const &model_)
             else {
                 app.draw_commands_holder.add_draw_command(
                            render::nonindexed_draw_command{
-                        pipeline, material, app.pipeline_layout, app.object_resources_descriptor_set, app.render_pass,
+                        pipeline, material, pipeline_layout->handle(), app.object_resources_descriptor_set, app.render_pass,
                         vertex_buffer, vertex_input_binding_index, meshlet.first_vertex, meshlet.vertex_count,
                         static_cast<std::uint32_t>(transform_index)
                     }
@@ -510,6 +673,14 @@ void create_sync_objects(app_t &app)
 {
     auto &&resource_manager = *app.resource_manager;
 
+    auto const frames_in_flight = app.presentation_config.frames_in_flight;
+
+    app.image_available_semaphores.resize(frames_in_flight);
+    app.render_finished_semaphores.resize(frames_in_flight);
+
+    // Zero is the timeline's initial value, so the frames that haven't been submitted yet are never waited for.
+    app.frame_timeline_values.assign(frames_in_flight, 0);
+
     std::ranges::generate(app.image_available_semaphores, [&resource_manager] ()
     {
         if (auto semaphore = resource_manager.create_semaphore(); semaphore)
@@ -526,37 +697,37 @@ void create_sync_objects(app_t &app)
         throw resource::exception("failed to create render semaphore"s);
     });
 
-    std::ranges::generate(app.concurrent_frames_fences, [&resource_manager] ()
-    {
-        if (auto fence = resource_manager.create_fence(true); fence)
-            return fence;
-
-        throw resource::exception("failed to create frame fence"s);
-    });
-
-    app.busy_frames_fences.resize(std::size(app.swapchain->image_views()), nullptr);
+    app.busy_images_timeline_values.assign(std::size(app.render_target_views()), 0);
 }
 
-void update_viewport_descriptor_buffer(app_t const &app)
+// Computes the objects' data as seen by the state's camera; it only reads the application's scene.
+static void simulate_frame(app_t const &app, frame_state &state)
 {
-    auto &&device = *app.device;
-    auto &&buffer = *app.per_viewport_buffer;
+    TRACE_FUNCTION();
 
-    auto const offset = buffer.memory()->offset();
-    auto const size = buffer.memory()->size();
+    // Big enough chunks to amortize the scheduling, yet small enough to balance the load between the workers.
+    auto constexpr objects_grain_size = std::size_t{256};
 
-    void *data = nullptr;
+    app.job_system->parallel_for(0, std::size(state.objects), objects_grain_size, [&app, &state] (std::size_t begin, std::size_t end)
+    {
+        auto &&xmodel = app.xmodel;
 
-    if (auto result = vkMapMemory(device.handle(), buffer.memory()->handle(), offset, size, 0, &data); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to map per viewpor uniform buffer memory: {0:#x}", result));
+        for (auto index = begin; index < end; ++index) {
+            auto &&transform = xmodel.transforms.at(xmodel.scene_nodes[index].transform_index);
 
-    std::copy_n(&app.per_viewport_data, 1, static_cast<per_viewport_t *>(data));
+            auto normal = glm::inverseTranspose(state.camera.view * transform);
 
-    vkUnmapMemory(device.handle(), buffer.memory()->handle());
+            state.objects[index] = per_object_t{transform, normal, app.texture_index};
+        }
+    });
 }
 
-static void update(app_t &app)
+void update(app_t &app)
 {
+    TRACE_FUNCTION();
+
+    app.job_system->execute_main_thread_jobs();
+
     if (app.resize_callback) {
         app.resize_callback();
         app.resize_callback = nullptr;
@@ -565,63 +736,154 @@ static void update(app_t &app)
     app.camera_controller->update();
     app.cameraSystem.update();
 
-    {
-        auto &&device = *app.device;
-        auto &&buffer = *app.per_camera_buffer;
+    auto &&state = simulated_frame_state(app);
+
+    state.camera = app.camera_->data;
+    state.viewport = app.per_viewport_data;
 
-        auto const offset = buffer.memory()->offset();
-        auto const size = buffer.memory()->size();
+    if (app.features_config.pipelined_frames)
+        app.job_system->submit([&app, &state] { simulate_frame(app, state); }, &app.simulation_counter);
+
+    else simulate_frame(app, state);
+}
 
-        void *data = nullptr;
+void complete_frame_simulation(app_t &app)
+{
+    TRACE_FUNCTION();
 
-        if (auto result = vkMapMemory(device.handle(), buffer.memory()->handle(), offset, size, 0, &data); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to map per camera uniform buffer memory: {0:#x}", result));
+    app.job_system->wait(app.simulation_counter);
 
-        std::copy_n(&app.camera_->data, 1, static_cast<camera::data_t *>(data));
+    app.simulated_frame_state_index = (app.simulated_frame_state_index + 1) % std::size(app.frame_states);
+}
 
-        vkUnmapMemory(device.handle(), buffer.memory()->handle());
+void prepare_frame_pipeline(app_t &app)
+{
+    if (app.features_config.pipelined_frames) {
+        update(app);
+        complete_frame_simulation(app);
     }
+}
 
-    std::ranges::transform(app.xmodel.scene_nodes, std::begin(app.objects), [&xmodel = app.xmodel, &camera = app.camera_] (auto &&scene_node)
-    {
-        auto &&transform = xmodel.transforms.at(scene_node.transform_index);
+frame_state &simulated_frame_state(app_t &app)
+{
+    return app.frame_states.at(app.simulated_frame_state_index);
+}
 
-        auto normal = glm::inverseTranspose(camera->data.view * transform);
+frame_state const &submitted_frame_state(app_t const &app)
+{
+    return app.frame_states.at((app.simulated_frame_state_index + 1) % std::size(app.frame_states));
+}
 
-        return per_object_t{transform, normal};
-    });
+// Writes the submitted frame state into the image's slots of the view uniforms and the objects' buffer and flushes them at once.
+static void write_frame_data(app_t &app, std::uint32_t image_index)
+{
+    auto &&state = submitted_frame_state(app);
+    auto &&view_uniforms = *app.view_uniforms;
+    auto &&object_buffer = *app.object_buffer;
 
-    using objects_type = typename decltype(app.objects)::value_type;
-    auto it_begin = static_cast<objects_type *>(app.ssbo_mapped_ptr);
+    // The slots are read by the image's previous submission, which is usually complete by the time the image has been acquired;
+    // the command buffers retired by a resize might still read them though.
+    auto const slots_timeline_value = std::max(view_uniforms.slot_timeline_value(image_index), object_buffer.slot_timeline_value(image_index));
 
-    std::size_t const stride = app.aligned_buffer_size / std::size(app.objects);
+    app.device->graphics_queue.timeline().wait(slots_timeline_value);
 
-#if defined(_MSC_VER) && !defined(__clang__)
-    std::copy(std::execution::par, std::cbegin(app.objects), std::cend(app.objects), strided_bidirectional_iterator{it_begin, stride});
-#elif defined(__clang__)
-    std::copy(std::cbegin(app.objects), std::cend(app.objects), strided_bidirectional_iterator<objects_type>{it_begin, stride});
-#else
-    // std::ranges::copy(app.objects, strided_bidirectional_iterator<objects_type>{it_begin, stride}); :TODO:
-    std::copy(std::cbegin(app.objects), std::cend(app.objects), strided_bidirectional_iterator<objects_type>{it_begin, stride});
-#endif
+    view_uniforms.write(image_index, kCAMERA_UNIFORMS_RANGE, state.camera);
+    view_uniforms.write(image_index, kVIEWPORT_UNIFORMS_RANGE, state.viewport);
 
-    auto const mapped_ranges = std::array{
-        VkMappedMemoryRange{
-            VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-            nullptr,
-            app.per_object_buffer->memory()->handle(),
-            app.per_object_buffer->memory()->offset(),
-            app.aligned_buffer_size
-        }
+    // The objects are tightly packed in the slot.
+    object_buffer.write(image_index, kOBJECTS_RANGE, std::span<per_object_t const>{state.objects});
+
+    std::vector<VkMappedMemoryRange> mapped_ranges;
+
+    for (auto &&buffer : {&view_uniforms, &object_buffer}) {
+        if (auto mapped_range = buffer->flush_range(image_index); mapped_range)
+            mapped_ranges.push_back(*mapped_range);
+    }
+
+    if (mapped_ranges.empty())
+        return;
+
+    auto const mapped_ranges_number = static_cast<std::uint32_t>(std::size(mapped_ranges));
+
+    if (auto result = vkFlushMappedMemoryRanges(app.device->handle(), mapped_ranges_number, std::data(mapped_ranges)); result != VK_SUCCESS)
+        throw vulkan::exception(fmt::format("failed to flush frame data: {0:#x}", result));
+}
+
+// Submits the frame's command buffer signaling the graphics queue timeline along with the binary semaphores, if any.
+static void submit_frame(app_t &app, std::size_t image_index,
+                         std::span<VkSemaphore const> wait_semaphores, std::span<VkPipelineStageFlags const> wait_stages,
+                         std::span<VkSemaphore const> binary_signal_semaphores)
+{
+    auto &&device = *app.device;
+    auto &&timeline = device.graphics_queue.timeline();
+
+    std::vector<VkSemaphore> signal_semaphores{std::cbegin(binary_signal_semaphores), std::cend(binary_signal_semaphores)};
+    signal_semaphores.push_back(timeline.handle());
+
+    auto const timeline_value = timeline.next_value();
+
+    // Values of the binary semaphores are ignored.
+    std::vector<std::uint64_t> const wait_values(std::size(wait_semaphores), 0);
+    std::vector<std::uint64_t> signal_values(std::size(signal_semaphores), 0);
+    signal_values.back() = timeline_value;
+
+    VkTimelineSemaphoreSubmitInfo const timeline_info{
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        nullptr,
+        static_cast<std::uint32_t>(std::size(wait_values)), std::data(wait_values),
+        static_cast<std::uint32_t>(std::size(signal_values)), std::data(signal_values)
+    };
+
+    VkSubmitInfo const submit_info{
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        &timeline_info,
+        static_cast<std::uint32_t>(std::size(wait_semaphores)), std::data(wait_semaphores),
+        std::data(wait_stages),
+        1, &app.command_buffers.at(image_index),
+        static_cast<std::uint32_t>(std::size(signal_semaphores)), std::data(signal_semaphores),
     };
 
-    vkFlushMappedMemoryRanges(app.device->handle(), static_cast<std::uint32_t>(std::size(mapped_ranges)), std::data(mapped_ranges));
+    write_frame_data(app, static_cast<std::uint32_t>(image_index));
+
+    if (app.gpu_profiler)
+        app.gpu_profiler->submit(image_index);
+
+    if (auto result = vkQueueSubmit(device.graphics_queue.handle(), 1, &submit_info, VK_NULL_HANDLE); result != VK_SUCCESS)
+        throw vulkan::exception(fmt::format("failed to submit draw command buffer: {0:#x}", result));
+
+    timeline.commit_value(timeline_value);
+
+    app.frame_timeline_values[app.current_frame_index] = timeline_value;
+    app.busy_images_timeline_values.at(image_index) = timeline_value;
+
+    app.view_uniforms->submit(static_cast<std::uint32_t>(image_index), timeline_value);
+    app.object_buffer->submit(static_cast<std::uint32_t>(image_index), timeline_value);
+
+    app.current_frame_index = (app.current_frame_index + 1) % std::size(app.frame_timeline_values);
+}
+
+// Waits until the current concurrently processed frame's previous submission completes.
+static void wait_current_frame(app_t &app)
+{
+    app.device->graphics_queue.timeline().wait(app.frame_timeline_values[app.current_frame_index]);
+
+    release_retired_frame_data(app);
+
+    app.resource_manager->deletion_queue().collect();
 }
 
 static void render_frame(app_t &app)
 {
-    if (app.width < 1 || app.height < 1)
+    TRACE_FUNCTION();
+
+    // The latency is counted from the input the submitted state has been simulated from.
+    auto &&submitted_state = submitted_frame_state(app);
+    app.frame_pacer.begin_frame(submitted_state.input_time, submitted_state.input_delay);
+
+    if (app.width < 1 || app.height < 1) {
+        app.frame_pacer.discard_frame();
         return;
+    }
 
     auto &&device = *app.device;
     auto &&swapchain = *app.swapchain;
@@ -629,16 +891,12 @@ static void render_frame(app_t &app)
     auto &&image_available_semaphore = app.image_available_semaphores[app.current_frame_index];
     auto &&render_finished_semaphore = app.render_finished_semaphores[app.current_frame_index];
 
-#define USE_FENCES 1
+    auto &&frame_pacer = app.frame_pacer;
 
-#if USE_FENCES
-    auto &&frame_fence = app.concurrent_frames_fences[app.current_frame_index];
+    // Both the timeline wait and the image acquisition block when the CPU is ahead of the GPU or the presentation engine.
+    auto wait_begin = render::frame_pacer::now();
 
-    if (auto result = vkWaitForFences(device.handle(), 1, frame_fence->handle_ptr(), VK_TRUE, std::numeric_limits<std::uint64_t>::max()); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to wait current frame fence: {0:#x}", result));
-#else
-    vkQueueWaitIdle(device.presentation_queue.handle());
-#endif
+    wait_current_frame(app);
 
     /*VkAcquireNextImageInfoKHR next_image_info{
         VK_STRUCTURE_TYPE_ACQUIRE_NEXT_IMAGE_INFO_KHR,
@@ -654,6 +912,8 @@ static void render_frame(app_t &app)
     switch (auto result = vkAcquireNextImageKHR(device.handle(), swapchain.handle(), std::numeric_limits<std::uint64_t>::max(),
             image_available_semaphore->handle(), VK_NULL_HANDLE, &image_index); result) {
         case VK_ERROR_OUT_OF_DATE_KHR:
+            // Nothing is presented, so the frame would only skew the pacing.
+            frame_pacer.discard_frame();
             recreate_swap_chain(app);
             return;
 
@@ -665,13 +925,14 @@ static void render_frame(app_t &app)
             throw vulkan::exception(fmt::format("failed to acquire next image index: {0:#x}", result));
     }
 
-#if USE_FENCES
-    if (auto &&fence = app.busy_frames_fences.at(image_index); fence && fence->handle() != VK_NULL_HANDLE)
-        if (auto result = vkWaitForFences(device.handle(), 1, fence->handle_ptr(), VK_TRUE, std::numeric_limits<std::uint64_t>::max()); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to wait busy frame fence: {0:#x}", result));
+    frame_pacer.add_gpu_wait(render::frame_pacer::now() - wait_begin);
 
-    app.busy_frames_fences.at(image_index) = frame_fence;
-#endif
+    // The image may be acquired before the frame that has last rendered into it completes.
+    wait_begin = render::frame_pacer::now();
+
+    device.graphics_queue.timeline().wait(app.busy_images_timeline_values.at(image_index));
+
+    frame_pacer.add_gpu_wait(render::frame_pacer::now() - wait_begin);
 
     auto const wait_semaphores = std::array{ image_available_semaphore->handle() };
     auto const signal_semaphores = std::array{ render_finished_semaphore->handle() };
@@ -680,25 +941,7 @@ static void render_frame(app_t &app)
         VkPipelineStageFlags{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT }
     };
 
-    VkSubmitInfo const submit_info{
-        VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        nullptr,
-        static_cast<std::uint32_t>(std::size(wait_semaphores)), std::data(wait_semaphores),
-        std::data(wait_stages),
-        1, &app.command_buffers.at(image_index),
-        static_cast<std::uint32_t>(std::size(signal_semaphores)), std::data(signal_semaphores),
-    };
-
-#if USE_FENCES
-    if (auto result = vkResetFences(device.handle(), 1, frame_fence->handle_ptr()); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to reset previous frame fence: {0:#x}", result));
-
-    if (auto result = vkQueueSubmit(device.graphics_queue.handle(), 1, &submit_info, frame_fence->handle()); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to submit draw command buffer: {0:#x}", result));
-#else
-    if (auto result = vkQueueSubmit(device.graphics_queue.handle(), 1, &submit_info, VK_NULL_HANDLE); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to submit draw command buffer: {0:#x}", result));
-#endif
+    submit_frame(app, image_index, wait_semaphores, wait_stages, signal_semaphores);
 
     auto swapchain_handle = swapchain.handle();
 
@@ -710,25 +953,190 @@ static void render_frame(app_t &app)
         &image_index, nullptr
     };
 
-    switch (auto result = vkQueuePresentKHR(device.presentation_queue.handle(), &present_info); result) {
+    auto const present_result = vkQueuePresentKHR(device.presentation_queue.handle(), &present_info);
+
+    frame_pacer.end_frame(render::frame_pacer::now());
+
+    // The frame has been submitted regardless, so the next one is started after the swapchain is recreated.
+    switch (present_result) {
         case VK_ERROR_OUT_OF_DATE_KHR:
         case VK_SUBOPTIMAL_KHR:
             recreate_swap_chain(app);
-            return;
+            break;
 
         case VK_SUCCESS:
             break;
 
         default:
-            throw vulkan::exception(fmt::format("failed to submit request to present framebuffer: {0:#x}", result));
+            throw vulkan::exception(fmt::format("failed to submit request to present framebuffer: {0:#x}", present_result));
     }
 
-#if USE_FENCES
-    app.current_frame_index = (app.current_frame_index + 1) % render::kCONCURRENTLY_PROCESSED_FRAMES;
-#endif
+    TRACE_FRAME_MARK();
+}
+
+std::size_t wait_offscreen_frame(app_t &app)
+{
+    TRACE_FUNCTION();
+
+    wait_current_frame(app);
+
+    // Offscreen images are allocated per concurrently processed frame, so a frame always renders into its own image.
+    return app.current_frame_index;
+}
+
+void submit_offscreen_frame(app_t &app, std::size_t image_index)
+{
+    TRACE_FUNCTION();
+
+    submit_frame(app, image_index, {}, {}, {});
+
+    TRACE_FRAME_MARK();
 }
 
-int main()
+static void render_offscreen_frame(app_t &app)
+{
+    auto const image_index = wait_offscreen_frame(app);
+
+    submit_offscreen_frame(app, image_index);
+}
+
+// Saves the offscreen image as a binary PPM file dropping the alpha channel.
+static void capture_offscreen_frame(app_t &app, std::size_t image_index, std::string const &path)
+{
+    auto &&timeline = app.device->graphics_queue.timeline();
+
+    timeline.wait(timeline.last_value());
+
+    auto const texels = app.offscreen_target->read_back(image_index, app.graphics_command_pool);
+    auto const [width, height] = app.offscreen_target->extent();
+
+    auto const texel_size = graphics::size_bytes(app.offscreen_target->surface_format().format);
+
+    std::ofstream file{path, std::ios::out | std::ios::binary | std::ios::trunc};
+
+    if (!file.is_open())
+        throw resource::exception(fmt::format("failed to open capture file: {}", path));
+
+    file << fmt::format("P6\n{} {}\n255\n", width, height);
+
+    for (std::size_t offset = 0; offset < std::size(texels); offset += texel_size)
+        file.write(reinterpret_cast<char const *>(&texels[offset]), 3);
+}
+
+void create_camera(app_t &app, platform::input_manager &input_manager)
+{
+    app.camera_ = app.cameraSystem.create_camera();
+    app.camera_->aspect = static_cast<float>(app.width) / static_cast<float>(app.height);
+
+    app.camera_controller = std::make_unique<orbit_controller>(app.camera_, input_manager);
+    app.camera_controller->look_at(glm::vec3{2, 2, 2}, {0, 0, 0});
+}
+
+static void save_gpu_trace(app_t &app, std::string const &path)
+{
+    auto &&timeline = app.device->graphics_queue.timeline();
+
+    timeline.wait(timeline.last_value());
+
+    app.gpu_profiler->flush();
+
+    std::ofstream file{path, std::ios::out | std::ios::trunc};
+
+    if (!file.is_open())
+        throw resource::exception(fmt::format("failed to open GPU trace file: {}", path));
+
+    app.gpu_profiler->save_chrome_trace(file);
+}
+
+static void save_cpu_trace(std::string const &path)
+{
+    std::ofstream file{path, std::ios::out | std::ios::trunc};
+
+    if (!file.is_open())
+        throw resource::exception(fmt::format("failed to open CPU trace file: {}", path));
+
+    trace::save_chrome_trace(file);
+}
+
+static graphics::PRESENTATION_MODE parse_presentation_mode(std::string_view name)
+{
+    if (name == "fifo"sv)
+        return graphics::PRESENTATION_MODE::FIFO;
+
+    if (name == "fifo-relaxed"sv)
+        return graphics::PRESENTATION_MODE::FIFO_RELAXED;
+
+    if (name == "mailbox"sv)
+        return graphics::PRESENTATION_MODE::MAILBOX;
+
+    if (name == "immediate"sv)
+        return graphics::PRESENTATION_MODE::IMMEDIATE;
+
+    throw graphics::exception(fmt::format("unknown presentation mode: {}", name));
+}
+
+static void print_frame_timing_statistics(render::frame_timing_statistics const &statistics)
+{
+    auto constexpr ms = 1e-6;
+
+    fmt::print("frames: {}, frame interval: {:.2f} ms (max {:.2f} ms), input-to-present latency: {:.2f} ms (max {:.2f} ms), "
+               "GPU wait: {:.2f} ms, input delay: {:.2f} ms\n",
+               statistics.frames_number, statistics.frame_interval * ms, statistics.max_frame_interval * ms,
+               statistics.latency * ms, statistics.max_latency * ms, statistics.gpu_wait * ms, statistics.delay * ms);
+}
+
+// Runs a frame through both the stages; a pipelined frame submits the previously simulated state while the next one
+// is simulated.
+template<class F> requires std::invocable<F &, app_t &>
+static void run_frame(app_t &app, F &&render)
+{
+    update(app);
+
+    if (app.features_config.pipelined_frames) {
+        render(app);
+        complete_frame_simulation(app);
+    }
+
+    else {
+        complete_frame_simulation(app);
+        render(app);
+    }
+}
+
+static void run_headless(render::extent extent, std::size_t frames_number, std::optional<std::string> const &capture_path,
+                         std::optional<std::string> const &gpu_trace_path, bool pipeline_statistics,
+                         render::presentation_config const &presentation_config, render::features_config const &features_config,
+                         std::uint32_t workers_number)
+{
+    // Isn't connected to any window; the camera stays where it has been put.
+    const auto input_manager = std::make_shared<platform::input_manager>();
+
+    auto app_ptr = std::make_shared<app_t>(extent, std::nullopt, presentation_config, features_config, workers_number);
+
+    create_camera(*app_ptr, *input_manager);
+
+    if (gpu_trace_path)
+        app_ptr->enable_gpu_profiler(pipeline_statistics);
+
+    prepare_frame_pipeline(*app_ptr);
+
+    for (std::size_t frame_index = 0; frame_index < frames_number; ++frame_index)
+        run_frame(*app_ptr, render_offscreen_frame);
+
+    if (capture_path && frames_number > 0) {
+        auto const frames_in_flight = std::size(app_ptr->frame_timeline_values);
+        auto const last_image_index = (app_ptr->current_frame_index + frames_in_flight - 1) % frames_in_flight;
+
+        capture_offscreen_frame(*app_ptr, last_image_index, *capture_path);
+    }
+
+    if (gpu_trace_path)
+        save_gpu_trace(*app_ptr, *gpu_trace_path);
+
+    app_ptr->clean_up();
+}
+
+int main(int argc, char **argv)
 {
 #if defined(_MSC_VER)
     #if defined(_DEBUG) || defined(DEBUG)
@@ -744,35 +1152,231 @@ int main()
     #endif
 #endif
 
+    namespace po = boost::program_options;
+
+    po::options_description description{"Engine options"s};
+
+    description.add_options()
+        ("help,h", "print this message")
+        ("width", po::value<std::uint32_t>()->default_value(1920), "width of the window or the offscreen target")
+        ("height", po::value<std::uint32_t>()->default_value(1080), "height of the window or the offscreen target")
+        ("headless", "render into offscreen images without a window and a swapchain")
+        ("frames", po::value<std::size_t>()->default_value(1), "number of frames to render in the headless and benchmark modes")
+        ("capture", po::value<std::string>(), "path to save the last headless frame to as a PPM image")
+        ("gpu-trace", po::value<std::string>(), "path to save GPU timings of the render pass and draw batches to as a Chrome trace")
+        ("cpu-trace", po::value<std::string>(), "path to save CPU trace zones and counters to as a Chrome trace (requires USE_TRACING build)")
+        ("pipeline-statistics", "add pipeline statistics to the GPU trace if the device supports them")
+        ("benchmark", po::value<std::string>(), "render a synthetic scene headlessly and save frame timings to the JSON file")
+        ("jobs-benchmark", po::value<std::string>(), "update the synthetic objects' transforms on the CPU with growing numbers of workers and save the timings to the JSON file")
+        ("grain-size", po::value<std::size_t>()->default_value(256), "number of the objects updated by a single job in the jobs benchmark")
+        ("primitives-benchmark", po::value<std::string>(), "generate the primitives for the synthetic scene vertex layouts on the CPU and save the timings and output checksums to the JSON file")
+        ("segments", po::value<std::uint32_t>()->default_value(64), "tessellation of the primitives in the primitives benchmark")
+        ("subdivisions", po::value<std::uint32_t>()->default_value(8), "highest subdivision level of the icospheres in the primitives benchmark")
+        ("warmup-frames", po::value<std::size_t>()->default_value(16), "number of benchmark frames rendered before the measurements")
+        ("objects", po::value<std::size_t>()->default_value(64), "number of the benchmark scene objects")
+        ("materials", po::value<std::size_t>()->default_value(1), "number of the benchmark scene materials")
+        ("vertex-layouts", po::value<std::size_t>()->default_value(1), "number of the benchmark scene vertex layouts")
+        ("seed", po::value<std::uint32_t>()->default_value(0), "seed of the benchmark scene generator")
+        ("resize-interval", po::value<std::size_t>()->default_value(0), "number of benchmark frames between simulated extent changes (0 disables them)")
+        ("churn-resources", po::value<std::size_t>()->default_value(0), "number of buffers and images created and released every benchmark frame")
+        ("churn-descriptor-sets", po::value<std::size_t>()->default_value(0), "number of descriptor sets allocated and reset every benchmark frame")
+        ("descriptor-updates", po::value<std::size_t>()->default_value(0), "number of descriptor sets updates done every benchmark frame by each update path")
+        ("draw-selections", po::value<std::size_t>()->default_value(0), "number of draws selected every benchmark frame by push constants and by descriptor set rebinds")
+        ("present-mode", po::value<std::string>()->default_value("mailbox"s), "presentation mode: fifo, fifo-relaxed, mailbox or immediate (falls back to fifo)")
+        ("frames-in-flight", po::value<std::uint32_t>()->default_value(render::kCONCURRENTLY_PROCESSED_FRAMES), "number of frames the CPU may record ahead of the GPU")
+        ("swapchain-images", po::value<std::uint32_t>()->default_value(0), "number of the swapchain images (0 picks one more than the surface minimum)")
+        ("bindless", "sample textures through a global descriptor indexing array if the device supports it")
+        ("pipelined", "simulate the next frame on the job system while the current one is submitted")
+        ("workers", po::value<std::uint32_t>()->default_value(jobs::job_system::default_workers_number()), "number of the job system worker threads besides the main one")
+        ("fps-limit", po::value<double>(), "upper limit of the frame rate")
+        ("target-latency", po::value<double>(), "input-to-present latency in milliseconds to aim at by delaying the input sampling");
+
+    po::variables_map options;
+
+    po::store(po::parse_command_line(argc, argv, description), options);
+    po::notify(options);
+
+    if (options.count("help")) {
+        std::cout << description << std::endl;
+        return 0;
+    }
+
+    auto const width = options.at("width").as<std::uint32_t>();
+    auto const height = options.at("height").as<std::uint32_t>();
+
+    std::optional<std::string> gpu_trace_path;
+
+    if (options.count("gpu-trace"))
+        gpu_trace_path = options.at("gpu-trace").as<std::string>();
+
+    auto const pipeline_statistics = options.count("pipeline-statistics") != 0;
+
+    std::optional<std::string> cpu_trace_path;
+
+    if (options.count("cpu-trace"))
+        cpu_trace_path = options.at("cpu-trace").as<std::string>();
+
+    render::presentation_config const presentation_config{
+        parse_presentation_mode(options.at("present-mode").as<std::string>()),
+        options.at("frames-in-flight").as<std::uint32_t>(),
+        options.at("swapchain-images").as<std::uint32_t>()
+    };
+
+    render::features_config const features_config{
+        options.count("bindless") != 0,
+        options.count("pipelined") != 0
+    };
+
+    render::frame_pacing_config frame_pacing_config;
+
+    if (options.count("fps-limit")) {
+        auto const fps_limit = options.at("fps-limit").as<double>();
+
+        if (fps_limit <= 0.)
+            throw graphics::exception("frame rate limit has to be positive"s);
+
+        frame_pacing_config.min_frame_interval = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>{1. / fps_limit});
+    }
+
+    if (options.count("target-latency")) {
+        auto const target_latency = std::chrono::duration<double, std::milli>{options.at("target-latency").as<double>()};
+
+        frame_pacing_config.target_latency = std::chrono::duration_cast<std::chrono::nanoseconds>(target_latency);
+    }
+
+    auto const workers_number = options.at("workers").as<std::uint32_t>();
+
+    if (options.count("jobs-benchmark")) {
+        jobs_benchmark_info const info{
+            options.at("objects").as<std::size_t>(),
+            options.at("grain-size").as<std::size_t>(),
+            options.at("warmup-frames").as<std::size_t>(),
+            options.at("frames").as<std::size_t>(),
+            workers_number,
+            options.at("seed").as<std::uint32_t>()
+        };
+
+        run_jobs_benchmark(info, options.at("jobs-benchmark").as<std::string>());
+
+        return 0;
+    }
+
+    if (options.count("primitives-benchmark")) {
+        primitives_benchmark_info const info{
+            options.at("segments").as<std::uint32_t>(),
+            options.at("subdivisions").as<std::uint32_t>(),
+            options.at("warmup-frames").as<std::size_t>(),
+            options.at("frames").as<std::size_t>()
+        };
+
+        run_primitives_benchmark(info, options.at("primitives-benchmark").as<std::string>());
+
+        return 0;
+    }
+
+    if (options.count("benchmark")) {
+        benchmark_info const info{
+            render::extent{width, height},
+            synthetic_scene_info{
+                options.at("objects").as<std::size_t>(),
+                options.at("materials").as<std::size_t>(),
+                options.at("vertex-layouts").as<std::size_t>(),
+                options.at("seed").as<std::uint32_t>()
+            },
+            options.at("warmup-frames").as<std::size_t>(),
+            options.at("frames").as<std::size_t>(),
+            options.at("resize-interval").as<std::size_t>(),
+            options.at("churn-resources").as<std::size_t>(),
+            options.at("churn-descriptor-sets").as<std::size_t>(),
+            options.at("descriptor-updates").as<std::size_t>(),
+            options.at("draw-selections").as<std::size_t>(),
+            presentation_config.frames_in_flight,
+            features_config.bindless_textures,
+            features_config.pipelined_frames,
+            workers_number
+        };
+
+        run_benchmark(info, options.at("benchmark").as<std::string>());
+
+        if (cpu_trace_path)
+            save_cpu_trace(*cpu_trace_path);
+
+        return 0;
+    }
+
+    if (options.count("headless")) {
+        std::optional<std::string> capture_path;
+
+        if (options.count("capture"))
+            capture_path = options.at("capture").as<std::string>();
+
+        run_headless(render::extent{width, height}, options.at("frames").as<std::size_t>(), capture_path, gpu_trace_path, pipeline_statistics,
+                     presentation_config, features_config, workers_number);
+
+        if (cpu_trace_path)
+            save_cpu_trace(*cpu_trace_path);
+
+        return 0;
+    }
+
     if (auto result = glfwInit(); result != GLFW_TRUE)
         throw std::runtime_error(fmt::format("failed to init GLFW: {0:#x}", result));
 
-    auto [width, height] = std::pair{1920, 1080};
-
-    platform::window window{"engine"sv, width, height};
+    platform::window window{"engine"sv, static_cast<std::int32_t>(width), static_cast<std::int32_t>(height)};
 
     const auto input_manager = std::make_shared<platform::input_manager>();
     window.connect_input_handler(input_manager);
 
-    auto app_ptr = std::make_shared<app_t>(window);
+    auto app_ptr = std::make_shared<app_t>(window, presentation_config, features_config, workers_number);
     window.connect_event_handler(app_ptr);
 
-    app_ptr->camera_ = app_ptr->cameraSystem.create_camera();
-    app_ptr->camera_->aspect = static_cast<float>(app_ptr->width) / static_cast<float>(app_ptr->height);
+    app_ptr->frame_pacer = render::frame_pacer{frame_pacing_config};
+
+    create_camera(*app_ptr, *input_manager);
+
+    if (gpu_trace_path)
+        app_ptr->enable_gpu_profiler(pipeline_statistics);
+
+    simulated_frame_state(*app_ptr).input_time = render::frame_pacer::now();
 
-    app_ptr->camera_controller = std::make_unique<orbit_controller>(app_ptr->camera_, *input_manager);
-    app_ptr->camera_controller->look_at(glm::vec3{2, 2, 2}, {0, 0, 0});
+    prepare_frame_pipeline(*app_ptr);
 
     window.update([app_ptr]
     {
+        auto &&frame_pacer = app_ptr->frame_pacer;
+
+        // The input is sampled as late as the pacing allows.
+        auto const delay = frame_pacer.delay(render::frame_pacer::now());
+
+        if (delay > render::frame_pacer::duration{0}) {
+            TRACE_ZONE("frame pacing delay");
+
+            std::this_thread::sleep_for(delay);
+        }
+
+        auto const input_time = render::frame_pacer::now();
+
         glfwPollEvents();
 
-        update(*app_ptr);
+        auto &&state = simulated_frame_state(*app_ptr);
 
-        render_frame(*app_ptr);
+        state.input_time = input_time;
+        state.input_delay = delay;
+
+        run_frame(*app_ptr, render_frame);
+
+        TRACE_COUNTER("frame: input delay, ns", delay.count());
     });
 
+    print_frame_timing_statistics(app_ptr->frame_pacer.statistics());
+
+    if (gpu_trace_path)
+        save_gpu_trace(*app_ptr, *gpu_trace_path);
+
     app_ptr->clean_up();
 
     glfwTerminate();
+
+    if (cpu_trace_path)
+        save_cpu_trace(*cpu_trace_path);
 }
@@ -1,20 +1,48 @@
 #pragma once
 
+#include <cstddef>
+
 #include "../include/config.hxx"
 //#include "loaders/scene_loader.hxx"
 
 struct app_t;
+struct frame_state;
 struct xformat;
+struct descriptor_sets_data;
 
 namespace vulkan {
     class device;
 }
 
+namespace platform {
+    class input_manager;
+}
+
 void create_graphics_command_buffers(app_t &app);
+void record_graphics_command_buffer(app_t &app, std::size_t image_index);
 void create_frame_data(app_t &app);
 void cleanup_frame_data(app_t &app);
 void create_sync_objects(app_t &app);
 void build_render_pipelines(app_t &app, xformat const &model_);
 void recreate_swap_chain(app_t &app);
-void update_descriptor_set(app_t &app, vulkan::device const &device);
-void update_viewport_descriptor_buffer(app_t const &app);
+descriptor_sets_data get_descriptor_sets_data(app_t const &app);
+void update_descriptor_set(app_t &app);
+void create_per_frame_buffers(app_t &app);
+
+void create_camera(app_t &app, platform::input_manager &input_manager);
+// Takes the input and updates the cameras, then simulates the next frame state; the pipelined frames simulate it
+// on the job system.
+void update(app_t &app);
+
+// Waits for the simulation and makes the simulated state the one to submit.
+void complete_frame_simulation(app_t &app);
+
+// The pipelined frames submit the state simulated during the previous frame, so the first one is simulated in advance.
+void prepare_frame_pipeline(app_t &app);
+
+[[nodiscard]] frame_state &simulated_frame_state(app_t &app);
+[[nodiscard]] frame_state const &submitted_frame_state(app_t const &app);
+
+// Waits until the current frame's offscreen image is free and returns its index.
+std::size_t wait_offscreen_frame(app_t &app);
+void submit_offscreen_frame(app_t &app, std::size_t image_index);
@@ -1,22 +1,19 @@
 #include <array>
 #include <tuple>
 #include <ranges>
-#include <variant>
-#include <functional>
 
 #include <string>
 using namespace std::string_literals;
 
-#include "utility/mpl.hxx"
 #include "utility/helpers.hxx"
 #include "utility/exceptions.hxx"
 
 #include "math/math.hxx"
-#include "math/pack-unpack.hxx"
 
 #include "graphics/graphics.hxx"
 
 #include "primitives/primitives.hxx"
+#include "primitives/vertex_writer.hxx"
 
 
 namespace
@@ -204,273 +201,84 @@ namespace
         }
     }
 
-    template<std::size_t N, class T>
-    std::array<T, N> generate_position(std::uint32_t hsegments, std::uint32_t vsegments, float width, float height, glm::mat4 transform, std::size_t vertex_index)
-    {
-        auto step = glm::vec2{width / static_cast<float>(hsegments), -height / static_cast<float>(vsegments)};
-        auto xy = glm::vec2{-width, height} / 2.f + glm::vec2{vertex_index % (hsegments + 1u), vertex_index / (hsegments + 1u)} * step;
-
-        auto pos = glm::vec<4, T>{transform * glm::vec4{xy, 0, 1}};
-
-        if constexpr (N == 4)
-            return std::array<T, N>{pos.x, pos.y, pos.z, 1};
-
-        else if constexpr (N == 3)
-            return std::array<T, N>{pos.x, pos.y, pos.z};
-
-        else throw resource::exception("unsupported components number"s);
-    }
-    
-    template<std::size_t N, class T>
-    std::array<T, N>
-    generate_texcoord(std::pair<std::uint32_t, std::uint32_t> segments, graphics::FORMAT format, std::uint32_t vertex_index)
-    {
-        auto const [hsegments, vsegments] = segments;
-
-        if constexpr (N == 2) {
-            auto x = static_cast<float>(vertex_index % (hsegments + 1u)) / static_cast<float>(hsegments);
-            auto y = 1.f - static_cast<float>(vertex_index / (hsegments + 1u)) / static_cast<float>(vsegments);
-
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint16_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        return std::array<T, N>{static_cast<T>(x *type_max), static_cast<T>(y *type_max)};
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>)
-                        return std::array<T, N>{static_cast<T>(x), static_cast<T>(y)};
-
-                    else throw resource::exception("unsupported format type"s);
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-    
-    template<std::size_t N, class T>
-    std::array<T, N>
-    generate_color(glm::vec4 const &color, graphics::FORMAT format)
+    template<class T>
+    void generate_indices(primitives::box_create_info const &create_info, T *buffer_begin, std::uint32_t indices_number)
     {
-        if constexpr (N == 3 || N == 4) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint8_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        if constexpr (N == 4) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                    static_cast<T>(color.g * type_max),
-                                    static_cast<T>(color.b * type_max),
-                                    static_cast<T>(color.a * type_max)
-                            };
-                        }
-
-                        else if constexpr (N == 3) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                    static_cast<T>(color.g * type_max),
-                                    static_cast<T>(color.b * type_max)
-                            };
-                        }
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>) {
-                        if constexpr (N == 4)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b), 1};
-
-                        else
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b)};
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
+        auto it_begin = strided_bidirectional_iterator<T>{buffer_begin, sizeof(T)};
 
-    template<std::size_t N, class T>
-    void generate_positions(primitives::box_create_info const &create_info, graphics::FORMAT attribute_format, std::span<glm::mat4 const, 6> transforms,
-                            strided_bidirectional_iterator<std::array<T, N>> it_begin, [[maybe_unused]] std::size_t vertex_count)
-    {
-        if constexpr (N == 3) {
-            switch (graphics::numeric_format(attribute_format)) {
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    {
-                        auto vertices_number = calculate_box_faces_vertices_count(create_info);
-
-                        auto const dimensions_data = std::array{
-                            std::tuple{create_info.dsegments, create_info.vsegments, create_info.depth, create_info.height},
-                            std::tuple{create_info.hsegments, create_info.dsegments, create_info.width, create_info.depth},
-                            std::tuple{create_info.hsegments, create_info.vsegments, create_info.width, create_info.height}
-                        };
-
-                        bool is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
-
-                        for (std::size_t face_index = 0, offset = 0; auto &&transform : transforms) {
-                            auto [hsegments, vsegments, width, height] = dimensions_data.at(face_index / 2);
-                            auto generator = std::bind(generate_position<N, T>, hsegments, vsegments, width, height, transform, std::placeholders::_1);
-
-                            if (is_primitive_indexed) {
-                                std::generate_n(std::next(it_begin, static_cast<std::int32_t>(offset)), vertices_number.at(face_index / 2), [generator, i = 0u] () mutable
-                                {
-                                    return generator(i++);
-                                });
-                            }
-
-                            // else generate_vertex(generator, create_info, it_begin, vertex_count);
-                            else throw resource::exception("not yet implemented"s);
-
-                            offset += vertices_number.at(face_index / 2);
-                            ++face_index;
-                        }
-                    }
-                    break;
+        switch (create_info.topology) {
+            case graphics::PRIMITIVE_TOPOLOGY::POINTS:
+            case graphics::PRIMITIVE_TOPOLOGY::LINES:
+            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLES:
+            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP:
+                generate_vertex([] (auto vertex_index)
+                {
+                    return static_cast<T>(vertex_index);
+                }, create_info, it_begin, indices_number);
+                break;
 
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
+            default:
+                throw resource::exception("unsupported primitive topology"s);
         }
-
-        else throw resource::exception("unsupported components number"s);
     }
 
-    template<std::size_t N, class T>
-    void generate_normals(primitives::box_create_info const &create_info, graphics::FORMAT attribute_format, std::span<glm::mat4 const, 6> transforms,
-                          strided_bidirectional_iterator<std::array<T, N>> it_begin, [[maybe_unused]] std::size_t vertex_count)
+    void generate_vertices(primitives::box_create_info const &create_info, primitives::vertex_writer &writer)
     {
-        if constexpr (N != 2 && N != 3)
-            throw resource::exception("unsupported components number"s);
-
-        auto vertices_number = calculate_box_faces_vertices_count(create_info);
-
-        for (std::size_t face_index = 0, offset = 0; auto &&transform : transforms) {
-            auto normal = glm::vec<4, T>{transform * glm::vec4{0, 0, 1, 0}};
-
-            if constexpr (N == 2) {
-                switch (graphics::numeric_format(attribute_format)) {
-                    case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    {
-                        if constexpr (mpl::is_one_of_v<T, std::int8_t, std::int16_t>) {
-                            std::array<T, 2> oct;
-
-                            math::encode_unit_vector_to_oct_fast(std::span{oct}, glm::vec3{normal});
-
-                            std::fill_n(std::next(it_begin, static_cast<std::int32_t>(offset)), vertices_number.at(face_index / 2), oct);
-                        }
-
-                        else throw resource::exception("unsupported format type"s);
-
-                        break;
-                    }
-
-                    default:
-                        throw resource::exception("unsupported numeric format"s);
-                }
-            }
+        bool is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
 
-            else if constexpr (N == 3) {
-                switch (graphics::numeric_format(attribute_format)) {
-                    case graphics::NUMERIC_FORMAT::SCALED:
-                    case graphics::NUMERIC_FORMAT::INT:
-                    case graphics::NUMERIC_FORMAT::FLOAT:
-                        std::fill_n(std::next(it_begin, static_cast<std::int32_t>(offset)), vertices_number.at(face_index / 2), std::array<T, 3>{normal.x, normal.y, normal.z});
-                        break;
+        if (!is_primitive_indexed)
+            throw resource::exception("not yet implemented"s);
 
-                    default:
-                        throw resource::exception("unsupported numeric format"s);
-                }
-            }
-
-            offset += vertices_number.at(face_index / 2);
-            ++face_index;
-        }
-    }
+        auto const transforms = std::array{
+            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(+90.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.width / 2.f}),
+            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(-90.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.width / 2.f}),
+            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(-90.f), glm::vec3{1, 0, 0}), glm::vec3{0, 0, create_info.height / 2.f}),
+            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(+90.f), glm::vec3{1, 0, 0}), glm::vec3{0, 0, create_info.height / 2.f}),
+            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(360.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.depth / 2.f}),
+            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(180.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.depth / 2.f})
+        };
 
-    template<std::size_t N, class T>
-    void generate_texcoords(primitives::box_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it_begin, [[maybe_unused]] std::uint32_t vertex_count)
-    {
-        auto const segments = std::array{
-            std::pair{create_info.dsegments, create_info.vsegments},
-            std::pair{create_info.dsegments, create_info.vsegments},
-            std::pair{create_info.hsegments, create_info.dsegments},
-            std::pair{create_info.hsegments, create_info.dsegments},
-            std::pair{create_info.hsegments, create_info.vsegments},
-            std::pair{create_info.hsegments, create_info.vsegments}
+        auto const dimensions_data = std::array{
+            std::tuple{create_info.dsegments, create_info.vsegments, create_info.depth, create_info.height},
+            std::tuple{create_info.hsegments, create_info.dsegments, create_info.width, create_info.depth},
+            std::tuple{create_info.hsegments, create_info.vsegments, create_info.width, create_info.height}
         };
 
         auto vertices_number = calculate_box_faces_vertices_count(create_info);
 
-        for (std::size_t face_index = 0, offset = 0; auto s : segments) {
-            auto generator = std::bind(generate_texcoord<N, T>, s, format, std::placeholders::_1);
+        // The normals encoded into the octahedron are truncated to the integers first, which snaps them to the axes.
+        auto const normal_format = writer.format(vertex::SEMANTIC::NORMAL);
+        auto const snap_normals = normal_format && graphics::numeric_format(*normal_format) == graphics::NUMERIC_FORMAT::NORMALIZED;
 
-            bool is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
+        for (std::size_t face_index = 0; auto &&transform : transforms) {
+            auto [hsegments, vsegments, width, height] = dimensions_data.at(face_index / 2);
 
-            if (is_primitive_indexed) {
-                std::generate_n(std::next(it_begin, static_cast<std::int32_t>(offset)), vertices_number.at(face_index / 2), [generator, i = 0u] () mutable
-                {
-                    return generator(i++);
-                });
-            }
+            auto normal = glm::vec3{transform * glm::vec4{0, 0, 1, 0}};
 
-            //else generate_vertex(generator, create_info, it_begin, vertex_count);
-            else throw resource::exception("not yet implemented"s);
+            if (snap_normals)
+                normal = glm::vec3{glm::ivec3{normal}};
 
-            offset += vertices_number.at(face_index / 2);
-            ++face_index;
-        }
-    }
+            auto step = glm::vec2{width / static_cast<float>(hsegments), -height / static_cast<float>(vsegments)};
 
-    template<std::size_t N, class T>
-    void generate_colors(primitives::box_create_info const& create_info, graphics::FORMAT format,
-                         strided_bidirectional_iterator<std::array<T, N>> it_begin, [[maybe_unused]] std::uint32_t vertex_number)
-    {
-        auto vertices_number = calculate_box_faces_vertices_count(create_info);
+            writer.generate(vertices_number.at(face_index / 2), create_info.colors.at(face_index), [&] (primitives::vertex_batch &batch, std::size_t index, std::uint32_t vertex_index)
+            {
+                auto xy = glm::vec2{-width, height} / 2.f + glm::vec2{vertex_index % (hsegments + 1u), vertex_index / (hsegments + 1u)} * step;
 
-        for (std::size_t face_index = 0, offset = 0; auto &&color : create_info.colors) {
-            auto generator = std::bind(generate_color<N, T>, color, format);
+                auto const position = transform * glm::vec4{xy, 0, 1};
 
-            std::generate_n(std::next(it_begin, static_cast<std::int32_t>(offset)), vertices_number.at(face_index / 2), generator);
+                batch.px[index] = position.x;
+                batch.py[index] = position.y;
+                batch.pz[index] = position.z;
 
-            offset += vertices_number.at(face_index / 2);
-            ++face_index;
-        }
-    }
+                batch.nx[index] = normal.x;
+                batch.ny[index] = normal.y;
+                batch.nz[index] = normal.z;
 
-    template<class T>
-    void generate_indices(primitives::box_create_info const &create_info, T *buffer_begin, std::uint32_t indices_number)
-    {
-        auto it_begin = strided_bidirectional_iterator<T>{buffer_begin, sizeof(T)};
+                batch.u[index] = static_cast<float>(vertex_index % (hsegments + 1u)) / static_cast<float>(hsegments);
+                batch.v[index] = 1.f - static_cast<float>(vertex_index / (hsegments + 1u)) / static_cast<float>(vsegments);
+            });
 
-        switch (create_info.topology) {
-            case graphics::PRIMITIVE_TOPOLOGY::POINTS:
-            case graphics::PRIMITIVE_TOPOLOGY::LINES:
-            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLES:
-            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP:
-                generate_vertex([] (auto vertex_index)
-                {
-                    return static_cast<T>(vertex_index);
-                }, create_info, it_begin, indices_number);
-                break;
-
-            default:
-                throw resource::exception("unsupported primitive topology"s);
+            ++face_index;
         }
     }
 }
@@ -553,60 +361,8 @@ namespace primitives
 
     void generate_box(primitives::box_create_info const &create_info, std::span<std::byte> vertex_buffer)
     {
-        auto &&vertex_layout = create_info.vertex_layout;
+        primitives::vertex_writer writer{create_info.vertex_layout, vertex_buffer};
 
-        auto vertex_number = calculate_box_vertices_count(create_info);
-        auto vertex_size = static_cast<std::uint32_t>(vertex_layout.size_bytes);
-
-        auto &&attributes = vertex_layout.attributes;
-
-        auto const transforms = std::array{
-            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(+90.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.width / 2.f}),
-            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(-90.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.width / 2.f}),
-            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(-90.f), glm::vec3{1, 0, 0}), glm::vec3{0, 0, create_info.height / 2.f}),
-            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(+90.f), glm::vec3{1, 0, 0}), glm::vec3{0, 0, create_info.height / 2.f}),
-            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(360.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.depth / 2.f}),
-            glm::translate(glm::rotate(glm::mat4{1.f}, glm::radians(180.f), glm::vec3{0, 1, 0}), glm::vec3{0, 0, create_info.depth / 2.f})
-        };
-
-        for (std::size_t offset_in_bytes = 0; auto && attribute : attributes) {
-            if (auto format_inst = graphics::instantiate_format(attribute.format); format_inst) {
-                std::visit([&] <typename T> (T &&)
-                {
-                    using type = typename std::remove_cvref_t<T>;
-                    using pointer_type = typename std::add_pointer_t<type>;
-
-                    auto data = reinterpret_cast<pointer_type>(std::to_address(std::data(vertex_buffer)) + offset_in_bytes);
-
-                    offset_in_bytes += sizeof(type);
-
-                    auto it = strided_bidirectional_iterator<type>{data, vertex_size};
-
-                    switch (attribute.semantic) {
-                        case vertex::SEMANTIC::POSITION:
-                            generate_positions(create_info, attribute.format, std::span{transforms}, it, vertex_number);
-                            break;
-
-                        case vertex::SEMANTIC::NORMAL:
-                            generate_normals(create_info, attribute.format, std::span{transforms}, it, vertex_number);
-                            break;
-
-                        case vertex::SEMANTIC::TEXCOORD_0:
-                            generate_texcoords(create_info, attribute.format, it, vertex_number);
-                            break;
-
-                        case vertex::SEMANTIC::COLOR_0:
-                            generate_colors(create_info, attribute.format, it, vertex_number);
-                            break;
-
-                        default:
-                            break;
-                    }
-
-                }, *format_inst);
-            }
-
-            else throw resource::exception("unsupported attribute format"s);
-        }
+        generate_vertices(create_info, writer);
     }
 }
@@ -1,21 +1,21 @@
+#include <span>
 #include <array>
 #include <tuple>
 #include <ranges>
-#include <variant>
-#include <functional>
+#include <numeric>
+#include <algorithm>
 
 #include <string>
 using namespace std::string_literals;
 
-#include "utility/mpl.hxx"
-#include "utility/helpers.hxx"
 #include "utility/exceptions.hxx"
 
-#include "math/pack-unpack.hxx"
+#include "math/math.hxx"
 
 #include "graphics/graphics.hxx"
 
 #include "primitives/primitives.hxx"
+#include "primitives/vertex_writer.hxx"
 
 
 // https://github.com/mrdoob/three.js/blob/00a692864f541a3ec194d266e220efd597eb28fa/src/geometries/PolyhedronGeometry.js
@@ -90,199 +90,56 @@ namespace
             uv.x = azimuth / 2.f / static_cast<float>(std::numbers::pi_v<float>) + .5f;
     }
 
-    template<std::size_t N, class T>
-    void generate_position(primitives::icosahedron_create_info const &create_info, strided_bidirectional_iterator<std::array<T, N>> &it,
-                           std::span<std::uint32_t const, 3> face, std::uint32_t pattern_index, std::uint32_t i, std::uint32_t j)
+    std::array<glm::vec3, 3> generate_triangle(std::span<std::uint32_t const, 3> face, std::uint32_t columns, std::uint32_t pattern_index,
+                                               std::uint32_t i, std::uint32_t j)
     {
-        auto const columns = create_info.detail + 1;
-        auto const radius = create_info.radius;
-
-        it = std::transform(std::cbegin(offsets_pattern[pattern_index]), std::cend(offsets_pattern[pattern_index]), it, [&face, radius, columns, i, j] (auto offsets)
+        std::array<glm::vec3, 3> points{};
+        std::transform(std::cbegin(offsets_pattern[pattern_index]), std::cend(offsets_pattern[pattern_index]), std::begin(points), [&face, columns, i, j] (auto offsets)
         {
-            auto point = generate_point(face, columns, i + std::get<0>(offsets), j + std::get<1>(offsets)) * radius;
-
-            if constexpr (N == 4)
-                return std::array<T, N>{static_cast<T>(point.x), static_cast<T>(point.y), static_cast<T>(point.z), 1};
-
-            else if constexpr (N == 3)
-                return std::array<T, N>{static_cast<T>(point.x), static_cast<T>(point.y), static_cast<T>(point.z)};
-
-            else throw resource::exception("unsupported components number"s);
+            return generate_point(face, columns, i + std::get<0>(offsets), j + std::get<1>(offsets));
         });
+
+        return points;
     }
 
-    template<std::size_t N, class T>
-    void generate_normal(primitives::icosahedron_create_info const &create_info, strided_bidirectional_iterator<std::array<T, N>> &it,
-                         std::span<std::uint32_t const, 3> face, std::uint32_t pattern_index, std::uint32_t i, std::uint32_t j)
+    std::array<glm::vec2, 3> generate_uvs(std::span<glm::vec3 const, 3> points)
     {
-        auto const columns = create_info.detail + 1;
+        auto const centoroid = std::accumulate(std::cbegin(points), std::cend(points), glm::vec3{0}) / 3.f;
+        auto const centoroid_azimuth = azimuth(centoroid);
 
-        it = std::transform(std::cbegin(offsets_pattern[pattern_index]), std::cend(offsets_pattern[pattern_index]), it, [&face, columns, i, j] (auto offsets)
+        std::array<glm::vec2, 3> uvs{};
+        std::transform(std::cbegin(points), std::cend(points), std::begin(uvs), [centoroid_azimuth] (auto &&point)
         {
-            auto point = generate_point(face, columns, i + std::get<0>(offsets), j + std::get<1>(offsets));
-
-            if constexpr (N == 2) {
-                std::array<T, 2> oct{};
-
-                math::encode_unit_vector_to_oct_precise(std::span{ oct }, glm::vec3{ point });
+            auto uv = glm::vec2{azimuth(point) / 2.f / std::numbers::pi_v<float> + .5f, 1.f - (inclination(point) / std::numbers::pi_v<float> + .5f)};
 
-                return oct;
-            }
-
-            else if constexpr (N == 3)
-                return std::array<T, N>{static_cast<T>(point.x), static_cast<T>(point.y), static_cast<T>(point.z)};
+            correct_uv(uv, point, centoroid_azimuth);
 
-            else throw resource::exception("unsupported components number"s);
+            return uv;
         });
-    }
-
-    template<std::size_t N, class T>
-    void generate_texcoord(primitives::icosahedron_create_info const &create_info, strided_bidirectional_iterator<std::array<T, N>> &it, graphics::FORMAT format,
-                           std::span<std::uint32_t const, 3> face, std::uint32_t pattern_index, std::uint32_t i, std::uint32_t j)
-    {
-        if constexpr (N == 2) {
-            auto const columns = create_info.detail + 1;
-
-            std::array<glm::vec3, 3> points{};
-            std::transform(std::cbegin(offsets_pattern[pattern_index]), std::cend(offsets_pattern[pattern_index]), std::begin(points), [&face, columns, i, j] (auto offsets)
-            {
-                return generate_point(face, columns, i + std::get<0>(offsets), j + std::get<1>(offsets));
-            });
-
-            auto const centoroid = std::accumulate(std::cbegin(points), std::cend(points), glm::vec3{0}) / 3.f;
-            auto const centoroid_azimuth = azimuth(centoroid);
-
-            std::array<glm::vec2, 3> uvs{};
-            std::transform(std::cbegin(points), std::cend(points), std::begin(uvs), [centoroid_azimuth] (auto &&point)
-            {
-                auto uv = glm::vec2{azimuth(point) / 2.f / std::numbers::pi_v<float> + .5f, 1.f - (inclination(point) / std::numbers::pi_v<float> + .5f)};
-
-                correct_uv(uv, point, centoroid_azimuth);
-
-                return uv;
-            });
-
-            auto [min, max] = std::ranges::minmax(uvs, [] (auto &&lhs, auto &&rhs)
-            {
-                return lhs.x < rhs.x;
-            });
-
-            if (min.x < .1f && max.x > .9f) {
-                if (uvs[0].x < .2f)
-                    uvs[0].x += 1;
-
-                if (uvs[1].x < .2f)
-                    uvs[1].x += 1;
-
-                if (uvs[2].x < .2f)
-                    uvs[2].x += 1;
-            }
-
-            it = std::transform(std::cbegin(uvs), std::cend(uvs), it, [format] ([[maybe_unused]] auto &&uv)
-            {
-                switch (graphics::numeric_format(format)) {
-                    case graphics::NUMERIC_FORMAT::NORMALIZED:
-                        if constexpr (std::is_same_v<T, std::uint16_t>) {
-                            auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
 
-                            return std::array<T, N>{static_cast<T>(uv.x * type_max), static_cast<T>(uv.y * type_max)};
-                        }
-
-                        break;
-
-                    case graphics::NUMERIC_FORMAT::FLOAT:
-                        if constexpr (std::is_floating_point_v<T>)
-                            return std::array<T, N>{static_cast<T>(uv.x), static_cast<T>(uv.y)};
-
-                        break;
-
-                    default:
-                        break;
-                }
-
-                return std::array<T, N>{};
-            });
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-
-    template<std::size_t N, class T>
-    std::array<T, N> generate_color(glm::vec4 const &color, graphics::FORMAT format)
-    {
-        if constexpr (N == 3 || N == 4) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint8_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        if constexpr (N == 4) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                static_cast<T>(color.g * type_max),
-                                static_cast<T>(color.b * type_max),
-                                static_cast<T>(color.a * type_max)
-                            };
-                        }
-
-                        else if constexpr (N == 3) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                static_cast<T>(color.g * type_max),
-                                static_cast<T>(color.b * type_max)
-                            };
-                        }
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>) {
-                        if constexpr (N == 4)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b), 1};
-
-                        else if constexpr (N == 3)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b)};
-                    }
+        auto [min, max] = std::ranges::minmax(uvs, [] (auto &&lhs, auto &&rhs)
+        {
+            return lhs.x < rhs.x;
+        });
 
-                    else throw resource::exception("unsupported format type"s);
+        if (min.x < .1f && max.x > .9f) {
+            if (uvs[0].x < .2f)
+                uvs[0].x += 1;
 
-                    break;
+            if (uvs[1].x < .2f)
+                uvs[1].x += 1;
 
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
+            if (uvs[2].x < .2f)
+                uvs[2].x += 1;
         }
 
-        else throw resource::exception("unsupported components number"s);
+        return uvs;
     }
 
-    template<std::size_t N, class T, class F>
-    void generate_vertex_as_triangles(F generator, primitives::icosahedron_create_info const &create_info,
-                                      strided_bidirectional_iterator<std::array<T, N>>)
-    {
-        auto const columns = create_info.detail + 1;
-
-        for (auto &&face : faces) {
-            for (auto i = 0u; i < columns; ++i) {
-                for (auto j = 0u; j < 2 * (columns - i) - 1; ++j) {
-                    auto const pattern_index = j % 2;
-
-                    generator(face, pattern_index, i, j / 2);
-                }
-            }
-        }
-    }
-
-    template<class T, class F>
-    void generate_vertex(F generator, primitives::icosahedron_create_info const &create_info,
-                         strided_bidirectional_iterator<T> it_begin)
+    void generate_vertices(primitives::icosahedron_create_info const &create_info, primitives::vertex_writer &writer)
     {
         switch (create_info.topology) {
             case graphics::PRIMITIVE_TOPOLOGY::TRIANGLES:
-                generate_vertex_as_triangles(generator, create_info, it_begin);
                 break;
 
             case graphics::PRIMITIVE_TOPOLOGY::POINTS:
@@ -291,86 +148,47 @@ namespace
             default:
                 throw resource::exception("unsupported primitive topology"s);
         }
-    }
 
-    template<std::size_t N, class T>
-    void generate_positions(primitives::icosahedron_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it)
-    {
-        if constexpr (N == 3 || N == 4) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    {
-                        auto generator = std::bind(generate_position<N, T>, create_info, it, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-                        generate_vertex(generator, create_info, it);
-                    }
-                    break;
+        auto const columns = create_info.detail + 1;
+        auto const radius = create_info.radius;
 
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-                    break;
-            }
-        }
+        primitives::vertex_batch batch;
+        batch.color = create_info.color;
 
-        else throw resource::exception("unsupported components number"s);
-    }
+        for (auto &&face : faces) {
+            for (auto i = 0u; i < columns; ++i) {
+                for (auto j = 0u; j < 2 * (columns - i) - 1; ++j) {
+                    // The triangle's points are computed once for all the attributes, as its texture coordinates depend on each other.
+                    auto const points = generate_triangle(face, columns, j % 2, i, j / 2);
 
-    template<std::size_t N, class T>
-    void generate_normals(primitives::icosahedron_create_info const &create_info, graphics::FORMAT format,
-                          strided_bidirectional_iterator<std::array<T, N>> it)
-    {
-        if constexpr (N == 2) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                {
-                    if constexpr (mpl::is_one_of_v<T, std::int8_t, std::int16_t>) {
-                        auto generator = std::bind(generate_normal<N, T>, create_info, it, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-                        generate_vertex(generator, create_info, it);
-                    }
+                    auto const uvs = generate_uvs(points);
 
-                    else throw resource::exception("unsupported format type"s);
+                    for (std::size_t vertex_index = 0; vertex_index < std::size(points); ++vertex_index) {
+                        if (batch.size == primitives::vertex_batch::kCAPACITY) {
+                            writer.write(batch);
+                            batch.size = 0;
+                        }
 
-                    break;
-                }
+                        auto &&point = points[vertex_index];
+                        auto const index = batch.size++;
 
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
+                        batch.px[index] = point.x * radius;
+                        batch.py[index] = point.y * radius;
+                        batch.pz[index] = point.z * radius;
 
-        else if constexpr (N == 3) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                {
-                    auto generator = std::bind(generate_normal<N, T>, create_info, it, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-                    generate_vertex(generator, create_info, it);
+                        batch.nx[index] = point.x;
+                        batch.ny[index] = point.y;
+                        batch.nz[index] = point.z;
 
-                    break;
+                        batch.u[index] = uvs[vertex_index].x;
+                        batch.v[index] = uvs[vertex_index].y;
+                    }
                 }
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
             }
         }
 
-        else throw resource::exception("unsupported components number"s);
-    }
-
-    template<std::size_t N, class T>
-    void generate_texcoords(primitives::icosahedron_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it)
-    {
-        auto generator = std::bind(generate_texcoord<N, T>, create_info, it, format, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-        generate_vertex(generator, create_info, it);
-    }
-
-    template<std::size_t N, class T>
-    void generate_colors(primitives::icosahedron_create_info const &create_info, graphics::FORMAT format,
-                         strided_bidirectional_iterator<std::array<T, N>> it_begin, std::uint32_t vertices_count)
-    {
-        auto generator = std::bind(generate_color<N, T>, create_info.color, format);
-
-        std::generate_n(it_begin, vertices_count, generator);
+        if (batch.size != 0)
+            writer.write(batch);
     }
 }
 
@@ -391,52 +209,8 @@ namespace primitives {
 
 	void generate_icosahedron(primitives::icosahedron_create_info const &create_info, std::span<std::byte> vertex_buffer)
 	{
-        auto &&vertex_layout = create_info.vertex_layout;
-
-        auto vertices_count = calculate_icosahedron_vertices_count(create_info);
-        auto vertex_size = static_cast<std::uint32_t>(vertex_layout.size_bytes);
-
-        auto &&attributes = vertex_layout.attributes;
-
-        for (std::size_t offset_in_bytes = 0; auto &&attribute : attributes) {
-            if (auto format_inst = graphics::instantiate_format(attribute.format); format_inst) {
-                std::visit([&] <typename T> (T &&)
-                {
-                    using type = typename std::remove_cvref_t<T>;
-                    using pointer_type = typename std::add_pointer_t<type>;
+        primitives::vertex_writer writer{create_info.vertex_layout, vertex_buffer, primitives::OCT_ENCODING::PRECISE};
 
-                    auto data = reinterpret_cast<pointer_type>(std::to_address(std::data(vertex_buffer)) + offset_in_bytes);
-
-                    offset_in_bytes += sizeof(type);
-
-                    auto it = strided_bidirectional_iterator<type>{data, vertex_size};
-
-                    switch (attribute.semantic) {
-                        case vertex::SEMANTIC::POSITION:
-                            std::fill_n(it, calculate_icosahedron_vertices_count(create_info), type{0});
-                            generate_positions(create_info, attribute.format, it);
-                            break;
-
-                        case vertex::SEMANTIC::NORMAL:
-                            generate_normals(create_info, attribute.format, it);
-                            break;
-
-                        case vertex::SEMANTIC::TEXCOORD_0:
-                            generate_texcoords(create_info, attribute.format, it);
-                            break;
-
-                        case vertex::SEMANTIC::COLOR_0:
-                            generate_colors(create_info, attribute.format, it, vertices_count);
-                            break;
-
-                        default:
-                            break;
-                    }
-
-                }, *format_inst);
-            }
-
-            else throw resource::exception("unsupported attribute format"s);
-        }
+        generate_vertices(create_info, writer);
 	}
 }
@@ -0,0 +1,260 @@
+#include <span>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <limits>
+#include <numbers>
+#include <algorithm>
+
+#include <string>
+using namespace std::string_literals;
+
+#include "utility/exceptions.hxx"
+
+#include "math/math.hxx"
+
+#include "graphics/graphics.hxx"
+
+#include "primitives/primitives.hxx"
+#include "primitives/vertex_writer.hxx"
+
+
+namespace
+{
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+    auto const t = (1.f + std::sqrt(5.f)) / 2.f;
+
+    // The icosahedron's vertices and faces are the same as the ones of the non-subdivided icosahedron primitive.
+    auto const base_vertices = std::array{
+        glm::vec3{-1, t, 0},    glm::vec3{1, t, 0},     glm::vec3{-1, -t, 0},   glm::vec3{1, -t, 0},
+        glm::vec3{0, -1, t},    glm::vec3{0, 1, t},     glm::vec3{0, -1, -t},   glm::vec3{0, 1, -t},
+        glm::vec3{t, 0, -1},    glm::vec3{t, 0, 1},     glm::vec3{-t, 0, -1},   glm::vec3{-t, 0, 1}
+    };
+
+    auto constexpr base_faces = std::array{
+        std::array{0u, 11u, 5u},    std::array{0u, 5u, 1u},     std::array{0u, 1u, 7u},     std::array{0u, 7u, 10u},    std::array{0u, 10u, 11u},
+        std::array{1u, 5u, 9u},     std::array{5u, 11u, 4u},    std::array{11u, 10u, 2u},   std::array{10u, 7u, 6u},    std::array{7u, 1u, 8u},
+        std::array{3u, 9u, 4u},     std::array{3u, 4u, 2u},     std::array{3u, 2u, 6u},     std::array{3u, 6u, 8u},     std::array{3u, 8u, 9u},
+        std::array{4u, 9u, 5u},     std::array{2u, 4u, 11u},    std::array{6u, 2u, 10u},    std::array{8u, 6u, 7u},     std::array{9u, 8u, 1u}
+    };
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+
+    // Every subdivision splits a triangle into four, so the edges and the vertices grow by the same factor.
+    std::uint64_t subdivision_factor(std::uint32_t subdivisions)
+    {
+        // 60 * 4^n indices are addressable by 32 bit counts up to 13 subdivisions.
+        if (subdivisions > 13)
+            throw resource::exception("too many icosphere subdivisions"s);
+
+        return std::uint64_t{1} << (subdivisions * 2);
+    }
+
+    struct icosphere_mesh final {
+        // Unit vectors, which are both the normals and the positions of the unit sphere.
+        std::vector<glm::vec3> points;
+
+        std::vector<std::array<std::uint32_t, 3>> triangles;
+    };
+
+    icosphere_mesh subdivide(std::uint32_t subdivisions)
+    {
+        auto const factor = subdivision_factor(subdivisions);
+
+        icosphere_mesh mesh;
+
+        mesh.points.reserve(static_cast<std::size_t>(factor * 10 + 2));
+
+        for (auto &&vertex : base_vertices)
+            mesh.points.push_back(glm::normalize(vertex));
+
+        mesh.triangles.assign(std::cbegin(base_faces), std::cend(base_faces));
+
+        // An edge is shared by two triangles, so its midpoint is cached by the first one and reused by the other.
+        // The cache is indexed by the edge's lesser vertex, and as no vertex has more than six neighbours,
+        // the midpoints are looked up among six slots at most instead of being hashed.
+        struct edge_midpoint final {
+            std::uint32_t vertex_index;
+            std::uint32_t midpoint_index;
+        };
+
+        auto constexpr kEMPTY_SLOT = edge_midpoint{std::numeric_limits<std::uint32_t>::max(), 0};
+
+        std::vector<std::array<edge_midpoint, 6>> midpoints;
+
+        auto midpoint = [&mesh, &midpoints] (std::uint32_t a, std::uint32_t b)
+        {
+            auto const [lesser, greater] = std::minmax(a, b);
+
+            for (auto &&slot : midpoints[lesser]) {
+                if (slot.vertex_index == greater)
+                    return slot.midpoint_index;
+
+                if (slot.vertex_index == kEMPTY_SLOT.vertex_index) {
+                    slot = edge_midpoint{greater, static_cast<std::uint32_t>(std::size(mesh.points))};
+
+                    mesh.points.push_back(glm::normalize(mesh.points[a] + mesh.points[b]));
+
+                    return slot.midpoint_index;
+                }
+            }
+
+            throw resource::exception("icosphere vertex has more than six neighbours"s);
+        };
+
+        std::vector<std::array<std::uint32_t, 3>> triangles;
+
+        for (auto level = 0u; level < subdivisions; ++level) {
+            // The midpoints are only shared between the triangles of the same level.
+            midpoints.assign(std::size(mesh.points), std::array{kEMPTY_SLOT, kEMPTY_SLOT, kEMPTY_SLOT, kEMPTY_SLOT, kEMPTY_SLOT, kEMPTY_SLOT});
+
+            triangles.clear();
+            triangles.reserve(std::size(mesh.triangles) * 4);
+
+            // The children of a triangle are consecutive and keep its winding, so the adjacent triangles stay close
+            // in the index buffer at every level, which is friendly to the post-transform vertex cache.
+            for (auto [a, b, c] : mesh.triangles) {
+                auto const ab = midpoint(a, b);
+                auto const bc = midpoint(b, c);
+                auto const ca = midpoint(c, a);
+
+                triangles.push_back({a, ab, ca});
+                triangles.push_back({ab, b, bc});
+                triangles.push_back({ca, bc, c});
+                triangles.push_back({ab, bc, ca});
+            }
+
+            std::swap(mesh.triangles, triangles);
+        }
+
+        return mesh;
+    }
+
+    void check_topology(primitives::icosphere_create_info const &create_info)
+    {
+        switch (create_info.topology) {
+            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLES:
+                break;
+
+            case graphics::PRIMITIVE_TOPOLOGY::POINTS:
+            case graphics::PRIMITIVE_TOPOLOGY::LINES:
+            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP:
+            default:
+                throw resource::exception("unsupported primitive topology"s);
+        }
+    }
+
+    void generate_vertices(primitives::icosphere_create_info const &create_info, icosphere_mesh const &mesh,
+                           primitives::vertex_writer &writer)
+    {
+        auto const radius = create_info.radius;
+
+        auto const indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
+
+        auto const vertices_count = calculate_icosphere_vertices_count(create_info);
+
+        writer.generate(vertices_count, create_info.color, [&] (primitives::vertex_batch &batch, std::size_t index, std::uint32_t vertex_index)
+        {
+            // The non-indexed icosphere repeats the shared vertices in the order of the triangles.
+            auto const point_index = indexed ? vertex_index : mesh.triangles[vertex_index / 3][vertex_index % 3];
+
+            auto &&point = mesh.points[point_index];
+
+            batch.px[index] = point.x * radius;
+            batch.py[index] = point.y * radius;
+            batch.pz[index] = point.z * radius;
+
+            batch.nx[index] = point.x;
+            batch.ny[index] = point.y;
+            batch.nz[index] = point.z;
+
+            // Same mapping as the icosahedron's one, but without the seam's correction, as the vertices are shared.
+            auto const azimuth = std::atan2(point.z, -point.x);
+            auto const inclination = std::atan2(-point.y, std::sqrt((point.x * point.x) + (point.z * point.z)));
+
+            batch.u[index] = azimuth / 2.f / std::numbers::pi_v<float> + .5f;
+            batch.v[index] = 1.f - (inclination / std::numbers::pi_v<float> + .5f);
+        });
+    }
+
+    template<class T>
+    void generate_indices(icosphere_mesh const &mesh, std::span<std::byte> index_buffer)
+    {
+        if (std::size(mesh.points) - 1 > std::numeric_limits<T>::max())
+            throw resource::exception("icosphere vertices aren't addressable by the index type"s);
+
+        if (std::size(mesh.triangles) * 3 * sizeof(T) > std::size(index_buffer))
+            throw resource::exception("index buffer is too small for the primitive"s);
+
+        auto it = reinterpret_cast<T *>(std::to_address(std::data(index_buffer)));
+
+        for (auto &&triangle : mesh.triangles)
+            for (auto vertex_index : triangle)
+                *it++ = static_cast<T>(vertex_index);
+    }
+}
+
+namespace primitives
+{
+    std::uint32_t calculate_icosphere_vertices_count(primitives::icosphere_create_info const &create_info)
+    {
+        check_topology(create_info);
+
+        auto const factor = subdivision_factor(create_info.subdivisions);
+
+        if (create_info.index_buffer_type == graphics::INDEX_TYPE::UNDEFINED)
+            return static_cast<std::uint32_t>(factor * 20 * 3);
+
+        return static_cast<std::uint32_t>(factor * 10 + 2);
+    }
+
+    std::uint32_t calculate_icosphere_indices_count(primitives::icosphere_create_info const &create_info)
+    {
+        if (create_info.index_buffer_type == graphics::INDEX_TYPE::UNDEFINED)
+            return 0;
+
+        check_topology(create_info);
+
+        return static_cast<std::uint32_t>(subdivision_factor(create_info.subdivisions) * 20 * 3);
+    }
+
+    void generate_icosphere(primitives::icosphere_create_info const &create_info, std::span<std::byte> vertex_buffer)
+    {
+        check_topology(create_info);
+
+        auto const mesh = subdivide(create_info.subdivisions);
+
+        primitives::vertex_writer writer{create_info.vertex_layout, vertex_buffer};
+
+        generate_vertices(create_info, mesh, writer);
+    }
+
+    void generate_icosphere_indexed(primitives::icosphere_create_info const &create_info, std::span<std::byte> vertex_buffer,
+                                    std::span<std::byte> index_buffer)
+    {
+        check_topology(create_info);
+
+        auto const mesh = subdivide(create_info.subdivisions);
+
+        switch (create_info.index_buffer_type) {
+            case graphics::INDEX_TYPE::UINT_16:
+                generate_indices<std::uint16_t>(mesh, index_buffer);
+                break;
+
+            case graphics::INDEX_TYPE::UINT_32:
+                generate_indices<std::uint32_t>(mesh, index_buffer);
+                break;
+
+            default:
+                throw resource::exception("unsupported index instance type"s);
+        }
+
+        primitives::vertex_writer writer{create_info.vertex_layout, vertex_buffer};
+
+        generate_vertices(create_info, mesh, writer);
+    }
+}
@@ -1,22 +1,20 @@
 #include <array>
 #include <tuple>
+#include <vector>
 #include <ranges>
-#include <variant>
-#include <functional>
 
 #include <string>
 using namespace std::string_literals;
 
-#include "utility/mpl.hxx"
 #include "utility/helpers.hxx"
 #include "utility/exceptions.hxx"
 
 #include "math/math.hxx"
-#include "math/pack-unpack.hxx"
 
 #include "graphics/graphics.hxx"
 
 #include "primitives/primitives.hxx"
+#include "primitives/vertex_writer.hxx"
 
 
 namespace
@@ -162,241 +160,72 @@ namespace
         }
     }
 
-    template<std::size_t N, class T>
-    std::array<T, N> generate_position(primitives::plane_create_info const &create_info, std::uint32_t vertex_index)
+    template<class T>
+    void generate_indices(primitives::plane_create_info const &create_info, T *buffer_begin, std::uint32_t indices_count)
     {
-        auto const hsegments = create_info.hsegments;
-        auto const vsegments = create_info.vsegments;
-
-        auto const width = create_info.width;
-        auto const height = create_info.height;
-
-        auto [x0, y0] = std::pair{-width / 2.f, height / 2.f};
-        auto [step_x, step_y] = std::pair{width / static_cast<float>(hsegments), -height / static_cast<float>(vsegments)};
-
-        auto x = static_cast<T>(x0 + static_cast<float>(vertex_index % (hsegments + 1u)) * step_x);
-        auto y = static_cast<T>(y0 + static_cast<float>(vertex_index / (hsegments + 1u)) * step_y);
-
-        if constexpr (N == 4)
-            return std::array<T, N>{x, y, 0, 1};
-
-        else if constexpr (N == 3)
-            return std::array<T, N>{x, y, 0};
+        auto it_begin = strided_bidirectional_iterator<T>{buffer_begin, sizeof(T)};
 
-        else if constexpr (N == 2)
-            return std::array<T, N>{x, y};
+        switch (create_info.topology) {
+            case graphics::PRIMITIVE_TOPOLOGY::POINTS:
+            case graphics::PRIMITIVE_TOPOLOGY::LINES:
+            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLES:
+            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP:
+                generate_vertex([] (auto vertex_index)
+                {
+                    return static_cast<T>(vertex_index);
+                }, create_info, it_begin, indices_count);
+                break;
 
-        else throw resource::exception("unsupported components number"s);
+            default:
+                throw resource::exception("unsupported primitive topology"s);
+        }
     }
 
-    template<std::size_t N, class T>
-    std::array<T, N> generate_texcoord(primitives::plane_create_info const &create_info, graphics::FORMAT format, std::uint32_t vertex_index)
+    void generate_vertices(primitives::plane_create_info const &create_info, primitives::vertex_writer &writer, glm::vec4 const &color)
     {
         auto const hsegments = create_info.hsegments;
         auto const vsegments = create_info.vsegments;
 
-        if constexpr (N == 2) {
-            auto x = static_cast<float>(vertex_index % (hsegments + 1u)) / static_cast<float>(hsegments);
-            auto y = 1.f - static_cast<float>(vertex_index / (hsegments + 1u)) / static_cast<float>(vsegments);
-
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint16_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        return std::array<T, N>{static_cast<T>(x * type_max), static_cast<T>(y * type_max)};
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>)
-                        return std::array<T, N>{static_cast<T>(x), static_cast<T>(y)};
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-
-    template<std::size_t N, class T>
-    std::array<T, N> generate_color(glm::vec4 const &color, graphics::FORMAT format)
-    {
-        if constexpr (N == 3 || N == 4) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint8_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        if constexpr (N == 4) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                static_cast<T>(color.g * type_max),
-                                static_cast<T>(color.b * type_max),
-                                static_cast<T>(color.a * type_max)
-                            };
-                        }
-
-                        else if constexpr (N == 3) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                static_cast<T>(color.g * type_max),
-                                static_cast<T>(color.b * type_max)
-                            };
-                        }
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>) {
-                        if constexpr (N == 4)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b), 1};
-
-                        else if constexpr (N == 3)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b)};
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-
-    template<std::size_t N, class T>
-    void generate_positions(primitives::plane_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it_begin, std::uint32_t vertices_count)
-    {
-        if constexpr (N == 2 || N == 3) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    {
-                        auto generator = std::bind(generate_position<N, T>, create_info, std::placeholders::_1);
-
-                        bool is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
-
-                        if (is_primitive_indexed) {
-                            std::generate_n(it_begin, vertices_count, [generator, i = 0u] () mutable
-                            {
-                                return generator(i++);
-                            });
-                        }
-
-                        else generate_vertex(generator, create_info, it_begin, vertices_count);
-                    }
-                    break;
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-
-    template<std::size_t N, class T>
-    void generate_normals(graphics::FORMAT format, strided_bidirectional_iterator<std::array<T, N>> it, std::uint32_t vertices_count)
-    {
-        if constexpr (N == 2) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                {
-                    if constexpr (mpl::is_one_of_v<T, std::int8_t, std::int16_t>) {
-                        std::array<T, 2> oct;
-
-                        math::encode_unit_vector_to_oct_fast(std::span{oct}, glm::vec3{0, 0, 1});
-
-                        std::fill_n(it, vertices_count, oct);
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-                }
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else if constexpr (N == 3) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::SCALED:
-                case graphics::NUMERIC_FORMAT::INT:
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    std::fill_n(it, vertices_count, std::array<T, 3>{0, 0, 1});
-                    break;
+        auto const width = create_info.width;
+        auto const height = create_info.height;
 
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
+        auto const vertices_count = calculate_plane_vertices_count(create_info);
 
-        else throw resource::exception("unsupported components number"s);
-    }
+        bool is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
 
-    template<std::size_t N, class T>
-    void generate_texcoords(primitives::plane_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it_begin, std::uint32_t vertices_count)
-    {
-        auto generator = std::bind(generate_texcoord<N, T>, create_info, format, std::placeholders::_1);
+        // The non-indexed vertices repeat the grid ones in the topology's order.
+        std::vector<std::uint32_t> grid_indices;
 
-        bool is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
+        if (!is_primitive_indexed) {
+            grid_indices.resize(vertices_count);
 
-        if (is_primitive_indexed) {
-            std::generate_n(it_begin, vertices_count, [generator, i = 0u] () mutable
+            generate_vertex([] (auto vertex_index)
             {
-                return generator(i++);
-            });
+                return static_cast<std::uint32_t>(vertex_index);
+            }, create_info, strided_bidirectional_iterator<std::uint32_t>{std::data(grid_indices), sizeof(std::uint32_t)}, vertices_count);
         }
 
-        else generate_vertex(generator, create_info, it_begin, vertices_count);
-    }
+        auto [x0, y0] = std::pair{-width / 2.f, height / 2.f};
+        auto [step_x, step_y] = std::pair{width / static_cast<float>(hsegments), -height / static_cast<float>(vsegments)};
 
-    template<std::size_t N, class T>
-    void generate_colors(glm::vec4 const &color, graphics::FORMAT format,
-                         strided_bidirectional_iterator<std::array<T, N>> it_begin, std::uint32_t vertices_count)
-    {
-        auto generator = std::bind(generate_color<N, T>, color, format);
+        writer.generate(vertices_count, color, [&] (primitives::vertex_batch &batch, std::size_t index, std::uint32_t vertex_index)
+        {
+            auto const grid_index = is_primitive_indexed ? vertex_index : grid_indices[vertex_index];
 
-        std::generate_n(it_begin, vertices_count, generator);
-    }
+            auto const column = static_cast<float>(grid_index % (hsegments + 1u));
+            auto const row = static_cast<float>(grid_index / (hsegments + 1u));
 
-    template<class T>
-    void generate_indices(primitives::plane_create_info const &create_info, T *buffer_begin, std::uint32_t indices_count)
-    {
-        auto it_begin = strided_bidirectional_iterator<T>{buffer_begin, sizeof(T)};
+            batch.px[index] = x0 + column * step_x;
+            batch.py[index] = y0 + row * step_y;
+            batch.pz[index] = 0.f;
 
-        switch (create_info.topology) {
-            case graphics::PRIMITIVE_TOPOLOGY::POINTS:
-            case graphics::PRIMITIVE_TOPOLOGY::LINES:
-            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLES:
-            case graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP:
-                generate_vertex([] (auto vertex_index)
-                {
-                    return static_cast<T>(vertex_index);
-                }, create_info, it_begin, indices_count);
-                break;
+            batch.nx[index] = 0.f;
+            batch.ny[index] = 0.f;
+            batch.nz[index] = 1.f;
 
-            default:
-                throw resource::exception("unsupported primitive topology"s);
-        }
+            batch.u[index] = column / static_cast<float>(hsegments);
+            batch.v[index] = 1.f - row / static_cast<float>(vsegments);
+        });
     }
 }
 
@@ -494,51 +323,8 @@ namespace primitives
 
     void generate_plane(primitives::plane_create_info const &create_info, std::span<std::byte> vertex_buffer, glm::vec4 const &color)
     {
-        auto &&vertex_layout = create_info.vertex_layout;
-
-        auto vertices_count = calculate_plane_vertices_count(create_info);
-        auto vertex_size = static_cast<std::uint32_t>(vertex_layout.size_bytes);
-
-        auto &&attributes = vertex_layout.attributes;
+        primitives::vertex_writer writer{create_info.vertex_layout, vertex_buffer};
 
-        for (std::size_t offset_in_bytes = 0; auto &&attribute : attributes) {
-            if (auto format_inst = graphics::instantiate_format(attribute.format); format_inst) {
-                std::visit([&] <typename T> (T &&)
-                {
-                    using type = typename std::remove_cvref_t<T>;
-                    using pointer_type = typename std::add_pointer_t<type>;
-
-                    auto data = reinterpret_cast<pointer_type>(std::to_address(std::data(vertex_buffer)) + offset_in_bytes);
-
-                    offset_in_bytes += sizeof(type);
-
-                    auto it = strided_bidirectional_iterator<type>{data, vertex_size};
-
-                    switch (attribute.semantic) {
-                        case vertex::SEMANTIC::POSITION:
-                            generate_positions(create_info, attribute.format, it, vertices_count);
-                            break;
-
-                        case vertex::SEMANTIC::NORMAL:
-                            generate_normals(attribute.format, it, vertices_count);
-                            break;
-
-                        case vertex::SEMANTIC::TEXCOORD_0:
-                            generate_texcoords(create_info, attribute.format, it, vertices_count);
-                            break;
-
-                        case vertex::SEMANTIC::COLOR_0:
-                            generate_colors(color, attribute.format, it, vertices_count);
-                            break;
-
-                        default:
-                            break;
-                    }
-
-                }, *format_inst);
-            }
-
-            else throw resource::exception("unsupported attribute format"s);
-        }
+        generate_vertices(create_info, writer, color);
     }
 }
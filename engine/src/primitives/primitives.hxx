@@ -113,5 +113,30 @@ namespace primitives
     std::uint32_t calculate_icosahedron_vertices_count(primitives::icosahedron_create_info const &create_info);
 
     void generate_icosahedron(primitives::icosahedron_create_info const &create_info, std::span<std::byte> vertex_buffer);
+
+    // Icosahedron whose triangles are subdivided into four by their edges' midpoints the given number of times
+    // and projected onto the sphere. The midpoints are shared by the adjacent triangles, so the indexed icosphere
+    // has 10 * 4^n + 2 vertices; the texture coordinates of the triangles crossing the seam aren't corrected.
+    struct icosphere_create_info final {
+        graphics::vertex_layout vertex_layout;
+
+        graphics::PRIMITIVE_TOPOLOGY topology;
+
+        graphics::INDEX_TYPE index_buffer_type;
+
+        float radius{1.f};
+        std::uint32_t subdivisions{0};
+
+        glm::vec4 color{glm::vec4{1}};
+    };
+
+    std::uint32_t calculate_icosphere_vertices_count(primitives::icosphere_create_info const &create_info);
+
+    std::uint32_t calculate_icosphere_indices_count(primitives::icosphere_create_info const &create_info);
+
+    void generate_icosphere(primitives::icosphere_create_info const &create_info, std::span<std::byte> vertex_buffer);
+
+    void generate_icosphere_indexed(primitives::icosphere_create_info const &create_info, std::span<std::byte> vertex_buffer,
+                                    std::span<std::byte> index_buffer);
 }
 
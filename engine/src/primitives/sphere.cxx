@@ -1,21 +1,19 @@
 #include <tuple>
+#include <vector>
 #include <ranges>
-#include <variant>
-#include <functional>
 
 #include <string>
 using namespace std::string_literals;
 
-#include "utility/mpl.hxx"
 #include "utility/helpers.hxx"
 #include "utility/exceptions.hxx"
 
 #include "math/math.hxx"
-#include "math/pack-unpack.hxx"
 
 #include "graphics/graphics.hxx"
 
 #include "primitives/primitives.hxx"
+#include "primitives/vertex_writer.hxx"
 
 
 namespace
@@ -67,300 +65,56 @@ namespace
         }
     }
 
-    glm::vec2 generate_uv(primitives::sphere_create_info const &create_info, std::uint32_t ix, std::uint32_t iy)
+    void generate_vertices(primitives::sphere_create_info const &create_info, primitives::vertex_writer &writer)
     {
         auto const wsegments = create_info.wsegments;
         auto const hsegments = create_info.hsegments;
 
-        if (ix == 0) {
-            if (iy == 0) {
-                return glm::vec2{0, 0};
-            }
-
-            else if (iy == hsegments) {
-                return glm::vec2{0, 1};
-            }
-        }
-
-        return glm::vec2{
-            static_cast<float>(ix) / static_cast<float>(wsegments),
-            static_cast<float>(iy) / static_cast<float>(hsegments)
-        };
-    }
-
-    glm::vec3 generate_point(primitives::sphere_create_info const &create_info, std::uint32_t ix, std::uint32_t iy)
-    {
-        auto const uv = generate_uv(create_info, ix, iy);
-
-        glm::vec3 point{
-            -std::cos(uv.x * std::numbers::pi_v<float> * 2) * std::sin(uv.y * std::numbers::pi_v<float>),
-            std::cos(uv.y * std::numbers::pi_v<float>),
-            std::sin(uv.x * std::numbers::pi_v<float> * 2) * std::sin(uv.y * std::numbers::pi_v<float>)
-        };
-
-        return glm::normalize(point);
-    }
-
-    template<std::size_t N, class T>
-    std::array<T, N> generate_position(primitives::sphere_create_info const &create_info, std::uint32_t ix, std::uint32_t iy)
-    {
-        auto const point = generate_point(create_info, ix, iy) * create_info.radius;
-
-        if constexpr (N == 4)
-            return std::array<T, N>{static_cast<T>(point.x), static_cast<T>(point.y), static_cast<T>(point.z), 1};
-
-        else if constexpr (N == 3)
-            return std::array<T, N>{static_cast<T>(point.x), static_cast<T>(point.y), static_cast<T>(point.z)};
-
-        else throw resource::exception("unsupported components number"s);
-    }
-    
-    template<std::size_t N, class T>
-    std::array<T, N> generate_normal(primitives::sphere_create_info const &create_info, std::uint32_t ix, std::uint32_t iy)
-    {
-        auto const point = generate_point(create_info, ix, iy);
-
-        if constexpr (N == 2) {
-            std::array<T, 2> oct;
-
-            math::encode_unit_vector_to_oct_fast(std::span{oct}, glm::vec3{point});
-            return oct;
-        }
-
-        else if constexpr (N == 3)
-            return std::array<T, N>{static_cast<T>(point.x), static_cast<T>(point.y), static_cast<T>(point.z)};
-
-        else throw resource::exception("unsupported components number"s);
-    }
-    
-    template<std::size_t N, class T>
-    std::array<T, N> generate_texcoord(primitives::sphere_create_info const &create_info, graphics::FORMAT format, std::uint32_t ix, std::uint32_t iy)
-    {
-        if constexpr (N == 2) {
-            auto const uv = generate_uv(create_info, ix, iy);
-
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint16_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        return std::array<T, N>{static_cast<T>(uv.x * type_max), static_cast<T>((1.f - uv.y) * type_max)};
-                    }
+        auto const radius = create_info.radius;
 
-                    else throw resource::exception("unsupported format type"s);
+        auto const vertices_count = calculate_sphere_vertices_count(create_info);
 
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>)
-                        return std::array<T, N>{static_cast<T>(uv.x), static_cast<T>(1.f - uv.y)};
-
-                    else throw resource::exception("unsupported format type"s);
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-    
-    template<std::size_t N, class T>
-    std::array<T, N> generate_color(glm::vec4 const &color, graphics::FORMAT format)
-    {
-        if constexpr (N == 3 || N == 4) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                    if constexpr (std::is_same_v<T, std::uint8_t>) {
-                        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
-
-                        if constexpr (N == 4) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                static_cast<T>(color.g * type_max),
-                                static_cast<T>(color.b * type_max),
-                                static_cast<T>(color.a * type_max)
-                            };
-                        }
-
-                        else if constexpr (N == 3) {
-                            return std::array<T, N>{
-                                static_cast<T>(color.r * type_max),
-                                static_cast<T>(color.g * type_max),
-                                static_cast<T>(color.b * type_max)
-                            };
-                        }
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    if constexpr (std::is_floating_point_v<T>) {
-                        if constexpr (N == 4)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b), 1};
-
-                        else if constexpr (N == 3)
-                            return std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b)};
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
+        // The trigonometric functions are evaluated once per column and row instead of per vertex and attribute.
+        std::vector<float> us(wsegments + 1), azimuth_cos(wsegments + 1), azimuth_sin(wsegments + 1);
 
-        else throw resource::exception("unsupported components number"s);
-    }
+        for (auto ix = 0u; ix <= wsegments; ++ix) {
+            us[ix] = static_cast<float>(ix) / static_cast<float>(wsegments);
 
-    template<std::size_t N, class T>
-    void generate_positions(primitives::sphere_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it, std::uint32_t vertices_count)
-    {
-        if constexpr (N == 2 || N == 3) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                    {
-                        auto const wsegments = create_info.wsegments;
-
-                        auto generator = std::bind(generate_position<N, T>, create_info, std::placeholders::_1, std::placeholders::_2);
-
-                        if (create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED) {
-                            std::generate_n(it, vertices_count, [generator, wsegments, i = 0u] () mutable
-                            {
-                                auto ix = std::max(0u, i - 1) % (wsegments + 1);
-                                auto iy = i == 0 ? 0u : (i - 1) / (wsegments + 1) + 1;
-                                ++i;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuseless-cast"
-                                return generator(static_cast<std::uint32_t>(ix), static_cast<std::uint32_t>(iy));
-#pragma GCC diagnostic pop
-                            });
-                        }
-
-                        // else generate_vertex(generator, create_info, it, vertices_count);
-                        else throw resource::exception("unsupported non-indexed mesh"s);
-                    }
-                    break;
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
+            azimuth_cos[ix] = std::cos(us[ix] * std::numbers::pi_v<float> * 2);
+            azimuth_sin[ix] = std::sin(us[ix] * std::numbers::pi_v<float> * 2);
         }
 
-        else throw resource::exception("unsupported components number"s);
-    }
-    
-    template<std::size_t N, class T>
-    void generate_normals(primitives::sphere_create_info const &create_info, graphics::FORMAT format,
-                          strided_bidirectional_iterator<std::array<T, N>> it, std::uint32_t vertices_count)
-    {
-        auto const wsegments = create_info.wsegments;
+        std::vector<float> vs(hsegments + 1), polar_cos(hsegments + 1), polar_sin(hsegments + 1);
 
-        if constexpr (N == 2) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::NORMALIZED:
-                {
-                    if constexpr (mpl::is_one_of_v<T, std::int8_t, std::int16_t>) {
-                        auto generator = std::bind(generate_normal<N, T>, create_info, std::placeholders::_1, std::placeholders::_2);
-
-                        if (create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED) {
-                            std::generate_n(it, vertices_count, [generator, wsegments, i = 0u] () mutable
-                            {
-                                auto ix = std::max(0u, i - 1) % (wsegments + 1);
-                                auto iy = i == 0 ? 0 : (i - 1) / (wsegments + 1) + 1;
-                                ++i;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuseless-cast"
-                                return generator(static_cast<std::uint32_t>(ix), static_cast<std::uint32_t>(iy));
-#pragma GCC diagnostic pop
-                            });
-                        }
-
-                        // else generate_vertex(generator, create_info, it, vertices_count);
-                        else throw resource::exception("unsupported non-indexed mesh"s);
-                    }
-
-                    else throw resource::exception("unsupported format type"s);
-
-                    break;
-                }
+        for (auto iy = 0u; iy <= hsegments; ++iy) {
+            vs[iy] = static_cast<float>(iy) / static_cast<float>(hsegments);
 
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
+            polar_cos[iy] = std::cos(vs[iy] * std::numbers::pi_v<float>);
+            polar_sin[iy] = std::sin(vs[iy] * std::numbers::pi_v<float>);
         }
 
-        else if constexpr (N == 3) {
-            switch (graphics::numeric_format(format)) {
-                case graphics::NUMERIC_FORMAT::SCALED:
-                case graphics::NUMERIC_FORMAT::INT:
-                case graphics::NUMERIC_FORMAT::FLOAT:
-                {
-                    auto generator = std::bind(generate_normal<N, T>, create_info, std::placeholders::_1, std::placeholders::_2);
-
-                    if (create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED) {
-                        std::generate_n(it, vertices_count, [generator, wsegments, i = 0u] () mutable
-                        {
-                            auto ix = std::max(0u, i - 1) % (wsegments + 1);
-                            auto iy = i == 0 ? 0 : (i - 1) / (wsegments + 1) + 1;
-                            ++i;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuseless-cast"
-                            return generator(static_cast<std::uint32_t>(ix), static_cast<std::uint32_t>(iy));
-#pragma GCC diagnostic pop
-                        });
-                    }
-
-                    // else generate_vertex(generator, create_info, it, vertices_count);
-                    else throw resource::exception("unsupported non-indexed mesh"s);
-
-                    break;
-                }
-
-                default:
-                    throw resource::exception("unsupported numeric format"s);
-            }
-        }
-
-        else throw resource::exception("unsupported components number"s);
-    }
-
-    template<std::size_t N, class T>
-    void generate_texcoords(primitives::sphere_create_info const &create_info, graphics::FORMAT format,
-                            strided_bidirectional_iterator<std::array<T, N>> it, std::uint32_t vertices_count)
-    {
-        auto const wsegments = create_info.wsegments;
+        writer.generate(vertices_count, create_info.color, [&] (primitives::vertex_batch &batch, std::size_t index, std::uint32_t vertex_index)
+        {
+            auto const ix = std::max(0u, vertex_index - 1) % (wsegments + 1);
+            auto const iy = vertex_index == 0 ? 0u : (vertex_index - 1) / (wsegments + 1) + 1;
 
-        auto generator = std::bind(generate_texcoord<N, T>, create_info, format, std::placeholders::_1, std::placeholders::_2);
-
-        auto is_primitive_indexed = create_info.index_buffer_type != graphics::INDEX_TYPE::UNDEFINED;
-        if (is_primitive_indexed) {
-            std::generate_n(it, vertices_count, [generator, wsegments, i = 0u] () mutable
-            {
-                auto ix = std::max(0u, i - 1) % (wsegments + 1);
-                auto iy = i == 0 ? 0 : (i - 1) / (wsegments + 1) + 1;
-                ++i;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuseless-cast"
-                return generator(static_cast<std::uint32_t>(ix), static_cast<std::uint32_t>(iy));
-#pragma GCC diagnostic pop
+            auto const point = glm::normalize(glm::vec3{
+                -azimuth_cos[ix] * polar_sin[iy],
+                polar_cos[iy],
+                azimuth_sin[ix] * polar_sin[iy]
             });
-        }
 
-        // else generate_vertex(generator, create_info, it_begin, vertices_count);
-        else throw resource::exception("unsupported non-indexed mesh"s);
-    }
+            batch.px[index] = point.x * radius;
+            batch.py[index] = point.y * radius;
+            batch.pz[index] = point.z * radius;
 
-    template<std::size_t N, class T>
-    void generate_colors(glm::vec4 const &color, graphics::FORMAT format,
-                         strided_bidirectional_iterator<std::array<T, N>> it_begin, std::uint32_t vertices_count)
-    {
-        auto generator = std::bind(generate_color<N, T>, color, format);
+            batch.nx[index] = point.x;
+            batch.ny[index] = point.y;
+            batch.nz[index] = point.z;
 
-        std::generate_n(it_begin, vertices_count, generator);
+            batch.u[index] = us[ix];
+            batch.v[index] = 1.f - vs[iy];
+        });
     }
 
     template<class T>
@@ -465,51 +219,8 @@ namespace primitives
 
     void generate_sphere(primitives::sphere_create_info const &create_info, std::span<std::byte> vertex_buffer)
     {
-        auto &&vertex_layout = create_info.vertex_layout;
-
-        auto vertices_count = calculate_sphere_vertices_count(create_info);
-        auto vertex_size = static_cast<std::uint32_t>(vertex_layout.size_bytes);
-
-        auto &&attributes = vertex_layout.attributes;
-
-        for (std::size_t offset_in_bytes = 0; auto &&attribute : attributes) {
-            if (auto format_inst = graphics::instantiate_format(attribute.format); format_inst) {
-                std::visit([&] <typename T> (T &&)
-                {
-                    using type = typename std::remove_cvref_t<T>;
-                    using pointer_type = typename std::add_pointer_t<type>;
-
-                    auto data = reinterpret_cast<pointer_type>(std::to_address(std::data(vertex_buffer)) + offset_in_bytes);
-
-                    offset_in_bytes += sizeof(type);
+        primitives::vertex_writer writer{create_info.vertex_layout, vertex_buffer};
 
-                    auto it = strided_bidirectional_iterator<type>{data, vertex_size};
-
-                    switch (attribute.semantic) {
-                        case vertex::SEMANTIC::POSITION:
-                            generate_positions(create_info, attribute.format, it, vertices_count);
-                            break;
-
-                        case vertex::SEMANTIC::NORMAL:
-                            generate_normals(create_info, attribute.format, it, vertices_count);
-                            break;
-
-                        case vertex::SEMANTIC::TEXCOORD_0:
-                            generate_texcoords(create_info, attribute.format, it, vertices_count);
-                            break;
-
-                        case vertex::SEMANTIC::COLOR_0:
-                            generate_colors(create_info.color, attribute.format, it, vertices_count);
-                            break;
-
-                        default:
-                            break;
-                    }
-
-                }, *format_inst);
-            }
-
-            else throw resource::exception("unsupported attribute format"s);
-        }
+        generate_vertices(create_info, writer);
     }
 }
@@ -0,0 +1,304 @@
+#include <cstring>
+#include <limits>
+#include <variant>
+#include <type_traits>
+
+#include <string>
+using namespace std::string_literals;
+
+#include "utility/mpl.hxx"
+#include "utility/exceptions.hxx"
+
+#include "math/pack-unpack.hxx"
+
+#include "graphics/graphics.hxx"
+
+#include "primitives/vertex_writer.hxx"
+
+
+namespace
+{
+    template<std::size_t N, class T>
+    void write_positions(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride) {
+            std::array<T, N> position;
+
+            if constexpr (N == 4)
+                position = std::array<T, N>{static_cast<T>(batch.px[index]), static_cast<T>(batch.py[index]), static_cast<T>(batch.pz[index]), 1};
+
+            else if constexpr (N == 3)
+                position = std::array<T, N>{static_cast<T>(batch.px[index]), static_cast<T>(batch.py[index]), static_cast<T>(batch.pz[index])};
+
+            else position = std::array<T, N>{static_cast<T>(batch.px[index]), static_cast<T>(batch.py[index])};
+
+            std::memcpy(data, &position, sizeof(position));
+        }
+    }
+
+    template<class T, primitives::OCT_ENCODING E>
+    void write_oct_normals(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride) {
+            std::array<T, 2> oct;
+
+            if constexpr (E == primitives::OCT_ENCODING::PRECISE)
+                math::encode_unit_vector_to_oct_precise(std::span{oct}, glm::vec3{batch.nx[index], batch.ny[index], batch.nz[index]});
+
+            else math::encode_unit_vector_to_oct_fast(std::span{oct}, glm::vec3{batch.nx[index], batch.ny[index], batch.nz[index]});
+
+            std::memcpy(data, &oct, sizeof(oct));
+        }
+    }
+
+    template<class T>
+    void write_normals(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride) {
+            auto const normal = std::array<T, 3>{static_cast<T>(batch.nx[index]), static_cast<T>(batch.ny[index]), static_cast<T>(batch.nz[index])};
+
+            std::memcpy(data, &normal, sizeof(normal));
+        }
+    }
+
+    template<class T>
+    void write_normalized_texcoords(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
+
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride) {
+            auto const texcoord = std::array<T, 2>{static_cast<T>(batch.u[index] * type_max), static_cast<T>(batch.v[index] * type_max)};
+
+            std::memcpy(data, &texcoord, sizeof(texcoord));
+        }
+    }
+
+    template<class T>
+    void write_texcoords(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride) {
+            auto const texcoord = std::array<T, 2>{static_cast<T>(batch.u[index]), static_cast<T>(batch.v[index])};
+
+            std::memcpy(data, &texcoord, sizeof(texcoord));
+        }
+    }
+
+    template<std::size_t N, class T>
+    void write_normalized_colors(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        auto constexpr type_max = static_cast<float>(std::numeric_limits<T>::max());
+
+        auto &&color = batch.color;
+
+        std::array<T, N> value;
+
+        if constexpr (N == 4) {
+            value = std::array<T, N>{
+                static_cast<T>(color.r * type_max),
+                static_cast<T>(color.g * type_max),
+                static_cast<T>(color.b * type_max),
+                static_cast<T>(color.a * type_max)
+            };
+        }
+
+        else {
+            value = std::array<T, N>{
+                static_cast<T>(color.r * type_max),
+                static_cast<T>(color.g * type_max),
+                static_cast<T>(color.b * type_max)
+            };
+        }
+
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride)
+            std::memcpy(data, &value, sizeof(value));
+    }
+
+    template<std::size_t N, class T>
+    void write_colors(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride)
+    {
+        auto &&color = batch.color;
+
+        std::array<T, N> value;
+
+        // The alpha is opaque regardless of the color's one.
+        if constexpr (N == 4)
+            value = std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b), 1};
+
+        else value = std::array<T, N>{static_cast<T>(color.r), static_cast<T>(color.g), static_cast<T>(color.b)};
+
+        for (std::size_t index = 0; index < batch.size; ++index, data += stride)
+            std::memcpy(data, &value, sizeof(value));
+    }
+
+    template<std::size_t N, class T, class W>
+    W select_position_writer(graphics::FORMAT format)
+    {
+        if constexpr (N == 2 || N == 3 || N == 4) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (graphics::numeric_format(format) == graphics::NUMERIC_FORMAT::FLOAT)
+                    return write_positions<N, T>;
+            }
+
+            throw resource::exception("unsupported numeric format"s);
+        }
+
+        else throw resource::exception("unsupported components number"s);
+    }
+
+    template<std::size_t N, class T, class W>
+    W select_normal_writer(graphics::FORMAT format, primitives::OCT_ENCODING oct_encoding)
+    {
+        if constexpr (N == 2) {
+            if (graphics::numeric_format(format) != graphics::NUMERIC_FORMAT::NORMALIZED)
+                throw resource::exception("unsupported numeric format"s);
+
+            if constexpr (mpl::is_one_of_v<T, std::int8_t, std::int16_t>) {
+                if (oct_encoding == primitives::OCT_ENCODING::PRECISE)
+                    return write_oct_normals<T, primitives::OCT_ENCODING::PRECISE>;
+
+                return write_oct_normals<T, primitives::OCT_ENCODING::FAST>;
+            }
+
+            else throw resource::exception("unsupported format type"s);
+        }
+
+        else if constexpr (N == 3) {
+            switch (graphics::numeric_format(format)) {
+                case graphics::NUMERIC_FORMAT::SCALED:
+                case graphics::NUMERIC_FORMAT::INT:
+                case graphics::NUMERIC_FORMAT::FLOAT:
+                    return write_normals<T>;
+
+                default:
+                    throw resource::exception("unsupported numeric format"s);
+            }
+        }
+
+        else throw resource::exception("unsupported components number"s);
+    }
+
+    template<std::size_t N, class T, class W>
+    W select_texcoord_writer(graphics::FORMAT format)
+    {
+        if constexpr (N == 2) {
+            switch (graphics::numeric_format(format)) {
+                case graphics::NUMERIC_FORMAT::NORMALIZED:
+                    if constexpr (std::is_same_v<T, std::uint16_t>)
+                        return write_normalized_texcoords<T>;
+
+                    else throw resource::exception("unsupported format type"s);
+
+                case graphics::NUMERIC_FORMAT::FLOAT:
+                    if constexpr (std::is_floating_point_v<T>)
+                        return write_texcoords<T>;
+
+                    else throw resource::exception("unsupported format type"s);
+
+                default:
+                    throw resource::exception("unsupported numeric format"s);
+            }
+        }
+
+        else throw resource::exception("unsupported components number"s);
+    }
+
+    template<std::size_t N, class T, class W>
+    W select_color_writer(graphics::FORMAT format)
+    {
+        if constexpr (N == 3 || N == 4) {
+            switch (graphics::numeric_format(format)) {
+                case graphics::NUMERIC_FORMAT::NORMALIZED:
+                    if constexpr (std::is_same_v<T, std::uint8_t>)
+                        return write_normalized_colors<N, T>;
+
+                    else throw resource::exception("unsupported format type"s);
+
+                case graphics::NUMERIC_FORMAT::FLOAT:
+                    if constexpr (std::is_floating_point_v<T>)
+                        return write_colors<N, T>;
+
+                    else throw resource::exception("unsupported format type"s);
+
+                default:
+                    throw resource::exception("unsupported numeric format"s);
+            }
+        }
+
+        else throw resource::exception("unsupported components number"s);
+    }
+}
+
+namespace primitives
+{
+    vertex_writer::vertex_writer(graphics::vertex_layout const &vertex_layout, std::span<std::byte> vertex_buffer,
+                                 primitives::OCT_ENCODING oct_encoding)
+        : vertex_buffer_{vertex_buffer}, vertex_size_{vertex_layout.size_bytes}
+    {
+        for (std::size_t offset_in_bytes = 0; auto &&attribute : vertex_layout.attributes) {
+            auto format_inst = graphics::instantiate_format(attribute.format);
+
+            if (!format_inst)
+                throw resource::exception("unsupported attribute format"s);
+
+            std::visit([&] <typename T> (T &&)
+            {
+                using type = typename std::remove_cvref_t<T>;
+
+                auto constexpr N = std::tuple_size_v<type>;
+                using value_type = typename type::value_type;
+
+                attribute_writer writer{nullptr};
+
+                switch (attribute.semantic) {
+                    case vertex::SEMANTIC::POSITION:
+                        writer = select_position_writer<N, value_type, attribute_writer>(attribute.format);
+                        break;
+
+                    case vertex::SEMANTIC::NORMAL:
+                        writer = select_normal_writer<N, value_type, attribute_writer>(attribute.format, oct_encoding);
+                        break;
+
+                    case vertex::SEMANTIC::TEXCOORD_0:
+                        writer = select_texcoord_writer<N, value_type, attribute_writer>(attribute.format);
+                        break;
+
+                    case vertex::SEMANTIC::COLOR_0:
+                        writer = select_color_writer<N, value_type, attribute_writer>(attribute.format);
+                        break;
+
+                    default:
+                        break;
+                }
+
+                if (writer != nullptr)
+                    attributes_.push_back(vertex_writer::attribute{attribute.semantic, attribute.format, offset_in_bytes, writer});
+
+                offset_in_bytes += sizeof(type);
+
+            }, *format_inst);
+        }
+    }
+
+    std::optional<graphics::FORMAT> vertex_writer::format(vertex::SEMANTIC semantic) const noexcept
+    {
+        auto it = std::ranges::find(attributes_, semantic, &vertex_writer::attribute::semantic);
+
+        if (it == std::cend(attributes_))
+            return { };
+
+        return it->format;
+    }
+
+    void vertex_writer::write(primitives::vertex_batch const &batch)
+    {
+        if ((vertices_number_ + batch.size) * vertex_size_ > std::size(vertex_buffer_))
+            throw resource::exception("vertex buffer is too small for the primitive"s);
+
+        auto data = std::data(vertex_buffer_) + vertices_number_ * vertex_size_;
+
+        for (auto &&attribute : attributes_)
+            attribute.writer(batch, data + attribute.offset_in_bytes, vertex_size_);
+
+        vertices_number_ += batch.size;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <concepts>
+
+#include "math/math.hxx"
+#include "graphics/vertex.hxx"
+
+
+namespace primitives
+{
+    // Data of the consecutive vertices, computed by a primitive generator once for all the layout's attributes. Every component
+    // is stored in its own array, so the generators' and the writers' loops over a batch are vectorizable.
+    struct vertex_batch final {
+        static std::size_t constexpr kCAPACITY{64};
+
+        std::size_t size{0};
+
+        std::array<float, kCAPACITY> px, py, pz;
+        std::array<float, kCAPACITY> nx, ny, nz;
+        std::array<float, kCAPACITY> u, v;
+
+        // The primitives are colored per face at most, and a batch doesn't span the faces.
+        glm::vec4 color{1};
+    };
+
+    enum struct OCT_ENCODING {
+        FAST, PRECISE
+    };
+
+    // Writes the batches into the interleaved vertex buffer through the functions instantiated for the layout's attribute
+    // formats, so the formats are dispatched once per attribute and batch instead of per attribute and vertex.
+    // The attributes of the semantics the primitives don't generate are left intact.
+    class vertex_writer final {
+    public:
+
+        // Throws if the layout has an attribute of a format the generators don't support.
+        vertex_writer(graphics::vertex_layout const &vertex_layout, std::span<std::byte> vertex_buffer,
+                      primitives::OCT_ENCODING oct_encoding = primitives::OCT_ENCODING::FAST);
+
+        [[nodiscard]] std::optional<graphics::FORMAT> format(vertex::SEMANTIC semantic) const noexcept;
+
+        // Writes the batch after the vertices written before.
+        void write(primitives::vertex_batch const &batch);
+
+        // Fills the batches by calling the function with a batch, the index in it and the index of the vertex,
+        // and writes them.
+        template<class F> requires std::invocable<F &, primitives::vertex_batch &, std::size_t, std::uint32_t>
+        void generate(std::uint32_t vertices_number, glm::vec4 const &color, F &&function)
+        {
+            primitives::vertex_batch batch;
+            batch.color = color;
+
+            for (std::uint32_t first = 0; first < vertices_number; first += static_cast<std::uint32_t>(batch.size)) {
+                batch.size = std::min(static_cast<std::size_t>(vertices_number - first), primitives::vertex_batch::kCAPACITY);
+
+                for (std::size_t index = 0; index < batch.size; ++index)
+                    function(batch, index, first + static_cast<std::uint32_t>(index));
+
+                write(batch);
+            }
+        }
+
+    private:
+
+        using attribute_writer = void (*)(primitives::vertex_batch const &batch, std::byte *data, std::size_t stride);
+
+        struct attribute final {
+            vertex::SEMANTIC semantic;
+            graphics::FORMAT format;
+
+            std::size_t offset_in_bytes;
+
+            attribute_writer writer;
+        };
+
+        std::vector<attribute> attributes_;
+
+        std::span<std::byte> vertex_buffer_;
+        std::size_t vertex_size_{0};
+
+        std::size_t vertices_number_{0};
+    };
+}
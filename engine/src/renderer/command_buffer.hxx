@@ -22,28 +22,41 @@
 
 void end_single_time_command(VkCommandBuffer command_buffer);
 
+// Waits only for the submitted command buffer, not for the whole queue.
 template<class Q>
 requires std::is_base_of_v<graphics::queue, std::remove_cvref_t<Q>>
 void submit_and_free_single_time_command_buffer(vulkan::device const &device, Q &queue, VkCommandPool command_pool, VkCommandBuffer &command_buffer)
 {
+    auto &&timeline = queue.timeline();
+
+    auto const timeline_handle = timeline.handle();
+    auto const timeline_value = timeline.next_value();
+
+    VkTimelineSemaphoreSubmitInfo const timeline_info{
+        VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        nullptr,
+        0, nullptr,
+        1, &timeline_value
+    };
+
     VkSubmitInfo const submit_info{
         VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        nullptr,
+        &timeline_info,
         0, nullptr,
         nullptr,
         1, &command_buffer,
-        0, nullptr,
+        1, &timeline_handle,
     };
 
     if (auto result = vkQueueSubmit(queue.handle(), 1, &submit_info, VK_NULL_HANDLE); result != VK_SUCCESS)
         throw vulkan::exception(fmt::format("failed to submit command buffer: {0:#x}", result));
 
-    vkQueueWaitIdle(queue.handle());
+    timeline.commit_value(timeline_value);
+    timeline.wait(timeline_value);
 
     vkFreeCommandBuffers(device.handle(), command_pool, 1, &command_buffer);
 }
 
-
 void copy_buffer_to_buffer(vulkan::device const &device, graphics::transfer_queue const &queue,
                            VkBuffer src, VkBuffer dst, std::span<VkBufferCopy const> const copy_region, VkCommandPool command_pool);
 
@@ -3,10 +3,12 @@
 #include <cstdint>
 
 #include "vulkan/device_limits.hxx"
+#include "graphics/graphics.hxx"
 
 
 namespace render
 {
+    // Default number of the frames the CPU may record while the GPU is still processing the previous ones.
     static std::uint32_t constexpr kCONCURRENTLY_PROCESSED_FRAMES{2};
 
 #ifdef _MSC_VER
@@ -26,5 +28,24 @@ namespace render
     #pragma warning(pop)
 #endif
 
+    // Chosen by the user rather than adjusted to the device; the swapchain falls back to FIFO if the mode isn't supported.
+    struct presentation_config final {
+        graphics::PRESENTATION_MODE presentation_mode{graphics::PRESENTATION_MODE::MAILBOX};
+
+        std::uint32_t frames_in_flight{render::kCONCURRENTLY_PROCESSED_FRAMES};
+
+        // Zero picks one image more than the surface minimum.
+        std::uint32_t swapchain_images_number{0};
+    };
+
+    // Optional features requested by the user; the ones the device doesn't support are left disabled.
+    struct features_config final {
+        // Textures are sampled through a global descriptor indexing array by the index from the per-object data.
+        bool bindless_textures{false};
+
+        // The next frame is simulated on the job system while the current one is submitted, at the cost of a frame of latency.
+        bool pipelined_frames{false};
+    };
+
     render::config adjust_renderer_config(vulkan::device_limits const &device_limits);
 }
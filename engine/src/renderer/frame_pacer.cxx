@@ -0,0 +1,108 @@
+#include <span>
+#include <algorithm>
+
+#include "frame_pacer.hxx"
+
+
+namespace render
+{
+    frame_pacer::duration frame_pacer::delay(time_point now) const noexcept
+    {
+        duration delay{0};
+
+        if (config_.min_frame_interval && input_time_)
+            delay = std::max(delay, *input_time_ + *config_.min_frame_interval - now);
+
+        if (config_.target_latency && window_size() != 0) {
+            auto const samples = std::span{std::data(samples_), window_size()};
+
+            // The slack is what the frame could have been delayed by without being presented later.
+            auto slack = duration::max();
+
+            // The latency of the frame if its input hadn't been delayed.
+            duration undelayed_latency{0};
+
+            for (auto &&sample : samples) {
+                slack = std::min(slack, sample.gpu_wait + sample.delay);
+                undelayed_latency += sample.latency + sample.delay;
+            }
+
+            undelayed_latency /= static_cast<duration::rep>(std::size(samples));
+
+            auto const latency_delay = std::clamp(undelayed_latency - *config_.target_latency, duration{0}, std::max(slack - kSLACK_MARGIN, duration{0}));
+
+            delay = std::max(delay, latency_delay);
+        }
+
+        return std::max(delay, duration{0});
+    }
+
+    void frame_pacer::begin_frame(time_point input_time, duration delay) noexcept
+    {
+        current_frame_ = frame_sample{
+            input_time_ ? input_time - *input_time_ : duration{0},
+            duration{0},
+            duration{0},
+            delay
+        };
+
+        input_time_ = input_time;
+    }
+
+    void frame_pacer::add_gpu_wait(duration wait) noexcept
+    {
+        if (current_frame_)
+            current_frame_->gpu_wait += wait;
+    }
+
+    void frame_pacer::end_frame(time_point present_time) noexcept
+    {
+        if (!current_frame_)
+            return;
+
+        current_frame_->latency = present_time - *input_time_;
+
+        samples_.at(frames_number_++ % kWINDOW_SIZE) = *std::exchange(current_frame_, std::nullopt);
+    }
+
+    void frame_pacer::discard_frame() noexcept
+    {
+        current_frame_.reset();
+    }
+
+    render::frame_timing_statistics frame_pacer::statistics() const noexcept
+    {
+        render::frame_timing_statistics statistics{};
+
+        statistics.frames_number = frames_number_;
+
+        if (window_size() == 0)
+            return statistics;
+
+        auto const samples = std::span{std::data(samples_), window_size()};
+
+        for (auto &&[interval, latency, gpu_wait, delay] : samples) {
+            statistics.frame_interval += static_cast<double>(interval.count());
+            statistics.latency += static_cast<double>(latency.count());
+            statistics.gpu_wait += static_cast<double>(gpu_wait.count());
+            statistics.delay += static_cast<double>(delay.count());
+
+            statistics.max_frame_interval = std::max(statistics.max_frame_interval, static_cast<double>(interval.count()));
+            statistics.max_latency = std::max(statistics.max_latency, static_cast<double>(latency.count()));
+        }
+
+        auto const size = static_cast<double>(std::size(samples));
+
+        statistics.frame_interval /= size;
+        statistics.latency /= size;
+        statistics.gpu_wait /= size;
+        statistics.delay /= size;
+
+        return statistics;
+    }
+
+    std::size_t frame_pacer::window_size() const noexcept
+    {
+        return std::min(frames_number_, kWINDOW_SIZE);
+    }
+}
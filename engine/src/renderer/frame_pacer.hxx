@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <optional>
+
+
+namespace render
+{
+    struct frame_pacing_config final {
+        // Upper limit of the frame rate; the frame rate isn't limited if not set.
+        std::optional<std::chrono::nanoseconds> min_frame_interval;
+
+        // Input-to-present latency to aim at by delaying the input sampling; the input isn't delayed if not set.
+        std::optional<std::chrono::nanoseconds> target_latency;
+    };
+
+    // Averages and maximums over the last frames, in nanoseconds.
+    struct frame_timing_statistics final {
+        std::size_t frames_number{0};
+
+        double frame_interval{0}, max_frame_interval{0};
+
+        // From the input sampling to the present request.
+        double latency{0}, max_latency{0};
+
+        // Time the CPU has been blocked waiting for the GPU and the presentation engine.
+        double gpu_wait{0};
+
+        // Time the input sampling has been delayed by.
+        double delay{0};
+    };
+
+    // Paces the frames of a window loop. When the CPU gets ahead of the GPU, it has to wait for the frame resources anyway;
+    // the pacer moves that wait in front of the input sampling, so the sampled input is more recent when it's presented.
+    // The delay never exceeds the least of the recent waits, so the frame rate isn't traded for the latency.
+    // All the time points are passed in, so the pacing can be driven by any clock.
+    class frame_pacer final {
+    public:
+
+        using clock = std::chrono::steady_clock;
+        using duration = std::chrono::nanoseconds;
+        using time_point = std::chrono::time_point<clock, duration>;
+
+        static std::size_t constexpr kWINDOW_SIZE{64};
+
+        // Kept out of the delay to absorb the jitter of the waits.
+        static duration constexpr kSLACK_MARGIN{std::chrono::microseconds{500}};
+
+        frame_pacer() = default;
+
+        explicit frame_pacer(render::frame_pacing_config config) noexcept : config_{std::move(config)} { }
+
+        [[nodiscard]] static time_point now() noexcept { return std::chrono::time_point_cast<duration>(clock::now()); }
+
+        [[nodiscard]] render::frame_pacing_config const &config() const noexcept { return config_; }
+
+        // Time to sleep for before the input of the next frame is sampled.
+        [[nodiscard]] duration delay(time_point now) const noexcept;
+
+        // Has to be called right after the input has been sampled.
+        void begin_frame(time_point input_time, duration delay) noexcept;
+
+        // Accumulates the time the frame has been blocked waiting for the GPU or the presentation engine.
+        void add_gpu_wait(duration wait) noexcept;
+
+        // Has to be called right after the frame has been requested to be presented.
+        void end_frame(time_point present_time) noexcept;
+
+        // Has to be called instead of end_frame() if the frame isn't going to be presented; the frame isn't sampled then.
+        void discard_frame() noexcept;
+
+        [[nodiscard]] render::frame_timing_statistics statistics() const noexcept;
+
+    private:
+
+        struct frame_sample final {
+            duration interval{0}, latency{0}, gpu_wait{0}, delay{0};
+        };
+
+        render::frame_pacing_config config_;
+
+        std::array<frame_sample, kWINDOW_SIZE> samples_{};
+        std::size_t frames_number_{0};
+
+        std::optional<time_point> input_time_;
+
+        std::optional<frame_sample> current_frame_;
+
+        [[nodiscard]] std::size_t window_size() const noexcept;
+    };
+}
@@ -0,0 +1,297 @@
+#include <array>
+#include <algorithm>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include <nlohmann/json.hpp>
+
+#include "utility/exceptions.hxx"
+#include "gpu_profiler.hxx"
+
+
+namespace
+{
+    auto constexpr kPIPELINE_STATISTICS_FLAGS = VkQueryPipelineStatisticFlags{
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+    };
+
+    // Counters are written in the order of the flag bits, followed by the availability value.
+    struct statistics_result final {
+        std::array<std::uint64_t, 6> counters;
+        std::uint64_t available;
+    };
+
+    struct timestamp_result final {
+        std::uint64_t value;
+        std::uint64_t available;
+    };
+
+    VkQueryPool create_query_pool(vulkan::device const &device, VkQueryType type, std::uint32_t count, VkQueryPipelineStatisticFlags statistics)
+    {
+        VkQueryPoolCreateInfo const create_info{
+            VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            nullptr, 0,
+            type,
+            count,
+            statistics
+        };
+
+        VkQueryPool handle;
+
+        if (auto result = vkCreateQueryPool(device.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to create query pool: {0:#x}", result));
+
+        return handle;
+    }
+
+    template<class T>
+    bool get_query_results(vulkan::device const &device, VkQueryPool query_pool, std::vector<T> &results)
+    {
+        auto const count = static_cast<std::uint32_t>(std::size(results));
+
+        if (count == 0)
+            return false;
+
+        // No 'VK_QUERY_RESULT_WAIT_BIT', unavailable results are reported by the availability values instead.
+        switch (auto result = vkGetQueryPoolResults(device.handle(), query_pool, 0, count, sizeof(T) * count, std::data(results), sizeof(T),
+                                                    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT); result) {
+            case VK_SUCCESS:
+            case VK_NOT_READY:
+                return true;
+
+            default:
+                throw vulkan::exception(fmt::format("failed to get query pool results: {0:#x}", result));
+        }
+    }
+}
+
+namespace render
+{
+    gpu_profiler::gpu_profiler(vulkan::device const &device, std::uint32_t max_scopes, bool pipeline_statistics)
+        : device_{device}, max_scopes_{max_scopes}, pipeline_statistics_{pipeline_statistics && device.features().pipelineStatisticsQuery == VK_TRUE}
+    {
+        std::uint32_t count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device_.physical_handle(), &count, nullptr);
+
+        std::vector<VkQueueFamilyProperties> properties(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(device_.physical_handle(), &count, std::data(properties));
+
+        auto const valid_bits = properties.at(device_.graphics_queue.family()).timestampValidBits;
+
+        if (valid_bits == 0)
+            throw graphics::exception("graphics queue doesn't support timestamps"s);
+
+        timestamp_mask_ = valid_bits < 64 ? (std::uint64_t{1} << valid_bits) - 1 : ~std::uint64_t{0};
+    }
+
+    gpu_profiler::~gpu_profiler()
+    {
+        for (auto &&queries : queries_) {
+            if (queries.timestamps != VK_NULL_HANDLE)
+                vkDestroyQueryPool(device_.handle(), queries.timestamps, nullptr);
+
+            if (queries.statistics != VK_NULL_HANDLE)
+                vkDestroyQueryPool(device_.handle(), queries.statistics, nullptr);
+        }
+    }
+
+    gpu_profiler::command_buffer_queries &gpu_profiler::queries(std::size_t command_buffer_index)
+    {
+        // Swapchain images count is known only after the swapchain has been created, so pools are created on demand.
+        while (std::size(queries_) <= command_buffer_index) {
+            auto &&queries = queries_.emplace_back();
+
+            queries.timestamps = create_query_pool(device_, VK_QUERY_TYPE_TIMESTAMP, max_scopes_ * 2, 0);
+
+            if (pipeline_statistics_)
+                queries.statistics = create_query_pool(device_, VK_QUERY_TYPE_PIPELINE_STATISTICS, max_scopes_, kPIPELINE_STATISTICS_FLAGS);
+        }
+
+        return queries_.at(command_buffer_index);
+    }
+
+    void gpu_profiler::begin_recording(VkCommandBuffer command_buffer, std::size_t command_buffer_index)
+    {
+        auto &&queries = this->queries(command_buffer_index);
+
+        // Results of the previous recording are still pending until the command buffer is submitted again.
+        if (queries.submitted_frame_number)
+            collect(queries, *queries.submitted_frame_number);
+
+        queries.scopes.clear();
+        queries.open_scopes.clear();
+        queries.statistics_queries_count = 0;
+        queries.submitted_frame_number.reset();
+
+        vkCmdResetQueryPool(command_buffer, queries.timestamps, 0, max_scopes_ * 2);
+
+        if (queries.statistics != VK_NULL_HANDLE)
+            vkCmdResetQueryPool(command_buffer, queries.statistics, 0, max_scopes_);
+    }
+
+    void gpu_profiler::begin_scope(VkCommandBuffer command_buffer, std::size_t command_buffer_index, std::string_view name)
+    {
+        auto &&queries = this->queries(command_buffer_index);
+
+        if (std::size(queries.scopes) >= max_scopes_) {
+            queries.open_scopes.emplace_back();
+            return;
+        }
+
+        auto const index = static_cast<std::uint32_t>(std::size(queries.scopes));
+        auto const depth = static_cast<std::uint32_t>(std::size(queries.open_scopes));
+
+        std::optional<std::uint32_t> statistics_query;
+
+        if (queries.statistics != VK_NULL_HANDLE && depth == 0) {
+            statistics_query = queries.statistics_queries_count++;
+
+            vkCmdBeginQuery(command_buffer, queries.statistics, *statistics_query, 0);
+        }
+
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queries.timestamps, index * 2);
+
+        queries.scopes.push_back(scope{std::string{name}, depth, statistics_query});
+        queries.open_scopes.emplace_back(index);
+    }
+
+    void gpu_profiler::end_scope(VkCommandBuffer command_buffer, std::size_t command_buffer_index)
+    {
+        auto &&queries = this->queries(command_buffer_index);
+
+        if (queries.open_scopes.empty())
+            throw vulkan::logic_error("there isn't any open GPU profiler scope"s);
+
+        auto const index = queries.open_scopes.back();
+        queries.open_scopes.pop_back();
+
+        if (!index)
+            return;
+
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queries.timestamps, *index * 2 + 1);
+
+        if (auto &&statistics_query = queries.scopes.at(*index).statistics_query; statistics_query)
+            vkCmdEndQuery(command_buffer, queries.statistics, *statistics_query);
+    }
+
+    void gpu_profiler::submit(std::size_t command_buffer_index)
+    {
+        auto &&queries = this->queries(command_buffer_index);
+
+        if (queries.submitted_frame_number)
+            collect(queries, *queries.submitted_frame_number);
+
+        queries.submitted_frame_number = frame_number_++;
+    }
+
+    void gpu_profiler::flush()
+    {
+        for (auto &&queries : queries_) {
+            if (queries.submitted_frame_number)
+                collect(queries, *queries.submitted_frame_number);
+
+            queries.submitted_frame_number.reset();
+        }
+
+        std::ranges::sort(events_, {}, &render::gpu_event::frame_number);
+    }
+
+    void gpu_profiler::collect(command_buffer_queries &queries, std::uint64_t frame_number)
+    {
+        std::vector<timestamp_result> timestamps(std::size(queries.scopes) * 2);
+
+        if (!get_query_results(device_, queries.timestamps, timestamps))
+            return;
+
+        std::vector<statistics_result> statistics(queries.statistics_queries_count);
+
+        if (queries.statistics != VK_NULL_HANDLE)
+            get_query_results(device_, queries.statistics, statistics);
+
+        auto const timestamp_period = static_cast<double>(device_.device_limits().timestamp_period);
+
+        for (std::size_t index = 0; auto &&scope : queries.scopes) {
+            auto &&begin = timestamps.at(index * 2);
+            auto &&end = timestamps.at(index * 2 + 1);
+
+            ++index;
+
+            if (begin.available == 0 || end.available == 0)
+                continue;
+
+            render::gpu_event event{
+                scope.name,
+                frame_number,
+                scope.depth,
+                static_cast<double>(begin.value & timestamp_mask_) * timestamp_period,
+                static_cast<double>(end.value & timestamp_mask_) * timestamp_period,
+                std::nullopt
+            };
+
+            if (scope.statistics_query) {
+                if (auto &&result = statistics.at(*scope.statistics_query); result.available != 0) {
+                    auto &&counters = result.counters;
+
+                    event.statistics = render::pipeline_statistics{
+                        counters[0], counters[1], counters[2], counters[3], counters[4], counters[5]
+                    };
+                }
+            }
+
+            events_.push_back(std::move(event));
+        }
+    }
+
+    void gpu_profiler::save_chrome_trace(std::ostream &stream) const
+    {
+        auto trace_events = nlohmann::json::array();
+
+        trace_events.push_back(nlohmann::json{
+            {"name", "thread_name"s},
+            {"ph", "M"s},
+            {"pid", 0},
+            {"tid", 0},
+            {"args", {{"name", "graphics queue"s}}}
+        });
+
+        // Timestamps are relative to the earliest one to keep them readable.
+        auto const origin_ns = events_.empty() ? 0. : std::ranges::min(events_, {}, &render::gpu_event::begin_ns).begin_ns;
+
+        for (auto &&event : events_) {
+            nlohmann::json args{
+                {"frame", event.frame_number}
+            };
+
+            if (auto &&statistics = event.statistics; statistics) {
+                args["input_assembly_vertices"] = statistics->input_assembly_vertices;
+                args["input_assembly_primitives"] = statistics->input_assembly_primitives;
+                args["vertex_shader_invocations"] = statistics->vertex_shader_invocations;
+                args["clipping_invocations"] = statistics->clipping_invocations;
+                args["clipping_primitives"] = statistics->clipping_primitives;
+                args["fragment_shader_invocations"] = statistics->fragment_shader_invocations;
+            }
+
+            // Complete events in microseconds, as the trace viewers expect.
+            trace_events.push_back(nlohmann::json{
+                {"name", event.name},
+                {"cat", "gpu"s},
+                {"ph", "X"s},
+                {"pid", 0},
+                {"tid", 0},
+                {"ts", (event.begin_ns - origin_ns) / 1000.},
+                {"dur", (event.end_ns - event.begin_ns) / 1000.},
+                {"args", std::move(args)}
+            });
+        }
+
+        stream << nlohmann::json{{"traceEvents", std::move(trace_events)}, {"displayTimeUnit", "ns"s}}.dump() << std::endl;
+    }
+}
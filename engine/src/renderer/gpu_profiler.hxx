@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <optional>
+#include <string_view>
+
+#include "vulkan/device.hxx"
+#include "graphics/graphics.hxx"
+
+
+namespace render
+{
+    // Subset of the pipeline statistics that's collected for the outermost scopes.
+    struct pipeline_statistics final {
+        std::uint64_t input_assembly_vertices{0};
+        std::uint64_t input_assembly_primitives{0};
+        std::uint64_t vertex_shader_invocations{0};
+        std::uint64_t clipping_invocations{0};
+        std::uint64_t clipping_primitives{0};
+        std::uint64_t fragment_shader_invocations{0};
+    };
+
+    struct gpu_event final {
+        std::string name;
+
+        std::uint64_t frame_number;
+        std::uint32_t depth;
+
+        // Device timestamps converted to nanoseconds.
+        double begin_ns, end_ns;
+
+        std::optional<render::pipeline_statistics> statistics;
+    };
+
+    // Per command buffer query pools with named scopes around render passes and draw batches.
+    // Results of a submission are read when the same command buffer is submitted again, i.e. after its previous submission has completed,
+    // so the readback lags the number of the frames in flight behind and never stalls.
+    class gpu_profiler final {
+    public:
+
+        gpu_profiler(vulkan::device const &device, std::uint32_t max_scopes, bool pipeline_statistics);
+        ~gpu_profiler();
+
+        [[nodiscard]] bool pipeline_statistics() const noexcept { return pipeline_statistics_; }
+
+        // Resets the command buffer's queries; has to be recorded outside of a render pass before any scope.
+        void begin_recording(VkCommandBuffer command_buffer, std::size_t command_buffer_index);
+
+        // Scopes past 'max_scopes' are ignored. Pipeline statistics are gathered only for the outermost scopes,
+        // as queries of the same type can't be nested.
+        void begin_scope(VkCommandBuffer command_buffer, std::size_t command_buffer_index, std::string_view name);
+        void end_scope(VkCommandBuffer command_buffer, std::size_t command_buffer_index);
+
+        // Collects the results of the command buffer's previous submission and marks it as submitted again.
+        // Has to be called after the command buffer's previous submission has completed.
+        void submit(std::size_t command_buffer_index);
+
+        // Collects the results of all submitted command buffers; has to be called when the queue is idle, e.g. before the export.
+        void flush();
+
+        [[nodiscard]] std::vector<render::gpu_event> const &events() const noexcept { return events_; }
+
+        void clear() noexcept { events_.clear(); }
+
+        void save_chrome_trace(std::ostream &stream) const;
+
+    private:
+
+        vulkan::device const &device_;
+
+        std::uint32_t max_scopes_;
+        bool pipeline_statistics_;
+
+        std::uint64_t timestamp_mask_{0};
+
+        std::uint64_t frame_number_{0};
+
+        struct scope final {
+            std::string name;
+            std::uint32_t depth;
+
+            std::optional<std::uint32_t> statistics_query;
+        };
+
+        struct command_buffer_queries final {
+            VkQueryPool timestamps{VK_NULL_HANDLE};
+            VkQueryPool statistics{VK_NULL_HANDLE};
+
+            std::vector<scope> scopes;
+            std::uint32_t statistics_queries_count{0};
+
+            // Indices of the open scopes; empty ones stand for the ignored scopes.
+            std::vector<std::optional<std::uint32_t>> open_scopes;
+
+            std::optional<std::uint64_t> submitted_frame_number;
+        };
+
+        std::vector<command_buffer_queries> queries_;
+
+        std::vector<render::gpu_event> events_;
+
+        command_buffer_queries &queries(std::size_t command_buffer_index);
+
+        void collect(command_buffer_queries &queries, std::uint64_t frame_number);
+
+        gpu_profiler() = delete;
+        gpu_profiler(gpu_profiler const &) = delete;
+        gpu_profiler(gpu_profiler &&) = delete;
+    };
+}
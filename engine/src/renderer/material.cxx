@@ -1,5 +1,6 @@
 #include <optional>
 #include <algorithm>
+#include <utility>
 #include <ranges>
 
 #include <string>
@@ -134,6 +135,21 @@ namespace graphics
     std::shared_ptr<graphics::material>
     material_factory::material(std::string_view material_name, std::uint32_t technique_index, graphics::vertex_layout const &renderable_vertex_layout, graphics::PRIMITIVE_TOPOLOGY primitive_topology)
     {
+        return material(material_id(material_name), technique_index, renderable_vertex_layout,
+                        graphics::hash<graphics::vertex_layout>{}(renderable_vertex_layout), primitive_topology);
+    }
+
+    std::shared_ptr<graphics::material>
+    material_factory::material(std::uint32_t material_id, std::uint32_t technique_index, graphics::vertex_layout const &renderable_vertex_layout,
+                               std::size_t renderable_vertex_layout_hash, graphics::PRIMITIVE_TOPOLOGY primitive_topology)
+    {
+        material_key const key{material_id, technique_index, renderable_vertex_layout_hash, primitive_topology};
+
+        if (auto material = material_cache_.find(key, renderable_vertex_layout); material)
+            return material;
+
+        std::string_view const material_name = material_names_.at(material_id);
+
         auto &&description = material_description(material_name);
 
         auto &&techniques = description.techniques;
@@ -150,8 +166,14 @@ namespace graphics
 
         auto hashed_name = compile_name(material_name, technique_index, *vertex_layout, primitive_topology);
 
-        if (materials_.contains(hashed_name))
-            return materials_.at(hashed_name);
+        // Different renderable layouts can be reduced to the same compatible one.
+        if (materials_.contains(hashed_name)) {
+            auto material = materials_.at(hashed_name);
+
+            material_cache_.insert(key, renderable_vertex_layout, material);
+
+            return material;
+        }
 
         std::vector<graphics::shader_stage> shader_stages;
 
@@ -177,13 +199,35 @@ namespace graphics
             };
         });
 
-        auto material = std::make_shared<graphics::material>(std::move(shader_stages), *vertex_layout, primitive_topology);
+        std::vector<graphics::push_constant_range> push_constant_ranges;
+
+        std::ranges::transform(description.push_constant_ranges, std::back_inserter(push_constant_ranges), [] (auto &&range)
+        {
+            return graphics::push_constant_range{range.shader_stages, range.offset, range.size};
+        });
+
+        auto material = std::make_shared<graphics::material>(std::move(shader_stages), *vertex_layout, primitive_topology, std::move(push_constant_ranges));
 
         materials_.emplace(hashed_name, material);
 
+        material_cache_.insert(key, renderable_vertex_layout, material);
+
         return material;
     }
 
+    std::uint32_t material_factory::material_id(std::string_view name)
+    {
+        if (auto it = material_ids_.find(name); it != std::end(material_ids_))
+            return it->second;
+
+        auto const id = static_cast<std::uint32_t>(std::size(material_names_));
+
+        material_ids_.emplace(std::string{name}, id);
+        material_names_.emplace_back(name);
+
+        return id;
+    }
+
     loader::material_description const &material_factory::material_description(std::string_view name)
     {
         auto key = std::string{name};
@@ -208,6 +252,67 @@ namespace graphics
     }
 }
 
+namespace graphics
+{
+    std::shared_ptr<graphics::material>
+    material_factory::material_cache::find(material_key const &key, graphics::vertex_layout const &renderable_vertex_layout) const noexcept
+    {
+        if (slots_.empty())
+            return nullptr;
+
+        auto const mask = std::size(slots_) - 1;
+
+        for (auto index = hash(key) & mask; slots_[index].material != nullptr; index = (index + 1) & mask) {
+            auto &&slot = slots_[index];
+
+            if (slot.key == key && slot.vertex_layout == renderable_vertex_layout)
+                return slot.material;
+        }
+
+        return nullptr;
+    }
+
+    void material_factory::material_cache::insert(material_key const &key, graphics::vertex_layout const &renderable_vertex_layout, std::shared_ptr<graphics::material> material)
+    {
+        // Keep the load factor under 0.5 so the probe sequences stay short.
+        if ((size_ + 1) * 2 > std::size(slots_))
+            grow();
+
+        auto const mask = std::size(slots_) - 1;
+
+        auto index = hash(key) & mask;
+
+        while (slots_[index].material != nullptr)
+            index = (index + 1) & mask;
+
+        slots_[index] = slot{key, renderable_vertex_layout, std::move(material)};
+
+        ++size_;
+    }
+
+    std::size_t material_factory::material_cache::hash(material_key const &key) noexcept
+    {
+        std::size_t seed = key.vertex_layout_hash;
+
+        boost::hash_combine(seed, key.name_id);
+        boost::hash_combine(seed, key.technique_index);
+        boost::hash_combine(seed, key.topology);
+
+        return seed;
+    }
+
+    void material_factory::material_cache::grow()
+    {
+        auto slots = std::exchange(slots_, std::vector<slot>(std::max(kINITIAL_CAPACITY, std::size(slots_) * 2)));
+
+        size_ = 0;
+
+        for (auto &&entry : slots)
+            if (entry.material != nullptr)
+                insert(entry.key, entry.vertex_layout, std::move(entry.material));
+    }
+}
+
 namespace graphics
 {
     std::size_t hash<graphics::material>::operator() (graphics::material const &material) const
@@ -219,6 +324,11 @@ namespace graphics
         for (auto &&shader_stage : material.shader_stages)
             boost::hash_combine(seed, shader_stage_hasher(shader_stage));
 
+        graphics::hash<graphics::push_constant_range> constexpr push_constant_range_hasher;
+
+        for (auto &&range : material.push_constant_ranges)
+            boost::hash_combine(seed, push_constant_range_hasher(range));
+
         return seed;
     }
 }
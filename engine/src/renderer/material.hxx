@@ -1,6 +1,10 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <functional>
 #include <unordered_map>
 
 #include "main.hxx"
@@ -9,21 +13,26 @@
 #include "graphics/graphics.hxx"
 #include "graphics/vertex.hxx"
 #include "graphics/shader_program.hxx"
+#include "graphics/descriptors.hxx"
 #include "loaders/material_loader.hxx"
 
 
 namespace graphics
 {
     struct material final {
-        material(std::vector<graphics::shader_stage> shader_stages, graphics::vertex_layout vertex_layout, graphics::PRIMITIVE_TOPOLOGY topology)
-            : shader_stages{shader_stages}, vertex_layout{vertex_layout}, topology{topology} { }
+        material(std::vector<graphics::shader_stage> shader_stages, graphics::vertex_layout vertex_layout, graphics::PRIMITIVE_TOPOLOGY topology,
+                 std::vector<graphics::push_constant_range> push_constant_ranges)
+            : shader_stages{shader_stages}, vertex_layout{vertex_layout}, topology{topology}, push_constant_ranges{push_constant_ranges} { }
 
         std::vector<graphics::shader_stage> shader_stages;
 
         graphics::vertex_layout vertex_layout;
         graphics::PRIMITIVE_TOPOLOGY topology;
 
-        // TODO:: descriptor set and pipeline layout.
+        // Ranges of the per-draw data the material's shaders read; the pipeline layout is extended by them.
+        std::vector<graphics::push_constant_range> push_constant_ranges;
+
+        // TODO:: descriptor set layouts.
     };
 }
 
@@ -32,12 +41,81 @@ namespace graphics
     class material_factory final {
     public:
 
+        // Resolves the material's name once; the callers keep the id, so the requests don't hash the name.
+        [[nodiscard]] std::uint32_t material_id(std::string_view name);
+
         // TODO:: replace 'renderable_vertex_layout' method argument by reference to renderable instance.
+        // The cache is keyed by the material id and the layout hash the caller has already computed, e.g. the vertex buffer's one.
+        [[nodiscard]] std::shared_ptr<graphics::material>
+        material(std::uint32_t material_id, std::uint32_t technique, graphics::vertex_layout const &renderable_vertex_layout,
+                 std::size_t renderable_vertex_layout_hash, graphics::PRIMITIVE_TOPOLOGY topology);
+
         [[nodiscard]] std::shared_ptr<graphics::material>
         material(std::string_view name, std::uint32_t technique, graphics::vertex_layout const &renderable_vertex_layout, graphics::PRIMITIVE_TOPOLOGY topology);
 
     private:
 
+        // Structured key of a material request; it's used on the hot path instead of the name-based UUID.
+        struct material_key final {
+            std::uint32_t name_id;
+            std::uint32_t technique_index;
+
+            std::size_t vertex_layout_hash;
+
+            graphics::PRIMITIVE_TOPOLOGY topology;
+
+            template<class T> requires std::same_as<std::remove_cvref_t<T>, material_key>
+            auto constexpr operator== (T &&rhs) const
+            {
+                return name_id == rhs.name_id && technique_index == rhs.technique_index &&
+                       vertex_layout_hash == rhs.vertex_layout_hash && topology == rhs.topology;
+            }
+        };
+
+        // Open addressing (linear probing) table of already resolved requests.
+        class material_cache final {
+        public:
+
+            [[nodiscard]] std::shared_ptr<graphics::material>
+            find(material_key const &key, graphics::vertex_layout const &renderable_vertex_layout) const noexcept;
+
+            void insert(material_key const &key, graphics::vertex_layout const &renderable_vertex_layout, std::shared_ptr<graphics::material> material);
+
+        private:
+
+            static std::size_t constexpr kINITIAL_CAPACITY{64};
+
+            struct slot final {
+                material_key key;
+
+                // The renderable layout is kept to resolve layout hash collisions.
+                graphics::vertex_layout vertex_layout;
+
+                std::shared_ptr<graphics::material> material;
+            };
+
+            std::vector<slot> slots_;
+            std::size_t size_{0};
+
+            [[nodiscard]] static std::size_t hash(material_key const &key) noexcept;
+
+            void grow();
+        };
+
+        struct string_hash final {
+            using is_transparent = void;
+
+            std::size_t operator() (std::string_view string) const noexcept { return std::hash<std::string_view>{}(string); }
+        };
+
+        std::unordered_map<std::string, std::uint32_t, string_hash, std::equal_to<>> material_ids_;
+
+        // Indexed by the material ids; the names are only needed when a request misses the cache.
+        std::vector<std::string> material_names_;
+
+        material_cache material_cache_;
+
+        // Materials created so far keyed by name-based UUIDs; they are computed only when a request misses the cache.
         std::map<std::string, std::shared_ptr<graphics::material>> materials_;
 
         // TODO:: move to general loader manager.
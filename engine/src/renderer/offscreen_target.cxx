@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <ranges>
+
+#include <string>
+using namespace std::string_literals;
+
+#include "utility/exceptions.hxx"
+#include "graphics/graphics_api.hxx"
+#include "command_buffer.hxx"
+#include "offscreen_target.hxx"
+
+
+namespace render
+{
+    offscreen_target::offscreen_target(vulkan::device const &device, resource::resource_manager &resource_manager,
+                                       render::surface_format surface_format, render::extent extent, std::uint32_t image_count)
+        : device_{device}, resource_manager_{resource_manager}, extent_{extent}, surface_format_{surface_format}
+    {
+        auto constexpr usage_flags = graphics::IMAGE_USAGE::COLOR_ATTACHMENT | graphics::IMAGE_USAGE::TRANSFER_SOURCE;
+        auto constexpr property_flags = graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL;
+
+        for (std::uint32_t i = 0; i < image_count; ++i) {
+            auto image = resource_manager_.create_image(graphics::IMAGE_TYPE::TYPE_2D, surface_format_.format, extent_, 1, 1,
+                                                        graphics::IMAGE_TILING::OPTIMAL, usage_flags, property_flags);
+
+            if (image == nullptr)
+                throw graphics::exception("failed to create an offscreen target image"s);
+
+            auto image_view = resource_manager_.create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+
+            if (image_view == nullptr)
+                throw graphics::exception("failed to create an offscreen target image view"s);
+
+            images_.push_back(std::move(image));
+            image_views_.push_back(std::move(image_view));
+        }
+
+        auto const size_bytes = graphics::size_bytes(surface_format_.format) * extent_.width * extent_.height;
+
+        readback_buffer_ = resource_manager_.create_buffer(size_bytes, graphics::BUFFER_USAGE::TRANSFER_DESTINATION,
+                                                           graphics::MEMORY_PROPERTY_TYPE::HOST_VISIBLE | graphics::MEMORY_PROPERTY_TYPE::HOST_COHERENT,
+                                                           graphics::RESOURCE_SHARING_MODE::EXCLUSIVE);
+
+        if (readback_buffer_ == nullptr)
+            throw resource::exception("failed to create an offscreen target readback buffer"s);
+    }
+
+    std::vector<std::byte> offscreen_target::read_back(std::size_t image_index, VkCommandPool command_pool)
+    {
+        auto &&image = *images_.at(image_index);
+        auto &&queue = device_.graphics_queue;
+
+        auto command_buffer = begin_single_time_command(device_, command_pool);
+
+        // The render pass has already transitioned the image; only the color writes have to be made visible to the copy.
+        VkImageMemoryBarrier const image_barrier{
+            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            nullptr,
+            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+            image.handle(),
+            { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
+        };
+
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                             0, nullptr, 0, nullptr, 1, &image_barrier);
+
+        VkBufferImageCopy const copy_region{
+            0,
+            0, 0,
+            { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+            { 0, 0, 0 },
+            { extent_.width, extent_.height, 1 }
+        };
+
+        vkCmdCopyImageToBuffer(command_buffer, image.handle(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback_buffer_->handle(), 1, &copy_region);
+
+        VkBufferMemoryBarrier const buffer_barrier{
+            VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            nullptr,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT,
+            VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+            readback_buffer_->handle(),
+            0, VK_WHOLE_SIZE
+        };
+
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &buffer_barrier, 0, nullptr);
+
+        end_single_time_command(command_buffer);
+
+        submit_and_free_single_time_command_buffer(device_, queue, command_pool, command_buffer);
+
+        auto const mapped_range = readback_buffer_->memory()->mapped_range();
+
+        if (std::size(mapped_range) < readback_buffer_->size_bytes())
+            throw vulkan::exception("offscreen target readback buffer memory isn't mapped"s);
+
+        std::vector<std::byte> texels(readback_buffer_->size_bytes());
+
+        std::copy_n(std::data(mapped_range), std::size(texels), std::data(texels));
+
+        return texels;
+    }
+}
+
+
+std::unique_ptr<render::offscreen_target>
+create_offscreen_target(vulkan::device const &device, resource::resource_manager &resource_manager, render::extent extent, std::uint32_t image_count)
+{
+    // Matches one of the formats the swapchain is created with, so the same pipelines are compatible with both targets.
+    render::surface_format constexpr surface_format{graphics::FORMAT::RGBA8_SRGB, graphics::COLOR_SPACE::SRGB_NONLINEAR};
+
+    auto const supported_format = find_supported_image_format(device, {surface_format.format}, graphics::IMAGE_TILING::OPTIMAL,
+                                                              graphics::FORMAT_FEATURE::COLOR_ATTACHMENT | graphics::FORMAT_FEATURE::TRANSFER_SOURCE);
+
+    if (!supported_format)
+        throw graphics::exception("offscreen target format isn't supported as color attachment"s);
+
+    return std::make_unique<render::offscreen_target>(device, resource_manager, surface_format, extent, image_count);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "vulkan/device.hxx"
+#include "graphics/graphics.hxx"
+#include "resources/resource_manager.hxx"
+#include "resources/buffer.hxx"
+#include "resources/image.hxx"
+#include "renderer/config.hxx"
+
+
+namespace render
+{
+    // Device-local color images that stand in for the swapchain ones when there is no window to present to.
+    // Images are expected to be left in the 'TRANSFER_SOURCE' layout by the render pass, so they can be read back.
+    class offscreen_target final {
+    public:
+
+        offscreen_target(vulkan::device const &device, resource::resource_manager &resource_manager,
+                         render::surface_format surface_format, render::extent extent, std::uint32_t image_count);
+
+        render::surface_format const &surface_format() const noexcept { return surface_format_; }
+
+        render::extent extent() const noexcept { return extent_; }
+
+        std::vector<std::shared_ptr<resource::image>> const &images() const noexcept { return images_; }
+        std::vector<std::shared_ptr<resource::image_view>> const &image_views() const noexcept { return image_views_; }
+
+        // Copies the tightly packed texels of the image; waits until the graphics queue is idle.
+        [[nodiscard]] std::vector<std::byte> read_back(std::size_t image_index, VkCommandPool command_pool);
+
+    private:
+
+        vulkan::device const &device_;
+        resource::resource_manager &resource_manager_;
+
+        render::extent extent_;
+        render::surface_format surface_format_;
+
+        std::vector<std::shared_ptr<resource::image>> images_;
+        std::vector<std::shared_ptr<resource::image_view>> image_views_;
+
+        std::shared_ptr<resource::buffer> readback_buffer_;
+
+        offscreen_target() = delete;
+        offscreen_target(offscreen_target const &) = delete;
+        offscreen_target(offscreen_target &&) = delete;
+    };
+}
+
+std::unique_ptr<render::offscreen_target>
+create_offscreen_target(vulkan::device const &device, resource::resource_manager &resource_manager, render::extent extent, std::uint32_t image_count);
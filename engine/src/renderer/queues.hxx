@@ -1,10 +1,12 @@
 #pragma once
 
+#include <memory>
 #include <variant>
 
 #include "utility/mpl.hxx"
 #include "vulkan/device.hxx"
 #include "graphics/graphics.hxx"
+#include "renderer/timeline.hxx"
 
 
 namespace vulkan
@@ -22,11 +24,16 @@ namespace graphics
         std::uint32_t family() const noexcept { return family_; }
         std::uint32_t index() const noexcept { return index_; }
 
+        // Signaled by the submissions to the queue; shared by the queue copies.
+        render::timeline &timeline() const noexcept { return *timeline_; }
+
     private:
 
         VkQueue handle_{VK_NULL_HANDLE};
         std::uint32_t family_{0}, index_{0};
 
+        std::shared_ptr<render::timeline> timeline_;
+
         friend vulkan::device;
     };
 
@@ -1,66 +1,217 @@
 #include <ranges>
 #include <array>
 
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
 #include "utility/exceptions.hxx"
+#include "graphics/graphics_api.hxx"
+#include "resources/image.hxx"
 #include "render_flow.hxx"
 
 
+namespace
+{
+    auto constexpr kDEPTH_STENCIL_FORMATS = std::array{
+        graphics::FORMAT::D16_UNORM,
+        graphics::FORMAT::D16_UNORM_S8_UINT,
+        graphics::FORMAT::D24_UNORM_S8_UINT,
+        graphics::FORMAT::X8_D24_UNORM_PACK32,
+        graphics::FORMAT::D32_SFLOAT,
+        graphics::FORMAT::D32_SFLOAT_S8_UINT
+    };
+
+    bool is_depth_stencil_format(graphics::FORMAT format)
+    {
+        return std::ranges::any_of(kDEPTH_STENCIL_FORMATS, [format] (auto dsf)
+        {
+            return format == dsf;
+        });
+    }
+
+    // Barriers of the combined depth stencil images have to cover both aspects.
+    graphics::IMAGE_ASPECT barrier_aspect(graphics::FORMAT format)
+    {
+        switch (format) {
+            case graphics::FORMAT::D16_UNORM_S8_UINT:
+            case graphics::FORMAT::D24_UNORM_S8_UINT:
+            case graphics::FORMAT::D32_SFLOAT_S8_UINT:
+                return graphics::IMAGE_ASPECT::DEPTH_BIT | graphics::IMAGE_ASPECT::STENCIL_BIT;
+
+            default:
+                return is_depth_stencil_format(format) ? graphics::IMAGE_ASPECT::DEPTH_BIT : graphics::IMAGE_ASPECT::COLOR_BIT;
+        }
+    }
+}
+
 namespace graphics
 {
-    render_graph_manager::render_graph_manager(vulkan::device const &device, std::shared_ptr<resource::resource_manager> resource_manager)
-        : device_{device}, resource_manager_{resource_manager}
+    render_flow::render_flow(graphics::render_graph graph, graphics::compiled_render_graph compiled_graph,
+                             std::vector<std::vector<std::shared_ptr<resource::image>>> images, graphics::transient_memory_layout memory_layout)
+        : graph_{std::move(graph)}, compiled_graph_{std::move(compiled_graph)}, images_{std::move(images)}, memory_layout_{std::move(memory_layout)} { }
+
+    std::shared_ptr<resource::image> const &render_flow::image(std::uint32_t resource, std::size_t image_index) const
     {
-        render_pass_manager_ = std::make_unique<graphics::render_pass_manager>(device);
+        auto &&images = images_.at(resource);
+
+        return std::size(images) == 1 ? images.front() : images.at(image_index);
     }
-    
-    graphics::render_graph
-    render_graph_manager::create_render_flow(render::swapchain const &, std::vector<graphics::render_graph_node> const &)
+
+    void render_flow::record(VkCommandBuffer command_buffer, std::size_t image_index, std::function<void(graphics::graph_pass const &)> const &record_pass) const
+    {
+        for (auto &&compiled_pass : compiled_graph_.passes) {
+            record_barriers(command_buffer, image_index, compiled_pass.barriers);
+
+            record_pass(graph_.passes().at(compiled_pass.pass_index));
+        }
+
+        record_barriers(command_buffer, image_index, compiled_graph_.final_barriers);
+    }
+
+    void render_flow::record_barriers(VkCommandBuffer command_buffer, std::size_t image_index, std::vector<graphics::image_barrier> const &barriers) const
+    {
+        if (barriers.empty())
+            return;
+
+        std::vector<VkImageMemoryBarrier> image_barriers;
+        image_barriers.reserve(std::size(barriers));
+
+        graphics::PIPELINE_STAGE source_stages{}, destination_stages{};
+
+        // All the barriers preceding a pass are batched into a single command.
+        for (auto &&[resource, source, destination] : barriers) {
+            auto &&image = this->image(resource, image_index);
+
+            image_barriers.push_back(VkImageMemoryBarrier{
+                VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                nullptr,
+                convert_to::vulkan(source.access), convert_to::vulkan(destination.access),
+                convert_to::vulkan(source.layout), convert_to::vulkan(destination.layout),
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+                image->handle(),
+                {
+                    .aspectMask = convert_to::vulkan(barrier_aspect(image->format())),
+                    .baseMipLevel = 0,
+                    .levelCount = image->mip_levels(),
+                    .baseArrayLayer = 0,
+                    .layerCount = 1
+                }
+            });
+
+            source_stages = source_stages | source.stages;
+            destination_stages = destination_stages | destination.stages;
+        }
+
+        // Nothing to wait for, e.g. the first use of an image that hasn't been written yet.
+        if (source_stages == graphics::PIPELINE_STAGE{})
+            source_stages = graphics::PIPELINE_STAGE::TOP_OF_PIPE;
+
+        vkCmdPipelineBarrier(command_buffer, convert_to::vulkan(source_stages), convert_to::vulkan(destination_stages), 0,
+                             0, nullptr, 0, nullptr, static_cast<std::uint32_t>(std::size(image_barriers)), std::data(image_barriers));
+    }
+
+    render_graph_manager::render_graph_manager(resource::resource_manager &resource_manager, resource::memory_manager &memory_manager)
+        : resource_manager_{resource_manager}, memory_manager_{memory_manager} { }
+
+    std::unique_ptr<graphics::render_flow>
+    render_graph_manager::create_render_flow(graphics::render_graph graph,
+                                             std::map<std::uint32_t, std::vector<std::shared_ptr<resource::image>>> const &imported_images)
     {
-        return graphics::render_graph();
+        auto compiled_graph = graph.compile();
+
+        auto &&resources = graph.resources();
+
+        std::vector<std::vector<std::shared_ptr<resource::image>>> images(std::size(resources));
+
+        for (auto &&[resource_index, resource_images] : imported_images) {
+            if (resource_index >= std::size(resources) || !resources[resource_index].imported)
+                throw graphics::exception(fmt::format("render graph resource #{} isn't an imported one", resource_index));
+
+            images[resource_index] = resource_images;
+        }
+
+        for (std::size_t resource_index = 0; resource_index < std::size(resources); ++resource_index) {
+            if (resources[resource_index].imported && images[resource_index].empty())
+                throw graphics::exception(fmt::format("images of the render graph imported resource '{}' haven't been given", resources[resource_index].name));
+        }
+
+        // Images are created first, as their memory requirements are needed to place them.
+        std::vector<std::shared_ptr<resource::image>> transient_images;
+        std::vector<graphics::transient_memory_requirements> memory_requirements;
+
+        for (auto &&transient_image : compiled_graph.transient_images) {
+            auto &&[format, extent, samples_count] = resources.at(transient_image.resource).description;
+
+            auto image = resource_manager_.create_unbound_image(graphics::IMAGE_TYPE::TYPE_2D, format, extent, 1, samples_count,
+                                                                 graphics::IMAGE_TILING::OPTIMAL, transient_image.usage);
+
+            auto const [size, alignment, memory_type_bits] = resource_manager_.image_memory_requirements(*image);
+
+            memory_requirements.push_back(graphics::transient_memory_requirements{size, alignment, memory_type_bits});
+
+            images.at(transient_image.resource).push_back(image);
+            transient_images.push_back(std::move(image));
+        }
+
+        auto memory_layout = graphics::alias_transient_memory(compiled_graph, memory_requirements);
+
+        // Heaps holding nothing but the transient attachments ask for the lazily allocated memory, which the tile-based GPUs
+        // may never back; the memory manager falls back to the plain device local memory elsewhere.
+        std::vector<graphics::MEMORY_PROPERTY_TYPE> heap_memory_property_types(std::size(memory_layout.heaps), kTRANSIENT_ATTACHMENT_MEMORY_PROPERTY_TYPES);
+
+        for (std::size_t index = 0; auto &&transient_image : compiled_graph.transient_images) {
+            auto const heap_index = memory_layout.placements.at(index++).heap_index;
+
+            if ((transient_image.usage & graphics::IMAGE_USAGE::TRANSIENT_ATTACHMENT) != graphics::IMAGE_USAGE::TRANSIENT_ATTACHMENT)
+                heap_memory_property_types.at(heap_index) = kMEMORY_PROPERTY_TYPES;
+        }
+
+        std::vector<std::shared_ptr<resource::memory_block>> heaps;
+
+        for (std::size_t heap_index = 0; auto &&[size, alignment, memory_type_bits] : memory_layout.heaps) {
+            auto const memory_property_types = heap_memory_property_types.at(heap_index++);
+
+            auto memory = memory_manager_.allocate_memory(resource::memory_requirements{size, alignment, memory_type_bits}, memory_property_types, false);
+
+            if (memory == nullptr)
+                throw memory::exception("failed to allocate render graph transient memory"s);
+
+            heaps.push_back(std::move(memory));
+        }
+
+        for (std::size_t index = 0; auto &&image : transient_images) {
+            auto &&[heap_index, offset] = memory_layout.placements.at(index++);
+
+            resource_manager_.bind_image_memory(*image, heaps.at(heap_index), offset);
+        }
+
+        return std::make_unique<graphics::render_flow>(std::move(graph), std::move(compiled_graph), std::move(images), std::move(memory_layout));
     }
 }
 
 std::vector<graphics::attachment>
-create_attachments(resource::resource_manager &resource_manager,
-                   std::vector<graphics::attachment_description> const &attachment_descriptions, render::extent extent)
+create_attachments(resource::resource_manager &resource_manager, graphics::render_flow const &render_flow, std::vector<std::uint32_t> const &resources)
 {
     auto constexpr mip_levels = 1u;
 
-    auto constexpr image_type = graphics::IMAGE_TYPE::TYPE_2D;
     auto constexpr image_view_type = graphics::IMAGE_VIEW_TYPE::TYPE_2D;
-
-    auto constexpr property_flags = graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL /*graphics::MEMORY_PROPERTY_TYPE::LAZILY_ALLOCATED*/;
     auto constexpr tiling = graphics::IMAGE_TILING::OPTIMAL;
 
     std::vector<graphics::attachment> attachments;
 
-    auto constexpr kDEPTH_STENCIL_FORMATS = std::array{
-        graphics::FORMAT::D16_UNORM,
-        graphics::FORMAT::D16_UNORM_S8_UINT,
-        graphics::FORMAT::D24_UNORM_S8_UINT,
-        graphics::FORMAT::X8_D24_UNORM_PACK32,
-        graphics::FORMAT::D32_SFLOAT,
-        graphics::FORMAT::D32_SFLOAT_S8_UINT
-    };
-
-    for (auto &&attachment_description : attachment_descriptions) {
-        auto format = attachment_description.format;
-        auto samples_count = attachment_description.samples_count;
+    for (auto resource : resources) {
+        auto &&[format, extent, samples_count] = render_flow.graph().resources().at(resource).description;
 
-        auto is_color_attachment = std::ranges::none_of(kDEPTH_STENCIL_FORMATS, [format] (auto dsf)
-        {
-            return format == dsf;
-        });
-
-        auto usage_flags = is_color_attachment ? graphics::IMAGE_USAGE::COLOR_ATTACHMENT : graphics::IMAGE_USAGE::DEPTH_STENCIL_ATTACHMENT;
-        usage_flags = usage_flags | graphics::IMAGE_USAGE::TRANSIENT_ATTACHMENT;
+        auto is_color_attachment = !is_depth_stencil_format(format);
 
         auto aspect_flags = is_color_attachment ? graphics::IMAGE_ASPECT::COLOR_BIT : graphics::IMAGE_ASPECT::DEPTH_BIT;
 
-        auto image = resource_manager.create_image(image_type, format, extent, mip_levels, samples_count, tiling, usage_flags, property_flags);
+        auto image = render_flow.image(resource, 0);
 
         if (image == nullptr)
-            throw graphics::exception("failed to create image for an attachment");
+            throw graphics::exception("render flow has no image for an attachment");
 
         auto image_view = resource_manager.create_image_view(image, image_view_type, aspect_flags);
 
@@ -78,10 +229,10 @@ create_attachments(resource::resource_manager &resource_manager,
 }
 
 std::vector<graphics::attachment_description>
-create_attachment_descriptions(vulkan::device const &device, render::config const &renderer_config, render::swapchain const &swapchain)
+create_attachment_descriptions(vulkan::device const &device, render::config const &renderer_config, render::surface_format surface_format)
 {
     const auto samples_count = renderer_config.framebuffer_sample_counts;
-    const auto color_attachment_format = swapchain.surface_format().format;
+    const auto color_attachment_format = surface_format.format;
 
     auto depth_attachment_format = find_supported_image_format(
         device,
@@ -99,7 +250,7 @@ create_attachment_descriptions(vulkan::device const &device, render::config cons
             samples_count,
             graphics::ATTACHMENT_LOAD_TREATMENT::CLEAR,
             graphics::ATTACHMENT_STORE_TREATMENT::DONT_CARE,
-            graphics::IMAGE_LAYOUT::UNDEFINED,
+            graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT,
             graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT
         },
         graphics::attachment_description{
@@ -107,7 +258,7 @@ create_attachment_descriptions(vulkan::device const &device, render::config cons
             samples_count,
             graphics::ATTACHMENT_LOAD_TREATMENT::CLEAR,
             graphics::ATTACHMENT_STORE_TREATMENT::DONT_CARE,
-            graphics::IMAGE_LAYOUT::UNDEFINED,
+            graphics::IMAGE_LAYOUT::DEPTH_STENCIL_ATTACHMENT,
             graphics::IMAGE_LAYOUT::DEPTH_STENCIL_ATTACHMENT
         }
     };
@@ -123,8 +274,8 @@ create_render_pass(graphics::render_pass_manager &render_pass_manager, render::s
             1,
             graphics::ATTACHMENT_LOAD_TREATMENT::DONT_CARE,
             graphics::ATTACHMENT_STORE_TREATMENT::STORE,
-            graphics::IMAGE_LAYOUT::UNDEFINED,
-            graphics::IMAGE_LAYOUT::PRESENT_SOURCE
+            graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT,
+            graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT
         }
     );
     
@@ -162,13 +313,12 @@ create_render_pass(graphics::render_pass_manager &render_pass_manager, render::s
 }
 
 std::vector<std::shared_ptr<resource::framebuffer>>
-create_framebuffers(resource::resource_manager &resource_manager, render::swapchain const &swapchain,
+create_framebuffers(resource::resource_manager &resource_manager, render::extent extent,
+                    std::vector<std::shared_ptr<resource::image_view>> const &target_views,
                     std::shared_ptr<graphics::render_pass> render_pass, std::vector<graphics::attachment> const &attachments)
 {
     std::vector<std::shared_ptr<resource::framebuffer>> framebuffers;
 
-    auto &&swapchain_views = swapchain.image_views();
-
     std::vector<std::shared_ptr<resource::image_view>> image_views;
 
     for (auto attachment : attachments) {
@@ -181,12 +331,12 @@ create_framebuffers(resource::resource_manager &resource_manager, render::swapch
 
     std::vector<std::shared_ptr<resource::image_view>> image_views_copy;
 
-    for (auto &&swapchain_view : swapchain_views) {
+    for (auto &&target_view : target_views) {
         image_views_copy.clear();
         std::ranges::copy(image_views, std::back_inserter(image_views_copy));
-        image_views_copy.push_back(swapchain_view);
+        image_views_copy.push_back(target_view);
 
-        auto framebuffer = resource_manager.create_framebuffer(render_pass, swapchain.extent(), image_views_copy);
+        auto framebuffer = resource_manager.create_framebuffer(render_pass, extent, image_views_copy);
         framebuffers.push_back(std::move(framebuffer));
     }
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <functional>
 #include <map>
 #include <set>
 
@@ -11,74 +13,85 @@
 
 #include "renderer/config.hxx"
 #include "renderer/swapchain.hxx"
+#include "renderer/render_graph.hxx"
 
 
 namespace graphics
 {
-    struct render_graph_node final {
-        render::extent extent;
-
-        graphics::FORMAT format;
-        graphics::IMAGE_LAYOUT layout;
+    // Compiled render graph with its images: the transient ones are shared by all the frames,
+    // while the imported ones, e.g. the swapchain images, are picked by the image index.
+    class render_flow final {
+    public:
 
-        std::uint32_t samples_count;
+        render_flow(graphics::render_graph graph, graphics::compiled_render_graph compiled_graph,
+                    std::vector<std::vector<std::shared_ptr<resource::image>>> images, graphics::transient_memory_layout memory_layout);
 
+        [[nodiscard]] graphics::render_graph const &graph() const noexcept { return graph_; }
+        [[nodiscard]] graphics::compiled_render_graph const &compiled_graph() const noexcept { return compiled_graph_; }
 
-        std::vector<graphics::attachment> input_attachments;
-        std::vector<graphics::attachment> color_attachments;
-        std::vector<graphics::attachment> depth_stencil_attachments;
+        [[nodiscard]] graphics::transient_memory_layout const &memory_layout() const noexcept { return memory_layout_; }
 
-        std::shared_ptr<graphics::material> material;
+        [[nodiscard]] std::shared_ptr<resource::image> const &image(std::uint32_t resource, std::size_t image_index) const;
 
-        graphics::pipeline_states pipeline_states;
-
-        // TODO:: add graphics and compute commands collection.
-    };
-
-    class render_graph final {
-    public:
+        // Records the passes left after the culling, each one preceded by its barriers, and then the final transitions.
+        void record(VkCommandBuffer command_buffer, std::size_t image_index, std::function<void(graphics::graph_pass const &)> const &record_pass) const;
 
     private:
 
-        std::unique_ptr<render::swapchain> swapchain_;
+        graphics::render_graph graph_;
+        graphics::compiled_render_graph compiled_graph_;
+
+        // Indexed by the resource; a transient resource has a single image.
+        std::vector<std::vector<std::shared_ptr<resource::image>>> images_;
 
-        std::vector<std::shared_ptr<graphics::render_pass>> render_passes;
+        graphics::transient_memory_layout memory_layout_;
 
-        std::vector<graphics::attachment> attachments_;
-        std::vector<std::shared_ptr<resource::framebuffer>> framebuffers_;
+        void record_barriers(VkCommandBuffer command_buffer, std::size_t image_index, std::vector<graphics::image_barrier> const &barriers) const;
 
-        // std::vector<graphics::render_pipeline_node> nodes_;
+        render_flow() = delete;
+        render_flow(render_flow const &) = delete;
+        render_flow(render_flow &&) = delete;
     };
 
     class render_graph_manager final {
     public:
-    
-        render_graph_manager(vulkan::device const &device, std::shared_ptr<resource::resource_manager> resource_manager);
 
-        [[nodiscard]] graphics::render_graph
-        create_render_flow(render::swapchain const &swapchain, std::vector<graphics::render_graph_node> const &nodes);
+        render_graph_manager(resource::resource_manager &resource_manager, resource::memory_manager &memory_manager);
+
+        // Compiles the graph and creates its transient images, aliasing the memory of the ones whose lifetimes don't overlap.
+        // Every imported resource has to be given its images, one per frame.
+        [[nodiscard]] std::unique_ptr<graphics::render_flow>
+        create_render_flow(graphics::render_graph graph, std::map<std::uint32_t, std::vector<std::shared_ptr<resource::image>>> const &imported_images);
 
     private:
 
-        [[maybe_unused]] vulkan::device const &device_;
+        static auto constexpr kMEMORY_PROPERTY_TYPES{graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL};
+
+        static auto constexpr kTRANSIENT_ATTACHMENT_MEMORY_PROPERTY_TYPES{
+            graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL | graphics::MEMORY_PROPERTY_TYPE::LAZILY_ALLOCATED
+        };
 
-        std::shared_ptr<resource::resource_manager> resource_manager_;
-        std::unique_ptr<graphics::render_pass_manager> render_pass_manager_;
+        resource::resource_manager &resource_manager_;
+        resource::memory_manager &memory_manager_;
     };
 }
 
 
+// Views of the render flow transient images to be used as the framebuffer attachments, in the order of the resources.
 std::vector<graphics::attachment>
-create_attachments(resource::resource_manager &resource_manager,
-                   std::vector<graphics::attachment_description> const &attachment_descriptions, render::extent extent);
+create_attachments(resource::resource_manager &resource_manager, graphics::render_flow const &render_flow, std::vector<std::uint32_t> const &resources);
 
 std::vector<graphics::attachment_description>
-create_attachment_descriptions(vulkan::device const &device, render::config const &renderer_config, render::swapchain const &swapchain);
+create_attachment_descriptions(vulkan::device const &device, render::config const &renderer_config, render::surface_format surface_format);
 
+// All the attachments, including the render target one, are expected to be in their attachment layouts around the pass;
+// the layout transitions are done by the render graph barriers.
 std::shared_ptr<graphics::render_pass>
-create_render_pass(graphics::render_pass_manager &render_pass_manager,
-                   render::surface_format surface_format, std::vector<graphics::attachment_description> attachment_descriptions);
+create_render_pass(graphics::render_pass_manager &render_pass_manager, render::surface_format surface_format,
+                   std::vector<graphics::attachment_description> attachment_descriptions);
 
+// Creates a framebuffer per render target image view; the attachments are shared between all of them.
 std::vector<std::shared_ptr<resource::framebuffer>>
-create_framebuffers(resource::resource_manager &resource_manager, render::swapchain const &swapchain,
+create_framebuffers(resource::resource_manager &resource_manager, render::extent extent,
+                    std::vector<std::shared_ptr<resource::image_view>> const &target_views,
                     std::shared_ptr<graphics::render_pass> render_pass, std::vector<graphics::attachment> const &attachments);
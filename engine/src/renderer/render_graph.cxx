@@ -0,0 +1,431 @@
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include <boost/align/align_up.hpp>
+
+#include "utility/exceptions.hxx"
+#include "render_graph.hxx"
+
+
+namespace
+{
+    auto constexpr kWRITE_ACCESS = graphics::MEMORY_ACCESS_TYPE::SHADER_WRITE | graphics::MEMORY_ACCESS_TYPE::COLOR_ATTACHMENT_WRITE |
+                                   graphics::MEMORY_ACCESS_TYPE::DEPTH_STENCIL_ATTACHMENT_WRITE | graphics::MEMORY_ACCESS_TYPE::TRANSFER_WRITE |
+                                   graphics::MEMORY_ACCESS_TYPE::HOST_WRITE | graphics::MEMORY_ACCESS_TYPE::MEMORY_WRITE;
+
+    // Transient images used only as attachments may be left without any memory backing on the tile-based GPUs.
+    auto constexpr kNON_ATTACHMENT_USAGE = graphics::IMAGE_USAGE::TRANSFER_SOURCE | graphics::IMAGE_USAGE::TRANSFER_DESTINATION |
+                                           graphics::IMAGE_USAGE::SAMPLED | graphics::IMAGE_USAGE::STORAGE;
+
+    std::optional<graphics::IMAGE_USAGE> image_usage(graphics::RESOURCE_USAGE usage) noexcept
+    {
+        switch (usage) {
+            case graphics::RESOURCE_USAGE::COLOR_ATTACHMENT:
+                return graphics::IMAGE_USAGE::COLOR_ATTACHMENT;
+
+            case graphics::RESOURCE_USAGE::DEPTH_STENCIL_ATTACHMENT:
+            case graphics::RESOURCE_USAGE::DEPTH_STENCIL_READ_ONLY:
+                return graphics::IMAGE_USAGE::DEPTH_STENCIL_ATTACHMENT;
+
+            case graphics::RESOURCE_USAGE::INPUT_ATTACHMENT:
+                return graphics::IMAGE_USAGE::INPUT_ATTACHMENT;
+
+            case graphics::RESOURCE_USAGE::SAMPLED:
+                return graphics::IMAGE_USAGE::SAMPLED;
+
+            case graphics::RESOURCE_USAGE::TRANSFER_SOURCE:
+                return graphics::IMAGE_USAGE::TRANSFER_SOURCE;
+
+            case graphics::RESOURCE_USAGE::TRANSFER_DESTINATION:
+                return graphics::IMAGE_USAGE::TRANSFER_DESTINATION;
+
+            default:
+                return { };
+        }
+    }
+
+    struct tracked_state final {
+        graphics::IMAGE_LAYOUT layout;
+
+        // Stages and accesses of the last write or layout transition.
+        graphics::PIPELINE_STAGE write_stages;
+        graphics::MEMORY_ACCESS_TYPE write_access;
+
+        // Stages that have read the image since the last write and the ones the write has been made visible to.
+        graphics::PIPELINE_STAGE read_stages;
+        graphics::PIPELINE_STAGE visible_stages;
+    };
+
+    std::optional<graphics::image_barrier>
+    access_image(tracked_state &state, std::uint32_t resource, graphics::RESOURCE_USAGE usage, bool discard_contents)
+    {
+        auto const destination = graphics::usage_state(usage);
+        auto const is_write = graphics::is_write_usage(usage);
+
+        // Layout transitions are writes as well, so both have to wait for the previous reads.
+        if (state.layout != destination.layout || is_write) {
+            graphics::image_barrier const barrier{
+                resource,
+                graphics::resource_state{
+                    discard_contents ? graphics::IMAGE_LAYOUT::UNDEFINED : state.layout,
+                    state.write_stages | state.read_stages,
+                    state.write_access
+                },
+                destination
+            };
+
+            state = tracked_state{
+                destination.layout,
+                destination.stages,
+                destination.access & kWRITE_ACCESS,
+                is_write ? graphics::PIPELINE_STAGE{} : destination.stages,
+                destination.stages
+            };
+
+            return barrier;
+        }
+
+        // Reads in the same layout only need the last write to be made visible to their stages.
+        state.read_stages = state.read_stages | destination.stages;
+
+        if ((state.visible_stages & destination.stages) == destination.stages)
+            return { };
+
+        state.visible_stages = state.visible_stages | destination.stages;
+
+        return graphics::image_barrier{
+            resource,
+            graphics::resource_state{state.layout, state.write_stages, state.write_access},
+            destination
+        };
+    }
+}
+
+namespace graphics
+{
+    graphics::resource_state usage_state(graphics::RESOURCE_USAGE usage) noexcept
+    {
+        switch (usage) {
+            case graphics::RESOURCE_USAGE::COLOR_ATTACHMENT:
+                return {
+                    graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT,
+                    graphics::PIPELINE_STAGE::COLOR_ATTACHMENT_OUTPUT,
+                    graphics::MEMORY_ACCESS_TYPE::COLOR_ATTACHMENT_READ | graphics::MEMORY_ACCESS_TYPE::COLOR_ATTACHMENT_WRITE
+                };
+
+            case graphics::RESOURCE_USAGE::DEPTH_STENCIL_ATTACHMENT:
+                return {
+                    graphics::IMAGE_LAYOUT::DEPTH_STENCIL_ATTACHMENT,
+                    graphics::PIPELINE_STAGE::EARLY_FRAGMENT_TESTS | graphics::PIPELINE_STAGE::LATE_FRAGMENT_TESTS,
+                    graphics::MEMORY_ACCESS_TYPE::DEPTH_STENCIL_ATTACHMENT_READ | graphics::MEMORY_ACCESS_TYPE::DEPTH_STENCIL_ATTACHMENT_WRITE
+                };
+
+            case graphics::RESOURCE_USAGE::DEPTH_STENCIL_READ_ONLY:
+                return {
+                    graphics::IMAGE_LAYOUT::DEPTH_STENCIL_READ_ONLY,
+                    graphics::PIPELINE_STAGE::EARLY_FRAGMENT_TESTS | graphics::PIPELINE_STAGE::LATE_FRAGMENT_TESTS | graphics::PIPELINE_STAGE::FRAGMENT_SHADER,
+                    graphics::MEMORY_ACCESS_TYPE::DEPTH_STENCIL_ATTACHMENT_READ | graphics::MEMORY_ACCESS_TYPE::SHADER_READ
+                };
+
+            case graphics::RESOURCE_USAGE::INPUT_ATTACHMENT:
+                return {
+                    graphics::IMAGE_LAYOUT::SHADER_READ_ONLY,
+                    graphics::PIPELINE_STAGE::FRAGMENT_SHADER,
+                    graphics::MEMORY_ACCESS_TYPE::INPUT_ATTACHMENT_READ
+                };
+
+            case graphics::RESOURCE_USAGE::SAMPLED:
+                return {
+                    graphics::IMAGE_LAYOUT::SHADER_READ_ONLY,
+                    graphics::PIPELINE_STAGE::FRAGMENT_SHADER | graphics::PIPELINE_STAGE::COMPUTE_SHADER,
+                    graphics::MEMORY_ACCESS_TYPE::SHADER_READ
+                };
+
+            case graphics::RESOURCE_USAGE::TRANSFER_SOURCE:
+                return {
+                    graphics::IMAGE_LAYOUT::TRANSFER_SOURCE,
+                    graphics::PIPELINE_STAGE::TRANSFER,
+                    graphics::MEMORY_ACCESS_TYPE::TRANSFER_READ
+                };
+
+            case graphics::RESOURCE_USAGE::TRANSFER_DESTINATION:
+                return {
+                    graphics::IMAGE_LAYOUT::TRANSFER_DESTINATION,
+                    graphics::PIPELINE_STAGE::TRANSFER,
+                    graphics::MEMORY_ACCESS_TYPE::TRANSFER_WRITE
+                };
+
+            case graphics::RESOURCE_USAGE::PRESENT:
+                return {
+                    graphics::IMAGE_LAYOUT::PRESENT_SOURCE,
+                    graphics::PIPELINE_STAGE::BOTTOM_OF_PIPE,
+                    graphics::MEMORY_ACCESS_TYPE{}
+                };
+        }
+
+        return { };
+    }
+
+    bool is_write_usage(graphics::RESOURCE_USAGE usage) noexcept
+    {
+        switch (usage) {
+            case graphics::RESOURCE_USAGE::COLOR_ATTACHMENT:
+            case graphics::RESOURCE_USAGE::DEPTH_STENCIL_ATTACHMENT:
+            case graphics::RESOURCE_USAGE::TRANSFER_DESTINATION:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    std::uint32_t render_graph::create_image(std::string name, graphics::graph_image_description description)
+    {
+        resources_.push_back(graphics::graph_resource{std::move(name), description, false, graphics::resource_state{}, std::nullopt});
+
+        return static_cast<std::uint32_t>(std::size(resources_) - 1);
+    }
+
+    std::uint32_t render_graph::import_image(std::string name, graphics::graph_image_description description,
+                                             graphics::resource_state initial_state, std::optional<graphics::RESOURCE_USAGE> final_usage)
+    {
+        resources_.push_back(graphics::graph_resource{std::move(name), description, true, initial_state, final_usage});
+
+        return static_cast<std::uint32_t>(std::size(resources_) - 1);
+    }
+
+    std::uint32_t render_graph::add_pass(std::string name, std::vector<graphics::graph_resource_access> accesses, bool side_effects)
+    {
+        for (auto &&access : accesses) {
+            if (access.resource >= std::size(resources_))
+                throw graphics::exception(fmt::format("render graph pass '{}' accesses unknown resource #{}", name, access.resource));
+
+            if (std::ranges::count(accesses, access.resource, &graphics::graph_resource_access::resource) > 1)
+                throw graphics::exception(fmt::format("render graph pass '{}' accesses '{}' more than once", name, resources_[access.resource].name));
+
+            if (!resources_[access.resource].imported && !image_usage(access.usage))
+                throw graphics::exception(fmt::format("render graph transient image '{}' can't be presented", resources_[access.resource].name));
+        }
+
+        passes_.push_back(graphics::graph_pass{std::move(name), std::move(accesses), side_effects});
+
+        return static_cast<std::uint32_t>(std::size(passes_) - 1);
+    }
+
+    graphics::compiled_render_graph render_graph::compile() const
+    {
+        std::vector<bool> alive_passes(std::size(passes_), false);
+
+        // Walks the passes backwards keeping the ones that write what is read afterwards or what ends up in the imported images.
+        std::vector<bool> needed_resources(std::size(resources_), false);
+
+        for (std::size_t resource_index = 0; auto &&resource : resources_)
+            needed_resources[resource_index++] = resource.imported;
+
+        for (auto pass_index = std::size(passes_); pass_index-- > 0; ) {
+            auto &&pass = passes_[pass_index];
+
+            auto const contributes = std::ranges::any_of(pass.accesses, [&needed_resources] (auto &&access)
+            {
+                return is_write_usage(access.usage) && needed_resources[access.resource];
+            });
+
+            if (!contributes && !pass.side_effects)
+                continue;
+
+            alive_passes[pass_index] = true;
+
+            for (auto &&access : pass.accesses) {
+                // The imported images are observable outside of the graph, so their previous writers are always kept.
+                auto const overwrites = is_write_usage(access.usage) && access.discard_contents && !resources_[access.resource].imported;
+
+                needed_resources[access.resource] = !overwrites;
+            }
+        }
+
+        std::vector<tracked_state> states;
+        states.reserve(std::size(resources_));
+
+        for (auto &&resource : resources_) {
+            auto &&[layout, stages, access] = resource.initial_state;
+
+            states.push_back(tracked_state{layout, stages, access & kWRITE_ACCESS, graphics::PIPELINE_STAGE{}, graphics::PIPELINE_STAGE{}});
+        }
+
+        graphics::compiled_render_graph compiled_graph;
+
+        std::vector<std::optional<std::size_t>> transient_indices(std::size(resources_));
+
+        for (std::size_t pass_index = 0; pass_index < std::size(passes_); ++pass_index) {
+            if (!alive_passes[pass_index])
+                continue;
+
+            auto const compiled_pass_index = std::size(compiled_graph.passes);
+
+            auto &&compiled_pass = compiled_graph.passes.emplace_back(graphics::compiled_pass{static_cast<std::uint32_t>(pass_index), { }});
+
+            for (auto &&access : passes_[pass_index].accesses) {
+                auto const barrier = access_image(states[access.resource], access.resource, access.usage, access.discard_contents);
+
+                if (!resources_[access.resource].imported) {
+                    auto const usage = *image_usage(access.usage);
+
+                    if (auto &&transient_index = transient_indices[access.resource]; transient_index) {
+                        auto &&transient_image = compiled_graph.transient_images[*transient_index];
+
+                        transient_image.last_pass = compiled_pass_index;
+                        transient_image.usage = transient_image.usage | usage;
+                    }
+
+                    else {
+                        // The first access always transitions the image from the undefined layout.
+                        transient_index = std::size(compiled_graph.transient_images);
+
+                        compiled_graph.transient_images.push_back(graphics::transient_image{
+                            access.resource, compiled_pass_index, compiled_pass_index, std::size(compiled_pass.barriers), usage, graphics::resource_state{}
+                        });
+                    }
+                }
+
+                if (barrier)
+                    compiled_pass.barriers.push_back(*barrier);
+            }
+        }
+
+        for (auto &&transient_image : compiled_graph.transient_images) {
+            auto &&state = states[transient_image.resource];
+
+            if ((transient_image.usage & kNON_ATTACHMENT_USAGE) == graphics::IMAGE_USAGE{})
+                transient_image.usage = transient_image.usage | graphics::IMAGE_USAGE::TRANSIENT_ATTACHMENT;
+
+            transient_image.last_state = graphics::resource_state{state.layout, state.write_stages | state.read_stages, state.write_access};
+
+            // Unless aliased, the image memory has been used only by the image itself in the previous frame.
+            auto &&first_barrier = compiled_graph.passes[transient_image.first_pass].barriers[transient_image.first_barrier];
+
+            first_barrier.source.stages = transient_image.last_state.stages;
+            first_barrier.source.access = transient_image.last_state.access;
+        }
+
+        for (std::uint32_t resource_index = 0; auto &&resource : resources_) {
+            if (resource.imported && resource.final_usage) {
+                if (auto barrier = access_image(states[resource_index], resource_index, *resource.final_usage, false); barrier)
+                    compiled_graph.final_barriers.push_back(*barrier);
+            }
+
+            ++resource_index;
+        }
+
+        return compiled_graph;
+    }
+
+    graphics::transient_memory_layout
+    alias_transient_memory(graphics::compiled_render_graph &compiled_graph, std::vector<graphics::transient_memory_requirements> const &requirements)
+    {
+        auto &&transient_images = compiled_graph.transient_images;
+
+        if (std::size(requirements) != std::size(transient_images))
+            throw graphics::exception("mismatched number of the transient images and their memory requirements"s);
+
+        graphics::transient_memory_layout layout;
+        layout.placements.resize(std::size(transient_images));
+
+        auto const lifetimes_overlap = [&transient_images] (std::size_t lhs, std::size_t rhs)
+        {
+            auto &&a = transient_images[lhs];
+            auto &&b = transient_images[rhs];
+
+            return a.first_pass <= b.last_pass && b.first_pass <= a.last_pass;
+        };
+
+        auto const ranges_overlap = [&layout, &requirements] (std::size_t lhs, std::size_t rhs)
+        {
+            auto &&a = layout.placements[lhs];
+            auto &&b = layout.placements[rhs];
+
+            return a.heap_index == b.heap_index && a.offset < b.offset + requirements[rhs].size && b.offset < a.offset + requirements[lhs].size;
+        };
+
+        // The biggest images are placed first to leave less gaps.
+        std::vector<std::size_t> order(std::size(transient_images));
+        std::iota(std::begin(order), std::end(order), std::size_t{0});
+
+        std::ranges::stable_sort(order, std::greater{}, [&requirements] (auto index) { return requirements[index].size; });
+
+        std::vector<std::size_t> placed;
+        placed.reserve(std::size(order));
+
+        for (auto index : order) {
+            auto &&[size, alignment, memory_type_bits] = requirements[index];
+
+            layout.unaliased_size += size;
+
+            auto it_heap = std::ranges::find_if(layout.heaps, [memory_type_bits] (auto &&heap)
+            {
+                return (heap.memory_type_bits & memory_type_bits) != 0;
+            });
+
+            if (it_heap == std::end(layout.heaps))
+                it_heap = layout.heaps.emplace(std::end(layout.heaps));
+
+            auto const heap_index = static_cast<std::size_t>(std::distance(std::begin(layout.heaps), it_heap));
+
+            // Either the heap start or the end of an image alive at the same time; the last candidate never collides.
+            std::vector<std::size_t> candidates{0};
+
+            for (auto other : placed) {
+                if (layout.placements[other].heap_index == heap_index && lifetimes_overlap(index, other))
+                    candidates.push_back(layout.placements[other].offset + requirements[other].size);
+            }
+
+            std::ranges::sort(candidates);
+
+            for (auto candidate : candidates) {
+                layout.placements[index] = graphics::transient_memory_placement{heap_index, boost::alignment::align_up(candidate, alignment)};
+
+                auto const collides = std::ranges::any_of(placed, [&] (auto other)
+                {
+                    return lifetimes_overlap(index, other) && ranges_overlap(index, other);
+                });
+
+                if (!collides)
+                    break;
+            }
+
+            auto &&heap = *it_heap;
+
+            heap.size = std::max(heap.size, layout.placements[index].offset + size);
+            heap.alignment = std::max(heap.alignment, alignment);
+            heap.memory_type_bits &= memory_type_bits;
+
+            placed.push_back(index);
+        }
+
+        // Images sharing the memory are used in the previous frame as well, so the first use waits for all of them.
+        for (std::size_t index = 0; auto &&transient_image : transient_images) {
+            graphics::resource_state source;
+
+            for (std::size_t other = 0; other < std::size(transient_images); ++other) {
+                if (other == index || ranges_overlap(index, other)) {
+                    source.stages = source.stages | transient_images[other].last_state.stages;
+                    source.access = source.access | transient_images[other].last_state.access;
+                }
+            }
+
+            auto &&first_barrier = compiled_graph.passes[transient_image.first_pass].barriers[transient_image.first_barrier];
+
+            first_barrier.source.stages = source.stages;
+            first_barrier.source.access = source.access;
+
+            ++index;
+        }
+
+        return layout;
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "graphics/graphics.hxx"
+
+
+namespace graphics
+{
+    // How a pass uses an image; the usage implies the image layout, pipeline stages and memory accesses.
+    enum struct RESOURCE_USAGE {
+        COLOR_ATTACHMENT = 0,
+        DEPTH_STENCIL_ATTACHMENT,
+        DEPTH_STENCIL_READ_ONLY,
+        INPUT_ATTACHMENT,
+        SAMPLED,
+        TRANSFER_SOURCE,
+        TRANSFER_DESTINATION,
+        PRESENT
+    };
+
+    struct resource_state final {
+        graphics::IMAGE_LAYOUT layout{graphics::IMAGE_LAYOUT::UNDEFINED};
+
+        graphics::PIPELINE_STAGE stages{};
+        graphics::MEMORY_ACCESS_TYPE access{};
+    };
+
+    [[nodiscard]] graphics::resource_state usage_state(graphics::RESOURCE_USAGE usage) noexcept;
+
+    [[nodiscard]] bool is_write_usage(graphics::RESOURCE_USAGE usage) noexcept;
+
+    struct graph_image_description final {
+        graphics::FORMAT format;
+        render::extent extent;
+
+        std::uint32_t samples_count{1};
+    };
+
+    struct graph_resource final {
+        std::string name;
+
+        graphics::graph_image_description description;
+
+        // Imported images are owned outside of the graph, e.g. the swapchain ones, and are never culled or aliased.
+        bool imported;
+
+        // The state an imported image is in before the first pass and the usage it's transitioned to after the last one.
+        graphics::resource_state initial_state;
+        std::optional<graphics::RESOURCE_USAGE> final_usage;
+    };
+
+    struct graph_resource_access final {
+        std::uint32_t resource;
+        graphics::RESOURCE_USAGE usage;
+
+        // Writes that don't depend on the previous contents, e.g. cleared attachments, make the previous writers cullable.
+        bool discard_contents{false};
+    };
+
+    struct graph_pass final {
+        std::string name;
+
+        std::vector<graphics::graph_resource_access> accesses;
+
+        // Passes with side effects aren't culled even if nothing reads what they write.
+        bool side_effects{false};
+    };
+
+    struct image_barrier final {
+        std::uint32_t resource;
+
+        graphics::resource_state source, destination;
+    };
+
+    struct compiled_pass final {
+        std::uint32_t pass_index;
+
+        // Recorded right before the pass.
+        std::vector<graphics::image_barrier> barriers;
+    };
+
+    // Lifetime of a transient image in terms of the compiled passes.
+    struct transient_image final {
+        std::uint32_t resource;
+
+        std::size_t first_pass, last_pass;
+
+        // Index of the image's first barrier in the first pass' barriers.
+        std::size_t first_barrier;
+
+        graphics::IMAGE_USAGE usage;
+
+        // Stages and accesses the next user of the image memory has to wait for.
+        graphics::resource_state last_state;
+    };
+
+    struct compiled_render_graph final {
+        std::vector<graphics::compiled_pass> passes;
+
+        // Transitions of the imported images to their final usages.
+        std::vector<graphics::image_barrier> final_barriers;
+
+        std::vector<graphics::transient_image> transient_images;
+    };
+
+    // Passes are executed in the order they've been added; the compilation only culls the ones that don't contribute
+    // to the imported images and computes the barriers in between the rest.
+    class render_graph final {
+    public:
+
+        std::uint32_t create_image(std::string name, graphics::graph_image_description description);
+
+        std::uint32_t import_image(std::string name, graphics::graph_image_description description,
+                                   graphics::resource_state initial_state, std::optional<graphics::RESOURCE_USAGE> final_usage);
+
+        // A resource can be accessed only once per pass.
+        std::uint32_t add_pass(std::string name, std::vector<graphics::graph_resource_access> accesses, bool side_effects = false);
+
+        [[nodiscard]] std::vector<graphics::graph_resource> const &resources() const noexcept { return resources_; }
+        [[nodiscard]] std::vector<graphics::graph_pass> const &passes() const noexcept { return passes_; }
+
+        [[nodiscard]] graphics::compiled_render_graph compile() const;
+
+    private:
+
+        std::vector<graphics::graph_resource> resources_;
+        std::vector<graphics::graph_pass> passes_;
+    };
+
+    struct transient_memory_requirements final {
+        std::size_t size, alignment;
+        std::uint32_t memory_type_bits;
+    };
+
+    struct transient_memory_heap final {
+        std::size_t size{0}, alignment{1};
+        std::uint32_t memory_type_bits{~0u};
+    };
+
+    struct transient_memory_placement final {
+        std::size_t heap_index;
+        std::size_t offset;
+    };
+
+    struct transient_memory_layout final {
+        std::vector<graphics::transient_memory_heap> heaps;
+
+        // Indexed as the compiled graph's transient images.
+        std::vector<graphics::transient_memory_placement> placements;
+
+        // Total size the transient images would take without the aliasing.
+        std::size_t unaliased_size{0};
+    };
+
+    // Places the transient images, whose memory requirements are indexed as 'compiled_graph.transient_images', into the heaps,
+    // so that the images with overlapping lifetimes never overlap in memory. The first barrier of an image is made to wait
+    // for all the images sharing its memory, including the previous frame's uses.
+    [[nodiscard]] graphics::transient_memory_layout
+    alias_transient_memory(graphics::compiled_render_graph &compiled_graph, std::vector<graphics::transient_memory_requirements> const &requirements);
+}
@@ -165,16 +165,9 @@ namespace render
         auto &&image_available_semaphore = image_available_semaphores_[current_frame_index_];
         auto &&render_finished_semaphore = render_finished_semaphores_[current_frame_index_];
 
-#define USE_FENCES 1
+        auto &&timeline = device.graphics_queue.timeline();
 
-#if USE_FENCES
-        auto &&frame_fence = concurrent_frames_fences_[current_frame_index_];
-
-        if (auto result = vkWaitForFences(device.handle(), 1, frame_fence->handle_ptr(), VK_TRUE, std::numeric_limits<std::uint64_t>::max()); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to wait current frame fence: {0:#x}", result));
-#else
-        vkQueueWaitIdle(device.presentation_queue.handle());
-#endif
+        timeline.wait(frames_timeline_values_[current_frame_index_]);
 
         /*VkAcquireNextImageInfoKHR next_image_info{
             VK_STRUCTURE_TYPE_ACQUIRE_NEXT_IMAGE_INFO_KHR,
@@ -201,16 +194,23 @@ namespace render
                 throw vulkan::exception(fmt::format("failed to acquire next image index: {0:#x}", result));
         }
 
-#if USE_FENCES
-        if (auto &&fence = busy_frames_fences_.at(image_index); fence && fence->handle() != VK_NULL_HANDLE)
-            if (auto result = vkWaitForFences(device.handle(), 1, fence->handle_ptr(), VK_TRUE, std::numeric_limits<std::uint64_t>::max()); result != VK_SUCCESS)
-                throw vulkan::exception(fmt::format("failed to wait busy frame fence: {0:#x}", result));
+        timeline.wait(busy_images_timeline_values_.at(image_index));
 
-        busy_frames_fences_.at(image_index) = frame_fence;
-#endif
+        auto const timeline_value = timeline.next_value();
 
         auto const wait_semaphores = std::array{ image_available_semaphore->handle() };
-        auto const signal_semaphores = std::array{ render_finished_semaphore->handle() };
+        auto const signal_semaphores = std::array{ render_finished_semaphore->handle(), timeline.handle() };
+
+        // Values of the binary semaphores are ignored.
+        auto const wait_values = std::array{ std::uint64_t{0} };
+        auto const signal_values = std::array{ std::uint64_t{0}, timeline_value };
+
+        VkTimelineSemaphoreSubmitInfo const timeline_info{
+            VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            nullptr,
+            static_cast<std::uint32_t>(std::size(wait_values)), std::data(wait_values),
+            static_cast<std::uint32_t>(std::size(signal_values)), std::data(signal_values)
+        };
 
         auto const wait_stages = std::array{
             VkPipelineStageFlags{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT }
@@ -218,30 +218,28 @@ namespace render
 
         VkSubmitInfo const submit_info{
             VK_STRUCTURE_TYPE_SUBMIT_INFO,
-            nullptr,
+            &timeline_info,
             static_cast<std::uint32_t>(std::size(wait_semaphores)), std::data(wait_semaphores),
             std::data(wait_stages),
             1, &command_buffers[image_index],
             static_cast<std::uint32_t>(std::size(signal_semaphores)), std::data(signal_semaphores),
         };
 
-#if USE_FENCES
-        if (auto result = vkResetFences(device.handle(), 1, frame_fence->handle_ptr()); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to reset previous frame fence: {0:#x}", result));
-
-        if (auto result = vkQueueSubmit(device.graphics_queue.handle(), 1, &submit_info, frame_fence->handle()); result != VK_SUCCESS)
-            throw vulkan::exception(fmt::format("failed to submit draw command buffer: {0:#x}", result));
-#else
         if (auto result = vkQueueSubmit(device.graphics_queue.handle(), 1, &submit_info, VK_NULL_HANDLE); result != VK_SUCCESS)
-        throw vulkan::exception(fmt::format("failed to submit draw command buffer: {0:#x}", result));
-#endif
+            throw vulkan::exception(fmt::format("failed to submit draw command buffer: {0:#x}", result));
+
+        timeline.commit_value(timeline_value);
+
+        frames_timeline_values_[current_frame_index_] = timeline_value;
+        busy_images_timeline_values_.at(image_index) = timeline_value;
 
         auto swapchain_handle = swapchain.handle();
 
+        // Presentation can wait only for the binary semaphore.
         VkPresentInfoKHR const present_info{
                 VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
                 nullptr,
-                static_cast<std::uint32_t>(std::size(signal_semaphores)), std::data(signal_semaphores),
+                1, std::data(signal_semaphores),
                 1, &swapchain_handle,
                 &image_index, nullptr
         };
@@ -259,9 +257,7 @@ namespace render
                 throw vulkan::exception(fmt::format("failed to submit request to present framebuffer: {0:#x}", result));
         }
 
-#if USE_FENCES
         current_frame_index_ = (current_frame_index_ + 1) % render::kCONCURRENTLY_PROCESSED_FRAMES;
-#endif
     }
 
     void renderer::fill_draw_command_buffers(std::span<VkCommandBuffer> command_buffers, render::draw_commands_holder &draw_commands_holder, app_t const &app)
@@ -282,6 +278,8 @@ namespace render
         auto indexed = draw_commands_holder.get_indexed_primitives_buffers_bind_range();
 
         for (auto i = 0u; auto &command_buffer : command_buffers) {
+            auto const image_index = i++;
+
             VkCommandBufferBeginInfo const begin_info{
                 VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
                 nullptr,
@@ -300,7 +298,7 @@ namespace render
                 VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
                 nullptr,
                 app.render_pass->handle(),
-                app.framebuffers.at(i++)->handle(),
+                app.framebuffers.at(image_index)->handle(),
                 {{0, 0}, VkExtent2D{width, height}},
                 static_cast<std::uint32_t>(std::size(clear_colors)), std::data(clear_colors)
             };
@@ -322,8 +320,20 @@ namespace render
             vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 #endif
 
-            const auto min_offset_alignment = static_cast<std::size_t>(device_->device_limits().min_storage_buffer_offset_alignment);
-            auto aligned_offset = boost::alignment::align_up(sizeof(per_object_t), min_offset_alignment);
+            auto const view_uniforms_offset = app.view_uniforms->dynamic_offset(image_index);
+            auto const object_buffer_offset = app.object_buffer->dynamic_offset(image_index);
+
+            std::array<std::uint32_t, 3> const dynamic_offsets{view_uniforms_offset, view_uniforms_offset, object_buffer_offset};
+
+            auto const push_per_draw_data = [command_buffer] (auto &&dc)
+            {
+                per_draw_t const per_draw{dc.transform_index};
+
+                for (auto &&range : dc.material->push_constant_ranges) {
+                    vkCmdPushConstants(command_buffer, dc.pipeline_layout, static_cast<VkShaderStageFlags>(convert_to::vulkan(range.shader_stages)),
+                                       range.offset, range.size, reinterpret_cast<std::byte const *>(&per_draw) + range.offset);
+                }
+            };
 
             for (auto &&range : indexed) {
                 vkCmdBindIndexBuffer(command_buffer, range.index_buffer_handle, range.index_buffer_offset, convert_to::vulkan(range.index_type));
@@ -342,15 +352,13 @@ namespace render
                                    app.view_resources_descriptor_set, dc.descriptor_set, app.image_resources_descriptor_set
                                };
 
-                               std::array<std::uint32_t, 1> dynamic_offsets{
-                                   dc.transform_index * static_cast<std::uint32_t>(aligned_offset)
-                               };
-
                                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline_layout,
                                                        0,
                                                        static_cast<std::uint32_t>(std::size(descriptor_sets)), std::data(descriptor_sets),
                                                        static_cast<std::uint32_t>(std::size(dynamic_offsets)), std::data(dynamic_offsets));
 
+                               push_per_draw_data(dc);
+
                                vkCmdDrawIndexed(command_buffer, dc.index_count, 1, dc.first_index, static_cast<std::int32_t>(dc.first_vertex), 0);
                            }
                        }
@@ -371,15 +379,13 @@ namespace render
                            app.view_resources_descriptor_set, dc.descriptor_set, app.image_resources_descriptor_set
                        };
 
-                       std::array<std::uint32_t, 1> dynamic_offsets{
-                           dc.transform_index *static_cast<std::uint32_t>(aligned_offset)
-                       };
-
                        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipeline_layout,
                                                0,
                                                static_cast<std::uint32_t>(std::size(descriptor_sets)), std::data(descriptor_sets),
                                                static_cast<std::uint32_t>(std::size(dynamic_offsets)), std::data(dynamic_offsets));
 
+                       push_per_draw_data(dc);
+
                        vkCmdDraw(command_buffer, dc.vertex_count, 1, dc.first_vertex, 0);
                    }
                }, range.draw_commands);
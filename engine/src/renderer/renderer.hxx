@@ -103,6 +103,8 @@ namespace render
         [[nodiscard]]
         std::vector<render::indexed_primitives_buffers_bind_range> get_indexed_primitives_buffers_bind_range();
 
+        [[nodiscard]] std::size_t size() const noexcept { return std::size(nonindexed_draw_commands_) + std::size(indexed_draw_commands_); }
+
         void clear();
 
     private:
@@ -153,9 +155,10 @@ namespace render
         std::array<std::shared_ptr<resource::semaphore>, render::kCONCURRENTLY_PROCESSED_FRAMES> image_available_semaphores_;
         std::array<std::shared_ptr<resource::semaphore>, render::kCONCURRENTLY_PROCESSED_FRAMES> render_finished_semaphores_;
 
-        std::array<std::shared_ptr<resource::fence>, render::kCONCURRENTLY_PROCESSED_FRAMES> concurrent_frames_fences_;
+        // Graphics queue timeline values the frames and the swapchain images have been last submitted with.
+        std::array<std::uint64_t, render::kCONCURRENTLY_PROCESSED_FRAMES> frames_timeline_values_{};
 
-        std::vector<std::shared_ptr<resource::fence>> busy_frames_fences_;
+        std::vector<std::uint64_t> busy_images_timeline_values_;
 
         /*std::shared_ptr<graphics::render_pass> render_pass_;
         std::unique_ptr<graphics::render_pass_manager> render_pass_manager_;*/
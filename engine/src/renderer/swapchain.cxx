@@ -52,15 +52,18 @@ namespace
         throw vulkan::swapchain_exception("none of required surface formats are supported");
     }
 
+    // FIFO is the only mode required to be supported.
     graphics::PRESENTATION_MODE
-    choose_supported_presentation_mode(render::swapchain_support_details const &support_details,
-                                       std::vector<graphics::PRESENTATION_MODE> &&required_modes)
+    choose_supported_presentation_mode(render::swapchain_support_details const &support_details, graphics::PRESENTATION_MODE required_mode)
     {
         auto &&supported_modes = support_details.presentation_modes;
 
-        auto it = std::ranges::find_first_of(required_modes, supported_modes);
+        if (std::ranges::find(supported_modes, required_mode) != std::cend(supported_modes))
+            return required_mode;
 
-        return it != std::cend(required_modes) ? *it : graphics::PRESENTATION_MODE::FIFO;
+        fmt::print(stderr, "required presentation mode isn't supported, FIFO is used instead\n");
+
+        return graphics::PRESENTATION_MODE::FIFO;
     }
 
     render::extent adjust_swapchain_extent(render::swapchain_support_details const &support_details, render::extent extent)
@@ -98,7 +101,8 @@ namespace
 namespace render
 {
     swapchain::swapchain(vulkan::device const &device, render::platform_surface const &platform_surface,
-                         render::surface_format surface_format, render::extent extent) : device_{ device}
+                         render::surface_format surface_format, render::extent extent, render::presentation_config const &presentation_config,
+                         render::swapchain const *old_swapchain) : device_{ device}
     {
         auto &&presentation_queue = device.presentation_queue;
         auto &&graphics_queue = device.graphics_queue;
@@ -107,21 +111,19 @@ namespace render
 
         surface_format_ = choose_supported_surface_format(swapchain_support_details, std::vector{surface_format});
 
-        presentation_mode_ = choose_supported_presentation_mode(swapchain_support_details, std::vector{
-        #ifndef _DEBUG
-            graphics::PRESENTATION_MODE::MAILBOX,
-        #endif
-            graphics::PRESENTATION_MODE::FIFO_RELAXED,
-            graphics::PRESENTATION_MODE::IMMEDIATE
-        });
+        presentation_mode_ = choose_supported_presentation_mode(swapchain_support_details, presentation_config.presentation_mode);
 
         extent_ = adjust_swapchain_extent(swapchain_support_details, extent);
 
         {
-            auto image_count = swapchain_support_details.surface_capabilities.minImageCount + 1;
+            auto &&surface_capabilities = swapchain_support_details.surface_capabilities;
+
+            auto image_count = presentation_config.swapchain_images_number != 0 ? presentation_config.swapchain_images_number : surface_capabilities.minImageCount + 1;
+
+            image_count = std::max(image_count, surface_capabilities.minImageCount);
 
-            if (swapchain_support_details.surface_capabilities.maxImageCount > 0)
-                image_count = std::min(image_count, swapchain_support_details.surface_capabilities.maxImageCount);
+            if (surface_capabilities.maxImageCount > 0)
+                image_count = std::min(image_count, surface_capabilities.maxImageCount);
 
             VkSwapchainCreateInfoKHR create_info{
                 VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
@@ -138,7 +140,7 @@ namespace render
                 VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
                 convert_to::vulkan(presentation_mode_),
                 VK_FALSE,
-                nullptr
+                old_swapchain ? old_swapchain->handle() : VK_NULL_HANDLE
             };
 
             if (graphics_queue.family() != presentation_queue.family()) {
@@ -204,7 +206,8 @@ namespace render
 
 
 std::unique_ptr<render::swapchain>
-create_swapchain(vulkan::device const &device, render::platform_surface const &platform_surface, render::extent extent)
+create_swapchain(vulkan::device const &device, render::platform_surface const &platform_surface, render::extent extent,
+                 render::presentation_config const &presentation_config, render::swapchain const *old_swapchain)
 {
     auto surface_formats = std::vector<render::surface_format>{
         { graphics::FORMAT::BGRA8_SRGB, graphics::COLOR_SPACE::SRGB_NONLINEAR },
@@ -215,7 +218,7 @@ create_swapchain(vulkan::device const &device, render::platform_surface const &p
 
     for (auto surface_format : surface_formats) {
         try {
-            swapchain = std::make_unique<render::swapchain>(device, platform_surface, surface_format, extent);
+            swapchain = std::make_unique<render::swapchain>(device, platform_surface, surface_format, extent, presentation_config, old_swapchain);
 
         } catch (vulkan::swapchain_exception const &ex) {
             std::cout << ex.what() << std::endl;
@@ -6,6 +6,7 @@
 #include "graphics/graphics.hxx"
 #include "resources/buffer.hxx"
 #include "resources/image.hxx"
+#include "renderer/config.hxx"
 
 
 namespace render
@@ -13,8 +14,9 @@ namespace render
     class swapchain final {
     public:
 
-        swapchain(vulkan::device const &device, render::platform_surface const &platform_surface,
-                  render::surface_format surface_format, render::extent extent);
+        // The old swapchain, if any, gets retired; it has to be kept alive until the frames presenting its images complete.
+        swapchain(vulkan::device const &device, render::platform_surface const &platform_surface, render::surface_format surface_format,
+                  render::extent extent, render::presentation_config const &presentation_config, render::swapchain const *old_swapchain = nullptr);
 
         ~swapchain();
 
@@ -24,6 +26,8 @@ namespace render
 
         render::extent extent() const noexcept { return extent_; }
 
+        graphics::PRESENTATION_MODE presentation_mode() const noexcept { return presentation_mode_; }
+
         std::vector<std::shared_ptr<resource::image>> const &images() const noexcept { return images_; }
         std::vector<std::shared_ptr<resource::image_view>> const &image_views() const noexcept { return image_views_; }
 
@@ -50,4 +54,5 @@ namespace render
 }
 
 std::unique_ptr<render::swapchain>
-create_swapchain(vulkan::device const &device, render::platform_surface const &platform_surface, render::extent extent);
+create_swapchain(vulkan::device const &device, render::platform_surface const &platform_surface, render::extent extent,
+                 render::presentation_config const &presentation_config, render::swapchain const *old_swapchain = nullptr);
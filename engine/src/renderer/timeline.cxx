@@ -0,0 +1,88 @@
+#include <fmt/format.h>
+
+#include "utility/exceptions.hxx"
+#include "timeline.hxx"
+
+
+namespace render
+{
+    timeline::timeline(VkDevice device) : device_{device}
+    {
+        VkSemaphoreTypeCreateInfo const type_create_info{
+            VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            nullptr,
+            VK_SEMAPHORE_TYPE_TIMELINE,
+            0
+        };
+
+        VkSemaphoreCreateInfo const create_info{
+            VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            &type_create_info, 0
+        };
+
+        if (auto result = vkCreateSemaphore(device_, &create_info, nullptr, &handle_); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to create a timeline semaphore: {0:#x}", result));
+    }
+
+    timeline::~timeline()
+    {
+        if (handle_ != VK_NULL_HANDLE)
+            vkDestroySemaphore(device_, handle_, nullptr);
+    }
+
+    std::uint64_t timeline::completed_value() const
+    {
+        std::uint64_t value = 0;
+
+        if (auto result = vkGetSemaphoreCounterValue(device_, handle_, &value); result != VK_SUCCESS)
+            throw vulkan::exception(fmt::format("failed to get timeline semaphore value: {0:#x}", result));
+
+        update_completed_value(value);
+
+        return value;
+    }
+
+    bool timeline::is_completed(std::uint64_t value) const
+    {
+        if (value <= completed_value_.load(std::memory_order_relaxed))
+            return true;
+
+        return value <= completed_value();
+    }
+
+    bool timeline::wait(std::uint64_t value, std::uint64_t timeout) const
+    {
+        if (value <= completed_value_.load(std::memory_order_relaxed))
+            return true;
+
+        VkSemaphoreWaitInfo const wait_info{
+            VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+            nullptr,
+            0,
+            1, &handle_, &value
+        };
+
+        switch (auto result = vkWaitSemaphores(device_, &wait_info, timeout); result) {
+            case VK_SUCCESS:
+                break;
+
+            case VK_TIMEOUT:
+                return false;
+
+            default:
+                throw vulkan::exception(fmt::format("failed to wait timeline semaphore: {0:#x}", result));
+        }
+
+        update_completed_value(value);
+
+        return true;
+    }
+
+    void timeline::update_completed_value(std::uint64_t value) const noexcept
+    {
+        // Another thread may have cached a greater value in between.
+        auto cached_value = completed_value_.load(std::memory_order_relaxed);
+
+        while (cached_value < value && !completed_value_.compare_exchange_weak(cached_value, value, std::memory_order_relaxed));
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <cstdint>
+
+#include <volk.h>
+
+
+namespace render
+{
+    // Timeline semaphore signaled by the submissions to a single queue, so its values complete in the order they've been committed in.
+    // Any thread may query or wait for a value; the value has to be taken, submitted and committed under the queue's external synchronization.
+    class timeline final {
+    public:
+
+        explicit timeline(VkDevice device);
+        ~timeline();
+
+        [[nodiscard]] VkSemaphore handle() const noexcept { return handle_; }
+
+        // The value the next submission has to signal.
+        [[nodiscard]] std::uint64_t next_value() const noexcept { return last_value_.load(std::memory_order_relaxed) + 1; }
+
+        // Has to be called once the submission signaling the next value has succeeded; a failed one leaves nothing to wait for.
+        void commit_value(std::uint64_t value) noexcept { last_value_.store(value, std::memory_order_relaxed); }
+
+        // The last committed value; it's completed once all the submissions made so far are.
+        [[nodiscard]] std::uint64_t last_value() const noexcept { return last_value_.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] std::uint64_t completed_value() const;
+
+        [[nodiscard]] bool is_completed(std::uint64_t value) const;
+
+        // Returns false if the timeout has expired before the value has been signaled.
+        bool wait(std::uint64_t value, std::uint64_t timeout = std::numeric_limits<std::uint64_t>::max()) const;
+
+    private:
+
+        VkDevice device_{VK_NULL_HANDLE};
+        VkSemaphore handle_{VK_NULL_HANDLE};
+
+        std::atomic<std::uint64_t> last_value_{0};
+
+        // Saves querying the semaphore for the values known to be completed.
+        mutable std::atomic<std::uint64_t> completed_value_{0};
+
+        void update_completed_value(std::uint64_t value) const noexcept;
+
+        timeline() = delete;
+        timeline(timeline const &) = delete;
+        timeline(timeline &&) = delete;
+    };
+}
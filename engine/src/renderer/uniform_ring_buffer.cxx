@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <boost/align/align_up.hpp>
+#include <boost/align/align_down.hpp>
+
+#include "uniform_ring_buffer.hxx"
+
+
+namespace render
+{
+    uniform_ring_buffer::uniform_ring_buffer(vulkan::device const &device, resource::resource_manager &resource_manager,
+                                             std::span<std::size_t const> ranges_sizes, std::uint32_t slots_number,
+                                             graphics::BUFFER_USAGE usage_flags)
+        : device_{device}, ranges_sizes_{std::cbegin(ranges_sizes), std::cend(ranges_sizes)}, slots_number_{slots_number},
+          slots_timeline_values_(slots_number, 0)
+    {
+        if (ranges_sizes_.empty() || slots_number_ == 0)
+            throw graphics::exception("uniform ring buffer has to have at least one range and one slot"s);
+
+        auto &&limits = device.device_limits();
+
+        auto offset_alignment = std::size_t{1};
+
+        if (static_cast<bool>(usage_flags & graphics::BUFFER_USAGE::UNIFORM_BUFFER))
+            offset_alignment = std::max(offset_alignment, static_cast<std::size_t>(limits.min_uniform_buffer_offset_alignment));
+
+        if (static_cast<bool>(usage_flags & graphics::BUFFER_USAGE::STORAGE_BUFFER))
+            offset_alignment = std::max(offset_alignment, static_cast<std::size_t>(limits.min_storage_buffer_offset_alignment));
+
+        // The slots are flushed independently, so they mustn't share the non-coherent atoms.
+        auto const slot_alignment = std::max(offset_alignment, static_cast<std::size_t>(limits.non_coherent_atom_size));
+
+        for (auto range_size : ranges_sizes_) {
+            ranges_offsets_.push_back(slot_size_);
+            slot_size_ = boost::alignment::align_up(slot_size_ + range_size, offset_alignment);
+        }
+
+        slot_size_ = boost::alignment::align_up(slot_size_, slot_alignment);
+
+        auto const size_bytes = slot_size_ * slots_number_;
+
+        auto constexpr property_flags = graphics::MEMORY_PROPERTY_TYPE::HOST_VISIBLE;
+        auto constexpr sharing_mode = graphics::RESOURCE_SHARING_MODE::EXCLUSIVE;
+
+        buffer_ = resource_manager.create_buffer(size_bytes, usage_flags, property_flags, sharing_mode);
+
+        if (buffer_ == nullptr)
+            throw resource::instantiation_fail("failed to create the uniform ring buffer"s);
+
+        // The memory may be shared with other host visible buffers, so it's the memory manager that keeps it mapped.
+        auto const mapped_range = buffer_->memory()->mapped_range();
+
+        if (std::size(mapped_range) < size_bytes)
+            throw resource::exception("uniform ring buffer memory isn't mapped"s);
+
+        mapped_range_ = mapped_range.first(size_bytes);
+    }
+
+    VkDescriptorBufferInfo uniform_ring_buffer::descriptor_buffer_info(std::size_t range_index) const
+    {
+        return VkDescriptorBufferInfo{
+            buffer_->handle(), ranges_offsets_.at(range_index), ranges_sizes_.at(range_index)
+        };
+    }
+
+    std::optional<VkMappedMemoryRange> uniform_ring_buffer::flush_range(std::uint32_t slot_index) const
+    {
+        auto &&memory = *buffer_->memory();
+
+        if (static_cast<bool>(memory.properties() & graphics::MEMORY_PROPERTY_TYPE::HOST_COHERENT))
+            return { };
+
+        auto const atom_size = static_cast<std::size_t>(device_.device_limits().non_coherent_atom_size);
+
+        // The memory block's offset isn't necessarily aligned to the atom size, unlike the slots relative to it.
+        auto const offset = memory.offset() + slot_size_ * slot_index;
+        auto const aligned_offset = boost::alignment::align_down(offset, atom_size);
+
+        return VkMappedMemoryRange{
+            VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+            nullptr,
+            memory.handle(),
+            aligned_offset,
+            boost::alignment::align_up(offset + slot_size_ - aligned_offset, atom_size)
+        };
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+#include "utility/exceptions.hxx"
+#include "vulkan/device.hxx"
+#include "graphics/graphics.hxx"
+#include "resources/buffer.hxx"
+#include "resources/resource_manager.hxx"
+
+
+namespace render
+{
+    // Persistently mapped uniform buffer with a slot per command buffer; every slot holds all the ranges, and the shaders
+    // select the slot by the dynamic offset recorded into the command buffer. A slot is written only after the submissions
+    // that have read it complete, so an update is a plain copy and no frame in flight sees it.
+    class uniform_ring_buffer final {
+    public:
+
+        // The ranges are aligned for the dynamic offsets of the uniform and storage buffer usages the buffer is created with.
+        uniform_ring_buffer(vulkan::device const &device, resource::resource_manager &resource_manager,
+                            std::span<std::size_t const> ranges_sizes, std::uint32_t slots_number,
+                            graphics::BUFFER_USAGE usage_flags = graphics::BUFFER_USAGE::UNIFORM_BUFFER);
+
+        [[nodiscard]] std::shared_ptr<resource::buffer> const &buffer() const noexcept { return buffer_; }
+
+        [[nodiscard]] std::uint32_t slots_number() const noexcept { return slots_number_; }
+
+        // The range of the first slot; the dynamic offsets move it to the other ones.
+        [[nodiscard]] VkDescriptorBufferInfo descriptor_buffer_info(std::size_t range_index) const;
+
+        [[nodiscard]] std::uint32_t dynamic_offset(std::uint32_t slot_index) const noexcept
+        {
+            return static_cast<std::uint32_t>(slot_size_ * slot_index);
+        }
+
+        // Timeline value of the last submission reading the slot; it has to complete before the slot is written.
+        [[nodiscard]] std::uint64_t slot_timeline_value(std::uint32_t slot_index) const { return slots_timeline_values_.at(slot_index); }
+
+        void submit(std::uint32_t slot_index, std::uint64_t timeline_value) { slots_timeline_values_.at(slot_index) = timeline_value; }
+
+        template<class T> requires std::is_trivially_copyable_v<T>
+        void write(std::uint32_t slot_index, std::size_t range_index, T const &data)
+        {
+            if (sizeof(T) > ranges_sizes_.at(range_index) || slot_index >= slots_number_)
+                throw graphics::exception("uniform ring buffer write is out of the range");
+
+            std::memcpy(std::data(mapped_range_) + slot_size_ * slot_index + ranges_offsets_.at(range_index), &data, sizeof(T));
+        }
+
+        template<class T> requires std::is_trivially_copyable_v<T>
+        void write(std::uint32_t slot_index, std::size_t range_index, std::span<T const> data)
+        {
+            if (std::size(data) * sizeof(T) > ranges_sizes_.at(range_index) || slot_index >= slots_number_)
+                throw graphics::exception("uniform ring buffer write is out of the range");
+
+            std::memcpy(std::data(mapped_range_) + slot_size_ * slot_index + ranges_offsets_.at(range_index), std::data(data), std::size(data) * sizeof(T));
+        }
+
+        // Reads what the device has written into a slot, once the submission writing it has completed.
+        template<class T> requires std::is_trivially_copyable_v<T>
+        [[nodiscard]] T read(std::uint32_t slot_index, std::size_t range_index) const
+        {
+            if (sizeof(T) > ranges_sizes_.at(range_index) || slot_index >= slots_number_)
+                throw graphics::exception("uniform ring buffer read is out of the range");
+
+            T data;
+            std::memcpy(&data, std::data(mapped_range_) + slot_size_ * slot_index + ranges_offsets_.at(range_index), sizeof(T));
+
+            return data;
+        }
+
+        // Empty if the memory is host coherent; the ranges are returned to be flushed along with the other ones at once,
+        // or to be invalidated before a slot the device has written is read.
+        [[nodiscard]] std::optional<VkMappedMemoryRange> flush_range(std::uint32_t slot_index) const;
+
+    private:
+
+        vulkan::device const &device_;
+
+        std::shared_ptr<resource::buffer> buffer_;
+        std::span<std::byte> mapped_range_;
+
+        std::vector<std::size_t> ranges_sizes_;
+        std::vector<std::size_t> ranges_offsets_;
+
+        std::size_t slot_size_{0};
+        std::uint32_t slots_number_{0};
+
+        std::vector<std::uint64_t> slots_timeline_values_;
+
+        uniform_ring_buffer() = delete;
+        uniform_ring_buffer(uniform_ring_buffer const &) = delete;
+        uniform_ring_buffer(uniform_ring_buffer &&) = delete;
+    };
+}
@@ -113,6 +113,9 @@ namespace resource
 
         graphics::vertex_layout const &vertex_layout() const noexcept { return vertex_layout_; }
 
+        // Computed once, so the per-draw lookups keyed by the layout don't hash its attributes.
+        std::size_t vertex_layout_hash() const noexcept { return vertex_layout_hash_; }
+
     private:
 
         std::shared_ptr<resource::buffer> device_buffer_{nullptr};
@@ -121,6 +124,7 @@ namespace resource
         std::size_t available_size_{0};
 
         graphics::vertex_layout vertex_layout_;
+        std::size_t vertex_layout_hash_{0};
 
         vertex_buffer() = delete;
         vertex_buffer(vertex_buffer const &) = delete;
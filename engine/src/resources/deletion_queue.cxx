@@ -0,0 +1,69 @@
+#include <vector>
+#include <algorithm>
+
+#include "utility/trace.hxx"
+#include "deletion_queue.hxx"
+
+
+namespace resource
+{
+    deletion_queue::~deletion_queue()
+    {
+        timeline_.wait(timeline_.last_value());
+
+        // Deleters may release other objects, which are pushed in turn.
+        while (collect() != 0);
+    }
+
+    void deletion_queue::push(std::function<void()> deleter)
+    {
+        std::lock_guard lock{mutex_};
+
+        entries_.push_back(entry{timeline_.last_value(), std::move(deleter)});
+
+        TRACE_COUNTER("deletion queue: pending objects", std::size(entries_));
+    }
+
+    std::size_t deletion_queue::collect()
+    {
+        TRACE_FUNCTION();
+
+        std::vector<std::function<void()>> deleters;
+
+        {
+            std::lock_guard lock{mutex_};
+
+            if (entries_.empty())
+                return 0;
+
+            auto const completed_value = timeline_.completed_value();
+
+            auto const it_end = std::ranges::find_if(entries_, [completed_value] (auto &&entry)
+            {
+                return entry.timeline_value > completed_value;
+            });
+
+            std::ranges::transform(std::begin(entries_), it_end, std::back_inserter(deleters), [] (auto &&entry)
+            {
+                return std::move(entry.deleter);
+            });
+
+            entries_.erase(std::begin(entries_), it_end);
+
+            TRACE_COUNTER("deletion queue: pending objects", std::size(entries_));
+        }
+
+        // Run outside of the lock, as they may release other objects.
+        for (auto &&deleter : deleters)
+            deleter();
+
+        return std::size(deleters);
+    }
+
+    std::size_t deletion_queue::size() const
+    {
+        std::lock_guard lock{mutex_};
+
+        return std::size(entries_);
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "renderer/timeline.hxx"
+
+
+namespace resource
+{
+    // Defers the destruction of the objects the GPU might still use until the submissions made before their release complete.
+    // Objects can be released from any thread; the deleters are run by the thread collecting them.
+    class deletion_queue final {
+    public:
+
+        explicit deletion_queue(render::timeline const &timeline) noexcept : timeline_{timeline} { }
+
+        // Waits for all the pending submissions and runs the remaining deleters.
+        ~deletion_queue();
+
+        // The object is considered to be used by all the submissions made so far.
+        void push(std::function<void()> deleter);
+
+        // Runs the deleters whose submissions have completed; returns the number of them.
+        std::size_t collect();
+
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+
+        struct entry final {
+            std::uint64_t timeline_value;
+            std::function<void()> deleter;
+        };
+
+        render::timeline const &timeline_;
+
+        mutable std::mutex mutex_;
+
+        // Sorted by the timeline value, as the reserved values only grow.
+        std::deque<entry> entries_;
+
+        deletion_queue() = delete;
+        deletion_queue(deletion_queue const &) = delete;
+        deletion_queue(deletion_queue &&) = delete;
+    };
+}
@@ -4,6 +4,8 @@
 
 #include <ranges>
 
+#include <boost/functional/hash.hpp>
+
 #include "renderer/command_buffer.hxx"
 #include "graphics/graphics_api.hxx"
 #include "image.hxx"
@@ -32,3 +34,38 @@ find_supported_image_format(vulkan::device const &device, std::vector<graphics::
 
     return it_format != std::cend(candidates) ? *it_format : std::optional<graphics::FORMAT>{ };
 }
+
+namespace resource
+{
+    std::size_t hash<resource::image_view_invariant>::operator() (resource::image_view_invariant const &invariant) const
+    {
+        std::size_t seed = 0;
+
+        boost::hash_combine(seed, invariant.image);
+
+        boost::hash_combine(seed, invariant.view_type);
+        boost::hash_combine(seed, invariant.format);
+        boost::hash_combine(seed, invariant.aspect);
+
+        boost::hash_combine(seed, invariant.mip_levels);
+
+        return seed;
+    }
+
+    std::size_t hash<resource::sampler_invariant>::operator() (resource::sampler_invariant const &invariant) const
+    {
+        std::size_t seed = 0;
+
+        boost::hash_combine(seed, invariant.min_filter);
+        boost::hash_combine(seed, invariant.mag_filter);
+        boost::hash_combine(seed, invariant.mipmap_mode);
+
+        boost::hash_combine(seed, invariant.min_lod);
+        boost::hash_combine(seed, invariant.max_lod);
+
+        boost::hash_combine(seed, invariant.anisotropy_enabled);
+        boost::hash_combine(seed, invariant.max_anisotropy_level);
+
+        return seed;
+    }
+}
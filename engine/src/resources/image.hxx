@@ -17,6 +17,9 @@ namespace resource
 {
     class resource_manager;
     class memory_block;
+
+    template<class T>
+    struct hash;
 }
 
 namespace resource
@@ -124,6 +127,54 @@ namespace resource
             : image{image}, view{view}, sampler{sampler} { }
     };
 }
+namespace resource
+{
+    struct image_view_invariant final {
+        VkImage image{VK_NULL_HANDLE};
+
+        graphics::IMAGE_VIEW_TYPE view_type;
+        graphics::FORMAT format{graphics::FORMAT::UNDEFINED};
+        graphics::IMAGE_ASPECT aspect;
+
+        std::uint32_t mip_levels{1};
+
+        template<class T> requires std::same_as<std::remove_cvref_t<T>, resource::image_view_invariant>
+        auto constexpr operator== (T &&rhs) const
+        {
+            return image == rhs.image && view_type == rhs.view_type && format == rhs.format &&
+                   aspect == rhs.aspect && mip_levels == rhs.mip_levels;
+        }
+    };
+
+    template<>
+    struct hash<resource::image_view_invariant> {
+        std::size_t operator() (resource::image_view_invariant const &invariant) const;
+    };
+
+    struct sampler_invariant final {
+        graphics::TEXTURE_FILTER min_filter;
+        graphics::TEXTURE_FILTER mag_filter;
+        graphics::TEXTURE_MIPMAP_MODE mipmap_mode;
+
+        float min_lod{0.f}, max_lod{0.f};
+
+        bool anisotropy_enabled{false};
+        float max_anisotropy_level{1.f};
+
+        template<class T> requires std::same_as<std::remove_cvref_t<T>, resource::sampler_invariant>
+        auto constexpr operator== (T &&rhs) const
+        {
+            return min_filter == rhs.min_filter && mag_filter == rhs.mag_filter && mipmap_mode == rhs.mipmap_mode &&
+                   min_lod == rhs.min_lod && max_lod == rhs.max_lod &&
+                   anisotropy_enabled == rhs.anisotropy_enabled && max_anisotropy_level == rhs.max_anisotropy_level;
+        }
+    };
+
+    template<>
+    struct hash<resource::sampler_invariant> {
+        std::size_t operator() (resource::sampler_invariant const &invariant) const;
+    };
+}
 
 [[nodiscard]] std::optional<graphics::FORMAT>
 find_supported_image_format(vulkan::device const &device, std::vector<graphics::FORMAT> const &candidates,
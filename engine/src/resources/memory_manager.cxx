@@ -14,10 +14,12 @@ using namespace std::string_literals;
 #include <boost/functional/hash.hpp>
 
 #include "utility/exceptions.hxx"
+#include "utility/trace.hxx"
 #include "graphics/graphics_api.hxx"
 
 #include "buffer.hxx"
 #include "image.hxx"
+#include "memory_type.hxx"
 
 #include "resource_manager.hxx"
 #include "memory_manager.hxx"
@@ -36,25 +38,18 @@ namespace
         return seed;
     }
 
-    std::optional<std::uint32_t>
-    find_memory_type_index(vulkan::device const &device, std::uint32_t filter, graphics::MEMORY_PROPERTY_TYPE memory_property_types) noexcept
+    bool is_lazily_allocated_memory(graphics::MEMORY_PROPERTY_TYPE properties) noexcept
     {
-        VkPhysicalDeviceMemoryProperties memory_properties;
-        vkGetPhysicalDeviceMemoryProperties(device.physical_handle(), &memory_properties);
-
-        auto const memory_types = mpl::to_array(memory_properties.memoryTypes);
-
-        auto it_type = std::ranges::find_if(memory_types, [filter, memory_property_types, i = 0u] (auto type) mutable
-        {
-            auto const property_flags = convert_to::vulkan(memory_property_types);
+        auto constexpr lazily_allocated = graphics::MEMORY_PROPERTY_TYPE::LAZILY_ALLOCATED;
 
-            return (filter & (1u << i++)) && (type.propertyFlags & property_flags) == property_flags;
-        });
+        return (properties & lazily_allocated) == lazily_allocated;
+    }
 
-        if (it_type < std::next(std::cbegin(memory_types), memory_properties.memoryTypeCount))
-            return static_cast<std::uint32_t>(std::distance(std::cbegin(memory_types), it_type));
+    bool is_host_visible_memory(graphics::MEMORY_PROPERTY_TYPE properties) noexcept
+    {
+        auto constexpr host_visible = graphics::MEMORY_PROPERTY_TYPE::HOST_VISIBLE;
 
-        return { };
+        return (properties & host_visible) == host_visible;
     }
 }
 
@@ -96,6 +91,9 @@ namespace resource
 
         std::size_t available_size{0};
 
+        // The whole page's mapping shared by its sub-allocations; null if the memory isn't host visible.
+        std::byte *mapped_ptr{nullptr};
+
         std::multiset<resource::memory_chunk, resource::memory_chunk::comparator> available_chunks;
     };
 
@@ -124,8 +122,14 @@ namespace resource
     struct memory_allocator final {
         vulkan::device const &device;
 
+        VkPhysicalDeviceMemoryProperties memory_properties;
+
         std::size_t buffer_image_granularity{0};
         std::size_t total_allocated_size{0};
+        std::size_t total_sub_allocated_size{0};
+
+        // Sub-allocations that have got the lazily allocated memory.
+        std::size_t lazily_sub_allocated_size{0};
 
         std::unordered_map<std::size_t, resource::memory_pool> memory_pools;
 
@@ -143,12 +147,16 @@ namespace resource
 
         void deallocate_memory(resource::memory_block &&memory_block);
 
+        [[nodiscard]] resource::memory_statistics statistics() const;
+
         decltype(memory_pool::memory_blocks)::iterator
         allocate_memory_block(std::size_t size_bytes, std::uint32_t memory_type_index, graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear);
     };
 
     memory_allocator::memory_allocator(vulkan::device const& device) : device{ device }
     {
+        vkGetPhysicalDeviceMemoryProperties(device.physical_handle(), &memory_properties);
+
         buffer_image_granularity = device.device_limits().buffer_image_granularity;
 
         if (resource::memory_manager::kPAGE_ALLOCATION_SIZE < buffer_image_granularity)
@@ -157,9 +165,14 @@ namespace resource
 
     memory_allocator::~memory_allocator()
     {
-        for (auto& memory_pool : memory_pools | std::views::values)
-            for (const auto& memory_handle : memory_pool.memory_blocks | std::views::keys)
+        for (auto& memory_pool : memory_pools | std::views::values) {
+            for (const auto& [memory_handle, memory_page] : memory_pool.memory_blocks) {
+                if (memory_page.mapped_ptr != nullptr)
+                    vkUnmapMemory(device.handle(), memory_handle);
+
                 vkFreeMemory(device.handle(), memory_handle, nullptr);
+            }
+        }
 
         memory_pools.clear();
     }
@@ -167,6 +180,8 @@ namespace resource
     std::shared_ptr<resource::memory_block>
     memory_allocator::allocate_memory(VkMemoryRequirements &&memory_requirements, graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear)
     {
+        TRACE_ZONE("memory_allocator::allocate_memory");
+
     #ifndef  _MSC_VER
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wuseless-cast"
@@ -180,12 +195,20 @@ namespace resource
         if (required_size > resource::memory_manager::kPAGE_ALLOCATION_SIZE)
             throw memory::bad_allocation("requested allocation size is bigger than memory page size."s);
 
-        std::uint32_t memory_type_index = 0;
+        auto const memory_type = resource::select_memory_type(memory_properties, memory_requirements.memoryTypeBits, properties);
+
+        if (!memory_type)
+            throw memory::bad_allocation("failed to find suitable memory type."s);
 
-        if (auto index = find_memory_type_index(device, memory_requirements.memoryTypeBits, properties); index)
-            memory_type_index = *index;
+        auto const memory_type_index = memory_type->index;
 
-        else throw memory::bad_allocation("failed to find suitable memory type."s);
+        // The requested lazy allocation may have been dropped.
+        properties = memory_type->properties;
+
+        auto const is_lazily_allocated = is_lazily_allocated_memory(properties);
+
+        // Lazily allocated memory is committed on demand, if at all; its blocks are sized exactly to not reserve the heap for nothing.
+        auto const block_size = is_lazily_allocated ? required_size : resource::memory_manager::kPAGE_ALLOCATION_SIZE;
 
         auto const key = hash_memory_block_properties(memory_type_index, properties, is_linear);
 
@@ -224,11 +247,11 @@ namespace resource
         });
 
         if (it_block == std::end(memory_blocks)) {
-            it_block = allocate_memory_block(resource::memory_manager::kPAGE_ALLOCATION_SIZE, memory_type_index, properties, is_linear);
+            it_block = allocate_memory_block(block_size, memory_type_index, properties, is_linear);
 
             auto &&available_chunks = it_block->second.available_chunks;
 
-            it_chunk = available_chunks.lower_bound(resource::memory_manager::kPAGE_ALLOCATION_SIZE);
+            it_chunk = available_chunks.lower_bound(block_size);
 
             if (it_chunk == std::end(available_chunks))
                 throw memory::exception("failed to find available memory chunk."s);
@@ -257,12 +280,23 @@ namespace resource
 
             available_chunks.erase(resource::memory_chunk{0, 0});
 
-            auto const kilobytes = static_cast<float>(required_size) / 1024.f;
+            total_sub_allocated_size += required_size;
+
+            TRACE_COUNTER("memory: sub-allocated bytes", total_sub_allocated_size);
+
+            if (is_lazily_allocated) {
+                lazily_sub_allocated_size += required_size;
+
+                TRACE_COUNTER("memory: lazily sub-allocated bytes", lazily_sub_allocated_size);
+            }
+
+            std::span<std::byte> mapped_range;
 
-            fmt::print("Memory manager: type index #{} : sub-allocation {} KB.\n", memory_type_index, kilobytes);
+            if (memory_page.mapped_ptr != nullptr)
+                mapped_range = std::span{memory_page.mapped_ptr + aligned_offset, required_size};
 
             return std::shared_ptr<resource::memory_block>{
-                new resource::memory_block{it_block->first, required_size, aligned_offset, memory_type_index, properties, is_linear},
+                new resource::memory_block{it_block->first, required_size, aligned_offset, memory_type_index, properties, is_linear, mapped_range},
                                             [this] (resource::memory_block *const ptr_memory)
                 {
                     deallocate_memory(std::forward<resource::memory_block>(*ptr_memory));
@@ -277,6 +311,8 @@ namespace resource
 
     void memory_allocator::deallocate_memory(resource::memory_block &&memory_block)
     {
+        TRACE_ZONE("memory_allocator::deallocate_memory");
+
         auto const key = hash_memory_block_properties(memory_block.type_index(), memory_block.properties(), memory_block.is_linear());
 
         if (!memory_pools.contains(key)) {
@@ -289,7 +325,6 @@ namespace resource
         auto const memory_handle = memory_block.handle();
         auto const memory_size = memory_block.size();
         auto const memory_offset = memory_block.offset();
-        auto const memory_type_index = memory_block.type_index();
 
         if (!memory_pool.memory_blocks.contains(memory_handle)) {
             std::cerr << "Memory manager: dead memory chunk encountered." << std::endl;
@@ -299,7 +334,15 @@ namespace resource
         auto &&memory_page = memory_pool.memory_blocks.at(memory_handle);
         auto &&available_chunks = memory_page.available_chunks;
 
-        fmt::print("Memory manager: type index #{} : releasing chunk {} KB.\n", memory_type_index, static_cast<float>(memory_size) / 1024.f);
+        total_sub_allocated_size -= memory_size;
+
+        TRACE_COUNTER("memory: sub-allocated bytes", total_sub_allocated_size);
+
+        if (is_lazily_allocated_memory(memory_block.properties())) {
+            lazily_sub_allocated_size -= memory_size;
+
+            TRACE_COUNTER("memory: lazily sub-allocated bytes", lazily_sub_allocated_size);
+        }
 
         auto it_chunk = available_chunks.emplace(memory_offset, memory_size);
 
@@ -326,11 +369,55 @@ namespace resource
         }
 
         memory_page.available_size += memory_size;
+
+        // Lazily allocated blocks are sized exactly for a single allocation, so an unused one is released right away.
+        if (is_lazily_allocated_memory(memory_block.properties()) && std::size(available_chunks) == 1) {
+            auto &&chunk = *std::begin(available_chunks);
+
+            if (chunk.offset == 0 && chunk.size == memory_page.available_size) {
+                vkFreeMemory(device.handle(), memory_handle, nullptr);
+
+                total_allocated_size -= chunk.size;
+                memory_pool.allocated_size -= chunk.size;
+
+                memory_pool.memory_blocks.erase(memory_handle);
+
+                TRACE_COUNTER("memory: allocated bytes", total_allocated_size);
+            }
+        }
+    }
+
+    resource::memory_statistics memory_allocator::statistics() const
+    {
+        resource::memory_statistics statistics{total_allocated_size, total_sub_allocated_size, lazily_sub_allocated_size, 0};
+
+        for (auto &&memory_pool : memory_pools | std::views::values) {
+            if (!is_lazily_allocated_memory(memory_pool.properties))
+                continue;
+
+            for (auto memory_handle : memory_pool.memory_blocks | std::views::keys) {
+                VkDeviceSize committed_size = 0;
+                vkGetDeviceMemoryCommitment(device.handle(), memory_handle, &committed_size);
+
+#if defined(__GNUC__) || defined(__GNUG__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+                statistics.lazily_committed_size += static_cast<std::size_t>(committed_size);
+#if defined(__GNUC__) || defined(__GNUG__)
+    #pragma GCC diagnostic pop
+#endif
+            }
+        }
+
+        return statistics;
     }
 
     decltype(memory_pool::memory_blocks)::iterator
     memory_allocator::allocate_memory_block(std::size_t size_bytes, std::uint32_t memory_type_index, graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear)
     {
+        TRACE_ZONE("memory_allocator::allocate_memory_block");
+
         auto const key = hash_memory_block_properties(memory_type_index, properties, is_linear);
 
         if (!memory_pools.contains(key))
@@ -358,17 +445,25 @@ namespace resource
         if (auto result = vkAllocateMemory(device.handle(), &allocation_info, nullptr, &handle); result != VK_SUCCESS)
             throw memory::bad_allocation("failed to allocate memory block from memory pool."s);
 
+        void *mapped_ptr{nullptr};
+
+        // Mapped for the block's lifetime; the sub-allocations get their ranges of the mapping.
+        if (is_host_visible_memory(properties)) {
+            if (auto result = vkMapMemory(device.handle(), handle, 0, VK_WHOLE_SIZE, 0, &mapped_ptr); result != VK_SUCCESS) {
+                vkFreeMemory(device.handle(), handle, nullptr);
+
+                throw memory::exception(fmt::format("failed to map memory block: {0:#x}", result));
+            }
+        }
+
         total_allocated_size += size_bytes;
         memory_pool.allocated_size += size_bytes;
 
         auto it_memory_block = memory_blocks.try_emplace(handle, size_bytes).first;
 
-        auto block_index = std::size(memory_blocks);
-
-        auto kilobytes = static_cast<float>(size_bytes) / 1024.f;
-        auto megabytes = static_cast<float>(total_allocated_size) / std::pow(2.f, 20.f);
+        it_memory_block->second.mapped_ptr = static_cast<std::byte *>(mapped_ptr);
 
-        fmt::print("Memory manager: type index #{} : {}th page allocation {} KB/{} MB.\n", memory_type_index, block_index, kilobytes, megabytes);
+        TRACE_COUNTER("memory: allocated bytes", total_allocated_size);
 
         return it_memory_block;
     }
@@ -379,6 +474,30 @@ namespace resource
     memory_manager::memory_manager(vulkan::device const &device)
         : device_{device}, allocator_{std::make_shared<resource::memory_allocator>(device)} { }
 
+    std::shared_ptr<resource::memory_block>
+    memory_manager::allocate_memory(resource::memory_requirements const &memory_requirements, graphics::MEMORY_PROPERTY_TYPE memory_property_types, bool is_linear)
+    {
+#if defined(__GNUC__) || defined(__GNUG__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+        VkMemoryRequirements vulkan_memory_requirements{
+            static_cast<VkDeviceSize>(memory_requirements.size),
+            static_cast<VkDeviceSize>(memory_requirements.alignment),
+            memory_requirements.memory_type_bits
+        };
+#if defined(__GNUC__) || defined(__GNUG__)
+    #pragma GCC diagnostic pop
+#endif
+
+        return allocator_->allocate_memory(std::move(vulkan_memory_requirements), memory_property_types, is_linear);
+    }
+
+    resource::memory_statistics memory_manager::statistics() const
+    {
+        return allocator_->statistics();
+    }
+
     std::shared_ptr<resource::memory_block>
     memory_manager::allocate_buffer_memory(resource::buffer const &buffer, graphics::MEMORY_PROPERTY_TYPE memory_property_types)
     {
@@ -402,6 +521,6 @@ namespace resource
     }
 
     memory_block::memory_block(VkDeviceMemory handle, std::size_t size, std::size_t offset, std::uint32_t type_index,
-                                 graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear) noexcept
-        : handle_{handle}, size_{size}, offset_{offset}, type_index_{type_index}, properties_{properties}, is_linear_{is_linear} { }
+                                 graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear, std::span<std::byte> mapped_range) noexcept
+        : handle_{handle}, size_{size}, offset_{offset}, mapped_range_{mapped_range}, type_index_{type_index}, properties_{properties}, is_linear_{is_linear} { }
 }
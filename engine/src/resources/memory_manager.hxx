@@ -1,6 +1,8 @@
 #pragma once
 
+#include <span>
 #include <memory>
+#include <cstddef>
 
 #include "main.hxx"
 #include "utility/mpl.hxx"
@@ -23,6 +25,14 @@ namespace resource
         std::uint32_t memory_type_bits;
     };
 
+    struct memory_statistics final {
+        std::size_t allocated_size, sub_allocated_size;
+
+        // What has been handed out of the lazily allocated memory types and how much of it the driver has actually committed;
+        // the difference is the memory saved by not backing the transient attachments.
+        std::size_t lazily_sub_allocated_size, lazily_committed_size;
+    };
+
     class memory_block final {
     public:
 
@@ -36,19 +46,25 @@ namespace resource
 
         bool is_linear() const noexcept { return is_linear_; }
 
+        // The host visible memory blocks are mapped once, when allocated, as Vulkan memory can't be mapped twice at a time;
+        // the block's range of that mapping is handed out instead. Empty for the rest of the memory.
+        std::span<std::byte> mapped_range() const noexcept { return mapped_range_; }
+
     private:
 
         VkDeviceMemory handle_;
 
         std::size_t size_, offset_;
 
+        std::span<std::byte> mapped_range_;
+
         std::uint32_t type_index_;
         graphics::MEMORY_PROPERTY_TYPE properties_;
 
         bool is_linear_;
 
         memory_block(VkDeviceMemory handle, std::size_t size, std::size_t offset, std::uint32_t type_index,
-                      graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear) noexcept;
+                      graphics::MEMORY_PROPERTY_TYPE properties, bool is_linear, std::span<std::byte> mapped_range) noexcept;
 
         friend resource::memory_allocator;
     };
@@ -60,11 +76,19 @@ namespace resource
 
         explicit memory_manager(vulkan::device const &device);
 
+        // Requests for the lazily allocated memory fall back to the rest of the properties if no such memory type is available;
+        // the returned block's properties tell which one has been picked.
         template<class T>
         requires mpl::is_one_of_v<std::remove_cvref_t<T>, resource::buffer, resource::image>
         std::shared_ptr<resource::memory_block>
         allocate_memory(T &&resource, graphics::MEMORY_PROPERTY_TYPE memory_property_types);
 
+        // Memory that isn't tied to a single resource, e.g. the one shared by the aliased images.
+        std::shared_ptr<resource::memory_block>
+        allocate_memory(resource::memory_requirements const &memory_requirements, graphics::MEMORY_PROPERTY_TYPE memory_property_types, bool is_linear);
+
+        [[nodiscard]] resource::memory_statistics statistics() const;
+
     private:
 
         vulkan::device const &device_;
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <type_traits>
+
+#include "graphics/graphics_api.hxx"
+#include "memory_type.hxx"
+
+
+namespace resource
+{
+    std::optional<std::uint32_t>
+    find_memory_type_index(VkPhysicalDeviceMemoryProperties const &memory_properties, std::uint32_t filter,
+                           graphics::MEMORY_PROPERTY_TYPE memory_property_types) noexcept
+    {
+        auto const property_flags = convert_to::vulkan(memory_property_types);
+
+        auto const excluded_flags = property_flags & VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT ?
+            VkMemoryPropertyFlags{0} : VkMemoryPropertyFlags{VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT};
+
+        auto const memory_types_number = std::min(memory_properties.memoryTypeCount, std::uint32_t{VK_MAX_MEMORY_TYPES});
+
+        for (std::uint32_t index = 0; index < memory_types_number; ++index) {
+            if ((filter & (1u << index)) == 0)
+                continue;
+
+            auto const type_flags = memory_properties.memoryTypes[index].propertyFlags;
+
+            if ((type_flags & property_flags) == property_flags && (type_flags & excluded_flags) == 0)
+                return index;
+        }
+
+        return { };
+    }
+
+    std::optional<resource::memory_type>
+    select_memory_type(VkPhysicalDeviceMemoryProperties const &memory_properties, std::uint32_t filter,
+                       graphics::MEMORY_PROPERTY_TYPE memory_property_types) noexcept
+    {
+        if (auto index = find_memory_type_index(memory_properties, filter, memory_property_types); index)
+            return resource::memory_type{*index, memory_property_types};
+
+        auto constexpr lazily_allocated = graphics::MEMORY_PROPERTY_TYPE::LAZILY_ALLOCATED;
+
+        if ((memory_property_types & lazily_allocated) != lazily_allocated)
+            return { };
+
+        using E = std::underlying_type_t<graphics::MEMORY_PROPERTY_TYPE>;
+
+        auto const fallback_property_types =
+            static_cast<graphics::MEMORY_PROPERTY_TYPE>(static_cast<E>(memory_property_types) & ~static_cast<E>(lazily_allocated));
+
+        if (auto index = find_memory_type_index(memory_properties, filter, fallback_property_types); index)
+            return resource::memory_type{*index, fallback_property_types};
+
+        return { };
+    }
+}
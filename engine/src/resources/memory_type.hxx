@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <volk.h>
+
+#include "graphics/graphics.hxx"
+
+
+namespace resource
+{
+    struct memory_type final {
+        std::uint32_t index;
+
+        // Properties the memory type has been selected for; lazy allocation is dropped from them when it isn't supported.
+        graphics::MEMORY_PROPERTY_TYPE properties;
+    };
+
+    // Index of the first memory type allowed by the filter that has all the required properties.
+    // Lazily allocated types are picked only if asked for, as they can back nothing but the transient attachments.
+    [[nodiscard]] std::optional<std::uint32_t>
+    find_memory_type_index(VkPhysicalDeviceMemoryProperties const &memory_properties, std::uint32_t filter,
+                           graphics::MEMORY_PROPERTY_TYPE memory_property_types) noexcept;
+
+    // Lazy allocation is a hint: if none of the allowed types is lazily allocated, the rest of the properties are matched alone.
+    [[nodiscard]] std::optional<resource::memory_type>
+    select_memory_type(VkPhysicalDeviceMemoryProperties const &memory_properties, std::uint32_t filter,
+                       graphics::MEMORY_PROPERTY_TYPE memory_property_types) noexcept;
+}
@@ -7,6 +7,7 @@ using namespace std::string_literals;
 #include <fmt/format.h>
 
 #include "utility/exceptions.hxx"
+#include "utility/trace.hxx"
 #include "graphics/graphics_api.hxx"
 #include "buffer.hxx"
 #include "image.hxx"
@@ -53,8 +54,7 @@ namespace resource
     class resource_manager::staging_buffer_pool final {
     public:
 
-        staging_buffer_pool(vulkan::device const &device, resource::resource_manager &resource_manager);
-        ~staging_buffer_pool();
+        explicit staging_buffer_pool(resource::resource_manager &resource_manager);
 
         std::shared_ptr<resource::buffer> buffer() const { return buffer_; }
         std::span<std::byte> total_mapped_range() const noexcept { return total_mapped_range_; }
@@ -72,7 +72,6 @@ namespace resource
 
         static auto constexpr kPOOL_SIZE_BYTES{resource::memory_manager::kPAGE_ALLOCATION_SIZE};
 
-        vulkan::device const &device_;
         resource::resource_manager &resource_manager_;
 
         std::shared_ptr<resource::buffer> buffer_;
@@ -81,31 +80,24 @@ namespace resource
         std::multiset<resource::buffer_chunk, resource::buffer_chunk::comparator> available_chunks_;
     };
 
-    resource_manager::staging_buffer_pool::staging_buffer_pool(vulkan::device const &device, resource::resource_manager &resource_manager)
-        : device_{device}, resource_manager_{resource_manager}
+    resource_manager::staging_buffer_pool::staging_buffer_pool(resource::resource_manager &resource_manager)
+        : resource_manager_{resource_manager}
     {
         buffer_ = resource_manager_.create_buffer(kPOOL_SIZE_BYTES, kBUFFER_USAGE_FLAGS, kMEMORY_PROPERTY_TYPES, kSHARING_MODE);
 
         if (buffer_ == nullptr)
             throw resource::instantiation_fail(fmt::format("failed to create the staging pool buffer"));
 
-        auto &&memory = buffer_->memory();
+        auto const mapped_range = buffer_->memory()->mapped_range();
 
-        void *mapped_ptr{nullptr};
+        if (std::size(mapped_range) < kPOOL_SIZE_BYTES)
+            throw resource::exception("staging buffer pool memory isn't mapped"s);
 
-        if (auto result = vkMapMemory(device_.handle(), memory->handle(), memory->offset(), kPOOL_SIZE_BYTES, 0, &mapped_ptr); result != VK_SUCCESS)
-            throw resource::exception(fmt::format("failed to map staging buffer memory: {0:#x}", result));
-
-        total_mapped_range_ = std::span{static_cast<std::byte *>(mapped_ptr), kPOOL_SIZE_BYTES};
+        total_mapped_range_ = mapped_range.first(kPOOL_SIZE_BYTES);
 
         available_chunks_.emplace(0, kPOOL_SIZE_BYTES);
     }
 
-    resource_manager::staging_buffer_pool::~staging_buffer_pool()
-    {
-        vkUnmapMemory(device_.handle(), buffer_->memory()->handle());
-    }
-
     std::pair<std::size_t, std::span<std::byte>> resource_manager::staging_buffer_pool::allocate_mapped_range(std::size_t size_bytes)
     {
         if (size_bytes > kPOOL_SIZE_BYTES)
@@ -113,6 +105,10 @@ namespace resource
 
         auto it_chunk = available_chunks_.lower_bound(size_bytes);
 
+        // The released ranges wait in the deletion queue, which isn't collected while loading.
+        if (it_chunk == std::end(available_chunks_) && resource_manager_.deletion_queue().collect() != 0)
+            it_chunk = available_chunks_.lower_bound(size_bytes);
+
         if (it_chunk == std::end(available_chunks_))
             throw resource::not_enough_memory("failed to find available staging buffer pool memory chunk."s);
 
@@ -172,6 +168,27 @@ namespace resource
             if (resource_ptr == nullptr)
                 return;
 
+            // A staging range goes back to the pool once the submissions that may read it complete; the deleter holds the pool,
+            // as the queue drains the remaining deleters after the pool is released.
+            if constexpr (std::is_same_v<T, resource::staging_buffer>) {
+                resource_manager.deletion_queue_.push([staging_buffer_pool = resource_manager.staging_buffer_pool_, resource_ptr]
+                {
+                    staging_buffer_pool->unmap_range(resource_ptr->offset_bytes(), resource_ptr->mapped_range());
+
+                    delete resource_ptr;
+                });
+            }
+
+            else resource_manager.deletion_queue_.push([&device = device, resource_ptr]
+            {
+                destroy(device, resource_ptr);
+            });
+        }
+
+        // The memory is released along with the object, so it isn't reused while the GPU might still access it.
+        template<class T>
+        static void destroy(vulkan::device const &device, T *resource_ptr)
+        {
             if constexpr (std::is_same_v<T, resource::buffer>) {
                 vkDestroyBuffer(device.handle(), resource_ptr->handle(), nullptr);
 
@@ -179,9 +196,6 @@ namespace resource
                     resource_ptr->memory().reset();
             }
 
-            else if constexpr (std::is_same_v<T, resource::staging_buffer>)
-                resource_manager.staging_buffer_pool_->unmap_range(resource_ptr->offset_bytes(), resource_ptr->mapped_range());
-
             else if constexpr (std::is_same_v<T, resource::image>) {
                 vkDestroyImage(device.handle(), resource_ptr->handle(), nullptr);
 
@@ -213,8 +227,9 @@ namespace resource
 {
     resource_manager::resource_manager(vulkan::device const &device, render::config const &config, resource::memory_manager &memory_manager)
         : device_{device}, config_{config}, memory_manager_{memory_manager},
+          deletion_queue_{device.graphics_queue.timeline()},
           resource_deleter_{std::make_shared<resource::resource_manager::resource_deleter>(device, *this)},
-          staging_buffer_pool_{std::make_shared<resource::resource_manager::staging_buffer_pool>(device_, *this)}
+          staging_buffer_pool_{std::make_shared<resource::resource_manager::staging_buffer_pool>(*this)}
     {
     }
 
@@ -222,6 +237,8 @@ namespace resource
     resource_manager::create_buffer(std::size_t size_bytes, graphics::BUFFER_USAGE usage, graphics::MEMORY_PROPERTY_TYPE memory_property_types,
                                     graphics::RESOURCE_SHARING_MODE sharing_mode) const
     {
+        TRACE_ZONE("resource_manager::create_buffer");
+
         VkBufferCreateInfo const create_info{
             VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             nullptr,
@@ -258,6 +275,8 @@ namespace resource
     std::shared_ptr<resource::staging_buffer>
     resource_manager::create_staging_buffer(std::size_t size_bytes) const
     {
+        TRACE_ZONE("resource_manager::create_staging_buffer");
+
         auto [offset_bytes, mapped_range] = staging_buffer_pool_->allocate_mapped_range(size_bytes);
 
         std::shared_ptr<resource::staging_buffer> buffer;
@@ -324,6 +343,24 @@ namespace resource
     std::shared_ptr<resource::image>
     resource_manager::create_image(graphics::IMAGE_TYPE type, graphics::FORMAT format, render::extent extent, std::uint32_t mip_levels, std::uint32_t samples_count,
                                    graphics::IMAGE_TILING tiling, graphics::IMAGE_USAGE usage_flags, graphics::MEMORY_PROPERTY_TYPE memory_property_types) const
+    {
+        TRACE_ZONE("resource_manager::create_image");
+
+        auto image = create_unbound_image(type, format, extent, mip_levels, samples_count, tiling, usage_flags);
+
+        auto const memory = memory_manager_.allocate_memory(*image, memory_property_types);
+
+        if (memory == nullptr)
+            throw memory::exception("failed to allocate image memory"s);
+
+        bind_image_memory(*image, memory, 0);
+
+        return image;
+    }
+
+    std::shared_ptr<resource::image>
+    resource_manager::create_unbound_image(graphics::IMAGE_TYPE type, graphics::FORMAT format, render::extent extent, std::uint32_t mip_levels,
+                                           std::uint32_t samples_count, graphics::IMAGE_TILING tiling, graphics::IMAGE_USAGE usage_flags) const
     {
         VkImageCreateInfo const create_info{
             VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
@@ -347,23 +384,52 @@ namespace resource
         if (auto result = vkCreateImage(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
             throw resource::instantiation_fail(fmt::format("failed to create an image: {0:#x}", result));
 
-        auto const memory = memory_manager_.allocate_memory(resource::image{nullptr, handle, format, tiling, mip_levels, extent}, memory_property_types);
+        std::shared_ptr<resource::image> image;
+        image.reset(new resource::image{nullptr, handle, format, tiling, mip_levels, extent}, *resource_deleter_);
 
-        if (memory == nullptr)
-            throw memory::exception("failed to allocate image memory"s);
+        return image;
+    }
 
-        if (auto result = vkBindImageMemory(device_.handle(), handle, memory->handle(), memory->offset()); result != VK_SUCCESS)
-            throw resource::memory_bind(fmt::format("failed to bind image buffer memory: {0:#x}", result));
+    resource::memory_requirements resource_manager::image_memory_requirements(resource::image const &image) const
+    {
+        VkMemoryRequirements memory_requirements;
+        vkGetImageMemoryRequirements(device_.handle(), image.handle(), &memory_requirements);
+
+#if defined(__GNUC__) || defined(__GNUG__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wuseless-cast"
+#endif
+        return resource::memory_requirements{
+            static_cast<std::size_t>(memory_requirements.size),
+            static_cast<std::size_t>(memory_requirements.alignment),
+            memory_requirements.memoryTypeBits
+        };
+#if defined(__GNUC__) || defined(__GNUG__)
+    #pragma GCC diagnostic pop
+#endif
+    }
 
-        std::shared_ptr<resource::image> image;
-        image.reset(new resource::image{memory, handle, format, tiling, mip_levels, extent}, *resource_deleter_);
+    void resource_manager::bind_image_memory(resource::image &image, std::shared_ptr<resource::memory_block> memory, std::size_t offset) const
+    {
+        if (auto result = vkBindImageMemory(device_.handle(), image.handle(), memory->handle(), memory->offset() + offset); result != VK_SUCCESS)
+            throw resource::memory_bind(fmt::format("failed to bind image buffer memory: {0:#x}", result));
 
-        return image;
+        image.memory() = std::move(memory);
     }
 
     std::shared_ptr<resource::image_view>
     resource_manager::create_image_view(std::shared_ptr<resource::image> image, graphics::IMAGE_VIEW_TYPE view_type, graphics::IMAGE_ASPECT image_aspect)
     {
+        TRACE_ZONE("resource_manager::create_image_view");
+
+        resource::image_view_invariant const invariant{
+            image->handle(), view_type, image->format(), image_aspect, image->mip_levels()
+        };
+
+        if (auto it = image_views_.find(invariant); it != std::end(image_views_))
+            if (auto image_view = it->second.lock(); image_view)
+                return image_view;
+
         std::shared_ptr<resource::image_view> image_view;
 
         VkImageViewCreateInfo const create_info{
@@ -392,13 +458,17 @@ namespace resource
         if (auto result = vkCreateImageView(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
             throw resource::instantiation_fail(fmt::format("failed to create an image view: {0:#x}", result));
 
-        else image_view.reset(new resource::image_view{handle, image, view_type}, [this] (resource::image_view *ptr_image_view)
+        else image_view.reset(new resource::image_view{handle, image, view_type}, [this, invariant] (resource::image_view *ptr_image_view)
         {
-            vkDestroyImageView(device_.handle(), ptr_image_view->handle(), nullptr);
+            (*resource_deleter_)(ptr_image_view);
 
-            delete ptr_image_view;
+            evict_expired(image_views_, invariant);
         });
 
+        image_views_.insert_or_assign(invariant, image_view);
+
+        TRACE_COUNTER("resources: cached image views", std::size(image_views_));
+
         return image_view;
     }
 
@@ -410,6 +480,18 @@ namespace resource
             float min_lod,
             float max_lod)
     {
+        TRACE_ZONE("resource_manager::create_image_sampler");
+
+        resource::sampler_invariant const invariant{
+            min_filter, mag_filter, mipmap_mode,
+            min_lod, max_lod,
+            config_.anisotropy_enabled, config_.max_anisotropy_level
+        };
+
+        if (auto it = samplers_.find(invariant); it != std::end(samplers_))
+            if (auto sampler = it->second.lock(); sampler)
+                return sampler;
+
         std::shared_ptr<resource::sampler> sampler;
 
         VkSamplerCreateInfo const create_info{
@@ -421,7 +503,7 @@ namespace resource
             VK_SAMPLER_ADDRESS_MODE_REPEAT,
             VK_SAMPLER_ADDRESS_MODE_REPEAT,
             0.f,
-            static_cast<VkBool32>(config_.anisotropy_enabled), config_.max_anisotropy_level,
+            static_cast<VkBool32>(invariant.anisotropy_enabled), invariant.max_anisotropy_level,
             VK_FALSE, VK_COMPARE_OP_ALWAYS,
             min_lod, max_lod,
             VK_BORDER_COLOR_INT_OPAQUE_BLACK,
@@ -433,14 +515,18 @@ namespace resource
         if (auto result = vkCreateSampler(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
             throw resource::instantiation_fail(fmt::format("failed to create a sampler: {0:#x}", result));
 
-        else sampler.reset(new resource::sampler{handle}, [this] (resource::sampler *ptr_sampler)
+        else sampler.reset(new resource::sampler{handle}, [this, invariant] (resource::sampler *ptr_sampler)
         {
-            vkDestroySampler(device_.handle(), ptr_sampler->handle(), nullptr);
+            (*resource_deleter_)(ptr_sampler);
 
-            delete ptr_sampler;
+            evict_expired(samplers_, invariant);
         }
         );
 
+        samplers_.insert_or_assign(invariant, sampler);
+
+        TRACE_COUNTER("resources: cached samplers", std::size(samplers_));
+
         return sampler;
     }
 
@@ -448,6 +534,8 @@ namespace resource
     resource_manager::create_framebuffer(std::shared_ptr<graphics::render_pass> render_pass, render::extent extent,
                                          std::vector<std::shared_ptr<resource::image_view>> const &attachments)
     {
+        TRACE_ZONE("resource_manager::create_framebuffer");
+
         std::vector<VkImageView> views;
 
         std::ranges::transform(attachments, std::back_inserter(views), [] (auto &&attachment)
@@ -470,12 +558,7 @@ namespace resource
         if (auto result = vkCreateFramebuffer(device_.handle(), &create_info, nullptr, &handle); result != VK_SUCCESS)
             throw resource::instantiation_fail(fmt::format("failed to create a framebuffer: {0:#x}", result));
 
-        framebuffer.reset(new resource::framebuffer{handle}, [this] (resource::framebuffer *ptr_framebuffer)
-        {
-            vkDestroyFramebuffer(device_.handle(), ptr_framebuffer->handle(), nullptr);
-
-            delete ptr_framebuffer;
-        });
+        framebuffer.reset(new resource::framebuffer{handle}, *resource_deleter_);
 
         return framebuffer;
     }
@@ -492,12 +575,7 @@ namespace resource
         VkSemaphore handle;
 
         if (auto result = vkCreateSemaphore(device_.handle(), &create_info, nullptr, &handle); result == VK_SUCCESS) {
-            semaphore.reset(new resource::semaphore{handle}, [this] (resource::semaphore *ptr_semaphore)
-            {
-                vkDestroySemaphore(device_.handle(), ptr_semaphore->handle(), nullptr);
-
-                delete ptr_semaphore;
-            });
+            semaphore.reset(new resource::semaphore{handle}, *resource_deleter_);
         }
 
         else throw resource::instantiation_fail(fmt::format("failed to create a semaphore: {0:#x}", result));
@@ -520,12 +598,7 @@ namespace resource
         VkFence handle;
 
         if (auto result = vkCreateFence(device_.handle(), &create_info, nullptr, &handle); result == VK_SUCCESS) {
-            fence.reset(new resource::fence{handle}, [this] (resource::fence *ptr_fence)
-            {
-                vkDestroyFence(device_.handle(), ptr_fence->handle(), nullptr);
-
-                delete ptr_fence;
-            });
+            fence.reset(new resource::fence{handle}, *resource_deleter_);
         }
 
         else throw resource::instantiation_fail(fmt::format("failed to create a fence: {0:#x}", result));
@@ -540,6 +613,8 @@ namespace resource
             std::shared_ptr<resource::staging_buffer> staging_buffer,
             VkCommandPool command_pool)
     {
+        TRACE_ZONE("resource_manager::stage_vertex_data");
+
         auto const container = staging_buffer->mapped_range();
 
         auto const staging_data_size_bytes = container.size_bytes();
@@ -607,6 +682,8 @@ namespace resource
     std::shared_ptr<resource::index_buffer>
     resource_manager::stage_index_data(graphics::INDEX_TYPE index_type, std::shared_ptr<resource::staging_buffer> staging_buffer, VkCommandPool command_pool)
     {
+        TRACE_ZONE("resource_manager::stage_index_data");
+
         if (std::ranges::none_of(kSUPPORTED_INDEX_FORMATS, [index_type] (auto type) { return type == index_type; }))
             throw resource::exception(fmt::format("unsupported index type: {0:#x}", static_cast<int>(index_type)));
 
@@ -673,6 +750,8 @@ namespace resource
     resource_manager::stage_image_data(graphics::IMAGE_TYPE type, graphics::FORMAT format, render::extent extent, graphics::IMAGE_TILING tiling, std::uint32_t mip_levels, std::uint32_t samples_count,
                                        std::shared_ptr<resource::staging_buffer> staging_buffer, [[maybe_unused]] VkCommandPool command_pool)
     {
+        TRACE_ZONE("resource_manager::stage_image_data");
+
         if (std::ranges::none_of(kSUPPORTED_IMAGE_FORMATS, [format] (auto t) { return t == format; }))
             throw resource::exception(fmt::format("unsupported image type: {0:#x}", static_cast<int>(format)));
 
@@ -700,6 +779,14 @@ namespace resource
 
 namespace resource
 {
+    template<class K, class V, class H>
+    void resource_manager::evict_expired(std::unordered_map<K, std::weak_ptr<V>, H> &cache, K const &key)
+    {
+        // The entry could have been already replaced by a live object created after the last owner had gone.
+        if (auto it = cache.find(key); it != std::end(cache) && it->second.expired())
+            cache.erase(it);
+    }
+
     template<class T>
     bool resource_manager::buffer_set_comparator<T>::operator() (std::shared_ptr<T> const &lhs, std::shared_ptr<T> const &rhs) const
     {
@@ -18,6 +18,8 @@
 #include "graphics/vertex.hxx"
 
 #include "memory_manager.hxx"
+#include "deletion_queue.hxx"
+#include "image.hxx"
 
 
 namespace resource
@@ -59,6 +61,16 @@ namespace resource
         create_image(graphics::IMAGE_TYPE type, graphics::FORMAT format, render::extent extent, std::uint32_t mip_levels, std::uint32_t samples_count,
                      graphics::IMAGE_TILING tiling, graphics::IMAGE_USAGE usage_flags, graphics::MEMORY_PROPERTY_TYPE memory_property_types) const;
 
+        // Image without any memory, e.g. to be placed into the memory shared with other images.
+        [[nodiscard]] std::shared_ptr<resource::image>
+        create_unbound_image(graphics::IMAGE_TYPE type, graphics::FORMAT format, render::extent extent, std::uint32_t mip_levels, std::uint32_t samples_count,
+                             graphics::IMAGE_TILING tiling, graphics::IMAGE_USAGE usage_flags) const;
+
+        [[nodiscard]] resource::memory_requirements image_memory_requirements(resource::image const &image) const;
+
+        // The offset is relative to the memory block; several images may share the same block.
+        void bind_image_memory(resource::image &image, std::shared_ptr<resource::memory_block> memory, std::size_t offset) const;
+
         [[nodiscard]] std::shared_ptr<resource::image_view>
         create_image_view(std::shared_ptr<resource::image> image, graphics::IMAGE_VIEW_TYPE view_type, graphics::IMAGE_ASPECT image_aspect);
 
@@ -79,6 +91,9 @@ namespace resource
         [[nodiscard]] std::shared_ptr<resource::index_buffer>
         stage_index_data(graphics::INDEX_TYPE index_type, std::shared_ptr<resource::staging_buffer> staging_buffer, VkCommandPool command_pool);
 
+        // Released objects are destroyed once the submissions made before their release complete; has to be called regularly, e.g. each frame.
+        [[nodiscard]] resource::deletion_queue &deletion_queue() noexcept { return deletion_queue_; }
+
         [[nodiscard]] std::shared_ptr<resource::image>
         stage_image_data(graphics::IMAGE_TYPE type, graphics::FORMAT format, render::extent extent, graphics::IMAGE_TILING tiling, std::uint32_t mip_levels, std::uint32_t samples_count,
                          std::shared_ptr<resource::staging_buffer> staging_buffer, VkCommandPool command_pool);
@@ -98,6 +113,9 @@ namespace resource
 
         resource::memory_manager &memory_manager_;
 
+        // Goes before the cached resources, as their release pushes to it.
+        resource::deletion_queue deletion_queue_;
+
         struct resource_deleter;
         std::shared_ptr<resource_deleter> resource_deleter_;
 
@@ -147,6 +165,13 @@ namespace resource
         std::unordered_map<graphics::INDEX_TYPE, index_buffer_set> index_buffers_;
 
         std::multiset<std::shared_ptr<resource::image>, buffer_set_comparator<resource::image>> image_buffers_;
+
+        // Identical create requests share a single Vulkan object; an entry is evicted when its last owner releases it.
+        std::unordered_map<resource::image_view_invariant, std::weak_ptr<resource::image_view>, resource::hash<resource::image_view_invariant>> image_views_;
+        std::unordered_map<resource::sampler_invariant, std::weak_ptr<resource::sampler>, resource::hash<resource::sampler_invariant>> samplers_;
+
+        template<class K, class V, class H>
+        static void evict_expired(std::unordered_map<K, std::weak_ptr<V>, H> &cache, K const &key);
     };
 }
 
@@ -0,0 +1,184 @@
+#include <vector>
+#include <chrono>
+#include <ranges>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include <string>
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+#include <fmt/format.h>
+
+#include <boost/program_options.hpp>
+
+#include "utility/helpers.hxx"
+#include "utility/exceptions.hxx"
+#include "loaders/material_loader.hxx"
+#include "loaders/cooked_material.hxx"
+#include "graphics/vertex.hxx"
+#include "renderer/material.hxx"
+
+
+namespace
+{
+    // Collects the names of all material sources under the materials folder, e.g. "debug/color-debug-material".
+    std::vector<std::string> enumerate_materials()
+    {
+        auto const root = loader::materials_contents_path();
+        auto const cooked_root = root / "bin"sv;
+
+        std::vector<std::string> names;
+
+        for (auto &&entry : fs::recursive_directory_iterator{root}) {
+            auto &&path = entry.path();
+
+            if (!entry.is_regular_file() || path.extension() != ".json"sv)
+                continue;
+
+            if (auto [it, _] = std::ranges::mismatch(cooked_root, path); it == std::end(cooked_root))
+                continue;
+
+            names.push_back(fs::relative(path, root).replace_extension().generic_string());
+        }
+
+        std::ranges::sort(names);
+
+        return names;
+    }
+
+    void benchmark(std::vector<std::string> const &names, std::size_t iterations)
+    {
+        using duration_t = std::chrono::nanoseconds;
+
+        iterations = std::max(iterations, std::size_t{1});
+
+        for (auto &&name : names) {
+            auto const json_time = measure<duration_t>::execution([&name, iterations]
+            {
+                for (std::size_t i = 0; i < iterations; ++i)
+                    [[maybe_unused]] auto description = loader::load_material_description_json(name);
+            });
+
+            auto const cooked_time = measure<duration_t>::execution([&name, iterations]
+            {
+                for (std::size_t i = 0; i < iterations; ++i)
+                    [[maybe_unused]] auto description = loader::load_cooked_material_description(loader::cooked_material_path(name));
+            });
+
+            fmt::print("{}: json {} ns, cooked {} ns\n", name,
+                       json_time / static_cast<duration_t::rep>(iterations),
+                       cooked_time / static_cast<duration_t::rep>(iterations));
+        }
+    }
+
+    // The material factory's hit path, resolving the name and hashing the layout on every request and with the precomputed keys.
+    void benchmark_material_cache(std::vector<std::string> const &names, std::size_t iterations)
+    {
+        using duration_t = std::chrono::nanoseconds;
+
+        iterations = std::max(iterations, std::size_t{1}) * 1000;
+
+        graphics::material_factory material_factory;
+
+        for (auto &&name : names) {
+            auto const description = loader::load_material_description(name);
+
+            if (description.techniques.empty() || description.techniques.front().vertex_layouts.empty())
+                continue;
+
+            // The layout the material's first technique declares is compatible with it by definition.
+            graphics::vertex_layout vertex_layout;
+
+            for (auto index : description.techniques.front().vertex_layouts.front()) {
+                auto [semantic, format] = description.vertex_attributes.at(index);
+
+                vertex_layout.size_bytes += vertex::compile_vertex_attributes(vertex_layout, semantic, format);
+            }
+
+            std::sort(std::begin(vertex_layout.attributes), std::end(vertex_layout.attributes));
+
+            auto const topology = graphics::PRIMITIVE_TOPOLOGY::TRIANGLES;
+
+            auto const material_id = material_factory.material_id(name);
+            auto const vertex_layout_hash = graphics::hash<graphics::vertex_layout>{}(vertex_layout);
+
+            // The first request misses and creates the material.
+            auto const material = material_factory.material(material_id, 0, vertex_layout, vertex_layout_hash, topology);
+
+            std::size_t misses = 0;
+
+            auto const name_time = measure<duration_t>::execution([&]
+            {
+                for (std::size_t i = 0; i < iterations; ++i)
+                    misses += material_factory.material(name, 0, vertex_layout, topology) != material ? 1 : 0;
+            });
+
+            auto const id_time = measure<duration_t>::execution([&]
+            {
+                for (std::size_t i = 0; i < iterations; ++i)
+                    misses += material_factory.material(material_id, 0, vertex_layout, vertex_layout_hash, topology) != material ? 1 : 0;
+            });
+
+            if (misses != 0)
+                throw graphics::exception(fmt::format("material cache missed {} requests of '{}'", misses, name));
+
+            fmt::print("{}: cache hit by name {} ns, by id {} ns\n", name,
+                       static_cast<double>(name_time) / static_cast<double>(iterations),
+                       static_cast<double>(id_time) / static_cast<double>(iterations));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    namespace po = boost::program_options;
+
+    po::options_description description{"Material cooker options"s};
+
+    description.add_options()
+        ("help,h", "print this message")
+        ("benchmark,b", po::value<std::size_t>()->implicit_value(100), "measure JSON and cooked load times and the material cache hits after cooking")
+        ("materials", po::value<std::vector<std::string>>(), "materials' names, e.g. 'debug/color-debug-material' (all by default)");
+
+    po::positional_options_description positional;
+    positional.add("materials", -1);
+
+    po::variables_map options;
+
+    try {
+        po::store(po::command_line_parser(argc, argv).options(description).positional(positional).run(), options);
+        po::notify(options);
+
+        if (options.count("help")) {
+            std::cout << description << std::endl;
+            return 0;
+        }
+
+        auto const names = options.count("materials") ? options.at("materials").as<std::vector<std::string>>() : enumerate_materials();
+
+        for (auto &&name : names) {
+            auto const path = loader::cooked_material_path(name);
+
+            loader::cook_material_description(loader::load_material_description_json(name), path);
+
+            fmt::print("{} -> {}\n", name, path.string());
+        }
+
+        if (options.count("benchmark")) {
+            auto const iterations = options.at("benchmark").as<std::size_t>();
+
+            benchmark(names, iterations);
+            benchmark_material_cache(names, iterations);
+        }
+    }
+
+    catch (std::exception const &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
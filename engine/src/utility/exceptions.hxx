@@ -71,6 +71,13 @@ namespace vulkan
     };
 }
 
+namespace jobs
+{
+    struct exception final : public std::runtime_error {
+        explicit exception(std::string const &what_arg) : std::runtime_error(what_arg.c_str()) { }
+    };
+}
+
 namespace app
 {
     struct exception final : public std::runtime_error {
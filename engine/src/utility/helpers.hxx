@@ -25,11 +25,12 @@ struct measure {
     template<class F, class... Args>
     static auto execution(F func, Args &&... args)
     {
-        auto const start = std::chrono::system_clock::now();
+        // Monotonic clock, so that the wall-clock adjustments don't skew the measurements.
+        auto const start = std::chrono::steady_clock::now();
 
         func(std::forward<Args>(args)...);
 
-        auto duration = std::chrono::duration_cast<TimeT>(std::chrono::system_clock::now() - start);
+        auto duration = std::chrono::duration_cast<TimeT>(std::chrono::steady_clock::now() - start);
 
         return duration.count();
     }
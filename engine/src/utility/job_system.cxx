@@ -0,0 +1,246 @@
+#include <utility>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <fmt/format.h>
+
+#include "exceptions.hxx"
+#include "trace.hxx"
+#include "job_system.hxx"
+
+
+namespace
+{
+    // The system the current thread is a worker of and the index of its queue there.
+    thread_local jobs::job_system const *worker_job_system{nullptr};
+    thread_local std::size_t worker_queue_index{0};
+
+    std::atomic_size_t dropped_exceptions_number_{0};
+
+    void report_exception(std::exception_ptr exception) noexcept
+    {
+        dropped_exceptions_number_.fetch_add(1, std::memory_order_relaxed);
+
+        try {
+            std::rethrow_exception(std::move(exception));
+        }
+
+        catch (std::exception const &ex) {
+            fmt::print(stderr, "job without a counter has thrown: {}\n", ex.what());
+        }
+
+        catch (...) {
+            fmt::print(stderr, "job without a counter has thrown an unknown exception\n");
+        }
+    }
+}
+
+namespace jobs
+{
+    std::size_t dropped_exceptions_number() noexcept
+    {
+        return dropped_exceptions_number_.load(std::memory_order_relaxed);
+    }
+
+    void job_system::work_queue::push(queued_job &&job)
+    {
+        std::lock_guard lock{mutex_};
+
+        jobs_.push_back(std::move(job));
+    }
+
+    std::optional<job_system::queued_job> job_system::work_queue::pop()
+    {
+        std::lock_guard lock{mutex_};
+
+        if (jobs_.empty())
+            return { };
+
+        auto job = std::move(jobs_.back());
+        jobs_.pop_back();
+
+        return job;
+    }
+
+    std::optional<job_system::queued_job> job_system::work_queue::steal()
+    {
+        std::lock_guard lock{mutex_};
+
+        if (jobs_.empty())
+            return { };
+
+        auto job = std::move(jobs_.front());
+        jobs_.pop_front();
+
+        return job;
+    }
+
+    std::uint32_t job_system::default_workers_number() noexcept
+    {
+        auto const hardware_threads_number = std::thread::hardware_concurrency();
+
+        return hardware_threads_number > 1 ? hardware_threads_number - 1 : 0;
+    }
+
+    job_system::job_system(std::uint32_t workers_number) : main_thread_id_{std::this_thread::get_id()}
+    {
+        for (std::size_t i = 0; i < workers_number + std::size_t{1}; ++i)
+            queues_.push_back(std::make_unique<work_queue>());
+
+        workers_.reserve(workers_number);
+
+        for (std::size_t i = 0; i < workers_number; ++i)
+            workers_.emplace_back([this, queue_index = i + 1] { worker_loop(queue_index); });
+    }
+
+    job_system::~job_system()
+    {
+        {
+            std::lock_guard lock{sleep_mutex_};
+            stopping_ = true;
+        }
+
+        wake_condition_.notify_all();
+
+        // The workers drain the queues before leaving.
+        for (auto &&worker : workers_)
+            worker.join();
+    }
+
+    void job_system::submit(jobs::job_function function, jobs::counter *counter)
+    {
+        if (counter)
+            counter->value_.fetch_add(1, std::memory_order_relaxed);
+
+        // Counted before it's pushed, so a worker taking the job right away can't bring the number below zero.
+        queued_jobs_number_.fetch_add(1, std::memory_order_release);
+
+        queues_.at(current_queue_index())->push(queued_job{std::move(function), counter});
+
+        // Checked under the lock, so a worker about to sleep either sees the job or gets notified.
+        std::lock_guard lock{sleep_mutex_};
+
+        if (sleeping_workers_number_ != 0)
+            wake_condition_.notify_one();
+    }
+
+    void job_system::submit_to_main_thread(jobs::job_function function, jobs::counter *counter)
+    {
+        if (counter)
+            counter->value_.fetch_add(1, std::memory_order_relaxed);
+
+        main_thread_queue_.push(queued_job{std::move(function), counter});
+    }
+
+    void job_system::execute_main_thread_jobs()
+    {
+        if (!is_main_thread())
+            throw jobs::exception("main thread jobs are executed by another thread"s);
+
+        while (auto job = main_thread_queue_.steal())
+            execute(*job);
+    }
+
+    void job_system::wait(jobs::counter &counter)
+    {
+        TRACE_FUNCTION();
+
+        auto const queue_index = current_queue_index();
+        auto const main_thread = is_main_thread();
+
+        while (!counter.done()) {
+            if (main_thread) {
+                if (auto job = main_thread_queue_.steal(); job) {
+                    execute(*job);
+                    continue;
+                }
+            }
+
+            if (auto job = take_job(queue_index); job)
+                execute(*job);
+
+            else std::this_thread::yield();
+        }
+
+        if (counter.exception_) {
+            auto exception = std::exchange(counter.exception_, nullptr);
+            counter.has_exception_.clear();
+
+            std::rethrow_exception(std::move(exception));
+        }
+    }
+
+    std::size_t job_system::current_queue_index() const noexcept
+    {
+        return worker_job_system == this ? worker_queue_index : 0;
+    }
+
+    std::optional<job_system::queued_job> job_system::take_job(std::size_t queue_index)
+    {
+        auto job = queues_[queue_index]->pop();
+
+        for (std::size_t i = 1; !job && i < std::size(queues_); ++i)
+            job = queues_[(queue_index + i) % std::size(queues_)]->steal();
+
+        if (job)
+            queued_jobs_number_.fetch_sub(1, std::memory_order_relaxed);
+
+        return job;
+    }
+
+    void job_system::execute(queued_job &job)
+    {
+        TRACE_ZONE("job");
+
+        try {
+            job.function();
+        }
+
+        catch (...) {
+            // Nobody waits for a job without a counter, so its exception is reported rather than let to terminate the thread.
+            if (job.counter == nullptr) {
+                report_exception(std::current_exception());
+                return;
+            }
+
+            if (!job.counter->has_exception_.test_and_set(std::memory_order_relaxed))
+                job.counter->exception_ = std::current_exception();
+        }
+
+        if (job.counter == nullptr)
+            return;
+
+        // Publishes the job's writes, and the exception, to the waiting thread.
+        job.counter->value_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void job_system::worker_loop(std::size_t queue_index)
+    {
+        worker_job_system = this;
+        worker_queue_index = queue_index;
+
+        while (true) {
+            if (auto job = take_job(queue_index); job) {
+                execute(*job);
+                continue;
+            }
+
+            std::unique_lock lock{sleep_mutex_};
+
+            ++sleeping_workers_number_;
+
+            wake_condition_.wait(lock, [this]
+            {
+                return stopping_ || queued_jobs_number_.load(std::memory_order_acquire) != 0;
+            });
+
+            --sleeping_workers_number_;
+
+            if (stopping_ && queued_jobs_number_.load(std::memory_order_acquire) == 0)
+                break;
+        }
+
+        worker_job_system = nullptr;
+    }
+}
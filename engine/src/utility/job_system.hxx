@@ -0,0 +1,165 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <concepts>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+
+namespace jobs
+{
+    using job_function = std::move_only_function<void()>;
+
+    // Number of the exceptions thrown by the jobs without a counter so far.
+    [[nodiscard]] std::size_t dropped_exceptions_number() noexcept;
+
+    // Number of the submitted jobs that haven't completed yet; a job depending on the others waits for their counter.
+    // The first exception thrown by the jobs is rethrown by the wait.
+    class counter final {
+    public:
+
+        counter() = default;
+
+        [[nodiscard]] bool done() const noexcept { return value_.load(std::memory_order_acquire) == 0; }
+
+    private:
+
+        friend class job_system;
+
+        std::atomic_size_t value_{0};
+
+        std::atomic_flag has_exception_;
+        std::exception_ptr exception_;
+
+        counter(counter const &) = delete;
+        counter(counter &&) = delete;
+    };
+
+    // Fixed pool of the worker threads, each with its own deque of jobs. A thread pushes and pops the jobs at the back
+    // of its deque and, running out of them, steals from the front of the others'. The thread that has created the system
+    // is the main one: it executes the jobs while waiting and exclusively the ones submitted to it, such as the Vulkan queue
+    // operations and the window calls, which have to stay on a single thread.
+    class job_system final {
+    public:
+
+        // One less than the hardware threads, as the main thread executes the jobs too.
+        [[nodiscard]] static std::uint32_t default_workers_number() noexcept;
+
+        // Without the workers all the jobs are executed by the waiting threads.
+        explicit job_system(std::uint32_t workers_number = default_workers_number());
+        ~job_system();
+
+        [[nodiscard]] std::uint32_t workers_number() const noexcept { return static_cast<std::uint32_t>(std::size(workers_)); }
+
+        [[nodiscard]] bool is_main_thread() const noexcept { return std::this_thread::get_id() == main_thread_id_; }
+
+        // The counter, if any, is incremented right away and decremented once the job completes. The exceptions of the jobs
+        // without a counter are reported to stderr and dropped.
+        void submit(jobs::job_function function, jobs::counter *counter = nullptr);
+
+        void submit_to_main_thread(jobs::job_function function, jobs::counter *counter = nullptr);
+
+        // Called by the main thread once per frame at least; the waits execute them as well.
+        void execute_main_thread_jobs();
+
+        // Executes the other jobs until the counter drops to zero. A worker waiting for the main thread jobs relies
+        // on the main thread to execute them.
+        void wait(jobs::counter &counter);
+
+        // Splits the [begin, end) range into the chunks of at most the grain size and calls the function with the bounds
+        // of each one; the calling thread takes its share and returns once all the chunks are done.
+        template<class F> requires std::invocable<F &, std::size_t, std::size_t>
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain_size, F &&function)
+        {
+            if (begin >= end)
+                return;
+
+            grain_size = std::max(grain_size, std::size_t{1});
+
+            auto const first_end = begin + std::min(grain_size, end - begin);
+
+            jobs::counter counter;
+
+            for (auto first = first_end; first < end;) {
+                auto const last = first + std::min(grain_size, end - first);
+
+                submit([&function, first, last] { function(first, last); }, &counter);
+
+                first = last;
+            }
+
+            try {
+                function(begin, first_end);
+            }
+
+            catch (...) {
+                wait(counter);
+                throw;
+            }
+
+            wait(counter);
+        }
+
+    private:
+
+        struct queued_job final {
+            jobs::job_function function;
+            jobs::counter *counter;
+        };
+
+        class work_queue final {
+        public:
+
+            void push(queued_job &&job);
+
+            // The owner takes the most recent jobs, which are likely to be still in the cache.
+            [[nodiscard]] std::optional<queued_job> pop();
+
+            [[nodiscard]] std::optional<queued_job> steal();
+
+        private:
+
+            std::mutex mutex_;
+            std::deque<queued_job> jobs_;
+        };
+
+        std::thread::id main_thread_id_;
+
+        // The main thread's queue is the first one; the workers' ones follow in the order of the workers.
+        std::vector<std::unique_ptr<work_queue>> queues_;
+
+        work_queue main_thread_queue_;
+
+        std::vector<std::thread> workers_;
+
+        // The jobs in the stealable queues; the idle workers sleep until there are any.
+        std::atomic_size_t queued_jobs_number_{0};
+
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_condition_;
+
+        std::size_t sleeping_workers_number_{0};
+        bool stopping_{false};
+
+        [[nodiscard]] std::size_t current_queue_index() const noexcept;
+
+        [[nodiscard]] std::optional<queued_job> take_job(std::size_t queue_index);
+
+        static void execute(queued_job &job);
+
+        void worker_loop(std::size_t queue_index);
+
+        job_system(job_system const &) = delete;
+        job_system(job_system &&) = delete;
+    };
+}
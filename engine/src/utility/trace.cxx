@@ -0,0 +1,182 @@
+#include <new>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+
+#include <string>
+using namespace std::string_literals;
+
+#include <nlohmann/json.hpp>
+
+#include "trace.hxx"
+
+
+namespace
+{
+    std::uint64_t const kORIGIN_NS = trace::now_ns();
+
+    // Chunks are only appended to, so a reader can walk them while the owning thread keeps recording.
+    struct chunk final {
+        static std::size_t constexpr kCAPACITY{4096};
+
+        std::array<trace::event, kCAPACITY> events;
+
+        std::atomic<std::size_t> size{0};
+        std::atomic<chunk *> next{nullptr};
+    };
+
+    struct thread_buffer final {
+        std::uint32_t thread_index;
+
+        chunk head;
+        chunk *tail{&head};
+
+        explicit thread_buffer(std::uint32_t thread_index) noexcept : thread_index{thread_index} { }
+
+        ~thread_buffer()
+        {
+            for (auto *next = head.next.load(std::memory_order_acquire); next != nullptr; )
+                delete std::exchange(next, next->next.load(std::memory_order_acquire));
+        }
+    };
+
+    // Buffers outlive their threads, so the events of finished threads can be saved too.
+    struct registry final {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<thread_buffer>> buffers;
+    };
+
+    registry &get_registry()
+    {
+        static registry instance;
+        return instance;
+    }
+
+    thread_buffer *register_thread_buffer() noexcept
+    {
+        auto &&registry = get_registry();
+
+        std::lock_guard lock{registry.mutex};
+
+        auto const thread_index = static_cast<std::uint32_t>(std::size(registry.buffers));
+
+        auto buffer = std::unique_ptr<thread_buffer>{new (std::nothrow) thread_buffer{thread_index}};
+
+        if (buffer == nullptr)
+            return nullptr;
+
+        try {
+            registry.buffers.push_back(std::move(buffer));
+        }
+
+        catch (...) {
+            return nullptr;
+        }
+
+        return registry.buffers.back().get();
+    }
+}
+
+namespace trace
+{
+    void record(trace::event const &event) noexcept
+    {
+        // Registration is the only synchronized part and happens once per thread.
+        thread_local auto *const buffer = register_thread_buffer();
+
+        if (buffer == nullptr)
+            return;
+
+        auto *tail = buffer->tail;
+        auto size = tail->size.load(std::memory_order_relaxed);
+
+        if (size == chunk::kCAPACITY) {
+            auto *next = new (std::nothrow) chunk;
+
+            if (next == nullptr)
+                return;
+
+            tail->next.store(next, std::memory_order_release);
+            buffer->tail = tail = next;
+
+            size = 0;
+        }
+
+        tail->events[size] = event;
+        tail->size.store(size + 1, std::memory_order_release);
+    }
+
+    void save_chrome_trace(std::ostream &stream)
+    {
+        auto trace_events = nlohmann::json::array();
+
+        // Microseconds relative to the program start, as the trace viewers expect.
+        auto const timestamp = [] (std::uint64_t timestamp_ns)
+        {
+            return static_cast<double>(timestamp_ns - kORIGIN_NS) / 1000.;
+        };
+
+        auto &&registry = get_registry();
+
+        std::lock_guard lock{registry.mutex};
+
+        for (auto &&buffer : registry.buffers) {
+            auto const thread_index = buffer->thread_index;
+
+            trace_events.push_back(nlohmann::json{
+                {"name", "thread_name"s},
+                {"ph", "M"s},
+                {"pid", 0},
+                {"tid", thread_index},
+                {"args", {{"name", "thread #"s + std::to_string(thread_index)}}}
+            });
+
+            for (auto const *chunk = &buffer->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+                auto const size = chunk->size.load(std::memory_order_acquire);
+
+                for (std::size_t index = 0; index < size; ++index) {
+                    auto &&event = chunk->events[index];
+
+                    switch (event.type) {
+                        case trace::EVENT_TYPE::ZONE:
+                            trace_events.push_back(nlohmann::json{
+                                {"name", event.name},
+                                {"ph", "X"s},
+                                {"pid", 0},
+                                {"tid", thread_index},
+                                {"ts", timestamp(event.timestamp_ns)},
+                                {"dur", static_cast<double>(event.value) / 1000.}
+                            });
+                            break;
+
+                        case trace::EVENT_TYPE::COUNTER:
+                            trace_events.push_back(nlohmann::json{
+                                {"name", event.name},
+                                {"ph", "C"s},
+                                {"pid", 0},
+                                {"ts", timestamp(event.timestamp_ns)},
+                                {"args", {{"value", event.value}}}
+                            });
+                            break;
+
+                        case trace::EVENT_TYPE::FRAME_MARK:
+                            trace_events.push_back(nlohmann::json{
+                                {"name", event.name},
+                                {"ph", "i"s},
+                                {"s", "g"s},
+                                {"pid", 0},
+                                {"tid", thread_index},
+                                {"ts", timestamp(event.timestamp_ns)}
+                            });
+                            break;
+                    }
+                }
+            }
+        }
+
+        stream << nlohmann::json{{"traceEvents", std::move(trace_events)}, {"displayTimeUnit", "ns"s}}.dump() << std::endl;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+#include "../include/config.hxx"
+
+
+// CPU instrumentation; all the macros are compiled out unless 'USE_TRACING' is enabled.
+// Names have to be string literals, as only the pointers are recorded.
+#if USE_TRACING
+    #define TRACE_CONCATENATE_IMPL(lhs, rhs) lhs##rhs
+    #define TRACE_CONCATENATE(lhs, rhs) TRACE_CONCATENATE_IMPL(lhs, rhs)
+
+    #define TRACE_ZONE(name) trace::zone const TRACE_CONCATENATE(trace_zone_, __LINE__){name}
+    #define TRACE_FUNCTION() TRACE_ZONE(__func__)
+
+    #define TRACE_COUNTER(name, value) trace::counter(name, static_cast<std::int64_t>(value))
+    #define TRACE_FRAME_MARK() trace::frame_mark()
+#else
+    #define TRACE_ZONE(name) static_cast<void>(0)
+    #define TRACE_FUNCTION() static_cast<void>(0)
+
+    #define TRACE_COUNTER(name, value) static_cast<void>(0)
+    #define TRACE_FRAME_MARK() static_cast<void>(0)
+#endif
+
+
+namespace trace
+{
+    enum struct EVENT_TYPE : std::uint8_t {
+        ZONE, COUNTER, FRAME_MARK
+    };
+
+    struct event final {
+        char const *name;
+
+        std::uint64_t timestamp_ns;
+
+        // Zone duration or counter value.
+        std::int64_t value;
+
+        trace::EVENT_TYPE type;
+    };
+
+    [[nodiscard]] inline std::uint64_t now_ns() noexcept
+    {
+        auto const time = std::chrono::steady_clock::now().time_since_epoch();
+
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+    }
+
+    // Appends the event to the calling thread's buffer without any locking; events are dropped if the buffer can't grow.
+    void record(trace::event const &event) noexcept;
+
+    class zone final {
+    public:
+
+        explicit zone(char const *name) noexcept : name_{name}, begin_ns_{now_ns()} { }
+
+        ~zone()
+        {
+            record(trace::event{name_, begin_ns_, static_cast<std::int64_t>(now_ns() - begin_ns_), trace::EVENT_TYPE::ZONE});
+        }
+
+    private:
+
+        char const *name_;
+        std::uint64_t begin_ns_;
+
+        zone() = delete;
+        zone(zone const &) = delete;
+        zone(zone &&) = delete;
+    };
+
+    inline void counter(char const *name, std::int64_t value) noexcept
+    {
+        record(trace::event{name, now_ns(), value, trace::EVENT_TYPE::COUNTER});
+    }
+
+    inline void frame_mark() noexcept
+    {
+        record(trace::event{"frame", now_ns(), 0, trace::EVENT_TYPE::FRAME_MARK});
+    }
+
+    // Writes all the recorded events in the Chrome trace event format, which Perfetto reads as well.
+    // Threads may keep recording meanwhile; the events recorded after a buffer has been visited are missed.
+    void save_chrome_trace(std::ostream &stream);
+}
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <iostream>
 #include <cstddef>
 
@@ -10,6 +11,11 @@ using namespace std::string_literals;
 #include "debug.hxx"
 
 
+namespace
+{
+    std::atomic<std::size_t> validation_errors_number_{0};
+}
+
 namespace vulkan
 {
     VKAPI_ATTR VkBool32 VKAPI_CALL
@@ -22,8 +28,11 @@ namespace vulkan
         if (message_severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
             fmt::print(stderr, "{} - {} : {}\n\n", data->messageIdNumber, data->pMessageIdName, data->pMessage);
 
-        else if (message_severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+        else if (message_severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+            validation_errors_number_.fetch_add(1, std::memory_order_relaxed);
+
             fmt::print(stderr, "{} - {} : {}\n\n", data->messageIdNumber, data->pMessageIdName, data->pMessage);
+        }
 
         return VK_FALSE;
     }
@@ -33,6 +42,9 @@ namespace vulkan
                    [[maybe_unused]] std::uint64_t object, [[maybe_unused]] std::size_t location, [[maybe_unused]] std::int32_t message_code,
                    [[maybe_unused]] const char *layer_prefix, const char *message, [[maybe_unused]] void *user_data)
     {
+        if (flags & VK_DEBUG_REPORT_ERROR_BIT_EXT)
+            validation_errors_number_.fetch_add(1, std::memory_order_relaxed);
+
         fmt::print(stderr, "{}\n\n", message);
 
         return VK_FALSE;
@@ -53,4 +65,9 @@ namespace vulkan
         if (auto result = vkCreateDebugReportCallbackEXT(instance, &create_info, nullptr, &callback); result != VK_SUCCESS)
             throw vulkan::exception(fmt::format("failed to set up debug callback: {0:#x}", result));
     }
+
+    std::size_t validation_errors_number() noexcept
+    {
+        return validation_errors_number_.load(std::memory_order_relaxed);
+    }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include <volk.h>
 
 
@@ -15,4 +17,7 @@ namespace vulkan
                    std::int32_t messageCode, const char *pLayerPrefix, const char *pMessage, void *pUserData);
 
     void create_debug_report_callback(VkInstance instance, VkDebugReportCallbackEXT &callback);
+
+    // Number of the error messages reported by the validation layers so far.
+    [[nodiscard]] std::size_t validation_errors_number() noexcept;
 }
@@ -245,6 +245,13 @@ namespace
 
                 return true;
             },
+            [] (VkPhysicalDeviceTimelineSemaphoreFeatures const &lhs, VkPhysicalDeviceTimelineSemaphoreFeatures const &rhs)
+            {
+                if (lhs.timelineSemaphore != (lhs.timelineSemaphore * rhs.timelineSemaphore))
+                    return false;
+
+                return true;
+            },
         };
 
         auto compare = [&overloaded_compare] (auto &&lhs, auto &&rhs)
@@ -362,13 +369,18 @@ namespace
 #endif
         {
             if constexpr (std::is_same_v<T, graphics::graphics_queue>) {
-                VkBool32 surface_supported = VK_FALSE;
+                auto const index = family_index++;
 
-                if (auto result = vkGetPhysicalDeviceSurfaceSupportKHR(device, family_index++, surface, &surface_supported); result != VK_SUCCESS)
-                    throw vulkan::device_exception(fmt::format("failed to retrieve surface support: {0:#x}", result));
+                // Headless devices don't present, so any graphics capable family will do.
+                if (surface != VK_NULL_HANDLE) {
+                    VkBool32 surface_supported = VK_FALSE;
 
-                if (surface_supported != VK_TRUE)
-                    return false;
+                    if (auto result = vkGetPhysicalDeviceSurfaceSupportKHR(device, index, surface, &surface_supported); result != VK_SUCCESS)
+                        throw vulkan::device_exception(fmt::format("failed to retrieve surface support: {0:#x}", result));
+
+                    if (surface_supported != VK_TRUE)
+                        return false;
+                }
             }
 
             auto const capability = ([]
@@ -482,14 +494,16 @@ namespace
         devices.erase(std::begin(subrange), std::end(subrange));
 
         // Matching by the swap chain properties support.
-        subrange = std::ranges::remove_if(std::begin(devices), std::end(devices), [surface] (auto &&device)
-        {
-            auto details = query_swapchain_support_details(device, surface);
+        if (surface != VK_NULL_HANDLE) {
+            subrange = std::ranges::remove_if(std::begin(devices), std::end(devices), [surface] (auto &&device)
+            {
+                auto details = query_swapchain_support_details(device, surface);
 
-            return details.surface_formats.empty() || details.presentation_modes.empty();
-        });
+                return details.surface_formats.empty() || details.presentation_modes.empty();
+            });
 
-        devices.erase(std::begin(subrange), std::end(subrange));
+            devices.erase(std::begin(subrange), std::end(subrange));
+        }
 
         if (devices.empty())
             throw vulkan::device_exception("failed to pick physical device"s);
@@ -518,10 +532,19 @@ namespace
 
     vulkan::device_limits get_device_limits(VkPhysicalDevice physical_handle)
     {
-        VkPhysicalDeviceProperties properties;
-        vkGetPhysicalDeviceProperties(physical_handle, &properties);
+        VkPhysicalDeviceDescriptorIndexingProperties descriptor_indexing_properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES,
+            .pNext = nullptr
+        };
 
-        auto &&limits = properties.limits;
+        VkPhysicalDeviceProperties2 properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &descriptor_indexing_properties
+        };
+
+        vkGetPhysicalDeviceProperties2(physical_handle, &properties);
+
+        auto &&limits = properties.properties.limits;
 
         return vulkan::device_limits{
             limits.bufferImageGranularity,
@@ -632,7 +655,10 @@ namespace
 
             limits.timestampComputeAndGraphics == VK_TRUE,
             limits.strictLines == VK_TRUE,
-            limits.standardSampleLocations == VK_TRUE
+            limits.standardSampleLocations == VK_TRUE,
+
+            descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+            descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages
         };
     }
 }
@@ -688,15 +714,20 @@ namespace vulkan
 
         std::vector<char const *> extensions;
 
+        auto const headless = platform_surface.handle() == VK_NULL_HANDLE;
+
         if constexpr (use_extensions) {
             auto constexpr extensions_ = vulkan::device_extensions;
 
-            std::ranges::copy(extensions_, std::back_inserter(extensions));
+            std::ranges::copy_if(extensions_, std::back_inserter(extensions), [headless] (auto extension)
+            {
+                return !headless || std::string_view{extension} != VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+            });
+        }
 
-            std::vector<std::string_view> extensions_view{std::begin(extensions), std::end(extensions)};
+        std::vector<std::string_view> extensions_view{std::begin(extensions), std::end(extensions)};
 
-            physical_handle_ = pick_physical_device(instance.handle(), platform_surface.handle(), std::move(extensions_view));
-        }
+        physical_handle_ = pick_physical_device(instance.handle(), platform_surface.handle(), std::move(extensions_view));
 
         auto required_extended_features = std::apply([] (auto ...args)
         {
@@ -719,6 +750,33 @@ namespace vulkan
             vulkan::device_features
         };
 
+        {
+            VkPhysicalDeviceDescriptorIndexingFeatures supported_descriptor_indexing_features{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+                .pNext = nullptr
+            };
+
+            VkPhysicalDeviceFeatures2 supported_features{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                .pNext = &supported_descriptor_indexing_features
+            };
+
+            vkGetPhysicalDeviceFeatures2(physical_handle_, &supported_features);
+
+            // Optional features are enabled whenever they are available.
+            required_device_features.features.pipelineStatisticsQuery = supported_features.features.pipelineStatisticsQuery;
+
+            // Only the ones the bindless textures rely on.
+            descriptor_indexing_features_.runtimeDescriptorArray = supported_descriptor_indexing_features.runtimeDescriptorArray;
+            descriptor_indexing_features_.descriptorBindingPartiallyBound = supported_descriptor_indexing_features.descriptorBindingPartiallyBound;
+            descriptor_indexing_features_.descriptorBindingUpdateUnusedWhilePending = supported_descriptor_indexing_features.descriptorBindingUpdateUnusedWhilePending;
+            descriptor_indexing_features_.descriptorBindingSampledImageUpdateAfterBind =
+                supported_descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind;
+
+            descriptor_indexing_features_.pNext = required_device_features.pNext;
+            required_device_features.pNext = &descriptor_indexing_features_;
+        }
+
         std::vector<queue_t> requested_queues{
             graphics_queue, compute_queue, transfer_queue, presentation_queue
         };
@@ -761,7 +819,15 @@ namespace vulkan
             }, queue);
         }
 
+        graphics_queue.timeline_ = std::make_shared<render::timeline>(handle_);
+        compute_queue.timeline_ = std::make_shared<render::timeline>(handle_);
+        transfer_queue.timeline_ = std::make_shared<render::timeline>(handle_);
+        presentation_queue.timeline_ = std::make_shared<render::timeline>(handle_);
+
         device_limits_ = get_device_limits(physical_handle_);
+        features_ = required_device_features.features;
+
+        descriptor_indexing_features_.pNext = nullptr;
     }
 
     device::~device()
@@ -771,6 +837,11 @@ namespace vulkan
 
         vkDeviceWaitIdle(handle_);
 
+        graphics_queue.timeline_.reset();
+        compute_queue.timeline_.reset();
+        transfer_queue.timeline_.reset();
+        presentation_queue.timeline_.reset();
+
         vkDestroyDevice(handle_, nullptr);
 
         handle_ = nullptr;
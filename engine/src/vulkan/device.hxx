@@ -46,6 +46,11 @@ namespace vulkan
 
         vulkan::device_limits const &device_limits() const noexcept { return device_limits_; }
 
+        // Features the logical device has been created with.
+        VkPhysicalDeviceFeatures const &features() const noexcept { return features_; }
+
+        VkPhysicalDeviceDescriptorIndexingFeatures const &descriptor_indexing_features() const noexcept { return descriptor_indexing_features_; }
+
         [[nodiscard]] render::swapchain_support_details query_swapchain_support_details(render::platform_surface platform_surface) const;
 
         [[nodiscard]] bool is_format_supported_as_buffer_feature(graphics::FORMAT format, graphics::FORMAT_FEATURE features) const noexcept;
@@ -61,6 +66,12 @@ namespace vulkan
         VkPhysicalDevice physical_handle_{VK_NULL_HANDLE};
 
         vulkan::device_limits device_limits_;
+        VkPhysicalDeviceFeatures features_{};
+
+        VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features_{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+            .pNext = nullptr
+        };
 
         struct queue_helper;
     };
@@ -106,6 +106,11 @@ namespace vulkan
             VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FLOAT16_INT8_FEATURES_KHR,
             nullptr,
             VK_FALSE, VK_TRUE
+        },
+        VkPhysicalDeviceTimelineSemaphoreFeatures{
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+            nullptr,
+            VK_TRUE
         }
     };
 }
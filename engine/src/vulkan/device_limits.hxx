@@ -117,5 +117,8 @@ namespace vulkan
         bool                              timestamp_compute_and_graphics;
         bool                              strict_lines;
         bool                              standard_sample_locations;
+
+        std::uint32_t                     max_per_stage_descriptor_update_after_bind_samplers;
+        std::uint32_t                     max_per_stage_descriptor_update_after_bind_sampled_images;
     };
 }
@@ -114,7 +114,7 @@ namespace
 
 namespace vulkan
 {
-    instance::instance()
+    instance::instance(bool headless) : headless_{headless}
     {
         if (auto result = volkInitialize(); result != VK_SUCCESS)
             throw vulkan::instance_exception("failed to initialize 'volk' meta-loader"s);
@@ -146,7 +146,10 @@ namespace vulkan
                 #endif
             }
 
-            std::ranges::copy(extensions_, std::back_inserter(extensions));
+            std::ranges::copy_if(extensions_, std::back_inserter(extensions), [headless] (auto extension)
+            {
+                return !headless || !std::string_view{extension}.ends_with("_surface");
+            });
         }
 
         if constexpr (use_layers) {
@@ -267,6 +270,9 @@ namespace vulkan
 
     render::platform_surface instance::get_platform_surface(platform::window &window)
     {
+        if (headless_)
+            throw vulkan::logic_error("headless instance can't create platform surfaces"s);
+
         if (!platform_surfaces_.contains(window.handle())) {
             render::platform_surface platform_surface;
 
@@ -36,7 +36,8 @@ namespace vulkan
     class instance final {
     public:
 
-        explicit instance();
+        // Headless instance doesn't enable window system integration extensions and can't create platform surfaces.
+        explicit instance(bool headless = false);
         ~instance();
 
         instance(instance const &) = delete;
@@ -47,12 +48,16 @@ namespace vulkan
 
         [[nodiscard]] VkInstance handle() const noexcept { return handle_; }
 
+        [[nodiscard]] bool headless() const noexcept { return headless_; }
+
         render::platform_surface get_platform_surface(platform::window &window);
 
     private:
 
         VkInstance handle_{VK_NULL_HANDLE};
 
+        bool headless_{false};
+
         VkDebugReportCallbackEXT debug_report_callback_{VK_NULL_HANDLE};
         VkDebugUtilsMessengerEXT debug_messenger_{VK_NULL_HANDLE};
 
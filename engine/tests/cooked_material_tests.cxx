@@ -0,0 +1,160 @@
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "loaders/material_loader.hxx"
+#include "loaders/cooked_material.hxx"
+
+
+namespace
+{
+    namespace cooked_material = loader::cooked_material;
+
+    [[nodiscard]] loader::material_description test_description()
+    {
+        loader::material_description description;
+
+        description.name = "test-material";
+
+        description.shader_modules = {
+            {graphics::SHADER_STAGE::VERTEX, "shader.vert"},
+            {graphics::SHADER_STAGE::FRAGMENT, "shader.frag"}
+        };
+
+        description.vertex_attributes = {
+            {vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT},
+            {vertex::SEMANTIC::NORMAL, graphics::FORMAT::RGB32_SFLOAT}
+        };
+
+        auto &&technique = description.techniques.emplace_back();
+
+        technique.shaders_bundle.push_back({0, 0, {std::int32_t{1}}});
+        technique.shaders_bundle.push_back({1, 0, {boost::float32_t{.5f}}});
+        technique.vertex_layouts.push_back({0, 1});
+
+        description.push_constant_ranges.push_back({graphics::SHADER_STAGE::VERTEX, 0, 4});
+
+        return description;
+    }
+
+    class cooked_material_test : public ::testing::Test {
+    protected:
+
+        void SetUp() override
+        {
+            path_ = std::filesystem::temp_directory_path() / "engine_tests_cooked_material.bin";
+
+            loader::cook_material_description(test_description(), path_);
+
+            std::ifstream file{path_, std::ios::binary};
+            bytes_.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(path_);
+        }
+
+        // Overwrites a word of the first record of the section and reseals the file, so only the value's check can reject it.
+        void patch(cooked_material::SECTION section, std::size_t word_index, std::uint32_t value)
+        {
+            cooked_material::header header;
+            std::memcpy(&header, std::data(bytes_), sizeof(header));
+
+            auto const offset = header.sections.at(static_cast<std::size_t>(section)).offset + word_index * sizeof(std::uint32_t);
+            std::memcpy(std::data(bytes_) + offset, &value, sizeof(value));
+
+            // 32-bit FNV-1a of the payload.
+            header.checksum = 0x811C'9DC5;
+
+            for (auto it = std::next(std::cbegin(bytes_), sizeof(header)); it != std::cend(bytes_); ++it) {
+                header.checksum ^= static_cast<unsigned char>(*it);
+                header.checksum *= 0x0100'0193;
+            }
+
+            std::memcpy(std::data(bytes_), &header, sizeof(header));
+
+            std::ofstream file{path_, std::ios::binary | std::ios::trunc};
+            file.write(std::data(bytes_), static_cast<std::streamsize>(std::size(bytes_)));
+        }
+
+        std::filesystem::path path_;
+        std::vector<char> bytes_;
+    };
+}
+
+TEST_F(cooked_material_test, round_trip_preserves_description)
+{
+    auto const description = loader::load_cooked_material_description(path_);
+
+    ASSERT_TRUE(description.has_value());
+
+    auto const expected = test_description();
+
+    EXPECT_EQ(description->name, expected.name);
+
+    ASSERT_EQ(std::size(description->shader_modules), 2u);
+    EXPECT_EQ(description->shader_modules[1].stage, graphics::SHADER_STAGE::FRAGMENT);
+    EXPECT_EQ(description->shader_modules[1].name, "shader.frag");
+
+    ASSERT_EQ(std::size(description->vertex_attributes), 2u);
+    EXPECT_EQ(description->vertex_attributes[1].semantic, vertex::SEMANTIC::NORMAL);
+    EXPECT_EQ(description->vertex_attributes[1].format, graphics::FORMAT::RGB32_SFLOAT);
+
+    ASSERT_EQ(std::size(description->techniques), 1u);
+    EXPECT_EQ(description->techniques[0].shaders_bundle[1].specialization_constants, expected.techniques[0].shaders_bundle[1].specialization_constants);
+    EXPECT_EQ(description->techniques[0].vertex_layouts, expected.techniques[0].vertex_layouts);
+
+    ASSERT_EQ(std::size(description->push_constant_ranges), 1u);
+    EXPECT_EQ(description->push_constant_ranges[0].size, 4u);
+}
+
+TEST_F(cooked_material_test, damaged_payload_is_rejected)
+{
+    bytes_.back() ^= 0x01;
+
+    std::ofstream{path_, std::ios::binary | std::ios::trunc}.write(std::data(bytes_), static_cast<std::streamsize>(std::size(bytes_)));
+
+    EXPECT_THROW(static_cast<void>(loader::load_cooked_material_description(path_)), resource::exception);
+}
+
+TEST_F(cooked_material_test, unknown_shader_stage_is_rejected)
+{
+    patch(cooked_material::SECTION::SHADER_MODULES, 0, static_cast<std::uint32_t>(graphics::SHADER_STAGE::ALL_GRAPHICS_SHADER_STAGES));
+
+    EXPECT_THROW(static_cast<void>(loader::load_cooked_material_description(path_)), resource::exception);
+}
+
+TEST_F(cooked_material_test, out_of_range_semantic_is_rejected)
+{
+    patch(cooked_material::SECTION::VERTEX_ATTRIBUTES, 0, static_cast<std::uint32_t>(vertex::SEMANTIC::WEIGHTS_0) + 1);
+
+    EXPECT_THROW(static_cast<void>(loader::load_cooked_material_description(path_)), resource::exception);
+}
+
+TEST_F(cooked_material_test, out_of_range_format_is_rejected)
+{
+    patch(cooked_material::SECTION::VERTEX_ATTRIBUTES, 1, static_cast<std::uint32_t>(graphics::FORMAT::RGBA12X4_UNORM_4PACK16) + 1);
+
+    EXPECT_THROW(static_cast<void>(loader::load_cooked_material_description(path_)), resource::exception);
+}
+
+TEST_F(cooked_material_test, out_of_range_specialization_constant_type_is_rejected)
+{
+    patch(cooked_material::SECTION::SPECIALIZATION_CONSTANTS, 0, static_cast<std::uint32_t>(cooked_material::SPECIALIZATION_CONSTANT_TYPE::FLOAT32) + 1);
+
+    EXPECT_THROW(static_cast<void>(loader::load_cooked_material_description(path_)), resource::exception);
+}
+
+TEST_F(cooked_material_test, unknown_push_constant_stages_are_rejected)
+{
+    patch(cooked_material::SECTION::PUSH_CONSTANT_RANGES, 0, static_cast<std::uint32_t>(graphics::SHADER_STAGE::ALL_SHADER_STAGES) << 1);
+
+    EXPECT_THROW(static_cast<void>(loader::load_cooked_material_description(path_)), resource::exception);
+}
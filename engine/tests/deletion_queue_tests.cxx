@@ -0,0 +1,197 @@
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "vulkan/debug.hxx"
+
+#include "graphics/graphics.hxx"
+
+#include "resources/buffer.hxx"
+#include "resources/image.hxx"
+#include "resources/memory_manager.hxx"
+#include "resources/resource_manager.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace
+{
+    class deletion_queue_test : public test::device_test {
+    protected:
+
+        void SetUp() override
+        {
+            test::device_test::SetUp();
+
+            if (IsSkipped())
+                return;
+
+            wait_idle();
+
+            validation_errors_number_ = vulkan::validation_errors_number();
+        }
+
+        void TearDown() override
+        {
+            if (IsSkipped())
+                return;
+
+            wait_idle();
+
+            EXPECT_EQ(resource_manager().deletion_queue().size(), 0u);
+            EXPECT_EQ(vulkan::validation_errors_number(), validation_errors_number_) << "validation errors have been reported";
+        }
+
+        // Empty submission signaling the next value of the graphics queue timeline, standing in for a frame.
+        static std::uint64_t submit_frame()
+        {
+            auto &&queue = device().graphics_queue;
+            auto &&timeline = queue.timeline();
+
+            auto const timeline_handle = timeline.handle();
+            auto const timeline_value = timeline.next_value();
+
+            VkTimelineSemaphoreSubmitInfo const timeline_info{
+                VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+                nullptr,
+                0, nullptr,
+                1, &timeline_value
+            };
+
+            VkSubmitInfo const submit_info{
+                VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                &timeline_info,
+                0, nullptr,
+                nullptr,
+                0, nullptr,
+                1, &timeline_handle,
+            };
+
+            if (auto result = vkQueueSubmit(queue.handle(), 1, &submit_info, VK_NULL_HANDLE); result != VK_SUCCESS)
+                throw vulkan::exception(fmt::format("failed to submit frame: {0:#x}", result));
+
+            timeline.commit_value(timeline_value);
+
+            return timeline_value;
+        }
+
+        static void wait_idle()
+        {
+            auto &&timeline = device().graphics_queue.timeline();
+
+            timeline.wait(timeline.last_value());
+
+            // Deleters may release other objects, which are pushed in turn.
+            while (resource_manager().deletion_queue().collect() != 0);
+        }
+
+        [[nodiscard]] static std::shared_ptr<resource::buffer> create_buffer()
+        {
+            return resource_manager().create_buffer(
+                4096, graphics::BUFFER_USAGE::VERTEX_BUFFER | graphics::BUFFER_USAGE::TRANSFER_DESTINATION,
+                graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL, graphics::RESOURCE_SHARING_MODE::EXCLUSIVE
+            );
+        }
+
+        [[nodiscard]] static std::shared_ptr<resource::image> create_image()
+        {
+            return resource_manager().create_image(
+                graphics::IMAGE_TYPE::TYPE_2D, graphics::FORMAT::RGBA8_UNORM, render::extent{16, 16}, 1, 1, graphics::IMAGE_TILING::OPTIMAL,
+                graphics::IMAGE_USAGE::SAMPLED | graphics::IMAGE_USAGE::TRANSFER_DESTINATION, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL
+            );
+        }
+
+    private:
+
+        std::size_t validation_errors_number_{0};
+    };
+}
+
+TEST_F(deletion_queue_test, released_objects_wait_for_submissions)
+{
+    auto buffer = create_buffer();
+
+    auto const timeline_value = submit_frame();
+
+    auto const pending_objects_number = resource_manager().deletion_queue().size();
+
+    buffer.reset();
+
+    EXPECT_EQ(resource_manager().deletion_queue().size(), pending_objects_number + 1);
+
+    device().graphics_queue.timeline().wait(timeline_value);
+
+    EXPECT_GE(resource_manager().deletion_queue().collect(), 1u);
+}
+
+TEST_F(deletion_queue_test, staging_buffers_are_deferred)
+{
+    auto staging_buffer = resource_manager().create_staging_buffer(1024);
+
+    submit_frame();
+
+    auto const pending_objects_number = resource_manager().deletion_queue().size();
+
+    staging_buffer.reset();
+
+    EXPECT_EQ(resource_manager().deletion_queue().size(), pending_objects_number + 1);
+}
+
+TEST_F(deletion_queue_test, staging_allocation_collects_released_ranges)
+{
+    auto staging_buffer = resource_manager().create_staging_buffer(1024);
+
+    staging_buffer.reset();
+
+    device().graphics_queue.timeline().wait(device().graphics_queue.timeline().last_value());
+
+    // The whole pool is available only if the released range has been returned to it.
+    staging_buffer = resource_manager().create_staging_buffer(resource::memory_manager::kPAGE_ALLOCATION_SIZE);
+
+    EXPECT_NE(staging_buffer, nullptr);
+}
+
+TEST_F(deletion_queue_test, churn_keeps_pending_objects_bounded)
+{
+    std::size_t constexpr kFRAMES_NUMBER{256};
+    std::size_t constexpr kFRAMES_IN_FLIGHT{3};
+
+    std::array<std::uint64_t, kFRAMES_IN_FLIGHT> frame_timeline_values{};
+
+    std::size_t max_pending_objects_number{0};
+
+    for (std::size_t frame_index = 0; frame_index < kFRAMES_NUMBER; ++frame_index) {
+        auto &&frame_timeline_value = frame_timeline_values[frame_index % kFRAMES_IN_FLIGHT];
+
+        device().graphics_queue.timeline().wait(frame_timeline_value);
+
+        resource_manager().deletion_queue().collect();
+
+        // Everything is released at the end of the frame it's been created in.
+        {
+            auto buffer = create_buffer();
+            auto image = create_image();
+            auto image_view = resource_manager().create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+            auto staging_buffer = resource_manager().create_staging_buffer(4096);
+
+            ASSERT_NE(buffer, nullptr);
+            ASSERT_NE(image_view, nullptr);
+            ASSERT_NE(staging_buffer, nullptr);
+        }
+
+        frame_timeline_value = submit_frame();
+
+        max_pending_objects_number = std::max(max_pending_objects_number, resource_manager().deletion_queue().size());
+    }
+
+    // Four objects per frame, kept for at most the frames in flight and the one being recorded.
+    EXPECT_LE(max_pending_objects_number, 4 * (kFRAMES_IN_FLIGHT + 1));
+}
@@ -0,0 +1,271 @@
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "vulkan/debug.hxx"
+
+#include "graphics/graphics.hxx"
+#include "graphics/descriptors.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace
+{
+    struct created_pool final {
+        std::uint32_t max_sets;
+        std::vector<VkDescriptorPoolSize> pool_sizes;
+
+        [[nodiscard]] std::uint32_t descriptors_number(VkDescriptorType type) const
+        {
+            auto it = std::ranges::find(pool_sizes, type, &VkDescriptorPoolSize::type);
+
+            return it != std::end(pool_sizes) ? it->descriptorCount : 0;
+        }
+    };
+
+    struct pool_usage final {
+        created_pool description;
+
+        std::uint32_t sets_number{0};
+        std::map<VkDescriptorType, std::uint32_t> descriptors_numbers;
+    };
+
+    std::vector<created_pool> created_pools;
+
+    std::map<VkDescriptorPool, pool_usage> pools_usage;
+    std::map<VkDescriptorSetLayout, std::vector<graphics::descriptor_set_binding>> layouts_bindings;
+
+    bool fragment_next_allocation{false};
+
+    PFN_vkCreateDescriptorPool create_descriptor_pool{nullptr};
+    PFN_vkAllocateDescriptorSets allocate_descriptor_sets{nullptr};
+    PFN_vkResetDescriptorPool reset_descriptor_pool{nullptr};
+
+    VKAPI_ATTR VkResult VKAPI_CALL recorded_create_descriptor_pool(VkDevice device, VkDescriptorPoolCreateInfo const *create_info,
+                                                                   VkAllocationCallbacks const *allocator, VkDescriptorPool *pool)
+    {
+        auto const result = create_descriptor_pool(device, create_info, allocator, pool);
+
+        if (result == VK_SUCCESS) {
+            auto &&description = created_pools.emplace_back(created_pool{
+                create_info->maxSets, {create_info->pPoolSizes, create_info->pPoolSizes + create_info->poolSizeCount}
+            });
+
+            pools_usage[*pool] = pool_usage{description};
+        }
+
+        return result;
+    }
+
+    // Some implementations, e.g. lavapipe, don't run out of pool memory, so the pool limits are enforced as the strictest one would do.
+    VKAPI_ATTR VkResult VKAPI_CALL strict_allocate_descriptor_sets(VkDevice device, VkDescriptorSetAllocateInfo const *allocate_info,
+                                                                   VkDescriptorSet *descriptor_sets)
+    {
+        if (std::exchange(fragment_next_allocation, false))
+            return VK_ERROR_FRAGMENTED_POOL;
+
+        auto &&usage = pools_usage.at(allocate_info->descriptorPool);
+
+        auto descriptors_numbers = usage.descriptors_numbers;
+
+        for (std::uint32_t i = 0; i < allocate_info->descriptorSetCount; ++i) {
+            for (auto &&binding : layouts_bindings.at(allocate_info->pSetLayouts[i]))
+                descriptors_numbers[static_cast<VkDescriptorType>(binding.descriptor_type)] += binding.descriptor_count;
+        }
+
+        if (usage.sets_number + allocate_info->descriptorSetCount > usage.description.max_sets)
+            return VK_ERROR_OUT_OF_POOL_MEMORY;
+
+        for (auto [type, descriptors_number] : descriptors_numbers)
+            if (descriptors_number > usage.description.descriptors_number(type))
+                return VK_ERROR_OUT_OF_POOL_MEMORY;
+
+        auto const result = allocate_descriptor_sets(device, allocate_info, descriptor_sets);
+
+        if (result == VK_SUCCESS) {
+            usage.sets_number += allocate_info->descriptorSetCount;
+            usage.descriptors_numbers = std::move(descriptors_numbers);
+        }
+
+        return result;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL recorded_reset_descriptor_pool(VkDevice device, VkDescriptorPool pool, VkDescriptorPoolResetFlags flags)
+    {
+        auto &&usage = pools_usage.at(pool);
+
+        usage.sets_number = 0;
+        usage.descriptors_numbers.clear();
+
+        return reset_descriptor_pool(device, pool, flags);
+    }
+
+    // The pool functions are volk's global pointers, so they are swapped for the test's duration.
+    class descriptor_allocator_test : public test::device_test {
+    protected:
+
+        void SetUp() override
+        {
+            test::device_test::SetUp();
+
+            if (IsSkipped())
+                return;
+
+            created_pools.clear();
+            pools_usage.clear();
+            layouts_bindings.clear();
+
+            fragment_next_allocation = false;
+
+            create_descriptor_pool = std::exchange(vkCreateDescriptorPool, recorded_create_descriptor_pool);
+            allocate_descriptor_sets = std::exchange(vkAllocateDescriptorSets, strict_allocate_descriptor_sets);
+            reset_descriptor_pool = std::exchange(vkResetDescriptorPool, recorded_reset_descriptor_pool);
+
+            validation_errors_number_ = vulkan::validation_errors_number();
+
+            descriptor_registry_ = std::make_unique<graphics::descriptor_registry>(device());
+
+            uniform_buffer_layout_ = descriptor_registry_->create_descriptor_set_layout({
+                {0, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER, graphics::SHADER_STAGE::VERTEX}
+            });
+
+            image_sampler_layout_ = descriptor_registry_->create_descriptor_set_layout({
+                {0, 4, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT}
+            });
+
+            for (auto &&layout : {uniform_buffer_layout_, image_sampler_layout_})
+                layouts_bindings.emplace(layout->handle(), layout->descriptor_set_bindings());
+        }
+
+        void TearDown() override
+        {
+            if (IsSkipped())
+                return;
+
+            image_sampler_layout_.reset();
+            uniform_buffer_layout_.reset();
+            descriptor_registry_.reset();
+
+            vkCreateDescriptorPool = std::exchange(create_descriptor_pool, nullptr);
+            vkAllocateDescriptorSets = std::exchange(allocate_descriptor_sets, nullptr);
+            vkResetDescriptorPool = std::exchange(reset_descriptor_pool, nullptr);
+
+            EXPECT_EQ(vulkan::validation_errors_number(), validation_errors_number_) << "validation errors have been reported";
+        }
+
+        std::unique_ptr<graphics::descriptor_registry> descriptor_registry_;
+
+        std::shared_ptr<graphics::descriptor_set_layout> uniform_buffer_layout_;
+        std::shared_ptr<graphics::descriptor_set_layout> image_sampler_layout_;
+
+    private:
+
+        std::size_t validation_errors_number_{0};
+    };
+}
+
+TEST_F(descriptor_allocator_test, exhausted_pools_are_chained)
+{
+    graphics::descriptor_allocator descriptor_allocator{device(), 1};
+
+    std::set<VkDescriptorSet> descriptor_sets;
+
+    for (auto i = 0; i < 1024; ++i) {
+        auto const descriptor_set = descriptor_allocator.allocate(*uniform_buffer_layout_);
+
+        ASSERT_NE(descriptor_set, VK_NULL_HANDLE);
+
+        descriptor_sets.insert(descriptor_set);
+    }
+
+    EXPECT_EQ(std::size(descriptor_sets), 1024u);
+
+    // The pools double in size, so a handful of them holds all the sets.
+    EXPECT_GT(descriptor_allocator.pools_number(), 1u);
+    EXPECT_LE(descriptor_allocator.pools_number(), 11u);
+    EXPECT_EQ(descriptor_allocator.pools_number(), std::size(created_pools));
+
+    for (std::size_t i = 1; i < std::size(created_pools); ++i)
+        EXPECT_EQ(created_pools[i].max_sets, std::min(created_pools[i - 1].max_sets * 2, graphics::descriptor_allocator::kMAX_SETS_PER_POOL));
+}
+
+TEST_F(descriptor_allocator_test, pool_without_fitting_descriptors_is_chained)
+{
+    graphics::descriptor_allocator descriptor_allocator{device()};
+
+    ASSERT_NE(descriptor_allocator.allocate(*uniform_buffer_layout_), VK_NULL_HANDLE);
+
+    // The first pool has been sized for uniform buffers only, so it runs out of pool memory, not of sets.
+    ASSERT_EQ(std::size(created_pools), 1u);
+    EXPECT_EQ(created_pools[0].descriptors_number(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER), 0u);
+
+    ASSERT_NE(descriptor_allocator.allocate(*image_sampler_layout_), VK_NULL_HANDLE);
+
+    ASSERT_EQ(std::size(created_pools), 2u);
+    EXPECT_GE(created_pools[1].descriptors_number(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER), 4u);
+}
+
+TEST_F(descriptor_allocator_test, fragmented_pool_is_chained)
+{
+    graphics::descriptor_allocator descriptor_allocator{device()};
+
+    ASSERT_NE(descriptor_allocator.allocate(*uniform_buffer_layout_), VK_NULL_HANDLE);
+
+    fragment_next_allocation = true;
+
+    ASSERT_NE(descriptor_allocator.allocate(*uniform_buffer_layout_), VK_NULL_HANDLE);
+
+    EXPECT_EQ(descriptor_allocator.pools_number(), 2u);
+}
+
+TEST_F(descriptor_allocator_test, reset_recycles_pools)
+{
+    graphics::descriptor_allocator descriptor_allocator{device(), 4};
+
+    for (auto frame = 0; frame < 16; ++frame) {
+        descriptor_allocator.reset();
+
+        for (auto i = 0; i < 256; ++i)
+            ASSERT_NE(descriptor_allocator.allocate(*uniform_buffer_layout_), VK_NULL_HANDLE);
+    }
+
+    // Only the first frame has created pools.
+    EXPECT_EQ(descriptor_allocator.pools_number(), std::size(created_pools));
+    EXPECT_LE(std::size(created_pools), 7u);
+}
+
+TEST_F(descriptor_allocator_test, pools_are_sized_by_recent_usage)
+{
+    graphics::descriptor_allocator descriptor_allocator{device(), 4};
+
+    for (auto i = 0; i < 4; ++i)
+        ASSERT_NE(descriptor_allocator.allocate(*image_sampler_layout_), VK_NULL_HANDLE);
+
+    // The image samplers are no longer used, so their share in the usage decays with each reset.
+    for (auto frame = 0; frame < 8; ++frame) {
+        descriptor_allocator.reset();
+
+        for (auto i = 0; i < 4; ++i)
+            ASSERT_NE(descriptor_allocator.allocate(*uniform_buffer_layout_), VK_NULL_HANDLE);
+    }
+
+    auto const pools_number = std::size(created_pools);
+
+    // More sets than the recycled pools hold.
+    for (auto i = 0; i < 256; ++i)
+        ASSERT_NE(descriptor_allocator.allocate(*uniform_buffer_layout_), VK_NULL_HANDLE);
+
+    ASSERT_GT(std::size(created_pools), pools_number);
+
+    auto &&last_pool = created_pools.back();
+
+    EXPECT_EQ(last_pool.descriptors_number(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER), 0u);
+    EXPECT_GT(last_pool.descriptors_number(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER), 0u);
+}
@@ -0,0 +1,174 @@
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "graphics/graphics.hxx"
+#include "graphics/descriptors.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace
+{
+    std::size_t set_layouts_created{0};
+    std::size_t pipeline_layouts_created{0};
+    std::size_t update_templates_created{0};
+
+    PFN_vkCreateDescriptorSetLayout create_descriptor_set_layout{nullptr};
+    PFN_vkCreatePipelineLayout create_pipeline_layout{nullptr};
+    PFN_vkCreateDescriptorUpdateTemplate create_descriptor_update_template{nullptr};
+
+    VKAPI_ATTR VkResult VKAPI_CALL counted_create_descriptor_set_layout(VkDevice device, VkDescriptorSetLayoutCreateInfo const *create_info,
+                                                                        VkAllocationCallbacks const *allocator, VkDescriptorSetLayout *layout)
+    {
+        ++set_layouts_created;
+
+        return create_descriptor_set_layout(device, create_info, allocator, layout);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL counted_create_pipeline_layout(VkDevice device, VkPipelineLayoutCreateInfo const *create_info,
+                                                                  VkAllocationCallbacks const *allocator, VkPipelineLayout *layout)
+    {
+        ++pipeline_layouts_created;
+
+        return create_pipeline_layout(device, create_info, allocator, layout);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL counted_create_descriptor_update_template(VkDevice device, VkDescriptorUpdateTemplateCreateInfo const *create_info,
+                                                                             VkAllocationCallbacks const *allocator, VkDescriptorUpdateTemplate *update_template)
+    {
+        ++update_templates_created;
+
+        return create_descriptor_update_template(device, create_info, allocator, update_template);
+    }
+
+    // The device functions are volk's global pointers, so the calls are counted by swapping them for the test's duration.
+    // The registry is a member of the fixture, so it outlives the objects created by the test's body.
+    class descriptor_registry_test : public test::device_test {
+    protected:
+
+        void SetUp() override
+        {
+            test::device_test::SetUp();
+
+            if (IsSkipped())
+                return;
+
+            set_layouts_created = 0;
+            pipeline_layouts_created = 0;
+            update_templates_created = 0;
+
+            create_descriptor_set_layout = std::exchange(vkCreateDescriptorSetLayout, counted_create_descriptor_set_layout);
+            create_pipeline_layout = std::exchange(vkCreatePipelineLayout, counted_create_pipeline_layout);
+            create_descriptor_update_template = std::exchange(vkCreateDescriptorUpdateTemplate, counted_create_descriptor_update_template);
+
+            descriptor_registry_ = std::make_unique<graphics::descriptor_registry>(device());
+        }
+
+        void TearDown() override
+        {
+            if (IsSkipped())
+                return;
+
+            vkCreateDescriptorSetLayout = std::exchange(create_descriptor_set_layout, nullptr);
+            vkCreatePipelineLayout = std::exchange(create_pipeline_layout, nullptr);
+            vkCreateDescriptorUpdateTemplate = std::exchange(create_descriptor_update_template, nullptr);
+        }
+
+        [[nodiscard]] std::shared_ptr<graphics::descriptor_set_layout> create_view_layout() const
+        {
+            return descriptor_registry_->create_descriptor_set_layout({
+                {0, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER, graphics::SHADER_STAGE::VERTEX},
+                {1, 1, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT}
+            });
+        }
+
+        std::unique_ptr<graphics::descriptor_registry> descriptor_registry_;
+    };
+}
+
+TEST_F(descriptor_registry_test, equal_bindings_share_set_layout)
+{
+    auto const first = create_view_layout();
+
+    // The bindings order doesn't matter.
+    auto const second = descriptor_registry_->create_descriptor_set_layout({
+        {1, 1, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT},
+        {0, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER, graphics::SHADER_STAGE::VERTEX}
+    });
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(set_layouts_created, 1u);
+}
+
+TEST_F(descriptor_registry_test, different_bindings_get_distinct_set_layouts)
+{
+    auto const first = create_view_layout();
+
+    auto const second = descriptor_registry_->create_descriptor_set_layout({
+        {0, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER, graphics::SHADER_STAGE::VERTEX | graphics::SHADER_STAGE::FRAGMENT},
+        {1, 1, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT}
+    });
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(set_layouts_created, 2u);
+}
+
+TEST_F(descriptor_registry_test, released_set_layout_is_created_again)
+{
+    auto layout = create_view_layout();
+    layout.reset();
+
+    layout = create_view_layout();
+
+    EXPECT_NE(layout, nullptr);
+    EXPECT_EQ(set_layouts_created, 2u);
+}
+
+TEST_F(descriptor_registry_test, equal_descriptions_share_pipeline_layout)
+{
+    auto const set_layout = create_view_layout();
+
+    auto const push_constant_ranges = std::vector<graphics::push_constant_range>{{graphics::SHADER_STAGE::VERTEX, 0, 64}};
+
+    auto const first = descriptor_registry_->create_pipeline_layout({set_layout}, push_constant_ranges);
+    auto const second = descriptor_registry_->create_pipeline_layout({create_view_layout()}, push_constant_ranges);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(pipeline_layouts_created, 1u);
+
+    auto const third = descriptor_registry_->create_pipeline_layout({set_layout});
+
+    EXPECT_NE(first, third);
+    EXPECT_EQ(pipeline_layouts_created, 2u);
+}
+
+TEST_F(descriptor_registry_test, pipeline_layout_keeps_set_layouts_alive)
+{
+    auto set_layout = create_view_layout();
+
+    auto const pipeline_layout = descriptor_registry_->create_pipeline_layout({set_layout});
+
+    set_layout.reset();
+
+    // The set layout is still cached, as the pipeline layout holds it.
+    EXPECT_EQ(create_view_layout(), pipeline_layout->descriptor_set_layouts().front());
+    EXPECT_EQ(set_layouts_created, 1u);
+}
+
+TEST_F(descriptor_registry_test, equal_set_layouts_share_update_template)
+{
+    auto const set_layout = create_view_layout();
+
+    auto const first = descriptor_registry_->create_descriptor_update_template(set_layout);
+    auto const second = descriptor_registry_->create_descriptor_update_template(create_view_layout());
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(update_templates_created, 1u);
+
+    // A buffer and an image descriptor, each aligned as its info struct.
+    EXPECT_EQ(first->data_size(), sizeof(VkDescriptorBufferInfo) + sizeof(VkDescriptorImageInfo));
+}
@@ -0,0 +1,57 @@
+#include "utility/exceptions.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace test
+{
+    std::unique_ptr<vulkan::instance> device_test::instance_;
+    std::unique_ptr<vulkan::device> device_test::device_;
+
+    render::config device_test::renderer_config_;
+
+    std::unique_ptr<resource::memory_manager> device_test::memory_manager_;
+    std::unique_ptr<resource::resource_manager> device_test::resource_manager_;
+
+    std::string device_test::skip_reason_;
+
+    void device_test::SetUpTestSuite()
+    {
+        try {
+            instance_ = std::make_unique<vulkan::instance>(true);
+            device_ = std::make_unique<vulkan::device>(*instance_, render::platform_surface{});
+        }
+
+        catch (vulkan::exception const &ex) {
+            skip_reason_ = ex.what();
+
+            device_.reset();
+            instance_.reset();
+
+            return;
+        }
+
+        renderer_config_ = render::adjust_renderer_config(device_->device_limits());
+
+        memory_manager_ = std::make_unique<resource::memory_manager>(*device_);
+        resource_manager_ = std::make_unique<resource::resource_manager>(*device_, renderer_config_, *memory_manager_);
+    }
+
+    void device_test::TearDownTestSuite()
+    {
+        if (device_)
+            vkDeviceWaitIdle(device_->handle());
+
+        resource_manager_.reset();
+        memory_manager_.reset();
+
+        device_.reset();
+        instance_.reset();
+    }
+
+    void device_test::SetUp()
+    {
+        if (device_ == nullptr)
+            GTEST_SKIP() << "no Vulkan device: " << skip_reason_;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "vulkan/instance.hxx"
+#include "vulkan/device.hxx"
+
+#include "renderer/config.hxx"
+
+#include "resources/memory_manager.hxx"
+#include "resources/resource_manager.hxx"
+
+
+namespace test
+{
+    // Headless device shared by the tests of a suite. The suites are skipped where there is no Vulkan implementation;
+    // the CI runs them on lavapipe, e.g. with VK_DRIVER_FILES pointing to its ICD.
+    class device_test : public ::testing::Test {
+    protected:
+
+        static void SetUpTestSuite();
+        static void TearDownTestSuite();
+
+        void SetUp() override;
+
+        [[nodiscard]] static vulkan::device &device() noexcept { return *device_; }
+        [[nodiscard]] static render::config const &renderer_config() noexcept { return renderer_config_; }
+
+        [[nodiscard]] static resource::memory_manager &memory_manager() noexcept { return *memory_manager_; }
+        [[nodiscard]] static resource::resource_manager &resource_manager() noexcept { return *resource_manager_; }
+
+    private:
+
+        static std::unique_ptr<vulkan::instance> instance_;
+        static std::unique_ptr<vulkan::device> device_;
+
+        static render::config renderer_config_;
+
+        static std::unique_ptr<resource::memory_manager> memory_manager_;
+        static std::unique_ptr<resource::resource_manager> resource_manager_;
+
+        static std::string skip_reason_;
+    };
+}
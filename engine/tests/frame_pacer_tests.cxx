@@ -0,0 +1,147 @@
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "renderer/frame_pacer.hxx"
+
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    using duration = render::frame_pacer::duration;
+    using time_point = render::frame_pacer::time_point;
+
+    // The pacer takes all the time points as arguments, so the tests drive it by a mock clock starting at the epoch.
+    class frame_pacer_test : public ::testing::Test {
+    protected:
+
+        time_point now_{};
+
+        // Samples the input at the current time and presents the frame after the latency; the next input is sampled after the interval.
+        void run_frame(render::frame_pacer &frame_pacer, duration latency, duration gpu_wait, duration interval, duration delay = 0ms)
+        {
+            frame_pacer.begin_frame(now_, delay);
+            frame_pacer.add_gpu_wait(gpu_wait);
+            frame_pacer.end_frame(now_ + latency);
+
+            now_ += interval;
+        }
+    };
+}
+
+TEST_F(frame_pacer_test, unconfigured_pacer_never_delays)
+{
+    render::frame_pacer frame_pacer;
+
+    EXPECT_EQ(frame_pacer.delay(now_), 0ms);
+
+    for (auto i = 0; i < 8; ++i)
+        run_frame(frame_pacer, 30ms, 10ms, 2ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 0ms);
+}
+
+TEST_F(frame_pacer_test, min_frame_interval_limits_frame_rate)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{10ms, std::nullopt}};
+
+    // Nothing to limit before the first frame.
+    EXPECT_EQ(frame_pacer.delay(now_), 0ms);
+
+    run_frame(frame_pacer, 5ms, 0ms, 3ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 7ms);
+    EXPECT_EQ(frame_pacer.delay(now_ + 7ms), 0ms);
+    EXPECT_EQ(frame_pacer.delay(now_ + 12ms), 0ms);
+}
+
+TEST_F(frame_pacer_test, latency_targeting_is_clamped_by_slack)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{std::nullopt, 5ms}};
+
+    // No samples, no latency to target.
+    EXPECT_EQ(frame_pacer.delay(now_), 0ms);
+
+    // 15 ms over the target, but only 4 ms of the frame is spent waiting for the GPU.
+    for (auto i = 0; i < 4; ++i)
+        run_frame(frame_pacer, 20ms, 4ms, 16ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 4ms - render::frame_pacer::kSLACK_MARGIN);
+}
+
+TEST_F(frame_pacer_test, latency_targeting_stops_at_target)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{std::nullopt, 5ms}};
+
+    for (auto i = 0; i < 4; ++i)
+        run_frame(frame_pacer, 20ms, 30ms, 16ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 15ms);
+
+    // The delayed frames are as slack as the undelayed ones and have the same undelayed latency.
+    for (auto i = 0; i < 4; ++i)
+        run_frame(frame_pacer, 5ms, 15ms, 16ms, 15ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 15ms);
+}
+
+TEST_F(frame_pacer_test, latency_below_target_is_not_delayed)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{std::nullopt, 25ms}};
+
+    for (auto i = 0; i < 4; ++i)
+        run_frame(frame_pacer, 20ms, 10ms, 16ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 0ms);
+}
+
+TEST_F(frame_pacer_test, frame_rate_limit_wins_over_latency_delay)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{10ms, 5ms}};
+
+    for (auto i = 0; i < 4; ++i)
+        run_frame(frame_pacer, 8ms, 2ms, 1ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 9ms);
+}
+
+TEST_F(frame_pacer_test, old_samples_leave_window)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{std::nullopt, 5ms}};
+
+    // A frame without any slack keeps the delay at zero while it is in the window.
+    run_frame(frame_pacer, 40ms, 0ms, 16ms);
+
+    for (std::size_t i = 1; i < render::frame_pacer::kWINDOW_SIZE; ++i)
+        run_frame(frame_pacer, 20ms, 30ms, 16ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 0ms);
+
+    run_frame(frame_pacer, 20ms, 30ms, 16ms);
+
+    EXPECT_EQ(frame_pacer.delay(now_), 15ms);
+
+    auto const statistics = frame_pacer.statistics();
+
+    EXPECT_EQ(statistics.frames_number, render::frame_pacer::kWINDOW_SIZE + 1);
+    EXPECT_DOUBLE_EQ(statistics.max_latency, static_cast<double>(duration{20ms}.count()));
+    EXPECT_DOUBLE_EQ(statistics.frame_interval, static_cast<double>(duration{16ms}.count()));
+}
+
+TEST_F(frame_pacer_test, discarded_frames_are_not_sampled)
+{
+    render::frame_pacer frame_pacer{render::frame_pacing_config{std::nullopt, 5ms}};
+
+    run_frame(frame_pacer, 20ms, 30ms, 16ms);
+
+    frame_pacer.begin_frame(now_, 0ms);
+    frame_pacer.add_gpu_wait(0ms);
+    frame_pacer.discard_frame();
+
+    // Late calls of a discarded frame are ignored.
+    frame_pacer.end_frame(now_ + 100ms);
+
+    EXPECT_EQ(frame_pacer.statistics().frames_number, 1u);
+    EXPECT_EQ(frame_pacer.delay(now_), 15ms);
+}
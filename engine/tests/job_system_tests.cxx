@@ -0,0 +1,215 @@
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+#include "utility/job_system.hxx"
+
+
+// The stress tests are meant to be run under ThreadSanitizer as well, e.g. built with USE_TSAN, so they race
+// the submissions, the steals and the workers going to sleep on purpose.
+namespace
+{
+    std::uint32_t constexpr kWORKERS_NUMBER{4};
+
+    // Every job but the leaves submits two more to the same counter, so the jobs are pushed and stolen concurrently.
+    void submit_tree(jobs::job_system &job_system, jobs::counter &counter, std::atomic_size_t &leaves_number, std::uint32_t depth)
+    {
+        if (depth == 0) {
+            leaves_number.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        for (auto i = 0; i < 2; ++i)
+            job_system.submit([&job_system, &counter, &leaves_number, depth] { submit_tree(job_system, counter, leaves_number, depth - 1); }, &counter);
+    }
+}
+
+TEST(job_system, counter_waits_for_all_jobs)
+{
+    jobs::job_system job_system{kWORKERS_NUMBER};
+
+    for (auto iteration = 0; iteration < 64; ++iteration) {
+        jobs::counter counter;
+
+        std::vector<std::uint32_t> values(4096, 0);
+
+        for (auto &&value : values)
+            job_system.submit([&value] { ++value; }, &counter);
+
+        job_system.wait(counter);
+
+        ASSERT_TRUE(counter.done());
+
+        // The jobs' writes are visible after the wait.
+        ASSERT_EQ(std::accumulate(std::cbegin(values), std::cend(values), std::size_t{0}), std::size(values));
+    }
+}
+
+TEST(job_system, nested_submissions_complete)
+{
+    jobs::job_system job_system{kWORKERS_NUMBER};
+
+    std::uint32_t constexpr kDEPTH{12};
+
+    for (auto iteration = 0; iteration < 16; ++iteration) {
+        jobs::counter counter;
+        std::atomic_size_t leaves_number{0};
+
+        submit_tree(job_system, counter, leaves_number, kDEPTH);
+
+        job_system.wait(counter);
+
+        ASSERT_EQ(leaves_number.load(), std::size_t{1} << kDEPTH);
+    }
+}
+
+TEST(job_system, parallel_for_covers_range_once)
+{
+    for (auto workers_number : {0u, 1u, kWORKERS_NUMBER}) {
+        jobs::job_system job_system{workers_number};
+
+        for (auto grain_size : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{256}, std::size_t{1} << 20}) {
+            std::vector<std::atomic_uint32_t> visits(10'000);
+
+            job_system.parallel_for(0, std::size(visits), grain_size, [&visits] (std::size_t begin, std::size_t end)
+            {
+                for (auto index = begin; index < end; ++index)
+                    visits[index].fetch_add(1, std::memory_order_relaxed);
+            });
+
+            for (auto &&visit : visits)
+                ASSERT_EQ(visit.load(std::memory_order_relaxed), 1u);
+        }
+    }
+}
+
+TEST(job_system, concurrent_submitters)
+{
+    jobs::job_system job_system{kWORKERS_NUMBER};
+
+    std::size_t constexpr kJOBS_NUMBER{2048};
+
+    std::atomic_size_t executed_jobs_number{0};
+
+    // Threads outside the system submit to the main thread's queue, racing the workers stealing from it.
+    std::vector<std::jthread> submitters;
+
+    for (auto i = 0; i < 4; ++i) {
+        submitters.emplace_back([&job_system, &executed_jobs_number]
+        {
+            jobs::counter counter;
+
+            for (std::size_t j = 0; j < kJOBS_NUMBER; ++j)
+                job_system.submit([&executed_jobs_number] { executed_jobs_number.fetch_add(1, std::memory_order_relaxed); }, &counter);
+
+            job_system.wait(counter);
+        });
+    }
+
+    submitters.clear();
+
+    EXPECT_EQ(executed_jobs_number.load(), 4 * kJOBS_NUMBER);
+}
+
+TEST(job_system, first_exception_is_rethrown_by_wait)
+{
+    jobs::job_system job_system{kWORKERS_NUMBER};
+
+    jobs::counter counter;
+
+    std::atomic_size_t executed_jobs_number{0};
+
+    for (auto i = 0; i < 256; ++i) {
+        job_system.submit([&executed_jobs_number, i]
+        {
+            executed_jobs_number.fetch_add(1, std::memory_order_relaxed);
+
+            if (i % 16 == 0)
+                throw std::runtime_error("job failure");
+        }, &counter);
+    }
+
+    EXPECT_THROW(job_system.wait(counter), std::runtime_error);
+
+    // The other jobs still run, and the exception is rethrown once.
+    EXPECT_EQ(executed_jobs_number.load(), 256u);
+    EXPECT_NO_THROW(job_system.wait(counter));
+}
+
+TEST(job_system, exception_without_counter_is_dropped)
+{
+    jobs::job_system job_system{kWORKERS_NUMBER};
+
+    auto const dropped_exceptions_number = jobs::dropped_exceptions_number();
+
+    for (auto i = 0; i < 8; ++i)
+        job_system.submit([] { throw std::runtime_error("job without a counter failure"); });
+
+    // The workers keep running; the jobs submitted next are executed in turn.
+    jobs::counter counter;
+    std::atomic_size_t executed_jobs_number{0};
+
+    for (auto i = 0; i < 64; ++i)
+        job_system.submit([&executed_jobs_number] { executed_jobs_number.fetch_add(1, std::memory_order_relaxed); }, &counter);
+
+    job_system.wait(counter);
+
+    EXPECT_EQ(executed_jobs_number.load(), 64u);
+
+    while (jobs::dropped_exceptions_number() < dropped_exceptions_number + 8)
+        std::this_thread::yield();
+}
+
+TEST(job_system, main_thread_jobs_stay_on_main_thread)
+{
+    jobs::job_system job_system{kWORKERS_NUMBER};
+
+    auto const main_thread_id = std::this_thread::get_id();
+
+    jobs::counter counter;
+    std::atomic_size_t other_threads_jobs_number{0};
+
+    // Workers' jobs hand the work over to the main thread.
+    for (auto i = 0; i < 64; ++i) {
+        job_system.submit([&job_system, &counter, &other_threads_jobs_number, main_thread_id]
+        {
+            job_system.submit_to_main_thread([&other_threads_jobs_number, main_thread_id]
+            {
+                if (std::this_thread::get_id() != main_thread_id)
+                    other_threads_jobs_number.fetch_add(1, std::memory_order_relaxed);
+            }, &counter);
+        }, &counter);
+    }
+
+    job_system.wait(counter);
+
+    EXPECT_EQ(other_threads_jobs_number.load(), 0u);
+
+    std::thread other_thread{[&job_system]
+    {
+        EXPECT_THROW(job_system.execute_main_thread_jobs(), jobs::exception);
+    }};
+
+    other_thread.join();
+}
+
+TEST(job_system, destruction_drains_queues)
+{
+    std::atomic_size_t executed_jobs_number{0};
+
+    for (auto iteration = 0; iteration < 64; ++iteration) {
+        jobs::job_system job_system{kWORKERS_NUMBER};
+
+        for (auto i = 0; i < 64; ++i)
+            job_system.submit([&executed_jobs_number] { executed_jobs_number.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    EXPECT_EQ(executed_jobs_number.load(), 64u * 64u);
+}
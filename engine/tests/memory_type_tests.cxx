@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <volk.h>
+
+#include "graphics/graphics.hxx"
+#include "resources/memory_type.hxx"
+
+
+namespace
+{
+    [[nodiscard]] VkPhysicalDeviceMemoryProperties memory_properties(std::vector<VkMemoryPropertyFlags> const &types)
+    {
+        VkPhysicalDeviceMemoryProperties properties{};
+
+        properties.memoryHeapCount = 1;
+        properties.memoryTypeCount = static_cast<std::uint32_t>(std::size(types));
+
+        for (std::uint32_t index = 0; auto flags : types)
+            properties.memoryTypes[index++] = VkMemoryType{flags, 0};
+
+        return properties;
+    }
+
+    auto constexpr kDEVICE_LOCAL = VkMemoryPropertyFlags{VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
+    auto constexpr kLAZILY_ALLOCATED = VkMemoryPropertyFlags{VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT};
+    auto constexpr kHOST_VISIBLE = VkMemoryPropertyFlags{VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+
+    auto constexpr kTRANSIENT = graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL | graphics::MEMORY_PROPERTY_TYPE::LAZILY_ALLOCATED;
+
+    // A tile based GPU exposing a lazily allocated type ahead of the plain device local one, and a desktop GPU without any.
+    auto const kTILER = memory_properties({kLAZILY_ALLOCATED, kDEVICE_LOCAL, kHOST_VISIBLE});
+    auto const kDESKTOP = memory_properties({kDEVICE_LOCAL, kHOST_VISIBLE});
+}
+
+TEST(memory_type, lazily_allocated_type_is_chosen_when_present)
+{
+    auto const memory_type = resource::select_memory_type(kTILER, ~0u, kTRANSIENT);
+
+    ASSERT_TRUE(memory_type.has_value());
+
+    EXPECT_EQ(memory_type->index, 0u);
+    EXPECT_EQ(memory_type->properties, kTRANSIENT);
+}
+
+TEST(memory_type, lazy_allocation_falls_back_to_device_local)
+{
+    auto const memory_type = resource::select_memory_type(kDESKTOP, ~0u, kTRANSIENT);
+
+    ASSERT_TRUE(memory_type.has_value());
+
+    EXPECT_EQ(memory_type->index, 0u);
+    EXPECT_EQ(memory_type->properties, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL);
+}
+
+TEST(memory_type, lazy_allocation_falls_back_when_filtered_out)
+{
+    // The image's requirements don't allow the lazily allocated type.
+    auto const memory_type = resource::select_memory_type(kTILER, 0b110u, kTRANSIENT);
+
+    ASSERT_TRUE(memory_type.has_value());
+
+    EXPECT_EQ(memory_type->index, 1u);
+    EXPECT_EQ(memory_type->properties, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL);
+}
+
+TEST(memory_type, plain_requests_never_land_on_lazily_allocated_type)
+{
+    auto const memory_type = resource::select_memory_type(kTILER, ~0u, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL);
+
+    ASSERT_TRUE(memory_type.has_value());
+
+    EXPECT_EQ(memory_type->index, 1u);
+
+    EXPECT_EQ(resource::find_memory_type_index(kTILER, 0b001u, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL), std::nullopt);
+    EXPECT_EQ(resource::select_memory_type(kTILER, 0b001u, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL), std::nullopt);
+}
+
+TEST(memory_type, all_required_properties_are_matched)
+{
+    auto const host_visible = graphics::MEMORY_PROPERTY_TYPE::HOST_VISIBLE | graphics::MEMORY_PROPERTY_TYPE::HOST_COHERENT;
+
+    EXPECT_EQ(resource::find_memory_type_index(kTILER, ~0u, host_visible), 2u);
+    EXPECT_EQ(resource::find_memory_type_index(kTILER, ~0u, host_visible | graphics::MEMORY_PROPERTY_TYPE::HOST_CACHED), std::nullopt);
+}
+
+TEST(memory_type, types_beyond_reported_count_are_ignored)
+{
+    auto properties = kDESKTOP;
+    properties.memoryTypes[2] = VkMemoryType{kLAZILY_ALLOCATED, 0};
+
+    auto const memory_type = resource::select_memory_type(properties, ~0u, kTRANSIENT);
+
+    ASSERT_TRUE(memory_type.has_value());
+
+    EXPECT_EQ(memory_type->index, 0u);
+}
@@ -0,0 +1,449 @@
+#include <map>
+#include <span>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "graphics/graphics.hxx"
+#include "graphics/vertex.hxx"
+
+#include "primitives/primitives.hxx"
+
+#include "reference_primitives/reference_primitives.hxx"
+
+
+namespace
+{
+    std::size_t constexpr kVERTEX_LAYOUTS_NUMBER{26};
+
+    // The synthetic scene's attribute formats and some more: the byte-sized normals, the colors without alpha, the layout without
+    // normals and the one with integer normals and a texture coordinate set the generators leave intact.
+    [[nodiscard]] std::vector<graphics::vertex_layout> vertex_layouts()
+    {
+        std::vector<graphics::vertex_layout> layouts;
+
+        for (auto normal_format : {graphics::FORMAT::RGB32_SFLOAT, graphics::FORMAT::RG16_SNORM, graphics::FORMAT::RG8_SNORM}) {
+            for (auto tex_coord_format : {graphics::FORMAT::RG16_UNORM, graphics::FORMAT::RG32_SFLOAT}) {
+                for (auto color_format : {graphics::FORMAT::RGBA8_UNORM, graphics::FORMAT::RGBA32_SFLOAT, graphics::FORMAT::RGB8_UNORM, graphics::FORMAT::RGB32_SFLOAT}) {
+                    layouts.push_back(vertex::create_vertex_layout(
+                        vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT,
+                        vertex::SEMANTIC::NORMAL, normal_format,
+                        vertex::SEMANTIC::TEXCOORD_0, tex_coord_format,
+                        vertex::SEMANTIC::COLOR_0, color_format
+                    ));
+                }
+            }
+        }
+
+        layouts.push_back(vertex::create_vertex_layout(
+            vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT,
+            vertex::SEMANTIC::TEXCOORD_0, graphics::FORMAT::RG16_UNORM,
+            vertex::SEMANTIC::COLOR_0, graphics::FORMAT::RGBA8_UNORM
+        ));
+
+        layouts.push_back(vertex::create_vertex_layout(
+            vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT,
+            vertex::SEMANTIC::NORMAL, graphics::FORMAT::RGB32_SINT,
+            vertex::SEMANTIC::TEXCOORD_1, graphics::FORMAT::RG32_SFLOAT,
+            vertex::SEMANTIC::COLOR_0, graphics::FORMAT::RGBA8_UNORM
+        ));
+
+        return layouts;
+    }
+
+    struct primitive_variant final {
+        graphics::PRIMITIVE_TOPOLOGY topology;
+        graphics::INDEX_TYPE index_type;
+    };
+
+    // The box, the sphere and the icosahedron are generated as triangle lists only, and the icosahedron isn't indexed.
+    std::array<primitive_variant, 12> constexpr kPLANE_VARIANTS{{
+        {graphics::PRIMITIVE_TOPOLOGY::POINTS, graphics::INDEX_TYPE::UNDEFINED},
+        {graphics::PRIMITIVE_TOPOLOGY::POINTS, graphics::INDEX_TYPE::UINT_16},
+        {graphics::PRIMITIVE_TOPOLOGY::POINTS, graphics::INDEX_TYPE::UINT_32},
+        {graphics::PRIMITIVE_TOPOLOGY::LINES, graphics::INDEX_TYPE::UNDEFINED},
+        {graphics::PRIMITIVE_TOPOLOGY::LINES, graphics::INDEX_TYPE::UINT_16},
+        {graphics::PRIMITIVE_TOPOLOGY::LINES, graphics::INDEX_TYPE::UINT_32},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, graphics::INDEX_TYPE::UNDEFINED},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, graphics::INDEX_TYPE::UINT_16},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, graphics::INDEX_TYPE::UINT_32},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP, graphics::INDEX_TYPE::UNDEFINED},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP, graphics::INDEX_TYPE::UINT_16},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLE_STRIP, graphics::INDEX_TYPE::UINT_32}
+    }};
+
+    std::array<primitive_variant, 2> constexpr kINDEXED_TRIANGLES_VARIANTS{{
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, graphics::INDEX_TYPE::UINT_16},
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, graphics::INDEX_TYPE::UINT_32}
+    }};
+
+    std::array<primitive_variant, 1> constexpr kTRIANGLES_VARIANTS{{
+        {graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, graphics::INDEX_TYPE::UNDEFINED}
+    }};
+
+    glm::vec4 const kCOLOR{.3f, .61f, .97f, .5f};
+
+    struct primitive_output final {
+        std::vector<std::byte> vertex_buffer, index_buffer;
+    };
+
+    // Generates the primitive for every layout by the engine's generators and by the reference ones, and compares the outputs
+    // byte for byte. The layouts the reference generators reject are checked to be accepted by the engine's ones.
+    template<class F>
+    void expect_reference_outputs(std::string_view primitive_name, std::span<primitive_variant const> variants, F &&generate)
+    {
+        auto const layouts = vertex_layouts();
+
+        ASSERT_EQ(std::size(layouts), kVERTEX_LAYOUTS_NUMBER);
+
+        for (auto &&variant : variants) {
+            for (std::size_t layout_index = 0; layout_index < kVERTEX_LAYOUTS_NUMBER; ++layout_index) {
+                auto &&layout = layouts[layout_index];
+
+                SCOPED_TRACE(fmt::format("{} as {}, index type {}, layout {}: {}", primitive_name, graphics::to_string(variant.topology),
+                                         static_cast<int>(variant.index_type), layout_index, graphics::to_string(layout)));
+
+                primitive_output output;
+
+                ASSERT_NO_THROW(generate(false, layout, variant, output));
+
+                primitive_output reference_output;
+
+                try {
+                    generate(true, layout, variant, reference_output);
+                }
+
+                catch (resource::exception const &) {
+                    continue;
+                }
+
+                ASSERT_EQ(std::size(output.vertex_buffer), std::size(reference_output.vertex_buffer));
+                ASSERT_EQ(std::size(output.index_buffer), std::size(reference_output.index_buffer));
+
+                auto const it_vertex = std::ranges::mismatch(output.vertex_buffer, reference_output.vertex_buffer).in1;
+
+                EXPECT_TRUE(it_vertex == std::end(output.vertex_buffer))
+                    << "the vertex " << std::distance(std::begin(output.vertex_buffer), it_vertex) / static_cast<std::ptrdiff_t>(layout.size_bytes)
+                    << " differs from the reference one";
+
+                EXPECT_EQ(output.index_buffer, reference_output.index_buffer) << "the indices differ from the reference ones";
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t index_size_bytes(graphics::INDEX_TYPE index_type)
+    {
+        return index_type == graphics::INDEX_TYPE::UNDEFINED ? 0 : graphics::size_bytes(index_type);
+    }
+
+    // The position and the normal are the first attributes, so they are at the vertex's beginning in this order.
+    graphics::vertex_layout const kICOSPHERE_LAYOUT = vertex::create_vertex_layout(
+        vertex::SEMANTIC::POSITION, graphics::FORMAT::RGB32_SFLOAT,
+        vertex::SEMANTIC::NORMAL, graphics::FORMAT::RGB32_SFLOAT,
+        vertex::SEMANTIC::TEXCOORD_0, graphics::FORMAT::RG32_SFLOAT
+    );
+
+    struct icosphere final {
+        std::vector<std::byte> vertex_buffer;
+        std::vector<std::uint32_t> indices;
+
+        [[nodiscard]] std::size_t vertices_number() const { return std::size(vertex_buffer) / kICOSPHERE_LAYOUT.size_bytes; }
+
+        [[nodiscard]] glm::vec3 vector(std::size_t vertex_index, std::size_t offset) const
+        {
+            glm::vec3 value;
+            std::memcpy(&value, std::data(vertex_buffer) + vertex_index * kICOSPHERE_LAYOUT.size_bytes + offset, sizeof(value));
+
+            return value;
+        }
+
+        [[nodiscard]] glm::vec3 position(std::size_t vertex_index) const { return vector(vertex_index, 0); }
+        [[nodiscard]] glm::vec3 normal(std::size_t vertex_index) const { return vector(vertex_index, sizeof(glm::vec3)); }
+    };
+
+    [[nodiscard]] icosphere generate_icosphere(std::uint32_t subdivisions, graphics::INDEX_TYPE index_type, float radius = 1.f)
+    {
+        primitives::icosphere_create_info const create_info{
+            kICOSPHERE_LAYOUT, graphics::PRIMITIVE_TOPOLOGY::TRIANGLES, index_type,
+            radius, subdivisions,
+            kCOLOR
+        };
+
+        icosphere mesh;
+
+        mesh.vertex_buffer.resize(primitives::calculate_icosphere_vertices_count(create_info) * kICOSPHERE_LAYOUT.size_bytes);
+
+        std::vector<std::byte> index_buffer(primitives::calculate_icosphere_indices_count(create_info) * index_size_bytes(index_type));
+
+        if (index_type == graphics::INDEX_TYPE::UNDEFINED) {
+            primitives::generate_icosphere(create_info, mesh.vertex_buffer);
+            return mesh;
+        }
+
+        primitives::generate_icosphere_indexed(create_info, mesh.vertex_buffer, index_buffer);
+
+        for (std::size_t offset = 0; offset < std::size(index_buffer); offset += index_size_bytes(index_type)) {
+            if (index_type == graphics::INDEX_TYPE::UINT_16) {
+                std::uint16_t index;
+                std::memcpy(&index, std::data(index_buffer) + offset, sizeof(index));
+
+                mesh.indices.push_back(index);
+            }
+
+            else {
+                std::uint32_t index;
+                std::memcpy(&index, std::data(index_buffer) + offset, sizeof(index));
+
+                mesh.indices.push_back(index);
+            }
+        }
+
+        return mesh;
+    }
+
+    std::uint32_t constexpr kMAX_TESTED_SUBDIVISIONS{5};
+}
+
+TEST(primitives, plane_matches_reference_output)
+{
+    expect_reference_outputs("plane", kPLANE_VARIANTS, [] (bool reference, graphics::vertex_layout const &layout, primitive_variant variant,
+                                                           primitive_output &output)
+    {
+        // More vertices than a batch holds, and a grid that isn't square.
+        primitives::plane_create_info const create_info{
+            layout, variant.topology, variant.index_type,
+            2.5f, 1.25f, 17, 4
+        };
+
+        if (reference) {
+            output.vertex_buffer.resize(reference_primitives::calculate_plane_vertices_count(create_info) * layout.size_bytes);
+            output.index_buffer.resize(reference_primitives::calculate_plane_indices_count(create_info) * index_size_bytes(variant.index_type));
+
+            if (variant.index_type == graphics::INDEX_TYPE::UNDEFINED)
+                reference_primitives::generate_plane(create_info, output.vertex_buffer, kCOLOR);
+
+            else reference_primitives::generate_plane_indexed(create_info, output.vertex_buffer, output.index_buffer, kCOLOR);
+        }
+
+        else {
+            output.vertex_buffer.resize(primitives::calculate_plane_vertices_count(create_info) * layout.size_bytes);
+            output.index_buffer.resize(primitives::calculate_plane_indices_count(create_info) * index_size_bytes(variant.index_type));
+
+            if (variant.index_type == graphics::INDEX_TYPE::UNDEFINED)
+                primitives::generate_plane(create_info, output.vertex_buffer, kCOLOR);
+
+            else primitives::generate_plane_indexed(create_info, output.vertex_buffer, output.index_buffer, kCOLOR);
+        }
+    });
+}
+
+TEST(primitives, box_matches_reference_output)
+{
+    expect_reference_outputs("box", kINDEXED_TRIANGLES_VARIANTS, [] (bool reference, graphics::vertex_layout const &layout, primitive_variant variant,
+                                                                     primitive_output &output)
+    {
+        primitives::box_create_info const create_info{
+            layout, variant.topology, variant.index_type,
+            1.5f, .7f, 2.3f, 3, 5, 4,
+            {glm::vec4{1, 0, 0, 1}, glm::vec4{0, 1, 0, .5f}, glm::vec4{0, 0, 1, 1}, glm::vec4{.2f, .3f, .4f, 1}, glm::vec4{.9f, .1f, .5f, 1}, kCOLOR}
+        };
+
+        if (reference) {
+            output.vertex_buffer.resize(reference_primitives::calculate_box_vertices_count(create_info) * layout.size_bytes);
+            output.index_buffer.resize(reference_primitives::calculate_box_indices_number(create_info) * index_size_bytes(variant.index_type));
+
+            reference_primitives::generate_box_indexed(create_info, output.vertex_buffer, output.index_buffer);
+        }
+
+        else {
+            output.vertex_buffer.resize(primitives::calculate_box_vertices_count(create_info) * layout.size_bytes);
+            output.index_buffer.resize(primitives::calculate_box_indices_number(create_info) * index_size_bytes(variant.index_type));
+
+            primitives::generate_box_indexed(create_info, output.vertex_buffer, output.index_buffer);
+        }
+    });
+}
+
+TEST(primitives, sphere_matches_reference_output)
+{
+    expect_reference_outputs("sphere", kINDEXED_TRIANGLES_VARIANTS, [] (bool reference, graphics::vertex_layout const &layout, primitive_variant variant,
+                                                                        primitive_output &output)
+    {
+        primitives::sphere_create_info const create_info{
+            layout, variant.topology, variant.index_type,
+            .64f, 13, 9,
+            kCOLOR
+        };
+
+        if (reference) {
+            output.vertex_buffer.resize(reference_primitives::calculate_sphere_vertices_count(create_info) * layout.size_bytes);
+            output.index_buffer.resize(reference_primitives::calculate_sphere_indices_count(create_info) * index_size_bytes(variant.index_type));
+
+            reference_primitives::generate_sphere_indexed(create_info, output.vertex_buffer, output.index_buffer);
+        }
+
+        else {
+            output.vertex_buffer.resize(primitives::calculate_sphere_vertices_count(create_info) * layout.size_bytes);
+            output.index_buffer.resize(primitives::calculate_sphere_indices_count(create_info) * index_size_bytes(variant.index_type));
+
+            primitives::generate_sphere_indexed(create_info, output.vertex_buffer, output.index_buffer);
+        }
+    });
+}
+
+TEST(primitives, icosahedron_matches_reference_output)
+{
+    expect_reference_outputs("icosahedron", kTRIANGLES_VARIANTS, [] (bool reference, graphics::vertex_layout const &layout, primitive_variant variant,
+                                                                     primitive_output &output)
+    {
+        primitives::icosahedron_create_info const create_info{
+            layout, variant.topology,
+            kCOLOR,
+            1.3f, 4
+        };
+
+        if (reference) {
+            output.vertex_buffer.resize(reference_primitives::calculate_icosahedron_vertices_count(create_info) * layout.size_bytes);
+
+            reference_primitives::generate_icosahedron(create_info, output.vertex_buffer);
+        }
+
+        else {
+            output.vertex_buffer.resize(primitives::calculate_icosahedron_vertices_count(create_info) * layout.size_bytes);
+
+            primitives::generate_icosahedron(create_info, output.vertex_buffer);
+        }
+    });
+}
+
+TEST(primitives, icosphere_has_shared_vertices)
+{
+    for (auto subdivisions = 0u; subdivisions <= kMAX_TESTED_SUBDIVISIONS; ++subdivisions) {
+        SCOPED_TRACE(fmt::format("{} subdivisions", subdivisions));
+
+        auto const mesh = generate_icosphere(subdivisions, graphics::INDEX_TYPE::UINT_32);
+
+        auto const factor = std::size_t{1} << (subdivisions * 2);
+
+        EXPECT_EQ(mesh.vertices_number(), 10 * factor + 2);
+        ASSERT_EQ(std::size(mesh.indices), 20 * factor * 3);
+
+        // Every vertex is referenced.
+        std::vector<bool> referenced(mesh.vertices_number(), false);
+
+        for (auto index : mesh.indices) {
+            ASSERT_LT(index, mesh.vertices_number());
+            referenced[index] = true;
+        }
+
+        EXPECT_TRUE(std::ranges::all_of(referenced, [] (bool value) { return value; }));
+    }
+}
+
+TEST(primitives, icosphere_is_closed_manifold)
+{
+    for (auto subdivisions = 0u; subdivisions <= kMAX_TESTED_SUBDIVISIONS; ++subdivisions) {
+        SCOPED_TRACE(fmt::format("{} subdivisions", subdivisions));
+
+        auto const mesh = generate_icosphere(subdivisions, graphics::INDEX_TYPE::UINT_32);
+
+        // Every directed edge is used once and its opposite one once as well, so every edge has two triangles
+        // and the adjacent triangles are wound consistently.
+        std::map<std::pair<std::uint32_t, std::uint32_t>, std::size_t> directed_edges;
+
+        for (std::size_t first = 0; first < std::size(mesh.indices); first += 3) {
+            for (std::size_t corner = 0; corner < 3; ++corner)
+                ++directed_edges[{mesh.indices[first + corner], mesh.indices[first + (corner + 1) % 3]}];
+        }
+
+        for (auto &&[edge, count] : directed_edges) {
+            ASSERT_EQ(count, 1u) << "the edge " << edge.first << "-" << edge.second << " is used more than once";
+            ASSERT_TRUE(directed_edges.contains({edge.second, edge.first})) << "the edge " << edge.first << "-" << edge.second << " is a border";
+        }
+
+        // The Euler characteristic of the sphere.
+        auto const vertices_number = static_cast<std::int64_t>(mesh.vertices_number());
+        auto const edges_number = static_cast<std::int64_t>(std::size(directed_edges) / 2);
+        auto const faces_number = static_cast<std::int64_t>(std::size(mesh.indices) / 3);
+
+        EXPECT_EQ(vertices_number - edges_number + faces_number, 2);
+    }
+}
+
+TEST(primitives, icosphere_triangles_face_outward)
+{
+    for (auto subdivisions = 0u; subdivisions <= kMAX_TESTED_SUBDIVISIONS; ++subdivisions) {
+        SCOPED_TRACE(fmt::format("{} subdivisions", subdivisions));
+
+        auto const mesh = generate_icosphere(subdivisions, graphics::INDEX_TYPE::UINT_32);
+
+        // Counter-clockwise, seen from the outside.
+        for (std::size_t first = 0; first < std::size(mesh.indices); first += 3) {
+            auto const a = mesh.position(mesh.indices[first]);
+            auto const b = mesh.position(mesh.indices[first + 1]);
+            auto const c = mesh.position(mesh.indices[first + 2]);
+
+            ASSERT_GT(glm::dot(glm::cross(b - a, c - a), a + b + c), 0.f) << "the triangle " << first / 3 << " faces inward";
+        }
+    }
+}
+
+TEST(primitives, icosphere_vertices_lie_on_sphere)
+{
+    auto constexpr radius = 2.5f;
+
+    for (auto subdivisions = 0u; subdivisions <= kMAX_TESTED_SUBDIVISIONS; ++subdivisions) {
+        SCOPED_TRACE(fmt::format("{} subdivisions", subdivisions));
+
+        auto const mesh = generate_icosphere(subdivisions, graphics::INDEX_TYPE::UINT_32, radius);
+
+        for (std::size_t vertex_index = 0; vertex_index < mesh.vertices_number(); ++vertex_index) {
+            auto const position = mesh.position(vertex_index);
+            auto const normal = mesh.normal(vertex_index);
+
+            ASSERT_NEAR(std::sqrt(glm::dot(position, position)), radius, radius * 1e-6f);
+            ASSERT_NEAR(std::sqrt(glm::dot(normal, normal)), 1.f, 1e-6f);
+
+            // The normal points along the position.
+            ASSERT_NEAR(glm::dot(position, normal), radius, radius * 1e-6f);
+        }
+    }
+}
+
+TEST(primitives, icosphere_non_indexed_matches_indexed)
+{
+    auto const vertex_size = kICOSPHERE_LAYOUT.size_bytes;
+
+    for (auto subdivisions = 0u; subdivisions <= kMAX_TESTED_SUBDIVISIONS; ++subdivisions) {
+        SCOPED_TRACE(fmt::format("{} subdivisions", subdivisions));
+
+        auto const non_indexed = generate_icosphere(subdivisions, graphics::INDEX_TYPE::UNDEFINED);
+
+        for (auto index_type : {graphics::INDEX_TYPE::UINT_16, graphics::INDEX_TYPE::UINT_32}) {
+            auto const indexed = generate_icosphere(subdivisions, index_type);
+
+            ASSERT_EQ(non_indexed.vertices_number(), std::size(indexed.indices));
+
+            // The non-indexed vertices are the indexed ones in the order of the indices.
+            for (std::size_t vertex_index = 0; vertex_index < non_indexed.vertices_number(); ++vertex_index) {
+                auto const non_indexed_vertex = std::data(non_indexed.vertex_buffer) + vertex_index * vertex_size;
+                auto const indexed_vertex = std::data(indexed.vertex_buffer) + indexed.indices[vertex_index] * vertex_size;
+
+                ASSERT_EQ(std::memcmp(non_indexed_vertex, indexed_vertex, vertex_size), 0) << "the vertex " << vertex_index << " differs";
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <span>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "primitives/primitives.hxx"
+
+
+// The per-attribute generators the layout-specialized batch writers have replaced, kept as they were to compare
+// the engine's output with. Both are built by the same toolchain, so the comparison holds whatever math library
+// rounds the trigonometry. The icosahedron accepts the floating point normals only.
+namespace reference_primitives
+{
+    std::uint32_t calculate_plane_vertices_count(primitives::plane_create_info const &create_info);
+
+    std::uint32_t calculate_plane_indices_count(primitives::plane_create_info const &create_info);
+
+    void generate_plane(primitives::plane_create_info const &create_info, std::span<std::byte> vertex_buffer,
+                        glm::vec4 const &color = glm::vec4{1});
+
+    void generate_plane_indexed(primitives::plane_create_info const &create_info, std::span<std::byte> vertex_buffer,
+                                std::span<std::byte> index_buffer, glm::vec4 const &color = glm::vec4{1});
+
+    std::uint32_t calculate_box_vertices_count(primitives::box_create_info const &create_info);
+
+    std::uint32_t calculate_box_indices_number(primitives::box_create_info const &create_info);
+
+    void generate_box(primitives::box_create_info const &create_info, std::span<std::byte> vertex_buffer);
+
+    void generate_box_indexed(primitives::box_create_info const &create_info, std::span<std::byte> vertex_buffer,
+                              std::span<std::byte> index_buffer);
+
+    std::uint32_t calculate_sphere_vertices_count(primitives::sphere_create_info const &create_info);
+
+    std::uint32_t calculate_sphere_indices_count(primitives::sphere_create_info const &create_info);
+
+    void generate_sphere(primitives::sphere_create_info const &create_info, std::span<std::byte> vertex_buffer);
+
+    void generate_sphere_indexed(primitives::sphere_create_info const &create_info, std::span<std::byte> vertex_buffer,
+                                 std::span<std::byte> index_buffer);
+
+    std::uint32_t calculate_icosahedron_vertices_count(primitives::icosahedron_create_info const &create_info);
+
+    void generate_icosahedron(primitives::icosahedron_create_info const &create_info, std::span<std::byte> vertex_buffer);
+}
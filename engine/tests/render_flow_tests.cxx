@@ -0,0 +1,97 @@
+#include <map>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "renderer/render_graph.hxx"
+#include "renderer/render_flow.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace
+{
+    render::extent constexpr kEXTENT{64, 64};
+
+    // The engine's forward graph: the transient color and depth images are created before the imported render target,
+    // so the imported resource isn't the first one.
+    struct forward_graph final {
+        graphics::render_graph graph;
+
+        std::uint32_t color, depth, target;
+
+        forward_graph()
+        {
+            color = graph.create_image("color", {graphics::FORMAT::RGBA8_UNORM, kEXTENT});
+            depth = graph.create_image("depth", {graphics::FORMAT::D32_SFLOAT, kEXTENT});
+
+            target = graph.import_image("render target", {graphics::FORMAT::RGBA8_UNORM, kEXTENT}, graphics::resource_state{},
+                                        graphics::RESOURCE_USAGE::TRANSFER_SOURCE);
+
+            graph.add_pass("forward", {
+                {color, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true},
+                {depth, graphics::RESOURCE_USAGE::DEPTH_STENCIL_ATTACHMENT, true},
+                {target, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}
+            });
+        }
+    };
+
+    class render_flow_test : public test::device_test {
+    protected:
+
+        [[nodiscard]] static std::vector<std::shared_ptr<resource::image>> create_target_images(std::size_t images_number)
+        {
+            std::vector<std::shared_ptr<resource::image>> images;
+
+            for (std::size_t index = 0; index < images_number; ++index) {
+                images.push_back(resource_manager().create_image(
+                    graphics::IMAGE_TYPE::TYPE_2D, graphics::FORMAT::RGBA8_UNORM, kEXTENT, 1, 1, graphics::IMAGE_TILING::OPTIMAL,
+                    graphics::IMAGE_USAGE::COLOR_ATTACHMENT | graphics::IMAGE_USAGE::TRANSFER_SOURCE, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL
+                ));
+            }
+
+            return images;
+        }
+    };
+}
+
+TEST_F(render_flow_test, imported_images_follow_transient_ones)
+{
+    forward_graph forward;
+
+    auto const target_images = create_target_images(2);
+
+    graphics::render_graph_manager render_graph_manager{resource_manager(), memory_manager()};
+
+    std::map<std::uint32_t, std::vector<std::shared_ptr<resource::image>>> const imported_images{{forward.target, target_images}};
+
+    std::unique_ptr<graphics::render_flow> render_flow;
+
+    ASSERT_NO_THROW(render_flow = render_graph_manager.create_render_flow(forward.graph, imported_images));
+    ASSERT_NE(render_flow, nullptr);
+
+    // The imported images are picked by the image index, and the transient ones are shared.
+    EXPECT_EQ(render_flow->image(forward.target, 0), target_images.at(0));
+    EXPECT_EQ(render_flow->image(forward.target, 1), target_images.at(1));
+
+    EXPECT_NE(render_flow->image(forward.color, 0), nullptr);
+    EXPECT_NE(render_flow->image(forward.depth, 0), nullptr);
+}
+
+TEST_F(render_flow_test, missing_imported_images_are_reported)
+{
+    forward_graph forward;
+
+    graphics::render_graph_manager render_graph_manager{resource_manager(), memory_manager()};
+
+    EXPECT_THROW(auto render_flow = render_graph_manager.create_render_flow(forward.graph, {}), graphics::exception);
+
+    // A transient resource can't be given images.
+    std::map<std::uint32_t, std::vector<std::shared_ptr<resource::image>>> const transient_images{{forward.color, create_target_images(1)}};
+
+    EXPECT_THROW(auto render_flow = render_graph_manager.create_render_flow(forward.graph, transient_images), graphics::exception);
+}
@@ -0,0 +1,355 @@
+#include <vector>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "renderer/render_graph.hxx"
+
+
+namespace
+{
+    graphics::graph_image_description constexpr kIMAGE{graphics::FORMAT::RGBA8_UNORM, render::extent{64, 64}};
+
+    template<class T>
+    [[nodiscard]] bool contains(T flags, T bits) noexcept
+    {
+        return (flags & bits) == bits;
+    }
+
+    [[nodiscard]] std::vector<std::uint32_t> pass_indices(graphics::compiled_render_graph const &compiled_graph)
+    {
+        std::vector<std::uint32_t> indices;
+
+        for (auto &&pass : compiled_graph.passes)
+            indices.push_back(pass.pass_index);
+
+        return indices;
+    }
+
+    [[nodiscard]] graphics::image_barrier const *find_barrier(graphics::compiled_pass const &pass, std::uint32_t resource)
+    {
+        auto it = std::ranges::find(pass.barriers, resource, &graphics::image_barrier::resource);
+
+        return it != std::end(pass.barriers) ? &*it : nullptr;
+    }
+
+    // Scene rendering into transient color and depth images, an unused debug pass and a post-processing pass into the swapchain.
+    struct forward_graph final {
+        graphics::render_graph graph;
+
+        std::uint32_t color, depth, debug, swapchain;
+
+        forward_graph()
+        {
+            color = graph.create_image("color", kIMAGE);
+            depth = graph.create_image("depth", kIMAGE);
+            debug = graph.create_image("debug", kIMAGE);
+            swapchain = graph.import_image("swapchain", kIMAGE, graphics::resource_state{}, graphics::RESOURCE_USAGE::PRESENT);
+
+            graph.add_pass("scene", {
+                {color, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true},
+                {depth, graphics::RESOURCE_USAGE::DEPTH_STENCIL_ATTACHMENT, true}
+            });
+
+            graph.add_pass("debug", {
+                {debug, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}
+            });
+
+            graph.add_pass("post", {
+                {color, graphics::RESOURCE_USAGE::SAMPLED},
+                {swapchain, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}
+            });
+        }
+    };
+}
+
+TEST(render_graph, passes_not_contributing_to_imported_images_are_culled)
+{
+    forward_graph forward;
+
+    auto const compiled_graph = forward.graph.compile();
+
+    EXPECT_EQ(pass_indices(compiled_graph), (std::vector<std::uint32_t>{0, 2}));
+
+    // The debug image is never accessed by a compiled pass, so it isn't allocated.
+    EXPECT_FALSE(std::ranges::any_of(compiled_graph.transient_images, [&forward] (auto &&image) { return image.resource == forward.debug; }));
+}
+
+TEST(render_graph, passes_with_side_effects_are_kept)
+{
+    graphics::render_graph graph;
+
+    auto const image = graph.create_image("readback", kIMAGE);
+
+    graph.add_pass("copy", {{image, graphics::RESOURCE_USAGE::TRANSFER_DESTINATION, true}}, true);
+
+    EXPECT_EQ(pass_indices(graph.compile()), (std::vector<std::uint32_t>{0}));
+}
+
+TEST(render_graph, writers_overwritten_before_read_are_culled)
+{
+    graphics::render_graph graph;
+
+    auto const image = graph.create_image("image", kIMAGE);
+    auto const swapchain = graph.import_image("swapchain", kIMAGE, graphics::resource_state{}, graphics::RESOURCE_USAGE::PRESENT);
+
+    graph.add_pass("first", {{image, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+    graph.add_pass("second", {{image, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+    graph.add_pass("blend", {{image, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT}});
+    graph.add_pass("present", {{image, graphics::RESOURCE_USAGE::SAMPLED}, {swapchain, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+
+    // The blending pass depends on the previous contents, so only the first write is dead.
+    EXPECT_EQ(pass_indices(graph.compile()), (std::vector<std::uint32_t>{1, 2, 3}));
+}
+
+TEST(render_graph, imported_image_writers_are_kept_despite_discards)
+{
+    graphics::render_graph graph;
+
+    auto const swapchain = graph.import_image("swapchain", kIMAGE, graphics::resource_state{}, graphics::RESOURCE_USAGE::PRESENT);
+
+    graph.add_pass("first", {{swapchain, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+    graph.add_pass("second", {{swapchain, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+
+    EXPECT_EQ(pass_indices(graph.compile()), (std::vector<std::uint32_t>{0, 1}));
+}
+
+TEST(render_graph, invalid_accesses_are_rejected)
+{
+    graphics::render_graph graph;
+
+    auto const image = graph.create_image("image", kIMAGE);
+
+    EXPECT_THROW(graph.add_pass("unknown", {{image + 1, graphics::RESOURCE_USAGE::SAMPLED}}), graphics::exception);
+
+    EXPECT_THROW(graph.add_pass("twice", {
+        {image, graphics::RESOURCE_USAGE::SAMPLED}, {image, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT}
+    }), graphics::exception);
+
+    EXPECT_THROW(graph.add_pass("present", {{image, graphics::RESOURCE_USAGE::PRESENT}}), graphics::exception);
+}
+
+TEST(render_graph, write_to_read_transitions_layout_and_waits_for_write)
+{
+    forward_graph forward;
+
+    auto const compiled_graph = forward.graph.compile();
+
+    ASSERT_EQ(std::size(compiled_graph.passes), 2u);
+
+    auto const *barrier = find_barrier(compiled_graph.passes[1], forward.color);
+    ASSERT_NE(barrier, nullptr);
+
+    EXPECT_EQ(barrier->source.layout, graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT);
+    EXPECT_EQ(barrier->source.stages, graphics::PIPELINE_STAGE::COLOR_ATTACHMENT_OUTPUT);
+    EXPECT_EQ(barrier->source.access, graphics::MEMORY_ACCESS_TYPE::COLOR_ATTACHMENT_WRITE);
+
+    EXPECT_EQ(barrier->destination.layout, graphics::IMAGE_LAYOUT::SHADER_READ_ONLY);
+    EXPECT_TRUE(contains(barrier->destination.stages, graphics::PIPELINE_STAGE::FRAGMENT_SHADER));
+    EXPECT_EQ(barrier->destination.access, graphics::MEMORY_ACCESS_TYPE::SHADER_READ);
+}
+
+TEST(render_graph, discarded_contents_transition_from_undefined_layout)
+{
+    forward_graph forward;
+
+    auto const compiled_graph = forward.graph.compile();
+
+    for (auto resource : {forward.color, forward.depth}) {
+        auto const *barrier = find_barrier(compiled_graph.passes[0], resource);
+        ASSERT_NE(barrier, nullptr);
+
+        EXPECT_EQ(barrier->source.layout, graphics::IMAGE_LAYOUT::UNDEFINED);
+    }
+
+    auto const *barrier = find_barrier(compiled_graph.passes[1], forward.swapchain);
+    ASSERT_NE(barrier, nullptr);
+
+    EXPECT_EQ(barrier->source.layout, graphics::IMAGE_LAYOUT::UNDEFINED);
+    EXPECT_EQ(barrier->destination.layout, graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT);
+}
+
+TEST(render_graph, repeated_reads_in_same_layout_need_no_barrier)
+{
+    graphics::render_graph graph;
+
+    auto const image = graph.create_image("image", kIMAGE);
+    auto const swapchain = graph.import_image("swapchain", kIMAGE, graphics::resource_state{}, graphics::RESOURCE_USAGE::PRESENT);
+
+    graph.add_pass("write", {{image, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+    graph.add_pass("first read", {{image, graphics::RESOURCE_USAGE::SAMPLED}}, true);
+    graph.add_pass("second read", {{image, graphics::RESOURCE_USAGE::SAMPLED}, {swapchain, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+
+    auto const compiled_graph = graph.compile();
+
+    ASSERT_EQ(std::size(compiled_graph.passes), 3u);
+
+    EXPECT_NE(find_barrier(compiled_graph.passes[1], image), nullptr);
+    EXPECT_EQ(find_barrier(compiled_graph.passes[2], image), nullptr);
+}
+
+TEST(render_graph, imported_images_transition_to_final_usage)
+{
+    forward_graph forward;
+
+    auto const compiled_graph = forward.graph.compile();
+
+    ASSERT_EQ(std::size(compiled_graph.final_barriers), 1u);
+
+    auto &&barrier = compiled_graph.final_barriers.front();
+
+    EXPECT_EQ(barrier.resource, forward.swapchain);
+    EXPECT_EQ(barrier.source.layout, graphics::IMAGE_LAYOUT::COLOR_ATTACHMENT);
+    EXPECT_EQ(barrier.source.stages, graphics::PIPELINE_STAGE::COLOR_ATTACHMENT_OUTPUT);
+    EXPECT_EQ(barrier.destination.layout, graphics::IMAGE_LAYOUT::PRESENT_SOURCE);
+}
+
+TEST(render_graph, transient_lifetimes_and_usages)
+{
+    forward_graph forward;
+
+    auto const compiled_graph = forward.graph.compile();
+
+    ASSERT_EQ(std::size(compiled_graph.transient_images), 2u);
+
+    auto &&color = compiled_graph.transient_images[0];
+    auto &&depth = compiled_graph.transient_images[1];
+
+    EXPECT_EQ(color.resource, forward.color);
+    EXPECT_EQ(color.first_pass, 0u);
+    EXPECT_EQ(color.last_pass, 1u);
+    EXPECT_EQ(color.usage, graphics::IMAGE_USAGE::COLOR_ATTACHMENT | graphics::IMAGE_USAGE::SAMPLED);
+
+    // Attachment only images may be lazily allocated.
+    EXPECT_EQ(depth.resource, forward.depth);
+    EXPECT_EQ(depth.first_pass, 0u);
+    EXPECT_EQ(depth.last_pass, 0u);
+    EXPECT_EQ(depth.usage, graphics::IMAGE_USAGE::DEPTH_STENCIL_ATTACHMENT | graphics::IMAGE_USAGE::TRANSIENT_ATTACHMENT);
+
+    // The first use of the memory waits for the previous frame's last one.
+    auto &&first_barrier = compiled_graph.passes[color.first_pass].barriers[color.first_barrier];
+
+    EXPECT_EQ(first_barrier.resource, forward.color);
+    EXPECT_TRUE(contains(first_barrier.source.stages, graphics::PIPELINE_STAGE::FRAGMENT_SHADER));
+}
+
+namespace
+{
+    // A chain of transient images, each one alive for two adjacent passes; the first one is used by transfers only.
+    struct chain_graph final {
+        graphics::render_graph graph;
+
+        std::uint32_t a, b, c;
+
+        chain_graph()
+        {
+            a = graph.create_image("a", kIMAGE);
+            b = graph.create_image("b", kIMAGE);
+            c = graph.create_image("c", kIMAGE);
+
+            auto const swapchain = graph.import_image("swapchain", kIMAGE, graphics::resource_state{}, graphics::RESOURCE_USAGE::PRESENT);
+
+            graph.add_pass("fill", {{a, graphics::RESOURCE_USAGE::TRANSFER_DESTINATION, true}});
+            graph.add_pass("copy", {{a, graphics::RESOURCE_USAGE::TRANSFER_SOURCE}, {b, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+            graph.add_pass("shade", {{b, graphics::RESOURCE_USAGE::SAMPLED}, {c, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+            graph.add_pass("post", {{c, graphics::RESOURCE_USAGE::SAMPLED}, {swapchain, graphics::RESOURCE_USAGE::COLOR_ATTACHMENT, true}});
+        }
+    };
+}
+
+TEST(render_graph, images_with_disjoint_lifetimes_share_memory)
+{
+    chain_graph chain;
+
+    auto compiled_graph = chain.graph.compile();
+
+    ASSERT_EQ(std::size(compiled_graph.transient_images), 3u);
+
+    auto const layout = graphics::alias_transient_memory(compiled_graph, {{1024, 256, 0b1}, {1024, 256, 0b1}, {1024, 256, 0b1}});
+
+    ASSERT_EQ(std::size(layout.heaps), 1u);
+
+    EXPECT_EQ(layout.unaliased_size, 3072u);
+    EXPECT_EQ(layout.heaps[0].size, 2048u);
+
+    auto &&placements = layout.placements;
+
+    EXPECT_EQ(placements[0].offset, 0u);
+    EXPECT_EQ(placements[1].offset, 1024u);
+    EXPECT_EQ(placements[2].offset, 0u);
+}
+
+TEST(render_graph, images_with_overlapping_lifetimes_never_overlap_in_memory)
+{
+    chain_graph chain;
+
+    auto compiled_graph = chain.graph.compile();
+
+    auto const requirements = std::vector<graphics::transient_memory_requirements>{{1000, 256, 0b1}, {3000, 512, 0b1}, {500, 64, 0b1}};
+
+    auto const layout = graphics::alias_transient_memory(compiled_graph, requirements);
+
+    auto &&images = compiled_graph.transient_images;
+
+    for (std::size_t i = 0; i < std::size(images); ++i) {
+        EXPECT_EQ(layout.placements[i].offset % requirements[i].alignment, 0u);
+        EXPECT_LE(layout.placements[i].offset + requirements[i].size, layout.heaps[layout.placements[i].heap_index].size);
+
+        for (auto j = i + 1; j < std::size(images); ++j) {
+            if (images[i].first_pass > images[j].last_pass || images[j].first_pass > images[i].last_pass)
+                continue;
+
+            auto &&lhs = layout.placements[i];
+            auto &&rhs = layout.placements[j];
+
+            EXPECT_TRUE(lhs.heap_index != rhs.heap_index || lhs.offset + requirements[i].size <= rhs.offset ||
+                        rhs.offset + requirements[j].size <= lhs.offset) << i << " and " << j << " overlap";
+        }
+    }
+}
+
+TEST(render_graph, incompatible_memory_types_get_separate_heaps)
+{
+    chain_graph chain;
+
+    auto compiled_graph = chain.graph.compile();
+
+    auto const layout = graphics::alias_transient_memory(compiled_graph, {{1024, 256, 0b01}, {1024, 256, 0b01}, {1024, 256, 0b10}});
+
+    ASSERT_EQ(std::size(layout.heaps), 2u);
+
+    EXPECT_EQ(layout.placements[0].heap_index, layout.placements[1].heap_index);
+    EXPECT_NE(layout.placements[0].heap_index, layout.placements[2].heap_index);
+
+    EXPECT_EQ(layout.heaps[layout.placements[2].heap_index].memory_type_bits, 0b10u);
+}
+
+TEST(render_graph, aliased_image_waits_for_previous_users_of_memory)
+{
+    chain_graph chain;
+
+    auto compiled_graph = chain.graph.compile();
+
+    static_cast<void>(graphics::alias_transient_memory(compiled_graph, {{1024, 256, 0b1}, {1024, 256, 0b1}, {1024, 256, 0b1}}));
+
+    auto first_barrier = [&compiled_graph] (std::size_t index)
+    {
+        auto &&image = compiled_graph.transient_images[index];
+        return compiled_graph.passes[image.first_pass].barriers[image.first_barrier];
+    };
+
+    // 'c' reuses the memory of 'a', which is last used by transfers, while 'b' has its own memory.
+    EXPECT_TRUE(contains(first_barrier(2).source.stages, graphics::PIPELINE_STAGE::TRANSFER));
+    EXPECT_FALSE(contains(first_barrier(1).source.stages, graphics::PIPELINE_STAGE::TRANSFER));
+}
+
+TEST(render_graph, mismatched_memory_requirements_are_rejected)
+{
+    chain_graph chain;
+
+    auto compiled_graph = chain.graph.compile();
+
+    EXPECT_THROW(static_cast<void>(graphics::alias_transient_memory(compiled_graph, {{1024, 256, 0b1}})), graphics::exception);
+}
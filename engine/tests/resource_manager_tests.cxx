@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "graphics/graphics.hxx"
+
+#include "resources/image.hxx"
+#include "resources/resource_manager.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace
+{
+    std::size_t image_views_created{0};
+    std::size_t samplers_created{0};
+
+    PFN_vkCreateImageView create_image_view{nullptr};
+    PFN_vkCreateSampler create_sampler{nullptr};
+
+    VKAPI_ATTR VkResult VKAPI_CALL counted_create_image_view(VkDevice device, VkImageViewCreateInfo const *create_info,
+                                                             VkAllocationCallbacks const *allocator, VkImageView *image_view)
+    {
+        ++image_views_created;
+
+        return create_image_view(device, create_info, allocator, image_view);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL counted_create_sampler(VkDevice device, VkSamplerCreateInfo const *create_info,
+                                                          VkAllocationCallbacks const *allocator, VkSampler *sampler)
+    {
+        ++samplers_created;
+
+        return create_sampler(device, create_info, allocator, sampler);
+    }
+
+    // The device functions are volk's global pointers, so the calls are counted by swapping them for the test's duration.
+    class resource_manager_test : public test::device_test {
+    protected:
+
+        void SetUp() override
+        {
+            test::device_test::SetUp();
+
+            if (IsSkipped())
+                return;
+
+            image_views_created = 0;
+            samplers_created = 0;
+
+            create_image_view = std::exchange(vkCreateImageView, counted_create_image_view);
+            create_sampler = std::exchange(vkCreateSampler, counted_create_sampler);
+        }
+
+        void TearDown() override
+        {
+            if (create_image_view)
+                vkCreateImageView = std::exchange(create_image_view, nullptr);
+
+            if (create_sampler)
+                vkCreateSampler = std::exchange(create_sampler, nullptr);
+        }
+
+        [[nodiscard]] static std::shared_ptr<resource::image> create_image()
+        {
+            return resource_manager().create_image(
+                graphics::IMAGE_TYPE::TYPE_2D, graphics::FORMAT::RGBA8_UNORM, render::extent{16, 16}, 1, 1, graphics::IMAGE_TILING::OPTIMAL,
+                graphics::IMAGE_USAGE::SAMPLED | graphics::IMAGE_USAGE::TRANSFER_DESTINATION, graphics::MEMORY_PROPERTY_TYPE::DEVICE_LOCAL
+            );
+        }
+    };
+}
+
+TEST_F(resource_manager_test, identical_image_views_share_vulkan_object)
+{
+    auto const image = create_image();
+
+    auto const first = resource_manager().create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+    auto const second = resource_manager().create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(image_views_created, 1u);
+}
+
+TEST_F(resource_manager_test, image_views_of_different_images_are_distinct)
+{
+    auto const first_image = create_image();
+    auto const second_image = create_image();
+
+    auto const first = resource_manager().create_image_view(first_image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+    auto const second = resource_manager().create_image_view(second_image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(image_views_created, 2u);
+}
+
+TEST_F(resource_manager_test, released_image_view_is_created_again)
+{
+    auto const image = create_image();
+
+    auto image_view = resource_manager().create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+    image_view.reset();
+
+    image_view = resource_manager().create_image_view(image, graphics::IMAGE_VIEW_TYPE::TYPE_2D, graphics::IMAGE_ASPECT::COLOR_BIT);
+
+    EXPECT_NE(image_view, nullptr);
+    EXPECT_EQ(image_views_created, 2u);
+}
+
+TEST_F(resource_manager_test, identical_samplers_share_vulkan_object)
+{
+    auto const first = resource_manager().create_image_sampler(graphics::TEXTURE_FILTER::LINEAR, graphics::TEXTURE_FILTER::LINEAR,
+                                                               graphics::TEXTURE_MIPMAP_MODE::LINEAR, 0.f, 4.f);
+
+    auto const second = resource_manager().create_image_sampler(graphics::TEXTURE_FILTER::LINEAR, graphics::TEXTURE_FILTER::LINEAR,
+                                                                graphics::TEXTURE_MIPMAP_MODE::LINEAR, 0.f, 4.f);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(samplers_created, 1u);
+}
+
+TEST_F(resource_manager_test, samplers_differing_in_any_state_are_distinct)
+{
+    auto const linear = resource_manager().create_image_sampler(graphics::TEXTURE_FILTER::LINEAR, graphics::TEXTURE_FILTER::LINEAR,
+                                                                graphics::TEXTURE_MIPMAP_MODE::LINEAR, 0.f, 4.f);
+
+    auto const nearest = resource_manager().create_image_sampler(graphics::TEXTURE_FILTER::NEAREST, graphics::TEXTURE_FILTER::LINEAR,
+                                                                 graphics::TEXTURE_MIPMAP_MODE::LINEAR, 0.f, 4.f);
+
+    auto const clamped = resource_manager().create_image_sampler(graphics::TEXTURE_FILTER::LINEAR, graphics::TEXTURE_FILTER::LINEAR,
+                                                                 graphics::TEXTURE_MIPMAP_MODE::LINEAR, 0.f, 1.f);
+
+    EXPECT_NE(linear, nearest);
+    EXPECT_NE(linear, clamped);
+    EXPECT_EQ(samplers_created, 3u);
+}
@@ -0,0 +1,319 @@
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "graphics/graphics.hxx"
+#include "graphics/descriptors.hxx"
+#include "graphics/shader_reflection.hxx"
+
+#include "loaders/SPIRV_loader.hxx"
+
+#include "graphics/bindless.hxx"
+#include "descriptor.hxx"
+#include "app.hxx"
+
+
+namespace
+{
+    // Minimal SPIR-V assembler; only the instructions the reflection reads are emitted.
+    class module_builder final {
+    public:
+
+        module_builder()
+        {
+            words_ = {0x0723'0203, 0x0001'0000, 0, 100, 0};
+        }
+
+        module_builder &op(std::uint32_t opcode, std::initializer_list<std::uint32_t> operands)
+        {
+            words_.push_back(static_cast<std::uint32_t>(std::size(operands) + 1) << 16 | opcode);
+            words_.insert(std::end(words_), operands);
+
+            return *this;
+        }
+
+        [[nodiscard]] std::vector<std::uint32_t> const &words() const noexcept { return words_; }
+
+    private:
+
+        std::vector<std::uint32_t> words_;
+    };
+
+    std::uint32_t constexpr kMAIN{0x6E69'616D}; // "main"
+
+    // A vertex shader with a uniform block at set 0 binding 1, an array of four combined image samplers at set 1 binding 0,
+    // a push constant block spanning [16, 32) and a floating point specialization constant with ID 7.
+    [[nodiscard]] std::vector<std::uint32_t> test_module()
+    {
+        module_builder builder;
+
+        builder
+            .op(15, {0, 1, kMAIN, 0})               // OpEntryPoint Vertex %1 "main"
+            .op(71, {10, 34, 0})                    // OpDecorate %10 DescriptorSet 0
+            .op(71, {10, 33, 1})                    // OpDecorate %10 Binding 1
+            .op(71, {11, 2})                        // OpDecorate %11 Block
+            .op(71, {20, 2})                        // OpDecorate %20 Block
+            .op(72, {20, 0, 35, 16})                // OpMemberDecorate %20 0 Offset 16
+            .op(71, {44, 34, 1})                    // OpDecorate %44 DescriptorSet 1
+            .op(71, {44, 33, 0})                    // OpDecorate %44 Binding 0
+            .op(71, {30, 1, 7})                     // OpDecorate %30 SpecId 7
+            .op(22, {2, 32})                        // %2 = OpTypeFloat 32
+            .op(23, {3, 2, 4})                      // %3 = OpTypeVector %2 4
+            .op(21, {50, 32, 0})                    // %50 = OpTypeInt 32 0
+            .op(43, {50, 51, 4})                    // %51 = OpConstant %50 4
+            .op(50, {2, 30, 0x3F80'0000})           // %30 = OpSpecConstant %2 1.0
+            .op(30, {11, 3})                        // %11 = OpTypeStruct %3
+            .op(32, {12, 2, 11})                    // %12 = OpTypePointer Uniform %11
+            .op(59, {12, 10, 2})                    // %10 = OpVariable %12 Uniform
+            .op(30, {20, 3})                        // %20 = OpTypeStruct %3
+            .op(32, {21, 9, 20})                    // %21 = OpTypePointer PushConstant %20
+            .op(59, {21, 22, 9})                    // %22 = OpVariable %21 PushConstant
+            .op(25, {40, 2, 1, 0, 0, 0, 1, 0})      // %40 = OpTypeImage %2 2D 0 0 0 1 Unknown
+            .op(27, {41, 40})                       // %41 = OpTypeSampledImage %40
+            .op(28, {42, 41, 51})                   // %42 = OpTypeArray %41 %51
+            .op(32, {43, 0, 42})                    // %43 = OpTypePointer UniformConstant %42
+            .op(59, {43, 44, 0});                   // %44 = OpVariable %43 UniformConstant
+
+        return builder.words();
+    }
+
+    [[nodiscard]] std::shared_ptr<graphics::descriptor_set_layout>
+    set_layout(std::vector<graphics::descriptor_set_binding> bindings)
+    {
+        return std::make_shared<graphics::descriptor_set_layout>(VK_NULL_HANDLE, std::move(bindings));
+    }
+
+    [[nodiscard]] graphics::pipeline_layout
+    pipeline_layout(std::vector<std::shared_ptr<graphics::descriptor_set_layout>> set_layouts, std::vector<graphics::push_constant_range> ranges)
+    {
+        return graphics::pipeline_layout{VK_NULL_HANDLE, std::move(set_layouts), std::move(ranges)};
+    }
+
+    [[nodiscard]] graphics::pipeline_layout matching_pipeline_layout()
+    {
+        return pipeline_layout({
+            set_layout({
+                {0, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER_DYNAMIC, graphics::SHADER_STAGE::VERTEX},
+                {1, 1, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER_DYNAMIC, graphics::SHADER_STAGE::VERTEX | graphics::SHADER_STAGE::FRAGMENT}
+            }),
+            set_layout({
+                {0, 4, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::ALL_GRAPHICS_SHADER_STAGES}
+            })
+        }, {
+            {graphics::SHADER_STAGE::FRAGMENT, 0, 16},
+            {graphics::SHADER_STAGE::VERTEX, 16, 16}
+        });
+    }
+}
+
+TEST(shader_reflection, reflects_module_interface)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    ASSERT_EQ(std::size(reflection.entry_points), 1u);
+    EXPECT_EQ(reflection.entry_point_stage("main"), graphics::SHADER_STAGE::VERTEX);
+    EXPECT_FALSE(reflection.entry_point_stage("other").has_value());
+
+    ASSERT_EQ(std::size(reflection.descriptor_bindings), 2u);
+
+    EXPECT_EQ(reflection.descriptor_bindings[0].set, 0u);
+    EXPECT_EQ(reflection.descriptor_bindings[0].binding, 1u);
+    EXPECT_EQ(reflection.descriptor_bindings[0].type, graphics::DESCRIPTOR_TYPE::UNIFORM_BUFFER);
+    EXPECT_EQ(reflection.descriptor_bindings[0].count, 1u);
+
+    EXPECT_EQ(reflection.descriptor_bindings[1].set, 1u);
+    EXPECT_EQ(reflection.descriptor_bindings[1].binding, 0u);
+    EXPECT_EQ(reflection.descriptor_bindings[1].type, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER);
+    EXPECT_EQ(reflection.descriptor_bindings[1].count, 4u);
+
+    EXPECT_EQ(reflection.push_constants_offset_bytes, 16u);
+    EXPECT_EQ(reflection.push_constants_size_bytes, 32u);
+
+    ASSERT_TRUE(reflection.specialization_constants.contains(7));
+    EXPECT_EQ(reflection.specialization_constants.at(7), graphics::shader_reflection::CONSTANT_TYPE::FLOATING_POINT);
+}
+
+TEST(shader_reflection, rejects_malformed_modules)
+{
+    auto words = test_module();
+
+    EXPECT_THROW(static_cast<void>(graphics::reflect_SPIRV(std::span{words}.first(3))), graphics::exception);
+
+    auto invalid_magic = words;
+    invalid_magic[0] = 0;
+
+    EXPECT_THROW(static_cast<void>(graphics::reflect_SPIRV(invalid_magic)), graphics::exception);
+
+    // The last instruction claims more words than the module has.
+    words[std::size(words) - 4] = 8u << 16 | 59;
+
+    EXPECT_THROW(static_cast<void>(graphics::reflect_SPIRV(words)), graphics::exception);
+}
+
+TEST(shader_reflection, cyclic_types_are_rejected)
+{
+    module_builder array_of_itself;
+
+    array_of_itself
+        .op(71, {10, 34, 0})                    // OpDecorate %10 DescriptorSet 0
+        .op(71, {10, 33, 0})                    // OpDecorate %10 Binding 0
+        .op(21, {50, 32, 0})                    // %50 = OpTypeInt 32 0
+        .op(43, {50, 51, 4})                    // %51 = OpConstant %50 4
+        .op(28, {42, 42, 51})                   // %42 = OpTypeArray %42 %51
+        .op(32, {43, 0, 42})                    // %43 = OpTypePointer UniformConstant %42
+        .op(59, {43, 10, 0});                   // %10 = OpVariable %43 UniformConstant
+
+    EXPECT_THROW(static_cast<void>(graphics::reflect_SPIRV(array_of_itself.words())), graphics::exception);
+
+    module_builder struct_of_itself;
+
+    struct_of_itself
+        .op(71, {20, 2})                        // OpDecorate %20 Block
+        .op(30, {20, 20})                       // %20 = OpTypeStruct %20
+        .op(32, {21, 9, 20})                    // %21 = OpTypePointer PushConstant %20
+        .op(59, {21, 22, 9});                   // %22 = OpVariable %21 PushConstant
+
+    EXPECT_THROW(static_cast<void>(graphics::reflect_SPIRV(struct_of_itself.words())), graphics::exception);
+}
+
+TEST(shader_reflection, matching_pipeline_layout_is_accepted)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    EXPECT_NO_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX, matching_pipeline_layout()));
+}
+
+TEST(shader_reflection, missing_descriptor_set_is_rejected)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    auto const layout = matching_pipeline_layout();
+
+    EXPECT_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX,
+                                                    pipeline_layout({layout.descriptor_set_layouts()[0]}, layout.push_constant_ranges())),
+                 graphics::exception);
+}
+
+TEST(shader_reflection, descriptor_type_mismatch_is_rejected)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    auto const layout = matching_pipeline_layout();
+
+    auto const storage_buffers = set_layout({
+        {1, 1, graphics::DESCRIPTOR_TYPE::STORAGE_BUFFER, graphics::SHADER_STAGE::VERTEX}
+    });
+
+    EXPECT_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX,
+                                                    pipeline_layout({storage_buffers, layout.descriptor_set_layouts()[1]}, layout.push_constant_ranges())),
+                 graphics::exception);
+}
+
+TEST(shader_reflection, insufficient_descriptor_count_is_rejected)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    auto const layout = matching_pipeline_layout();
+
+    auto const samplers = set_layout({
+        {0, 2, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::VERTEX}
+    });
+
+    EXPECT_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX,
+                                                    pipeline_layout({layout.descriptor_set_layouts()[0], samplers}, layout.push_constant_ranges())),
+                 graphics::exception);
+}
+
+TEST(shader_reflection, binding_invisible_to_stage_is_rejected)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    auto const layout = matching_pipeline_layout();
+
+    auto const samplers = set_layout({
+        {0, 4, graphics::DESCRIPTOR_TYPE::COMBINED_IMAGE_SAMPLER, graphics::SHADER_STAGE::FRAGMENT}
+    });
+
+    EXPECT_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX,
+                                                    pipeline_layout({layout.descriptor_set_layouts()[0], samplers}, layout.push_constant_ranges())),
+                 graphics::exception);
+}
+
+TEST(shader_reflection, push_constants_have_to_be_covered_for_stage)
+{
+    auto const reflection = graphics::reflect_SPIRV(test_module());
+
+    auto const set_layouts = matching_pipeline_layout().descriptor_set_layouts();
+
+    // Split between two ranges.
+    EXPECT_NO_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX, pipeline_layout(set_layouts, {
+        {graphics::SHADER_STAGE::VERTEX, 16, 8}, {graphics::SHADER_STAGE::VERTEX | graphics::SHADER_STAGE::FRAGMENT, 24, 8}
+    })));
+
+    EXPECT_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX, pipeline_layout(set_layouts, {
+        {graphics::SHADER_STAGE::VERTEX, 16, 12}
+    })), graphics::exception);
+
+    EXPECT_THROW(graphics::validate_pipeline_layout(reflection, graphics::SHADER_STAGE::VERTEX, pipeline_layout(set_layouts, {
+        {graphics::SHADER_STAGE::FRAGMENT, 0, 32}
+    })), graphics::exception);
+}
+
+// The modules compiled from the repository's shaders by the content pipeline, checked against the layouts the engine creates:
+// its descriptor sets with either the image resources set or the bindless texture table, and the per-draw push constants
+// the materials pick their ranges of.
+TEST(shader_reflection, repository_modules_match_engine_layouts)
+{
+    auto const names = loader::enumerate_SPIRV();
+
+    if (names.empty())
+        GTEST_SKIP() << "no compiled shaders; run scripts/compile_materials.py";
+
+    std::vector<graphics::push_constant_range> const push_constant_ranges{
+        {graphics::SHADER_STAGE::ALL_GRAPHICS_SHADER_STAGES, 0, static_cast<std::uint32_t>(sizeof(per_draw_t))}
+    };
+
+    auto const image_resources_layout = pipeline_layout({
+        set_layout(view_resources_descriptor_set_bindings()),
+        set_layout(object_resources_descriptor_set_bindings()),
+        set_layout(image_resources_descriptor_set_bindings())
+    }, push_constant_ranges);
+
+    auto const bindless_textures_layout = pipeline_layout({
+        set_layout(view_resources_descriptor_set_bindings()),
+        set_layout(object_resources_descriptor_set_bindings()),
+        set_layout(graphics::bindless_texture_table::descriptor_set_bindings(graphics::bindless_texture_table::kMAX_TEXTURES_NUMBER))
+    }, push_constant_ranges);
+
+    auto is_valid = [] (graphics::shader_reflection const &reflection, graphics::SHADER_STAGE stage, graphics::pipeline_layout const &layout)
+    {
+        try {
+            graphics::validate_pipeline_layout(reflection, stage, layout);
+        }
+
+        catch (graphics::exception const &) {
+            return false;
+        }
+
+        return true;
+    };
+
+    for (auto &&name : names) {
+        SCOPED_TRACE(name);
+
+        graphics::shader_reflection reflection;
+
+        ASSERT_NO_THROW(reflection = graphics::reflect_SPIRV(loader::map_SPIRV(name)));
+        ASSERT_FALSE(reflection.entry_points.empty());
+
+        for (auto &&entry_point : reflection.entry_points) {
+            EXPECT_TRUE(is_valid(reflection, entry_point.stage, image_resources_layout) || is_valid(reflection, entry_point.stage, bindless_textures_layout))
+                << "the module matches neither of the engine's pipeline layouts";
+        }
+    }
+}
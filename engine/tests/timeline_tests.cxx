@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <volk.h>
+
+#include "renderer/timeline.hxx"
+
+
+namespace
+{
+    // Value the fake GPU has signaled the semaphore with.
+    std::uint64_t signaled_value{0};
+
+    std::size_t waits_number{0};
+
+    PFN_vkCreateSemaphore create_semaphore{nullptr};
+    PFN_vkDestroySemaphore destroy_semaphore{nullptr};
+    PFN_vkGetSemaphoreCounterValue get_semaphore_counter_value{nullptr};
+    PFN_vkWaitSemaphores wait_semaphores{nullptr};
+
+    VKAPI_ATTR VkResult VKAPI_CALL fake_create_semaphore(VkDevice, VkSemaphoreCreateInfo const *, VkAllocationCallbacks const *, VkSemaphore *semaphore)
+    {
+        *semaphore = reinterpret_cast<VkSemaphore>(std::uintptr_t{1});
+
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL fake_destroy_semaphore(VkDevice, VkSemaphore, VkAllocationCallbacks const *) { }
+
+    VKAPI_ATTR VkResult VKAPI_CALL fake_get_semaphore_counter_value(VkDevice, VkSemaphore, std::uint64_t *value)
+    {
+        *value = signaled_value;
+
+        return VK_SUCCESS;
+    }
+
+    // Times out instead of blocking on a value that is never going to be signaled, however long the timeout is.
+    VKAPI_ATTR VkResult VKAPI_CALL fake_wait_semaphores(VkDevice, VkSemaphoreWaitInfo const *wait_info, std::uint64_t)
+    {
+        ++waits_number;
+
+        return wait_info->pValues[0] <= signaled_value ? VK_SUCCESS : VK_TIMEOUT;
+    }
+
+    // The semaphore functions are volk's global pointers, so the timeline runs without a device against the swapped ones.
+    class timeline_test : public ::testing::Test {
+    protected:
+
+        void SetUp() override
+        {
+            signaled_value = 0;
+            waits_number = 0;
+
+            create_semaphore = std::exchange(vkCreateSemaphore, fake_create_semaphore);
+            destroy_semaphore = std::exchange(vkDestroySemaphore, fake_destroy_semaphore);
+            get_semaphore_counter_value = std::exchange(vkGetSemaphoreCounterValue, fake_get_semaphore_counter_value);
+            wait_semaphores = std::exchange(vkWaitSemaphores, fake_wait_semaphores);
+        }
+
+        void TearDown() override
+        {
+            vkCreateSemaphore = std::exchange(create_semaphore, nullptr);
+            vkDestroySemaphore = std::exchange(destroy_semaphore, nullptr);
+            vkGetSemaphoreCounterValue = std::exchange(get_semaphore_counter_value, nullptr);
+            vkWaitSemaphores = std::exchange(wait_semaphores, nullptr);
+        }
+
+        // Takes the next value and commits it only if the submission succeeds, the same way the queue submissions do.
+        static std::uint64_t submit(render::timeline &timeline, bool succeeded)
+        {
+            auto const timeline_value = timeline.next_value();
+
+            if (succeeded)
+                timeline.commit_value(timeline_value);
+
+            return timeline_value;
+        }
+    };
+}
+
+TEST_F(timeline_test, next_value_does_not_reserve)
+{
+    render::timeline timeline{VK_NULL_HANDLE};
+
+    EXPECT_EQ(timeline.next_value(), 1u);
+    EXPECT_EQ(timeline.next_value(), 1u);
+    EXPECT_EQ(timeline.last_value(), 0u);
+}
+
+TEST_F(timeline_test, committed_values_are_waited_for)
+{
+    render::timeline timeline{VK_NULL_HANDLE};
+
+    EXPECT_EQ(submit(timeline, true), 1u);
+    EXPECT_EQ(submit(timeline, true), 2u);
+
+    EXPECT_EQ(timeline.last_value(), 2u);
+
+    EXPECT_FALSE(timeline.is_completed(timeline.last_value()));
+    EXPECT_FALSE(timeline.wait(timeline.last_value(), 0));
+
+    signaled_value = 2;
+
+    EXPECT_TRUE(timeline.wait(timeline.last_value()));
+    EXPECT_TRUE(timeline.is_completed(1));
+}
+
+TEST_F(timeline_test, failed_submission_leaves_nothing_to_wait_for)
+{
+    render::timeline timeline{VK_NULL_HANDLE};
+
+    submit(timeline, true);
+
+    signaled_value = 1;
+
+    EXPECT_TRUE(timeline.wait(timeline.last_value()));
+
+    // The failed submission never signals its value, so waiting for it would hang.
+    EXPECT_EQ(submit(timeline, false), 2u);
+
+    EXPECT_EQ(timeline.last_value(), 1u);
+    EXPECT_TRUE(timeline.wait(timeline.last_value()));
+
+    // The next submission signals the value the failed one didn't.
+    EXPECT_EQ(submit(timeline, true), 2u);
+    EXPECT_EQ(timeline.last_value(), 2u);
+}
+
+TEST_F(timeline_test, completed_values_are_cached)
+{
+    render::timeline timeline{VK_NULL_HANDLE};
+
+    submit(timeline, true);
+    submit(timeline, true);
+
+    signaled_value = 2;
+
+    EXPECT_TRUE(timeline.wait(2));
+    EXPECT_EQ(waits_number, 1u);
+
+    EXPECT_TRUE(timeline.wait(1));
+    EXPECT_TRUE(timeline.wait(2));
+    EXPECT_EQ(waits_number, 1u);
+}
@@ -0,0 +1,300 @@
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <gtest/gtest.h>
+
+#include "utility/exceptions.hxx"
+
+#include "vulkan/debug.hxx"
+
+#include "graphics/graphics.hxx"
+
+#include "renderer/command_buffer.hxx"
+#include "renderer/uniform_ring_buffer.hxx"
+
+#include "device_fixture.hxx"
+
+
+namespace
+{
+    // Big enough for a copy torn by an overlapping write to show.
+    struct frame_payload final {
+        std::array<std::uint64_t, 32> frame_indices;
+
+        explicit frame_payload(std::uint64_t frame_index = 0) noexcept { frame_indices.fill(frame_index); }
+    };
+
+    // Every frame writes its payload into the slot of its frame in flight, and the frame's submission copies the slot into
+    // another one, standing in for the shaders reading it. Had a slot been written before the submission reading it
+    // completed, the copy would hold a later frame's payload.
+    class uniform_ring_buffer_test : public test::device_test {
+    protected:
+
+        void SetUp() override
+        {
+            test::device_test::SetUp();
+
+            if (IsSkipped())
+                return;
+
+            validation_errors_number_ = vulkan::validation_errors_number();
+
+            command_pool_ = *create_command_pool(device(), device().graphics_queue, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+        }
+
+        void TearDown() override
+        {
+            if (IsSkipped())
+                return;
+
+            auto &&timeline = device().graphics_queue.timeline();
+
+            timeline.wait(timeline.last_value());
+
+            if (!command_buffers_.empty())
+                vkFreeCommandBuffers(device().handle(), command_pool_, static_cast<std::uint32_t>(std::size(command_buffers_)), std::data(command_buffers_));
+
+            vkDestroyCommandPool(device().handle(), command_pool_, nullptr);
+
+            EXPECT_EQ(vulkan::validation_errors_number(), validation_errors_number_) << "validation errors have been reported";
+        }
+
+        // The first half of the slots is written by the frames, the second one holds the copies.
+        [[nodiscard]] std::unique_ptr<render::uniform_ring_buffer> create_ring_buffer(std::uint32_t frames_in_flight)
+        {
+            auto const ranges_sizes = std::array{sizeof(frame_payload)};
+
+            auto constexpr usage_flags = graphics::BUFFER_USAGE::UNIFORM_BUFFER | graphics::BUFFER_USAGE::TRANSFER_SOURCE |
+                                         graphics::BUFFER_USAGE::TRANSFER_DESTINATION;
+
+            // The previous run's submissions have completed.
+            if (!command_buffers_.empty())
+                vkFreeCommandBuffers(device().handle(), command_pool_, static_cast<std::uint32_t>(std::size(command_buffers_)), std::data(command_buffers_));
+
+            command_buffers_.resize(frames_in_flight);
+
+            VkCommandBufferAllocateInfo const allocate_info{
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                nullptr,
+                command_pool_,
+                VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                frames_in_flight
+            };
+
+            if (auto result = vkAllocateCommandBuffers(device().handle(), &allocate_info, std::data(command_buffers_)); result != VK_SUCCESS)
+                throw vulkan::exception(fmt::format("failed to allocate command buffers: {0:#x}", result));
+
+            return std::make_unique<render::uniform_ring_buffer>(device(), resource_manager(), ranges_sizes, frames_in_flight * 2, usage_flags);
+        }
+
+        void submit_frame(render::uniform_ring_buffer &ring_buffer, std::uint32_t slot_index, std::uint32_t frames_in_flight)
+        {
+            auto command_buffer = command_buffers_.at(slot_index);
+
+            VkCommandBufferBeginInfo const begin_info{
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                nullptr,
+                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                nullptr
+            };
+
+            if (auto result = vkBeginCommandBuffer(command_buffer, &begin_info); result != VK_SUCCESS)
+                throw vulkan::exception(fmt::format("failed to record command buffer: {0:#x}", result));
+
+            auto const buffer_info = ring_buffer.descriptor_buffer_info(0);
+
+            VkBufferCopy const region{
+                buffer_info.offset + ring_buffer.dynamic_offset(slot_index),
+                buffer_info.offset + ring_buffer.dynamic_offset(slot_index + frames_in_flight),
+                sizeof(frame_payload)
+            };
+
+            vkCmdCopyBuffer(command_buffer, buffer_info.buffer, buffer_info.buffer, 1, &region);
+
+            VkMemoryBarrier const barrier{
+                VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                nullptr,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_ACCESS_HOST_READ_BIT
+            };
+
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+            if (auto result = vkEndCommandBuffer(command_buffer); result != VK_SUCCESS)
+                throw vulkan::exception(fmt::format("failed to end command buffer: {0:#x}", result));
+
+            auto &&queue = device().graphics_queue;
+            auto &&timeline = queue.timeline();
+
+            auto const timeline_handle = timeline.handle();
+            auto const timeline_value = timeline.next_value();
+
+            VkTimelineSemaphoreSubmitInfo const timeline_info{
+                VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+                nullptr,
+                0, nullptr,
+                1, &timeline_value
+            };
+
+            VkSubmitInfo const submit_info{
+                VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                &timeline_info,
+                0, nullptr,
+                nullptr,
+                1, &command_buffer,
+                1, &timeline_handle,
+            };
+
+            if (auto result = vkQueueSubmit(queue.handle(), 1, &submit_info, VK_NULL_HANDLE); result != VK_SUCCESS)
+                throw vulkan::exception(fmt::format("failed to submit frame: {0:#x}", result));
+
+            timeline.commit_value(timeline_value);
+
+            ring_buffer.submit(slot_index, timeline_value);
+        }
+
+        static void invalidate(render::uniform_ring_buffer const &ring_buffer, std::uint32_t slot_index)
+        {
+            if (auto mapped_range = ring_buffer.flush_range(slot_index); mapped_range) {
+                if (auto result = vkInvalidateMappedMemoryRanges(device().handle(), 1, &*mapped_range); result != VK_SUCCESS)
+                    throw vulkan::exception(fmt::format("failed to invalidate ring buffer slot: {0:#x}", result));
+            }
+        }
+
+        static void flush(render::uniform_ring_buffer const &ring_buffer, std::uint32_t slot_index)
+        {
+            if (auto mapped_range = ring_buffer.flush_range(slot_index); mapped_range) {
+                if (auto result = vkFlushMappedMemoryRanges(device().handle(), 1, &*mapped_range); result != VK_SUCCESS)
+                    throw vulkan::exception(fmt::format("failed to flush ring buffer slot: {0:#x}", result));
+            }
+        }
+
+        // Runs the frames as the application does and returns the payloads the submissions have read, in the frames order.
+        [[nodiscard]] std::vector<std::uint64_t> run_frames(std::uint32_t frames_in_flight, std::uint64_t frames_number)
+        {
+            auto const ring_buffer = create_ring_buffer(frames_in_flight);
+
+            auto &&timeline = device().graphics_queue.timeline();
+
+            std::vector<std::uint64_t> read_frame_indices;
+
+            auto const read_copy = [&] (std::uint32_t slot_index)
+            {
+                invalidate(*ring_buffer, slot_index + frames_in_flight);
+
+                auto const payload = ring_buffer->read<frame_payload>(slot_index + frames_in_flight, 0);
+
+                // A torn copy would mix the frames.
+                EXPECT_TRUE(std::ranges::all_of(payload.frame_indices, [&payload] (auto index) { return index == payload.frame_indices.front(); }));
+
+                read_frame_indices.push_back(payload.frame_indices.front());
+            };
+
+            for (std::uint64_t frame_index = 0; frame_index < frames_number; ++frame_index) {
+                auto const slot_index = static_cast<std::uint32_t>(frame_index % frames_in_flight);
+
+                timeline.wait(ring_buffer->slot_timeline_value(slot_index));
+
+                // The submission that has used the slot before is complete, so its copy can be checked.
+                if (frame_index >= frames_in_flight)
+                    read_copy(slot_index);
+
+                ring_buffer->write(slot_index, 0, frame_payload{frame_index});
+
+                flush(*ring_buffer, slot_index);
+
+                submit_frame(*ring_buffer, slot_index, frames_in_flight);
+            }
+
+            timeline.wait(timeline.last_value());
+
+            for (auto frame_index = frames_number - std::min<std::uint64_t>(frames_number, frames_in_flight); frame_index < frames_number; ++frame_index)
+                read_copy(static_cast<std::uint32_t>(frame_index % frames_in_flight));
+
+            return read_frame_indices;
+        }
+
+    private:
+
+        VkCommandPool command_pool_{VK_NULL_HANDLE};
+        std::vector<VkCommandBuffer> command_buffers_;
+
+        std::size_t validation_errors_number_{0};
+    };
+}
+
+TEST_F(uniform_ring_buffer_test, slots_are_aligned_for_dynamic_offsets)
+{
+    auto const ranges_sizes = std::array<std::size_t, 2>{4, 64};
+
+    render::uniform_ring_buffer const ring_buffer{device(), resource_manager(), ranges_sizes, 3};
+
+    auto const alignment = device().device_limits().min_uniform_buffer_offset_alignment;
+
+    EXPECT_EQ(ring_buffer.descriptor_buffer_info(1).offset % alignment, 0u);
+    EXPECT_EQ(ring_buffer.dynamic_offset(1) % alignment, 0u);
+    EXPECT_GE(ring_buffer.dynamic_offset(1), ring_buffer.descriptor_buffer_info(1).offset + 64);
+}
+
+TEST_F(uniform_ring_buffer_test, storage_slots_are_aligned_for_dynamic_offsets)
+{
+    auto const ranges_sizes = std::array<std::size_t, 1>{4};
+
+    render::uniform_ring_buffer const ring_buffer{device(), resource_manager(), ranges_sizes, 3, graphics::BUFFER_USAGE::STORAGE_BUFFER};
+
+    EXPECT_EQ(ring_buffer.dynamic_offset(1) % device().device_limits().min_storage_buffer_offset_alignment, 0u);
+}
+
+TEST_F(uniform_ring_buffer_test, frames_in_flight_read_their_own_slots)
+{
+    std::uint64_t constexpr kFRAMES_NUMBER{1024};
+
+    for (auto frames_in_flight : {1u, 2u, 3u, 8u}) {
+        SCOPED_TRACE(fmt::format("{} frames in flight", frames_in_flight));
+
+        auto const read_frame_indices = run_frames(frames_in_flight, kFRAMES_NUMBER);
+
+        ASSERT_EQ(std::size(read_frame_indices), kFRAMES_NUMBER);
+
+        for (std::uint64_t frame_index = 0; frame_index < kFRAMES_NUMBER; ++frame_index)
+            ASSERT_EQ(read_frame_indices[frame_index], frame_index) << "the submission has read another frame's data";
+    }
+}
+
+TEST_F(uniform_ring_buffer_test, ring_buffers_sharing_memory_outlive_each_other)
+{
+    auto const ranges_sizes = std::array{sizeof(frame_payload)};
+
+    // Sub-allocated from the same host visible memory blocks as the staging buffers, as the application's view and object buffers are.
+    auto first = std::make_unique<render::uniform_ring_buffer>(device(), resource_manager(), ranges_sizes, 2);
+    auto second = std::make_unique<render::uniform_ring_buffer>(device(), resource_manager(), ranges_sizes, 2);
+
+    auto const staging_buffer = resource_manager().create_staging_buffer(sizeof(frame_payload));
+
+    first->write(1, 0, frame_payload{1});
+    second->write(1, 0, frame_payload{2});
+
+    // The released ring buffer mustn't take the memory mapping of the others along.
+    first.reset();
+
+    second->write(0, 0, frame_payload{3});
+
+    EXPECT_EQ(second->read<frame_payload>(1, 0).frame_indices.front(), 2u);
+    EXPECT_EQ(second->read<frame_payload>(0, 0).frame_indices.front(), 3u);
+
+    std::ranges::fill(staging_buffer->mapped_range(), std::byte{0x5a});
+
+    // Created again while the second one is in use, as the per-frame buffers are on the swapchain recreation.
+    first = std::make_unique<render::uniform_ring_buffer>(device(), resource_manager(), ranges_sizes, 2);
+
+    first->write(0, 0, frame_payload{4});
+
+    EXPECT_EQ(first->read<frame_payload>(0, 0).frame_indices.front(), 4u);
+    EXPECT_EQ(second->read<frame_payload>(0, 0).frame_indices.front(), 3u);
+}
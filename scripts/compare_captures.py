@@ -0,0 +1,129 @@
+import argparse
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), 'pymodules'))
+
+from utils import err_print_fmt
+
+# CTest reports the test as skipped rather than failed when there is no Vulkan device to render with.
+SKIP_RETURN_CODE = 77
+
+NO_DEVICE_MESSAGES = (
+    'failed to find physical device with Vulkan API support',
+    'failed to pick physical device',
+)
+
+
+def parse_program_options():
+    argparser = argparse.ArgumentParser(description='Renders the same scene headlessly with two sets of engine options '
+                                                    'or two engine builds and compares the captured images')
+
+    argparser.add_argument('engine', help='path to the engine executable', metavar='<engine>')
+    argparser.add_argument('--common', dest='common', default='--headless --frames 8 --width 320 --height 240',
+                           help='options both the runs share (default is \'--headless --frames 8 --width 320 --height 240\')',
+                           metavar='<options>')
+    argparser.add_argument('--reference', dest='reference', default='',
+                           help='options of the reference run only (default is none)', metavar='<options>')
+    argparser.add_argument('--reference-engine', dest='reference_engine', default=None,
+                           help='engine executable of the reference run, e.g. built from an earlier revision to compare the images '
+                                'before and after a change (default is the compared engine)', metavar='<reference-engine>')
+    argparser.add_argument('--reference-contents-root', dest='reference_contents_root', default=None,
+                           help='folder the reference engine looks for its contents in, i.e. the source tree it has been built from '
+                                '(default is the current folder)', metavar='<reference-contents-root>')
+    argparser.add_argument('--candidate', dest='candidate', default='',
+                           help='options of the compared run only, e.g. \'--candidate=--bindless\' (default is none)', metavar='<options>')
+    argparser.add_argument('--tolerance', dest='tolerance', type=int, default=0,
+                           help='largest allowed difference of a color channel (default is 0)', metavar='<tolerance>')
+    argparser.add_argument('--output-path', dest='outpath', default=None,
+                           help='folder to keep the captures in (default is a temporary one)', metavar='<output-path>')
+
+    return argparser.parse_args()
+
+
+def read_ppm(path):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    # The engine writes the header as "P6\n<width> <height>\n255\n"; the texels may start with whitespace bytes.
+    magic, extent, max_value, texels = data.split(b'\n', maxsplit=3)
+    width, height = extent.split()
+
+    if magic != b'P6' or max_value != b'255':
+        raise RuntimeError(f'unsupported image format: {path}')
+
+    width, height = int(width), int(height)
+
+    if len(texels) != width * height * 3:
+        raise RuntimeError(f'truncated image: {path}')
+
+    return width, height, texels
+
+
+def render(engine, options, capture_path, working_path=None):
+    command = [engine, *shlex.split(options), '--capture', capture_path]
+
+    # The engine looks for the contents relative to the working folder.
+    result = subprocess.run(command, capture_output=True, text=True, cwd=working_path)
+
+    if result.returncode != 0:
+        output = result.stdout + result.stderr
+
+        if any(message in output for message in NO_DEVICE_MESSAGES):
+            err_print_fmt('No Vulkan device to render with:', output)
+            sys.exit(SKIP_RETURN_CODE)
+
+        err_print_fmt(f'Failed to render with \'{shlex.join(command)}\':', output)
+        sys.exit(1)
+
+    return read_ppm(capture_path)
+
+
+def compare(reference, candidate, tolerance):
+    reference_width, reference_height, reference_texels = reference
+    candidate_width, candidate_height, candidate_texels = candidate
+
+    if (reference_width, reference_height) != (candidate_width, candidate_height):
+        err_print_fmt('Image extents differ:', f'{reference_width}x{reference_height} vs {candidate_width}x{candidate_height}')
+        return False
+
+    differences = [abs(a - b) for a, b in zip(reference_texels, candidate_texels)]
+
+    mismatched_channels = sum(1 for difference in differences if difference > tolerance)
+
+    if mismatched_channels != 0:
+        first = next(index for index, difference in enumerate(differences) if difference > tolerance)
+        x, y = (first // 3) % reference_width, (first // 3) // reference_width
+
+        err_print_fmt('Images differ:', f'{mismatched_channels} channels exceed the tolerance of {tolerance}, '
+                                        f'the largest difference is {max(differences)}, the first one is at ({x}, {y})')
+        return False
+
+    return True
+
+
+def main():
+    args = parse_program_options()
+
+    with tempfile.TemporaryDirectory() as temporary_path:
+        outpath = args.outpath or temporary_path
+
+        os.makedirs(outpath, exist_ok=True)
+
+        reference_engine = os.path.abspath(args.reference_engine or args.engine)
+
+        reference = render(reference_engine, f'{args.common} {args.reference}', os.path.abspath(os.path.join(outpath, 'reference.ppm')),
+                           args.reference_contents_root)
+        candidate = render(args.engine, f'{args.common} {args.candidate}', os.path.abspath(os.path.join(outpath, 'candidate.ppm')))
+
+        if not compare(reference, candidate, args.tolerance):
+            sys.exit(1)
+
+    print('Images match')
+
+
+if __name__ == '__main__':
+    main()
@@ -1,10 +1,14 @@
 import argparse
+import functools
+import hashlib
 import json
 import os
+import re
 import subprocess
 import sys
 import traceback
 import uuid
+from concurrent.futures import ProcessPoolExecutor, as_completed
 from operator import attrgetter, itemgetter
 
 from abstract_shader_preprocessor import AbstractShaderPreprocessor
@@ -47,6 +51,14 @@ def parse_program_options():
                            help='material file extension (default is json)', metavar='<material-file-ext>')
     argparser.add_argument('--shader-compiler-path', dest='shader_compiler_path', default='glslangValidator',
                            help='shader compiler path (default is glslangValidator)', metavar='<shader_compiler_path>')
+    argparser.add_argument('-j', '--jobs', dest='jobs', type=int, default=os.cpu_count(),
+                           help='number of parallel compiler processes (default is the number of CPUs)',
+                           metavar='<jobs>')
+    argparser.add_argument('-f', '--force', dest='force',
+                           help='recompile all shaders ignoring the manifest (default is false)', action='store_true')
+    argparser.add_argument('--manifest-name', dest='manifest_name', default='manifest.json',
+                           help='name of the outputs manifest in the output folder (default is \'manifest.json\')',
+                           metavar='<manifest-name>')
 
     return vars(argparser.parse_args())
 
@@ -59,14 +71,10 @@ def get_shader_compilation_flags(shader_module: ShaderModuleInfo) -> list:
         return ['-V', '-D', '--hlsl-enable-16bit-types']
 
 
-def compile_shader(program_options: dict, shader_module: ShaderModuleInfo, output_path: str, source_code: str):
+def get_shader_compiler_args(program_options: dict, shader_module: ShaderModuleInfo) -> list:
     compilation_flags = get_shader_compilation_flags(shader_module)
 
-    dirpath = os.path.dirname(output_path)
-    if not os.path.exists(dirpath):
-        os.makedirs(dirpath)
-
-    compiler = subprocess.Popen([
+    return [
         program_options['shader_compiler_path'],
         '--entry-point', shader_module.entry_point,
         '--source-entrypoint', 'main',
@@ -74,19 +82,117 @@ def compile_shader(program_options: dict, shader_module: ShaderModuleInfo, outpu
         # '-H',
         '--target-env', 'spirv1.3',
         f'-I{program_options["shaders_include_folder"]}',
-        '-o', output_path,
         '--stdin',
         '-S', ShaderStage.to_str(shader_module.stage)
-    ], stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    ]
+
+
+def compile_shader(target_name: str, compiler_args: list, output_path: str, source_code: str) -> str:
+    dirpath = os.path.dirname(output_path)
+    os.makedirs(dirpath, exist_ok=True)
+
+    compiler = subprocess.Popen([*compiler_args, '-o', output_path],
+                                stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
 
     output, errors = compiler.communicate(source_code.encode('UTF-8'))
 
     output = output.decode('UTF-8')[len('stdin'):]
     if len(output) > 2:
-        raise exs.GLSLangValidatorError(shader_module.target_name, output)
+        raise exs.GLSLangValidatorError(target_name, output)
 
     if compiler.returncode != 0:
-        raise exs.GLSLangValidatorError(shader_module.target_name, errors.decode('UTF-8'))
+        raise exs.GLSLangValidatorError(target_name, errors.decode('UTF-8'))
+
+    return output_path
+
+
+INCLUDE_DIRECTIVE_PATTERN = re.compile(r'^[ \t]*#[ \t]*include[ \t]*(?:"([^"]+)"|<([^>]+)>)', re.MULTILINE)
+
+
+def collect_includes(source_code: str, including_folder: str, include_folders: list, includes: dict) -> None:
+    """
+    Recursively resolves include directives of the source code the same way the compiler does and stores
+    contents of every found file keyed by its path; unresolved includes are stored with empty contents.
+    Quoted includes are looked up in the including file's folder first, then in the include folders;
+    the source code compiled from the standard input has no folder of its own.
+    """
+    for quoted_name, angled_name in INCLUDE_DIRECTIVE_PATTERN.findall(source_code):
+        include_name = quoted_name or angled_name
+
+        folders = [including_folder, *include_folders] if quoted_name and including_folder else include_folders
+
+        path = next(filter(os.path.isfile, map(lambda f: os.path.join(f, include_name), folders)), None)
+
+        if path is None:
+            includes.setdefault(include_name, b'')
+            continue
+
+        path = os.path.normpath(path)
+
+        if path in includes:
+            continue
+
+        with open(path, 'rb') as file:
+            include_source = file.read()
+
+        includes[path] = include_source
+
+        collect_includes(include_source.decode('UTF-8'), os.path.dirname(path), include_folders, includes)
+
+
+@functools.lru_cache(maxsize=None)
+def get_shader_compiler_version(shader_compiler_path: str) -> bytes:
+    """
+    Output of the compiler's version query; empty if the compiler can't be run, which fails the compilation anyway.
+    """
+    try:
+        return subprocess.run([shader_compiler_path, '--version'], capture_output=True).stdout
+
+    except OSError:
+        return b''
+
+
+def get_shader_digest(program_options: dict, compiler_args: list, source_code: str) -> str:
+    """
+    Digest of everything that affects the compiled module: the preprocessed source code (which carries
+    the stage inputs, defines and specialization constants), contents of all included files, the compiler flags
+    and the compiler's version.
+    """
+    includes = {}
+    include_folders = [program_options['shaders_include_folder'], program_options['shaders_src_folder']]
+
+    collect_includes(source_code, None, include_folders, includes)
+
+    digest = hashlib.sha256()
+
+    digest.update(get_shader_compiler_version(program_options['shader_compiler_path']))
+    digest.update('\0'.join(compiler_args).encode('UTF-8'))
+    digest.update(source_code.encode('UTF-8'))
+
+    for include_name in sorted(includes):
+        digest.update(include_name.encode('UTF-8'))
+        digest.update(hashlib.sha256(includes[include_name]).digest())
+
+    return digest.hexdigest()
+
+
+def load_manifest(manifest_path: str) -> dict:
+    if not os.path.isfile(manifest_path):
+        return {}
+
+    try:
+        with open(manifest_path, 'r') as json_file:
+            return json.load(json_file).get('outputs', {})
+
+    except (OSError, ValueError):
+        return {}
+
+
+def save_manifest(manifest_path: str, outputs: dict) -> None:
+    os.makedirs(os.path.dirname(manifest_path), exist_ok=True)
+
+    with open(manifest_path, 'w') as json_file:
+        json.dump({'outputs': dict(sorted(outputs.items()))}, json_file, indent=4)
 
 
 def get_shader_preprocessor(glsl_preprocessor: GLSLShaderPreprocessor, hlsl_preprocessor: HLSLShaderPreprocessor,
@@ -98,7 +204,7 @@ def get_shader_preprocessor(glsl_preprocessor: GLSLShaderPreprocessor, hlsl_prep
         return hlsl_preprocessor
 
 
-def compile_material(program_options: dict, material_data: dict):
+def collect_material_jobs(program_options: dict, material_data: dict, jobs: dict) -> None:
     shaders_src_folder, glsl_version = itemgetter('shaders_src_folder', 'glsl_version')(program_options)
 
     glsl_preprocessor = GLSLShaderPreprocessor(shaders_src_folder, glsl_version)
@@ -107,43 +213,131 @@ def compile_material(program_options: dict, material_data: dict):
     for i, _ in enumerate(material_data['techniques']):
         material_tech = MaterialTechnique(material_data, i)
         for shader_module in material_tech.shader_bundle:
+            hashed_name = str(uuid.uuid5(uuid.NAMESPACE_DNS, shader_module.target_name))
+
+            # Different materials may share the same shader module variants.
+            if hashed_name in jobs:
+                continue
+
             shader_preprocessor = get_shader_preprocessor(glsl_preprocessor, hlsl_preprocessor, shader_module)
             shader_preprocessor.process(shader_module)
 
-            hashed_name = str(uuid.uuid5(uuid.NAMESPACE_DNS, shader_module.target_name))
-            output_path = os.path.join(program_options['outpath'], f'{hashed_name}.spv')
+            source_code = shader_preprocessor.source_code
+            compiler_args = get_shader_compiler_args(program_options, shader_module)
 
-            print(f'{shader_module.target_name} -> {output_path}')
-            compile_shader(program_options, shader_module, output_path, shader_preprocessor.source_code)
+            jobs[hashed_name] = {
+                'target_name': shader_module.target_name,
+                'output_path': os.path.join(program_options['outpath'], f'{hashed_name}.spv'),
+                'compiler_args': compiler_args,
+                'source_code': source_code,
+                'digest': get_shader_digest(program_options, compiler_args, source_code)
+            }
 
 
-def main():
-    program_options = parse_program_options()
+def collect_materials(program_options: dict) -> list:
+    materials_paths = []
+
+    for material in program_options['materials']:
+        if not os.path.isdir(material) and not os.path.isfile(material):
+            material = os.path.join(program_options['materials_src_folder'], material)
+
+        path = os.path.abspath(material)
+
+        if os.path.isdir(path):
+            for dirpath, _, filenames in os.walk(path):
+                filenames = filter(lambda n: n.endswith(program_options['mat_file_ext']), filenames)
+                filenames = map(lambda n: os.path.abspath(os.path.join(dirpath, n)), filenames)
+
+                materials_paths.extend(sorted(filenames))
+
+        elif os.path.isfile(path) and path.endswith(program_options['mat_file_ext']):
+            materials_paths.append(path)
+
+    return materials_paths
+
+
+def compile_materials(program_options: dict) -> bool:
+    jobs = {}
+
+    for path in collect_materials(program_options):
+        with open(path, 'r') as json_file:
+            collect_material_jobs(program_options, json.load(json_file), jobs)
+
+    manifest_path = os.path.join(program_options['outpath'], program_options['manifest_name'])
+    manifest = {} if program_options['force'] else load_manifest(manifest_path)
+
+    outdated_jobs = {}
+
+    for hashed_name, job in jobs.items():
+        entry = manifest.get(hashed_name)
+
+        if entry and entry['digest'] == job['digest'] and os.path.isfile(job['output_path']):
+            if program_options['verbose']:
+                print(f'{job["target_name"]} is up to date')
+
+            continue
+
+        manifest.pop(hashed_name, None)
+        outdated_jobs[hashed_name] = job
+
+    failed_count = 0
 
     try:
-        for material in program_options['materials']:
-            if not os.path.isdir(material) and not os.path.isfile(material):
-                material = os.path.join(program_options['materials_src_folder'], material)
+        with ProcessPoolExecutor(max_workers=max(1, program_options['jobs'])) as executor:
+            futures = {
+                executor.submit(compile_shader, *itemgetter('target_name', 'compiler_args', 'output_path', 'source_code')(job)):
+                    hashed_name for hashed_name, job in outdated_jobs.items()
+            }
+
+            for future in as_completed(futures):
+                hashed_name = futures[future]
+                job = outdated_jobs[hashed_name]
+
+                try:
+                    output_path = future.result()
+
+                except exs.GLSLangValidatorError as ex:
+                    shader_name, msg = attrgetter('shader_name', 'msg')(ex)
+                    err_print_fmt(f'==== Shader compilation error, shader \'{shader_name}\':', msg)
+
+                    failed_count += 1
+                    continue
 
-            path = os.path.abspath(material)
+                # E.g. the compiler isn't found or the output isn't writable; the other jobs are still collected.
+                except OSError as ex:
+                    err_print_fmt(f'==== Shader compilation error, shader \'{job["target_name"]}\':', str(ex))
 
-            if os.path.isdir(path):
-                for dirpath, _, filenames in os.walk(path):
-                    filenames = filter(lambda n: n.endswith(program_options['mat_file_ext']), filenames)
-                    filenames = map(lambda n: os.path.abspath(os.path.join(dirpath, n)), filenames)
+                    failed_count += 1
+                    continue
 
-                    for filename in filenames:
-                        with open(filename, 'r') as json_file:
-                            compile_material(program_options, json.load(json_file))
+                print(f'{job["target_name"]} -> {output_path}')
 
-            elif os.path.isfile(path) and path.endswith(program_options['mat_file_ext']):
-                with open(path, 'r') as json_file:
-                    compile_material(program_options, json.load(json_file))
+                manifest[hashed_name] = {
+                    'target_name': job['target_name'],
+                    'output': os.path.basename(output_path),
+                    'digest': job['digest']
+                }
+
+    finally:
+        # Only the successfully compiled outputs get into the manifest, so the failed ones are retried next time.
+        # It's saved even if the compilation is interrupted, so the already compiled outputs aren't compiled again.
+        save_manifest(manifest_path, manifest)
+
+    print(f'{len(jobs) - len(outdated_jobs)} up to date, {len(outdated_jobs) - failed_count} compiled, {failed_count} failed')
+
+    return failed_count == 0
+
+
+def main():
+    program_options = parse_program_options()
+
+    try:
+        if not compile_materials(program_options):
+            sys.exit(1)
 
-    except exs.GLSLangValidatorError as ex:
-        shader_name, msg = attrgetter('shader_name', 'msg')(ex)
-        err_print_fmt(f'==== Shader compilation error, shader \'{shader_name}\':', msg)
+    except (OSError, ValueError, KeyError):
         traceback.print_exc()
+        sys.exit(1)
 
 
 if __name__ == '__main__':